@@ -1,7 +1,11 @@
 #ifndef PHYSICS_ENGINE_CUDA_ACCELERATION_CALCULATION_H
 #define PHYSICS_ENGINE_CUDA_ACCELERATION_CALCULATION_H
 
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <memory>
+
 #include "physics/acceleration_calculation.h"
+#include "physics/force_laws.h"
 
 /**
  * @brief Namespace for physics-related functions and classes.
@@ -9,12 +13,43 @@
 namespace physics {
 
 	/**
-	 * @brief An <strong>CUDA-accelerated</strong> implementation of the calculation of gravitational accelerations of
-	 * N bodies.
+	 * @brief The buffers of the GPU, which are only visible to the CUDA translation unit.
 	 */
-	class CudaAccelerationCalculationImpl : public IAccelerationCalculation {
+	struct CudaAccelerationCalculationBuffers;
+
+	/**
+	 * @brief An <strong>CUDA-accelerated</strong> implementation of the calculation of accelerations of N bodies.
+	 * @details The template is explicitly instantiated for each force law in its translation unit. The buffers of the
+	 * GPU are allocated by the first calculation and reused by the following calculations, as long as the number of
+	 * bodies does not grow.
+	 * @tparam TForceLaw the force law between two bodies, which is passed by value to the kernel.
+	 */
+	template<typename TForceLaw>
+	class BasicCudaAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		private:
+			/**
+			 * The force law between two bodies.
+			 */
+			TForceLaw forceLaw_;
+
+			/**
+			 * The buffers of the GPU, which are kept between the calculations.
+			 */
+			std::unique_ptr<CudaAccelerationCalculationBuffers> pBuffers_;
 
 		public:
+			/**
+			 * @brief The parameterized constructor.
+			 * @param forceLaw the force law between two bodies.
+			 */
+			explicit BasicCudaAccelerationCalculationImpl(const TForceLaw &forceLaw = TForceLaw());
+
+			/**
+			 * @brief The destructor, which releases the buffers of the GPU.
+			 */
+			~BasicCudaAccelerationCalculationImpl() override;
+
 			/**
 			 * @brief Calculates the accelerations of the given bodies.
 			 * @param bodies the bodies whose accelerations are to be calculated.
@@ -31,6 +66,11 @@ namespace physics {
 					float squaredSofteningFactor
 			) override;
 	};
+
+	/**
+	 * @brief The CUDA-accelerated implementation of the calculation of gravitational accelerations of N bodies.
+	 */
+	using CudaAccelerationCalculationImpl = BasicCudaAccelerationCalculationImpl<NewtonianForceLaw>;
 }
 
 #endif //PHYSICS_ENGINE_CUDA_ACCELERATION_CALCULATION_H
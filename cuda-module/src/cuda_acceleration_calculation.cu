@@ -1,15 +1,19 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <memory>
+
 #include "cudamodule/cuda_acceleration_calculation.h"
-#include "physics/astronomical_algorithms.h"
 
 #include "cudatoolkit/gpu_facade.cuh"
 #include "cudatoolkit/gpu_code_utilities.cuh"
 
+template<typename TForceLaw>
 __global__ void calcAccelerationsKernel(
 		const float *masses,
 		const float *positions,
 		float *accelerations,
 		const unsigned int numBodies,
-		const float softeningFactorSquared
+		const float softeningFactorSquared,
+		const TForceLaw forceLaw
 ) {
 	// the global thread ID, which is unique across all threads in the grid.
 	const unsigned int globalThreadId = CudaToolkit::GpuCodeUtilities::getGlobalThreadId();
@@ -24,39 +28,100 @@ __global__ void calcAccelerationsKernel(
 			const unsigned int yCoordinateIndexBody2 = xCoordinateIndexBody2 + 1;
 			const unsigned int zCoordinateIndexBody2 = xCoordinateIndexBody2 + 2;
 
-			const float distanceVectorXCoordinate = positions[xCoordinateIndexBody1] - positions[xCoordinateIndexBody2];
-			const float distanceVectorYCoordinate = positions[yCoordinateIndexBody1] - positions[yCoordinateIndexBody2];
-			const float distanceVectorZCoordinate = positions[zCoordinateIndexBody1] - positions[zCoordinateIndexBody2];
+			// the distance vector points from body 1 to body 2
+			const float distanceVectorXCoordinate = positions[xCoordinateIndexBody2] - positions[xCoordinateIndexBody1];
+			const float distanceVectorYCoordinate = positions[yCoordinateIndexBody2] - positions[yCoordinateIndexBody1];
+			const float distanceVectorZCoordinate = positions[zCoordinateIndexBody2] - positions[zCoordinateIndexBody1];
 
-			const float distance = sqrt(
+			const float distanceSquared =
 					(distanceVectorXCoordinate * distanceVectorXCoordinate) +
 					(distanceVectorYCoordinate * distanceVectorYCoordinate) +
-					(distanceVectorZCoordinate * distanceVectorZCoordinate)
-			) + softeningFactorSquared; // to avoid zero in the following divisions
+					(distanceVectorZCoordinate * distanceVectorZCoordinate);
 
-			const float normalizedDistanceVectorXCoordinate = distanceVectorXCoordinate / distance;
-			const float normalizedDistanceVectorYCoordinate = distanceVectorYCoordinate / distance;
-			const float normalizedDistanceVectorZCoordinate = distanceVectorZCoordinate / distance;
-			const float receivedForce = masses[i] / (distance * distance);
+			const float receivedForce = forceLaw(distanceSquared, softeningFactorSquared, masses[globalThreadId],
+												 masses[i]);
 			// It is possible to write directly in to the accelerations array here, but the false sharing will
 			// reduce in this loop significantly the performance
-			forceVector[0] += (receivedForce * normalizedDistanceVectorXCoordinate);
-			forceVector[1] += (receivedForce * normalizedDistanceVectorYCoordinate);
-			forceVector[2] += (receivedForce * normalizedDistanceVectorZCoordinate);
+			forceVector[0] += (receivedForce * distanceVectorXCoordinate);
+			forceVector[1] += (receivedForce * distanceVectorYCoordinate);
+			forceVector[2] += (receivedForce * distanceVectorZCoordinate);
 		}
 	}
 	// false sharing is ok here
-	accelerations[xCoordinateIndexBody1] =
-			CudaToolkit::GpuCodeUtilities::castDoubleToFloat(GRAVITATIONAL_CONSTANT * forceVector[0]);
-	accelerations[yCoordinateIndexBody1] =
-			CudaToolkit::GpuCodeUtilities::castDoubleToFloat(GRAVITATIONAL_CONSTANT * forceVector[1]);
-	accelerations[zCoordinateIndexBody1] =
-			CudaToolkit::GpuCodeUtilities::castDoubleToFloat(GRAVITATIONAL_CONSTANT * forceVector[2]);
+	if (globalThreadId < numBodies) {
+		accelerations[xCoordinateIndexBody1] = forceVector[0];
+		accelerations[yCoordinateIndexBody1] = forceVector[1];
+		accelerations[zCoordinateIndexBody1] = forceVector[2];
+	}
+}
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief The buffers of the GPU for the bodies and their accelerations.
+	 */
+	struct CudaAccelerationCalculationBuffers {
+
+		/**
+		 * The number of bodies the buffers are large enough for.
+		 */
+		size_t capacity = 0;
+
+		/**
+		 * The buffer of the masses.
+		 */
+		std::unique_ptr<CudaToolkit::GpuMemory<float>> pMasses;
+
+		/**
+		 * The buffer of the positions.
+		 */
+		std::unique_ptr<CudaToolkit::GpuMemory<float>> pPositions;
+
+		/**
+		 * The buffer of the accelerations.
+		 */
+		std::unique_ptr<CudaToolkit::GpuMemory<float>> pAccelerations;
+
+		/**
+		 * @brief Reallocates the buffers if they are too small for the passed number of bodies.
+		 * @param numBodies the number of bodies.
+		 */
+		__host__ void reserve(const size_t numBodies) {
+			if (numBodies <= capacity) {
+				return;
+			}
+			// release the old buffers before the new ones are allocated, in order to limit the peak memory
+			pMasses.reset();
+			pPositions.reset();
+			pAccelerations.reset();
+			const size_t floatScalarGpuBufferSize = sizeof(float) * numBodies;
+			pMasses.reset(new CudaToolkit::GpuMemory<float>(
+					CudaToolkit::gpuFacade.allocateGpuMemory<float>(floatScalarGpuBufferSize)));
+			pPositions.reset(new CudaToolkit::GpuMemory<float>(
+					CudaToolkit::gpuFacade.allocateGpuMemory<float>(floatScalarGpuBufferSize * 3)));
+			pAccelerations.reset(new CudaToolkit::GpuMemory<float>(
+					CudaToolkit::gpuFacade.allocateGpuMemory<float>(floatScalarGpuBufferSize * 3)));
+			capacity = numBodies;
+		}
+	};
 }
 
 using namespace physics;
 
-__host__ void CudaAccelerationCalculationImpl::calcAccelerations(
+template<typename TForceLaw>
+__host__ BasicCudaAccelerationCalculationImpl<TForceLaw>::BasicCudaAccelerationCalculationImpl(const TForceLaw &forceLaw) :
+		forceLaw_(forceLaw),
+		pBuffers_(std::make_unique<CudaAccelerationCalculationBuffers>()) {
+}
+
+template<typename TForceLaw>
+__host__ BasicCudaAccelerationCalculationImpl<TForceLaw>::~BasicCudaAccelerationCalculationImpl() = default;
+
+template<typename TForceLaw>
+__host__ void BasicCudaAccelerationCalculationImpl<TForceLaw>::calcAccelerations(
 		const Bodies<float, float, float> &bodies,
 		const size_t numBodies,
 		float *accelerations,
@@ -66,12 +131,10 @@ __host__ void CudaAccelerationCalculationImpl::calcAccelerations(
 	// reuse floatScalarGpuBufferSize in this calculation:
 	const size_t float3dVectorGpuBufferSize = floatScalarGpuBufferSize * 3;
 
-	CudaToolkit::GpuMemory<float> massesGpuBuffer =
-			CudaToolkit::gpuFacade.allocateGpuMemory<float>(floatScalarGpuBufferSize);
-	CudaToolkit::GpuMemory<float> positionsGpuBuffer =
-			CudaToolkit::gpuFacade.allocateGpuMemory<float>(float3dVectorGpuBufferSize);
-	CudaToolkit::GpuMemory<float> accelerationsGpuBuffer =
-			CudaToolkit::gpuFacade.allocateGpuMemory<float>(float3dVectorGpuBufferSize);
+	pBuffers_->reserve(numBodies);
+	CudaToolkit::GpuMemory<float> &massesGpuBuffer = *pBuffers_->pMasses;
+	CudaToolkit::GpuMemory<float> &positionsGpuBuffer = *pBuffers_->pPositions;
+	CudaToolkit::GpuMemory<float> &accelerationsGpuBuffer = *pBuffers_->pAccelerations;
 
 	CudaToolkit::gpuFacade.copyDataFromCpuMemoryToGpuMemory<float>(bodies.masses, massesGpuBuffer,
 																   floatScalarGpuBufferSize);
@@ -83,19 +146,20 @@ __host__ void CudaAccelerationCalculationImpl::calcAccelerations(
 	cudaOccupancyMaxPotentialBlockSize(
 			&unused,
 			&maxSuggestedBlockSize,
-			calcAccelerationsKernel,
+			calcAccelerationsKernel<TForceLaw>,
 			unused,
 			static_cast<int>(numBodies)
 	);
 
 	const int numThreadsPerBlock = std::min(static_cast<int>(numBodies), maxSuggestedBlockSize);
 	const int numBlocks = std::ceil(static_cast<float>(numBodies) / static_cast<float>(numThreadsPerBlock));
-	calcAccelerationsKernel<<<numBlocks, numThreadsPerBlock>>>(
+	calcAccelerationsKernel<TForceLaw><<<numBlocks, numThreadsPerBlock>>>(
 			massesGpuBuffer,
 			positionsGpuBuffer,
 			accelerationsGpuBuffer,
 			numBodies,
-			squaredSofteningFactor
+			squaredSofteningFactor,
+			forceLaw_
 	);
 
 	// This copy blocks until the above kernel call returns
@@ -105,3 +169,5 @@ __host__ void CudaAccelerationCalculationImpl::calcAccelerations(
 			float3dVectorGpuBufferSize
 	);
 }
+
+PHYSICS_INSTANTIATE_FOR_ALL_FORCE_LAWS(physics::BasicCudaAccelerationCalculationImpl)
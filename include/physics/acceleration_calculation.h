@@ -3,8 +3,10 @@
 
 // Reminder: Always include standard library and system headers before including your own headers.
 #include <cstddef>
+#include <stdexcept>
 
 #include "bodies.h"
+#include "update_context.h"
 
 /**
  * @brief Namespace for physics-related functions and classes.
@@ -37,6 +39,192 @@ namespace physics {
 					float *accelerations,
 					float squaredSofteningFactor
 			) = 0;
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies with the resources of the passed update.
+			 * @details Implementations which need scratch memory take it from the arenas of the context instead of the
+			 * heap. By default the context is ignored. It is a separate method instead of an overload, so
+			 * implementations do not hide one of the overloads by overriding the other.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies, as by <code>calcAccelerations</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 * @param context the context of the update, whose arenas were reset before the call.
+			 */
+			virtual void calcAccelerationsInContext(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor,
+					UpdateContext &context
+			) {
+				(void) context;
+				calcAccelerations(bodies, numBodies, accelerations, squaredSofteningFactor);
+			}
+
+			/**
+			 * @brief Returns whether this implementation calculates the potentials of the bodies as a byproduct of the
+			 * accelerations, see <code>calcAccelerationsAndPotentials</code>.
+			 * @return <code>true</code> if the potentials are supported, otherwise <code>false</code>.
+			 */
+			[[nodiscard]] virtual bool isPotentialCalculationSupported() const {
+				return false;
+			}
+
+			/**
+			 * @brief Calculates the accelerations and the potential energies of the given bodies in the same sweep
+			 * over all pairs.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies, as by <code>calcAccelerations</code>.
+			 * @param[out] potentials the potential energy of each body with all other bodies. The number of elements
+			 * 					must be <code>numBodies</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 * @throws std::logic_error if the implementation does not support potentials.
+			 */
+			virtual void calcAccelerationsAndPotentials(
+					const Bodies<float, float, float> &,
+					size_t,
+					float *,
+					float *,
+					float
+			) {
+				// let it crash
+				throw std::logic_error("The acceleration calculation does not calculate potentials.");
+			}
+
+			/**
+			 * @brief Returns whether this implementation can calculate the accelerations of a range of target bodies
+			 * only, see <code>calcAccelerationsOfTargetRange</code>.
+			 * @return <code>true</code> if target ranges are supported, otherwise <code>false</code>.
+			 */
+			[[nodiscard]] virtual bool isTargetRangeSupported() const {
+				return false;
+			}
+
+			/**
+			 * @brief Calculates the accelerations of the target bodies of the passed range caused by all bodies, e.g.
+			 * so several implementations can share the work of one calculation.
+			 * @details The source bodies are read from the compressed position tiles if the compression is enabled.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param targetBegin the index of the first target body.
+			 * @param targetEnd the index after the last target body, at most <code>numBodies</code>.
+			 * @param[in, out] accelerations the accelerations of all passed bodies, of which only the elements of the
+			 * 					target bodies are written.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 * @throws std::logic_error if the implementation does not support target ranges, or not together with the
+			 * 					enabled position compression.
+			 */
+			virtual void calcAccelerationsOfTargetRange(
+					const Bodies<float, float, float> &,
+					size_t,
+					size_t,
+					size_t,
+					float *,
+					float
+			) {
+				// let it crash
+				throw std::logic_error("The acceleration calculation does not support target ranges.");
+			}
+
+			/**
+			 * @brief Returns whether this implementation can read the source bodies of its pairwise loop as compressed
+			 * position tiles, see <code>setPositionCompressionEnabled</code>.
+			 * @return <code>true</code> if the compression is supported, otherwise <code>false</code>.
+			 */
+			[[nodiscard]] virtual bool isPositionCompressionSupported() const {
+				return false;
+			}
+
+			/**
+			 * @brief Enables or disables the compressed position tiles of the source bodies.
+			 * @details The source bodies are packed into tiles of half-precision positions relative to a float origin
+			 * per tile and half-precision masses relative to a float scale per tile, which halves the memory traffic of
+			 * bandwidth-bound pairwise loops. The accumulation stays in float, but each position of a source body is
+			 * off by up to <code>2^-12</code> of the extent of its tile, so the bodies should be ordered along a
+			 * space-filling curve to keep the tiles small. The potentials are always calculated from the exact
+			 * positions. The compression is disabled by default.
+			 * @param enabled <code>true</code> if the source bodies should be compressed.
+			 * @throws std::logic_error if the compression is enabled, but not supported or the deterministic mode is
+			 * 					enabled.
+			 */
+			virtual void setPositionCompressionEnabled(const bool enabled) {
+				if (enabled) {
+					// let it crash
+					throw std::logic_error("The acceleration calculation does not support compressed positions.");
+				}
+			}
+
+			/**
+			 * @brief Returns whether this implementation can evaluate the field of the bodies at probes, see
+			 * <code>calcFieldAtProbes</code>.
+			 * @return <code>true</code> if probes are supported, otherwise <code>false</code>.
+			 */
+			[[nodiscard]] virtual bool isProbeEvaluationSupported() const {
+				return false;
+			}
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potential energies of probes caused by the passed
+			 * bodies, e.g. at a few points of interest, without calculating the accelerations of the bodies.
+			 * @details The probes are no sources, so their cost is proportional to the number of probes. A probe carries
+			 * a mass (resp. charge) for the force law, e.g. one for the field per unit mass. Bodies at the position of a
+			 * probe are skipped, so the accelerations of a subset of the bodies are calculated by probes at their
+			 * positions with their masses.
+			 * @param bodies the source bodies.
+			 * @param numBodies the number of bodies.
+			 * @param probeMasses the masses (resp. charges) of the probes.
+			 * @param probePositions the positions of the probes, <code>numProbes * vector dimension</code> coordinates.
+			 * @param numProbes the number of probes.
+			 * @param[out] accelerations the accelerations of the probes, <code>numProbes * vector dimension</code>
+			 * 					elements.
+			 * @param[out] potentials the potential energies of the probes with all bodies, <code>numProbes</code>
+			 * 					elements, or <code>nullptr</code> if they are not needed.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 * @throws std::logic_error if the implementation does not support probes.
+			 */
+			virtual void calcFieldAtProbes(
+					const Bodies<float, float, float> &,
+					size_t,
+					const float *,
+					const float *,
+					size_t,
+					float *,
+					float *,
+					float
+			) {
+				// let it crash
+				throw std::logic_error("The acceleration calculation does not support probes.");
+			}
+
+			/**
+			 * @brief Returns whether this implementation has a deterministic mode, see
+			 * <code>setDeterministicModeEnabled</code>.
+			 * @return <code>true</code> if the deterministic mode is supported, otherwise <code>false</code>.
+			 */
+			[[nodiscard]] virtual bool isDeterministicModeSupported() const {
+				return false;
+			}
+
+			/**
+			 * @brief Enables or disables the deterministic mode.
+			 * @details In the deterministic mode the contributions of all source bodies to a target body are summed up
+			 * exactly by fixed-point accumulators and rounded once, so the accelerations and potentials do not depend
+			 * on the number of threads, the schedule or the order of the pairs. They are bit-identical between all
+			 * implementations which support the mode, as long as they are compiled with the same floating-point
+			 * options. The mode cannot be combined with the position compression, and it does not apply to probes. Its
+			 * costs are reported by the performance tests. The mode is disabled by default.
+			 * @param enabled <code>true</code> if the calculation should be deterministic.
+			 * @throws std::logic_error if the mode is enabled, but not supported or the position compression is
+			 * 					enabled.
+			 */
+			virtual void setDeterministicModeEnabled(const bool enabled) {
+				if (enabled) {
+					// let it crash
+					throw std::logic_error("The acceleration calculation does not support the deterministic mode.");
+				}
+			}
 	};
 }
 
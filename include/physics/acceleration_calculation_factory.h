@@ -2,6 +2,8 @@
 #define PHYSICS_ENGINE_ACCELERATION_CALCULATION_FACTORY_H
 
 #include "acceleration_calculation.h"
+#include "force_laws.h"
+#include "periodic_box.h"
 
 /**
  * @brief Namespace for physics-related functions and classes.
@@ -31,17 +33,107 @@ namespace physics {
 		/**
  		 * The constant to specify the <strong>CUDA-accelerated</strong> implementation of the acceleration calculation.
  		 */
-		CUDA
+		CUDA,
+
+		/**
+		 * The constant to specify the <strong>TreePM</strong> implementation of the acceleration calculation, which
+		 * combines a particle-mesh solver for the long-range part with an octree walk for the short-range part.
+		 */
+		TREE_PM,
+
+		/**
+		 * The constant to specify the <strong>out-of-core</strong> implementation of the acceleration calculation,
+		 * which streams the bodies tile by tile, e.g. memory-mapped bodies exceeding the RAM.
+		 */
+		OUT_OF_CORE,
+
+		/**
+		 * The constant to specify the <strong>heterogeneous</strong> implementation of the acceleration calculation,
+		 * which splits the bodies between the OpenMP and the OpenCL implementation and balances the split by their
+		 * measured rates.
+		 */
+		HETEROGENEOUS,
+
+		/**
+		 * The constant to specify the <strong>multi-device OpenCL-accelerated</strong> implementation of the
+		 * acceleration calculation, which splits the bodies between all eligible OpenCL devices.
+		 */
+		OPEN_CL_MULTI_DEVICE,
+
+		/**
+		 * The constant to specify the <strong>small-N</strong> implementation of the acceleration calculation, which
+		 * calculates up to 64 bodies, e.g. planetary systems, by kernels specialized for each number of bodies and
+		 * more bodies by the OpenMP implementation.
+		 */
+		SMALL_N,
+
+		/**
+		 * The constant to specify the <strong>Ewald summation</strong> implementation of the acceleration
+		 * calculation, which calculates the bodies in a periodic box, see the overload with a periodic box.
+		 */
+		EWALD
 	};
 
 	/**
-	 * @brief Creates an acceleration calculation.
+	 * @brief Creates an acceleration calculation of Newtonian gravity.
 	 * @details The returned acceleration calculation should be destroyed with <code>delete</code> by the caller.
 	 * @param implementation the specification of a concrete implementation to be created.
 	 * @return the pointer to the implementation of the specified acceleration calculation.
 	 */
 	IAccelerationCalculation *
 	createAccelerationCalculation(const AccelerationCalculationImplementation &implementation);
+
+	/**
+	 * @brief Creates an acceleration calculation of the passed force law.
+	 * @details The returned acceleration calculation should be destroyed with <code>delete</code> by the caller.
+	 * The template is explicitly instantiated for the force laws of <code>force_laws.h</code>.
+	 * @tparam TForceLaw the force law between two bodies.
+	 * @param implementation the specification of a concrete implementation to be created.
+	 * @param forceLaw the force law between two bodies.
+	 * @return the pointer to the implementation of the specified acceleration calculation.
+	 * @throws std::invalid_argument if the implementation does not support the force law, e.g. the TreePM
+	 * implementation supports only Newtonian gravity, or if the implementation needs a periodic box.
+	 */
+	template<typename TForceLaw>
+	IAccelerationCalculation *
+	createAccelerationCalculation(const AccelerationCalculationImplementation &implementation,
+								  const TForceLaw &forceLaw);
+
+	/**
+	 * @brief Creates an acceleration calculation of the passed force law for a known number of bodies.
+	 * @details For few bodies the specified sequential or OpenMP implementation is replaced by the small-N
+	 * implementation, which avoids their overhead per call. All other implementations are created as specified.
+	 * The returned acceleration calculation should be destroyed with <code>delete</code> by the caller. The template
+	 * is explicitly instantiated for the force laws of <code>force_laws.h</code>.
+	 * @tparam TForceLaw the force law between two bodies.
+	 * @param implementation the specification of a concrete implementation to be created.
+	 * @param forceLaw the force law between two bodies.
+	 * @param numBodies the number of bodies, which will be passed to the acceleration calculation.
+	 * @return the pointer to the implementation of the specified acceleration calculation.
+	 * @throws std::invalid_argument if the implementation does not support the force law.
+	 */
+	template<typename TForceLaw>
+	IAccelerationCalculation *
+	createAccelerationCalculation(const AccelerationCalculationImplementation &implementation,
+								  const TForceLaw &forceLaw, size_t numBodies);
+
+	/**
+	 * @brief Creates an acceleration calculation of the passed force law in a periodic box.
+	 * @details Only the Ewald summation implementation supports periodic boundaries, whose correction table is
+	 * calculated by this call. The returned acceleration calculation should be destroyed with <code>delete</code> by
+	 * the caller. The template is explicitly instantiated for the force laws of <code>force_laws.h</code>.
+	 * @tparam TForceLaw the force law between two bodies.
+	 * @param implementation the specification of a concrete implementation to be created.
+	 * @param forceLaw the force law between two bodies.
+	 * @param periodicBox the periodic box.
+	 * @return the pointer to the implementation of the specified acceleration calculation.
+	 * @throws std::invalid_argument if the implementation does not support periodic boundaries or the force law,
+	 * e.g. the Ewald summation needs a force law which decays like <code>1 / r</code>.
+	 */
+	template<typename TForceLaw>
+	IAccelerationCalculation *
+	createAccelerationCalculation(const AccelerationCalculationImplementation &implementation,
+								  const TForceLaw &forceLaw, const PeriodicBox &periodicBox);
 }
 
 #endif //PHYSICS_ENGINE_ACCELERATION_CALCULATION_FACTORY_H
@@ -0,0 +1,180 @@
+#ifndef PHYSICS_ENGINE_ARENA_H
+#define PHYSICS_ENGINE_ARENA_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A resettable bump allocator for the scratch memory of one thread.
+	 * @details All allocations are released at once by <code>reset</code>. An allocation which does not fit into the
+	 * block of the arena is served by an overflow block, and the next reset replaces the block by one which is large
+	 * enough for the peak usage, so an arena stops allocating after a warm-up. Blocks of at least 2 MiB may be backed
+	 * by transparent huge pages on Linux, which reduces the TLB misses and page faults of large arrays.
+	 * An arena is not thread-safe; each thread uses its own arena.
+	 */
+	class Arena {
+
+		private:
+			/**
+			 * The block of the arena, <code>nullptr</code> if the capacity is zero.
+			 */
+			std::byte *pBlock_;
+
+			/**
+			 * The size of the block in bytes.
+			 */
+			size_t capacity_;
+
+			/**
+			 * The number of bytes allocated from the block since the last reset.
+			 */
+			size_t usage_;
+
+			/**
+			 * The number of bytes allocated from overflow blocks since the last reset.
+			 */
+			size_t overflowUsage_;
+
+			/**
+			 * The maximum number of bytes allocated between two resets.
+			 */
+			size_t peakUsage_;
+
+			/**
+			 * The most recent overflow block, whose first bytes link to the previous overflow block.
+			 */
+			std::byte *pOverflowBlocks_;
+
+			/**
+			 * Whether the blocks should be backed by huge pages.
+			 */
+			bool useHugePages_;
+
+			/**
+			 * Whether the block is backed by huge pages.
+			 */
+			bool isHugePageBacked_;
+
+			/**
+			 * Whether the block is mapped, so it must be unmapped instead of deleted.
+			 */
+			bool isMapped_;
+
+			/**
+			 * @brief Allocates the block of the arena with the passed capacity.
+			 * @param capacity the size of the block in bytes.
+			 */
+			void allocateBlock(size_t capacity);
+
+			/**
+			 * @brief Releases the block and all overflow blocks.
+			 */
+			void releaseBlocks();
+
+		public:
+			/**
+			 * The alignment of all allocations in bytes, which is the size of a cache line.
+			 */
+			static constexpr size_t ALIGNMENT = 64;
+
+			/**
+			 * @brief The parameterized constructor. Creates a new arena by the parameters.
+			 * @param capacity the initial size of the block in bytes, which may be zero.
+			 * @param useHugePages <code>true</code> if the blocks should be backed by huge pages where supported.
+			 */
+			explicit Arena(size_t capacity = 0, bool useHugePages = false);
+
+			/**
+			 * @brief The deleted copy constructor, since the blocks are owned exclusively.
+			 */
+			Arena(const Arena &) = delete;
+
+			/**
+			 * @brief The deleted copy assignment, since the blocks are owned exclusively.
+			 */
+			Arena &operator=(const Arena &) = delete;
+
+			/**
+			 * @brief The move constructor. The moved-from arena is empty.
+			 */
+			Arena(Arena &&other) noexcept;
+
+			/**
+			 * @brief The move assignment. The moved-from arena is empty.
+			 */
+			Arena &operator=(Arena &&other) noexcept;
+
+			/**
+			 * @brief The destructor, which releases all blocks.
+			 */
+			~Arena();
+
+			/**
+			 * @brief Allocates uninitialized memory, which is valid until the next reset.
+			 * @param numBytes the number of bytes.
+			 * @return the pointer to the memory, aligned to <code>ALIGNMENT</code>.
+			 * @throws std::bad_alloc if an overflow block cannot be allocated.
+			 */
+			void *allocate(size_t numBytes);
+
+			/**
+			 * @brief Allocates an uninitialized array, which is valid until the next reset.
+			 * @tparam T the type of the elements, which must be trivially destructible, since the arena runs no
+			 * destructors. The elements are not constructed, e.g. by <code>std::construct_at</code>.
+			 * @param count the number of elements.
+			 * @return the pointer to the first element, aligned to <code>ALIGNMENT</code>.
+			 * @throws std::bad_alloc if an overflow block cannot be allocated.
+			 */
+			template<typename T>
+			T *allocate(const size_t count) {
+				static_assert(std::is_trivially_destructible_v<T>, "An arena runs no destructors.");
+				return static_cast<T *>(allocate(count * sizeof(T)));
+			}
+
+			/**
+			 * @brief Releases all allocations. If overflow blocks were needed, the block is replaced by a block which
+			 * is large enough for the peak usage.
+			 */
+			void reset();
+
+			/**
+			 * @brief Returns the number of bytes allocated since the last reset.
+			 * @return the number of bytes allocated since the last reset, including the alignment padding.
+			 */
+			[[nodiscard]] inline size_t getUsage() const {
+				return usage_ + overflowUsage_;
+			}
+
+			/**
+			 * @brief Returns the maximum number of bytes allocated between two resets.
+			 * @return the peak usage in bytes.
+			 */
+			[[nodiscard]] inline size_t getPeakUsage() const {
+				return peakUsage_;
+			}
+
+			/**
+			 * @brief Returns the size of the block in bytes.
+			 * @return the size of the block in bytes.
+			 */
+			[[nodiscard]] inline size_t getCapacity() const {
+				return capacity_;
+			}
+
+			/**
+			 * @brief Returns whether the block is backed by huge pages.
+			 * @return <code>true</code> if the block is backed by huge pages.
+			 */
+			[[nodiscard]] inline bool isHugePageBacked() const {
+				return isHugePageBacked_;
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_ARENA_H
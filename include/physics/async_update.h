@@ -0,0 +1,82 @@
+#ifndef PHYSICS_ENGINE_ASYNC_UPDATE_H
+#define PHYSICS_ENGINE_ASYNC_UPDATE_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <coroutine>
+#include <cstddef>
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * The thread which runs the asynchronous updates of a system of bodies.
+	 */
+	class AsyncUpdateWorker;
+
+	/**
+	 * @brief The handle of an asynchronous update of a system of bodies, which can be waited for by a thread or
+	 * awaited by a coroutine.
+	 * @details A coroutine which awaits a pending update is resumed by the thread of the updates as soon as the update
+	 * is finished, so it must not block that thread by waiting for another update, but it may start and await the next
+	 * one. A handle must not outlive its system.
+	 */
+	class AsyncUpdate {
+
+		private:
+			/**
+			 * The thread which runs the update.
+			 */
+			AsyncUpdateWorker *pWorker_;
+
+			/**
+			 * The sequence number of the update.
+			 */
+			size_t ticket_;
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Creates a new handle by the parameters.
+			 * @param pWorker the thread which runs the update.
+			 * @param ticket the sequence number of the update.
+			 */
+			AsyncUpdate(AsyncUpdateWorker *pWorker, size_t ticket);
+
+			/**
+			 * @brief Returns whether the update is finished.
+			 * @return <code>true</code> if the update is finished.
+			 */
+			[[nodiscard]] bool isReady() const;
+
+			/**
+			 * @brief Blocks until the update is finished.
+			 */
+			void wait() const;
+
+			/**
+			 * @brief Blocks until the update is finished and rethrows the exception of the update, if any.
+			 */
+			void get() const;
+
+			/**
+			 * @brief Returns whether the update is finished, so an awaiting coroutine is not suspended.
+			 * @return <code>true</code> if the update is finished.
+			 */
+			[[nodiscard]] bool await_ready() const;
+
+			/**
+			 * @brief Registers the awaiting coroutine, which is resumed by the thread of the updates.
+			 * @param continuation the awaiting coroutine.
+			 * @return <code>false</code> if the update finished meanwhile, so the coroutine is resumed immediately.
+			 */
+			bool await_suspend(std::coroutine_handle<> continuation) const;
+
+			/**
+			 * @brief Rethrows the exception of the update into the awaiting coroutine, if any.
+			 */
+			void await_resume() const;
+	};
+}
+
+#endif //PHYSICS_ENGINE_ASYNC_UPDATE_H
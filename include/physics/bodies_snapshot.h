@@ -0,0 +1,102 @@
+#ifndef PHYSICS_ENGINE_BODIES_SNAPSHOT_H
+#define PHYSICS_ENGINE_BODIES_SNAPSHOT_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <vector>
+
+#include "bodies.h"
+#include "body_reordering.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A copy of the state of a system of bodies, which can be read while the system is updated.
+	 * @details The storage of a snapshot is reused by the next capture, so a capture allocates no memory unless the
+	 * number of bodies grows.
+	 */
+	class BodiesSnapshot {
+
+		private:
+			/**
+			 * The masses of the bodies.
+			 */
+			std::vector<float> masses_;
+
+			/**
+			 * The positions of the bodies.
+			 */
+			std::vector<float> positions_;
+
+			/**
+			 * The velocities of the bodies.
+			 */
+			std::vector<float> velocities_;
+
+			/**
+			 * The original IDs of the bodies by their indices.
+			 */
+			std::vector<size_t> originalIds_;
+
+			/**
+			 * The number of bodies.
+			 */
+			size_t numBodies_ = 0;
+
+		public:
+			/**
+			 * @brief Copies the state of the passed bodies into this snapshot.
+			 * @param bodies the bodies to be copied.
+			 * @param numBodies the number of bodies.
+			 * @param bodyReordering the reordering of the bodies, which provides their original IDs.
+			 */
+			void capture(const Bodies<float, float, float> &bodies, size_t numBodies,
+						 const BodyReordering &bodyReordering);
+
+			/**
+			 * @brief Returns the number of bodies.
+			 * @return the number of bodies.
+			 */
+			[[nodiscard]] inline size_t getNumBodies() const {
+				return numBodies_;
+			}
+
+			/**
+			 * @brief Returns the masses of the bodies.
+			 * @return the <code>numBodies</code> masses.
+			 */
+			[[nodiscard]] inline const float *getMasses() const {
+				return masses_.data();
+			}
+
+			/**
+			 * @brief Returns the positions of the bodies.
+			 * @return the <code>numBodies * 3</code> coordinates.
+			 */
+			[[nodiscard]] inline const float *getPositions() const {
+				return positions_.data();
+			}
+
+			/**
+			 * @brief Returns the velocities of the bodies.
+			 * @return the <code>numBodies * 3</code> coordinates.
+			 */
+			[[nodiscard]] inline const float *getVelocities() const {
+				return velocities_.data();
+			}
+
+			/**
+			 * @brief Returns the original ID of the body at the passed index.
+			 * @param index the index of the body within this snapshot.
+			 * @return the original ID of the body.
+			 */
+			[[nodiscard]] inline size_t getOriginalId(const size_t index) const {
+				return originalIds_[index];
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_BODIES_SNAPSHOT_H
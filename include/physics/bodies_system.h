@@ -1,9 +1,20 @@
 #ifndef PHYSICS_ENGINE_BODIES_SYSTEM_H
 #define PHYSICS_ENGINE_BODIES_SYSTEM_H
 
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <memory>
+
+#include "async_update.h"
 #include "bodies.h"
+#include "bodies_snapshot.h"
+#include "body_reordering.h"
+#include "frame_ring.h"
 #include "acceleration_calculation.h"
 #include "position_velocity_calculation.h"
+#include "collision_handling.h"
+#include "diagnostics.h"
+#include "update_context.h"
 
 /**
  * @brief Namespace for physics-related functions and classes.
@@ -12,6 +23,14 @@ namespace physics {
 
 	/**
 	 * @brief A system of bodies.
+	 * @details The system owns its calculations and all workspaces of the updates, which are allocated by the
+	 * constructor and by <code>setDiagnosticsEnabled</code>, so an update allocates no memory itself. The scratch
+	 * memory of the calculations is provided by the arenas of the update context, which are reset by each update. The bodies
+	 * remain owned by the caller, but the system may reorder them for a better locality, so a body should be addressed
+	 * by its original ID, i.e. its index at the construction of the system. An update may run asynchronously on a
+	 * thread of the system, while the caller reads a snapshot of the state before the update, and each update may
+	 * publish a frame to live observers on other threads. A system is movable, but
+	 * not copyable, and moving it waits for the pending asynchronous updates.
 	 */
 	class BodiesSystem {
 
@@ -27,14 +46,20 @@ namespace physics {
 			size_t numBodies_;
 
 			/**
-			 * The pointer to the acceleration calculation used by the current system.
+			 * The acceleration calculation owned by the current system.
+			 */
+			std::unique_ptr<IAccelerationCalculation> pAccelerationCalculation_;
+
+			/**
+			 * The position and velocity calculation owned by the current system.
 			 */
-			IAccelerationCalculation *pAccelerationCalculation_;
+			std::unique_ptr<IPositionVelocityCalculation> pPositionVelocityCalculation_;
 
 			/**
-			 * The pointer to the position and velocity calculation used by the current system.
+			 * The optional collision handling owned by the current system, <code>nullptr</code> if bodies may pass
+			 * through each other.
 			 */
-			IPositionVelocityCalculation *pPositionVelocityCalculation_;
+			std::unique_ptr<ICollisionHandling> pCollisionHandling_;
 
 			/**
 			 * The squared softening factor in order to avoid division by zero.
@@ -44,27 +69,130 @@ namespace physics {
 			/**
 			 * The accelerations.
 			 */
-			float *accelerations_;
+			std::unique_ptr<float[]> accelerations_;
+
+			/**
+			 * The positions at the beginning of the current time step, which the collision handling needs to detect
+			 * collisions of fast bodies. Only allocated if there is a collision handling.
+			 */
+			std::unique_ptr<float[]> previousPositions_;
+
+			/**
+			 * The potential energies of the bodies, which are calculated together with the accelerations. Only
+			 * allocated if the diagnostics are enabled.
+			 */
+			std::unique_ptr<float[]> potentials_;
+
+			/**
+			 * The context of the updates, which provides the scratch memory of the calculations.
+			 */
+			UpdateContext updateContext_;
+
+			/**
+			 * The number of updates between two calculations of the diagnostics, 0 if the diagnostics are disabled.
+			 */
+			size_t diagnosticsInterval_;
+
+			/**
+			 * The number of updates since the construction of the current system.
+			 */
+			size_t numUpdates_;
+
+			/**
+			 * The diagnostics of the last update which calculated them.
+			 */
+			Diagnostics diagnostics_;
+
+			/**
+			 * The reordering of the bodies, which keeps track of their original IDs.
+			 */
+			BodyReordering bodyReordering_;
+
+			/**
+			 * The number of updates between two reorders of the bodies, 0 if the reordering is disabled.
+			 */
+			size_t reorderingInterval_;
+
+			/**
+			 * The number of updates since the reordering was enabled.
+			 */
+			size_t numUpdatesSinceReorderingEnabled_;
+
+			/**
+			 * The snapshot of the state before the last asynchronous update, which is shared with the callers.
+			 */
+			std::shared_ptr<BodiesSnapshot> pFrontSnapshot_;
+
+			/**
+			 * The snapshot which is captured by the next asynchronous update, unless a caller still holds it.
+			 */
+			std::shared_ptr<BodiesSnapshot> pBackSnapshot_;
+
+			/**
+			 * The ring of the frames published by the updates, <code>nullptr</code> if the publishing is disabled.
+			 */
+			std::shared_ptr<FrameRing> pFrameRing_;
+
+			/**
+			 * The thread of the asynchronous updates, which is started by the first one. It is declared last, so the
+			 * pending update is finished before the other members are destroyed.
+			 */
+			std::unique_ptr<AsyncUpdateWorker> pAsyncUpdateWorker_;
+
+			/**
+			 * @brief Updates the current system's bodies on the calling thread.
+			 * @param timeStep the time step used to calculate the bodies positions, accelerations, velocities.
+			 */
+			void step(float timeStep);
 
 		public:
 			/**
 			 * @brief The parameterized Constructor. Creates a new instance of this class by the parameters.
-			 * @param bodies the bodies of the system to be created.
+			 * @param bodies the bodies of the system to be created, which remain owned by the caller.
 			 * @param numBodies the number of bodies.
-			 * @param pAccelerationCalculation the pointer to the acceleration calculation to be used by the system.
-			 * @param pPositionVelocityCalculation the pointer to the position and velocity calculation to be used by the system.
-			 * @param softeningFactor the squared softening factor in order to avoid division by zero.
+			 * @param pAccelerationCalculation the acceleration calculation to be owned by the system.
+			 * @param pPositionVelocityCalculation the position and velocity calculation to be owned by the system.
+			 * @param softeningFactor the softening factor (resp. length) <code>eps</code> of the softening kernel of the
+			 * 					force law, which is squared once for the acceleration calculation.
+			 * @param pCollisionHandling the optional collision handling to be owned by the system. Merged bodies are
+			 * 							removed from the passed bodies, so the number of bodies may decrease by an
+			 * 							update.
+			 * @throws std::invalid_argument if the acceleration calculation or the position and velocity calculation
+			 * is missing.
 			 */
 			BodiesSystem(
 					const Bodies<float, float, float> &bodies,
 					size_t numBodies,
-					IAccelerationCalculation *pAccelerationCalculation,
-					IPositionVelocityCalculation *pPositionVelocityCalculation,
-					float softeningFactor
+					std::unique_ptr<IAccelerationCalculation> pAccelerationCalculation,
+					std::unique_ptr<IPositionVelocityCalculation> pPositionVelocityCalculation,
+					float softeningFactor,
+					std::unique_ptr<ICollisionHandling> pCollisionHandling = nullptr
 			);
 
 			/**
-			 * @brief The destructor.
+			 * @brief The deleted copy constructor, since the calculations and workspaces are owned exclusively.
+			 */
+			BodiesSystem(const BodiesSystem &) = delete;
+
+			/**
+			 * @brief The deleted copy assignment, since the calculations and workspaces are owned exclusively.
+			 */
+			BodiesSystem &operator=(const BodiesSystem &) = delete;
+
+			/**
+			 * @brief The move constructor, which waits for the pending asynchronous update of the moved-from system. The
+			 * moved-from system may only be destroyed or assigned to.
+			 */
+			BodiesSystem(BodiesSystem &&) noexcept;
+
+			/**
+			 * @brief The move assignment, which waits for the pending asynchronous updates of both systems. The
+			 * moved-from system may only be destroyed or assigned to.
+			 */
+			BodiesSystem &operator=(BodiesSystem &&) noexcept;
+
+			/**
+			 * @brief The destructor, which waits for a pending asynchronous update.
 			 */
 			~BodiesSystem();
 
@@ -85,11 +213,122 @@ namespace physics {
 			}
 
 			/**
-			 * @brief Updates the current system's bodies.
+			 * @brief Updates the current system's bodies, after a pending asynchronous update is finished.
 			 * @param timeStep the optional time step used to calculate the bodies positions, accelerations, velocities.
 			 * If not specified 0.1 is used.
 			 */
 			void update(float timeStep = 0.1f);
+
+			/**
+			 * @brief Starts an update of the current system's bodies on the thread of the system, after a pending
+			 * asynchronous update is finished.
+			 * @details Before the update starts, the state is captured into a snapshot, see <code>getSnapshot</code>.
+			 * The bodies and all other state of the system must not be accessed until the returned update is finished,
+			 * except by the snapshot. The exception of a failed update is rethrown by the returned update.
+			 * @param timeStep the optional time step used to calculate the bodies positions, accelerations, velocities.
+			 * If not specified 0.1 is used.
+			 * @return the pending update, which can be waited for or awaited by a coroutine.
+			 */
+			AsyncUpdate updateAsync(float timeStep = 0.1f);
+
+			/**
+			 * @brief Blocks until the pending asynchronous update, if any, is finished.
+			 */
+			void waitForAsyncUpdate();
+
+			/**
+			 * @brief Returns the snapshot of the state before the last asynchronous update.
+			 * @details The snapshots are double-buffered: the next asynchronous update captures the state into the
+			 * other buffer, so a snapshot is not modified as long as a caller holds it. If a caller still holds the
+			 * other buffer, a new buffer is allocated instead.
+			 * @return the snapshot, or <code>nullptr</code> if there was no asynchronous update.
+			 */
+			[[nodiscard]] inline std::shared_ptr<const BodiesSnapshot> getSnapshot() const {
+				return pFrontSnapshot_;
+			}
+
+			/**
+			 * @brief Enables or disables the publishing of a frame of the state after each update.
+			 * @details The frames are published into a lock-free ring, from which any number of observers, e.g. a
+			 * renderer and a recorder, acquire the latest frame on their own threads without blocking the updates.
+			 * Enabling the publishing replaces the ring, so the observers must acquire the new one by
+			 * <code>getFrameRing</code>. The frames are not published by default.
+			 * @param enabled <code>true</code> if the updates should publish frames.
+			 * @param capacity the optional number of frames of the ring, at least the number of frames held by the
+			 * observers at the same time plus 2, so no frame is skipped. If not specified the ring has 8 frames.
+			 * @throws std::invalid_argument if the publishing is enabled with a capacity of less than 2.
+			 */
+			void setFramePublishingEnabled(bool enabled, size_t capacity = 8);
+
+			/**
+			 * @brief Returns the ring of the published frames, which the observers may share beyond the lifetime of
+			 * the system.
+			 * @return the ring, or <code>nullptr</code> if the publishing is disabled.
+			 */
+			[[nodiscard]] inline std::shared_ptr<FrameRing> getFrameRing() const {
+				return pFrameRing_;
+			}
+
+			/**
+			 * @brief Enables or disables the calculation of the diagnostics by the updates.
+			 * @details The diagnostics are fused into the calculation of the accelerations and the update of the
+			 * positions and velocities, so the bodies are not traversed again. The potential energies still cost about
+			 * a quarter of a direct summation, hence they may be sampled only by every n-th update. The updates
+			 * calculate no diagnostics by default.
+			 * @param enabled <code>true</code> if the updates should calculate the diagnostics.
+			 * @param interval the optional number of updates between two calculations of the diagnostics, starting with
+			 * the next update. If not specified every update calculates the diagnostics.
+			 */
+			void setDiagnosticsEnabled(bool enabled, size_t interval = 1);
+
+			/**
+			 * @brief Enables or disables the periodic reordering of the bodies along a space-filling curve.
+			 * @details A reorder permutes the masses, positions and velocities in place, so bodies which are close in
+			 * space become close in memory, which improves the cache and TLB behaviour of the calculations. Since the
+			 * bodies move, the locality degrades slowly and the bodies are reordered again after the interval. The
+			 * bodies are not reordered by default.
+			 * @param enabled <code>true</code> if the updates should reorder the bodies.
+			 * @param curve the optional space-filling curve. If not specified the Hilbert curve is used.
+			 * @param interval the optional number of updates between two reorders, starting with the next update. If not
+			 * specified the bodies are reordered by every 100th update.
+			 * @throws std::invalid_argument if the reordering is enabled with an interval of 0.
+			 */
+			void setReorderingEnabled(bool enabled, SpaceFillingCurve curve = SpaceFillingCurve::HILBERT,
+									  size_t interval = 100);
+
+			/**
+			 * @brief Returns the reordering of the bodies, e.g. to find a body by its original ID.
+			 * @return the reordering of the bodies.
+			 */
+			[[nodiscard]] inline const BodyReordering &getBodyReordering() const {
+				return bodyReordering_;
+			}
+
+			/**
+			 * @brief Replaces the scratch memory of the calculations by arenas of the passed capacity.
+			 * @details The arenas grow to the peak usage of the calculations anyway, so a capacity is only needed to
+			 * avoid the growth during the first updates. The scratch memory has one arena per OpenMP thread.
+			 * @param capacityPerThread the initial capacity of the arena of each thread in bytes.
+			 * @param useHugePages <code>true</code> if large arenas should be backed by huge pages.
+			 */
+			void setScratchMemory(size_t capacityPerThread, bool useHugePages);
+
+			/**
+			 * @brief Returns the context of the updates, e.g. to report the peak usage of the scratch memory.
+			 * @return the context of the updates.
+			 */
+			[[nodiscard]] inline const UpdateContext &getUpdateContext() const {
+				return updateContext_;
+			}
+
+			/**
+			 * @brief Returns the diagnostics of the state at the beginning of the last update which calculated them.
+			 * @details The potential energy is NaN if the acceleration calculation does not support it.
+			 * @return the diagnostics of the last update, or zero if there was no update with enabled diagnostics.
+			 */
+			[[nodiscard]] inline const Diagnostics &getDiagnostics() const {
+				return diagnostics_;
+			}
 	};
 }
 
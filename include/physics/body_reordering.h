@@ -0,0 +1,137 @@
+#ifndef PHYSICS_ENGINE_BODY_REORDERING_H
+#define PHYSICS_ENGINE_BODY_REORDERING_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "bodies.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief Contains the constants to specify the space-filling curve along which bodies are ordered.
+	 */
+	enum class SpaceFillingCurve {
+		/**
+		 * The constant to specify the Morton curve (Z-order), whose keys are cheaper to calculate.
+		 */
+		MORTON,
+
+		/**
+		 * The constant to specify the Hilbert curve, whose consecutive cells are always neighbours.
+		 */
+		HILBERT
+	};
+
+	/**
+	 * @brief Reorders bodies along a space-filling curve and keeps track of the original IDs of the bodies.
+	 * @details Bodies which are close in space become close in memory, which improves the cache and TLB behaviour of
+	 * all calculations. The original ID of a body is its index when the reordering was created. The IDs follow the
+	 * bodies through the reorders and the removals of merged bodies.
+	 */
+	class BodyReordering {
+
+		private:
+			/**
+			 * The space-filling curve along which the bodies are ordered.
+			 */
+			SpaceFillingCurve curve_;
+
+			/**
+			 * The original IDs of the bodies by their current indices.
+			 */
+			std::vector<size_t> originalIds_;
+
+			/**
+			 * The current indices of the bodies by their original IDs, <code>NO_INDEX</code> for removed bodies.
+			 */
+			std::vector<size_t> indices_;
+
+			/**
+			 * The keys and indices of the bodies to be sorted.
+			 */
+			std::vector<std::pair<std::uint64_t, size_t>> keysAndIndices_;
+
+			/**
+			 * The workspace of the radix sort.
+			 */
+			std::vector<std::pair<std::uint64_t, size_t>> sortBuffer_;
+
+			/**
+			 * The digit counts of the radix sort.
+			 */
+			std::vector<size_t> histograms_;
+
+			/**
+			 * The workspace to permute the masses, positions and velocities.
+			 */
+			std::vector<float> permutationBuffer_;
+
+			/**
+			 * The workspace to permute the original IDs.
+			 */
+			std::vector<size_t> originalIdsBuffer_;
+
+		public:
+			/**
+			 * The current index of a removed body.
+			 */
+			static constexpr size_t NO_INDEX = static_cast<size_t>(-1);
+
+			/**
+			 * @brief The parameterized constructor. Creates a new instance of this class by the parameters.
+			 * @param numBodies the number of bodies, whose original IDs are their current indices.
+			 * @param curve the space-filling curve along which the bodies are ordered.
+			 */
+			explicit BodyReordering(size_t numBodies, SpaceFillingCurve curve = SpaceFillingCurve::HILBERT);
+
+			/**
+			 * @brief Sets the space-filling curve along which the bodies are ordered by the next reorder.
+			 * @param curve the space-filling curve.
+			 */
+			inline void setCurve(const SpaceFillingCurve curve) {
+				curve_ = curve;
+			}
+
+			/**
+			 * @brief Sorts the bodies along the space-filling curve, by permuting the masses, positions and velocities
+			 * in place.
+			 * @param bodies the bodies to be reordered.
+			 * @param numBodies the number of bodies, which must be the number of bodies known by the reordering.
+			 */
+			void reorder(const Bodies<float, float, float> &bodies, size_t numBodies);
+
+			/**
+			 * @brief Removes the bodies which were merged into other bodies from the original IDs.
+			 * @param remainingBodyIndices the indices before the removal of the remaining bodies in ascending order.
+			 * @param numRemainingBodies the number of remaining bodies.
+			 */
+			void removeBodies(const size_t *remainingBodyIndices, size_t numRemainingBodies);
+
+			/**
+			 * @brief Returns the original ID of the body at the passed index.
+			 * @param index the current index of the body.
+			 * @return the original ID of the body.
+			 */
+			[[nodiscard]] inline size_t getOriginalId(const size_t index) const {
+				return originalIds_[index];
+			}
+
+			/**
+			 * @brief Returns the current index of the body with the passed original ID.
+			 * @param originalId the original ID of the body.
+			 * @return the current index of the body, or nothing if the body was merged into another body or the ID is
+			 * unknown.
+			 */
+			[[nodiscard]] std::optional<size_t> findBody(size_t originalId) const;
+	};
+}
+
+#endif //PHYSICS_ENGINE_BODY_REORDERING_H
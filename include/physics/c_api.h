@@ -0,0 +1,193 @@
+#ifndef PHYSICS_ENGINE_C_API_H
+#define PHYSICS_ENGINE_C_API_H
+
+/*
+ * The C API of the physics engine, which can be called from any language with a C foreign function interface, e.g.
+ * Fortran by ISO_C_BINDING or Rust by extern "C". The objects are opaque handles, which are created and destroyed by
+ * the library, and all arrays are provided by the caller, so a call copies no more than the arrays it is asked for.
+ * The functions never throw, but return a status and keep a message of the last error per thread. The API is
+ * versioned by PHYSICS_ENGINE_ABI_VERSION, which is the major version (SOVERSION) of the shared library.
+ */
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(PHYSICS_ENGINE_C_API_EXPORTS)
+#define PHYSICS_ENGINE_C_API __declspec(dllexport)
+#elif defined(PHYSICS_ENGINE_C_API_IMPORTS)
+#define PHYSICS_ENGINE_C_API __declspec(dllimport)
+#else
+#define PHYSICS_ENGINE_C_API
+#endif
+#else
+#define PHYSICS_ENGINE_C_API __attribute__((visibility("default")))
+#endif
+
+/**
+ * The version of the C API, which is incremented by each incompatible change.
+ */
+#define PHYSICS_ENGINE_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The status returned by the functions of the C API, one of the <code>PHYSICS_ENGINE_*</code> statuses.
+ */
+typedef int32_t physics_engine_status;
+
+/**
+ * @brief The statuses of the C API.
+ */
+enum {
+
+	/**
+	 * The call succeeded.
+	 */
+	PHYSICS_ENGINE_OK = 0,
+
+	/**
+	 * An argument was invalid, e.g. a null pointer or an unknown implementation.
+	 */
+	PHYSICS_ENGINE_INVALID_ARGUMENT = 1,
+
+	/**
+	 * The memory was exhausted.
+	 */
+	PHYSICS_ENGINE_OUT_OF_MEMORY = 2,
+
+	/**
+	 * The calculation failed, e.g. since no OpenCL device is available.
+	 */
+	PHYSICS_ENGINE_FAILURE = 3
+};
+
+/**
+ * @brief The implementations of the acceleration calculation, see
+ * <code>physics::AccelerationCalculationImplementation</code>.
+ */
+enum {
+	PHYSICS_ENGINE_SEQUENTIAL = 0,
+	PHYSICS_ENGINE_OPEN_MP = 1,
+	PHYSICS_ENGINE_OPEN_CL = 2,
+	PHYSICS_ENGINE_CUDA = 3,
+	PHYSICS_ENGINE_TREE_PM = 4,
+	PHYSICS_ENGINE_OUT_OF_CORE = 5,
+	PHYSICS_ENGINE_HETEROGENEOUS = 6,
+	PHYSICS_ENGINE_OPEN_CL_MULTI_DEVICE = 7,
+	PHYSICS_ENGINE_SMALL_N = 8
+};
+
+/**
+ * @brief The opaque handle of a system of bodies under Newtonian gravity, which owns a copy of its bodies.
+ */
+typedef struct physics_engine_system physics_engine_system;
+
+/**
+ * @brief The opaque handle of an acceleration calculation of Newtonian gravity.
+ */
+typedef struct physics_engine_acceleration_calculation physics_engine_acceleration_calculation;
+
+/**
+ * @brief Returns the version of the C API of the loaded library, which should equal
+ * <code>PHYSICS_ENGINE_ABI_VERSION</code> of the header the caller was compiled against.
+ * @return the version of the C API.
+ */
+PHYSICS_ENGINE_C_API uint32_t physics_engine_get_abi_version(void);
+
+/**
+ * @brief Returns the message of the last error of the calling thread.
+ * @return the message, which is valid until the next call of this thread, an empty string if there was no error.
+ */
+PHYSICS_ENGINE_C_API const char *physics_engine_get_last_error_message(void);
+
+/**
+ * @brief Creates a system of bodies, which integrates the bodies by the Euler method.
+ * @param masses the masses, <code>num_bodies</code> floats, which are copied.
+ * @param positions the positions, <code>num_bodies * 3</code> floats, which are copied.
+ * @param velocities the velocities, <code>num_bodies * 3</code> floats, which are copied.
+ * @param num_bodies the number of bodies.
+ * @param implementation the implementation of the acceleration calculation, e.g.
+ * 						<code>PHYSICS_ENGINE_OPEN_MP</code>.
+ * @param softening_factor the softening factor of the force law.
+ * @param[out] system the created system, which must be destroyed by <code>physics_engine_system_destroy</code>.
+ * @return <code>PHYSICS_ENGINE_OK</code> if the system was created.
+ */
+PHYSICS_ENGINE_C_API physics_engine_status physics_engine_system_create(
+		const float *masses, const float *positions, const float *velocities, size_t num_bodies,
+		int32_t implementation, float softening_factor, physics_engine_system **system);
+
+/**
+ * @brief Destroys a system of bodies.
+ * @param system the system to be destroyed, may be null.
+ */
+PHYSICS_ENGINE_C_API void physics_engine_system_destroy(physics_engine_system *system);
+
+/**
+ * @brief Advances the system of bodies by the passed number of time steps.
+ * @param system the system.
+ * @param time_step the time step.
+ * @param num_steps the number of time steps.
+ * @return <code>PHYSICS_ENGINE_OK</code> if the system was advanced.
+ */
+PHYSICS_ENGINE_C_API physics_engine_status physics_engine_system_step(
+		physics_engine_system *system, float time_step, size_t num_steps);
+
+/**
+ * @brief Returns the number of bodies of the system.
+ * @param system the system.
+ * @return the number of bodies, 0 if the system is null.
+ */
+PHYSICS_ENGINE_C_API size_t physics_engine_system_get_num_bodies(const physics_engine_system *system);
+
+/**
+ * @brief Copies the bodies of the system into the buffers of the caller, whose sizes are given by
+ * <code>physics_engine_system_get_num_bodies</code>.
+ * @param system the system.
+ * @param[out] masses the buffer of the masses, <code>num_bodies</code> floats, or null to skip them.
+ * @param[out] positions the buffer of the positions, <code>num_bodies * 3</code> floats, or null to skip them.
+ * @param[out] velocities the buffer of the velocities, <code>num_bodies * 3</code> floats, or null to skip them.
+ * @return <code>PHYSICS_ENGINE_OK</code> if the bodies were copied.
+ */
+PHYSICS_ENGINE_C_API physics_engine_status physics_engine_system_read(
+		const physics_engine_system *system, float *masses, float *positions, float *velocities);
+
+/**
+ * @brief Creates an acceleration calculation of Newtonian gravity.
+ * @param implementation the implementation, e.g. <code>PHYSICS_ENGINE_OPEN_MP</code>.
+ * @param[out] acceleration_calculation the created acceleration calculation, which must be destroyed by
+ * 										<code>physics_engine_acceleration_calculation_destroy</code>.
+ * @return <code>PHYSICS_ENGINE_OK</code> if the acceleration calculation was created.
+ */
+PHYSICS_ENGINE_C_API physics_engine_status physics_engine_acceleration_calculation_create(
+		int32_t implementation, physics_engine_acceleration_calculation **acceleration_calculation);
+
+/**
+ * @brief Destroys an acceleration calculation.
+ * @param acceleration_calculation the acceleration calculation to be destroyed, may be null.
+ */
+PHYSICS_ENGINE_C_API void physics_engine_acceleration_calculation_destroy(
+		physics_engine_acceleration_calculation *acceleration_calculation);
+
+/**
+ * @brief Calculates the accelerations of the passed bodies directly on the buffers of the caller.
+ * @param acceleration_calculation the acceleration calculation.
+ * @param masses the masses, <code>num_bodies</code> floats.
+ * @param positions the positions, <code>num_bodies * 3</code> floats.
+ * @param num_bodies the number of bodies.
+ * @param squared_softening_factor the squared softening factor.
+ * @param[out] accelerations the buffer of the accelerations, <code>num_bodies * 3</code> floats.
+ * @return <code>PHYSICS_ENGINE_OK</code> if the accelerations were calculated.
+ */
+PHYSICS_ENGINE_C_API physics_engine_status physics_engine_calc_accelerations(
+		physics_engine_acceleration_calculation *acceleration_calculation, const float *masses,
+		const float *positions, size_t num_bodies, float squared_softening_factor, float *accelerations);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //PHYSICS_ENGINE_C_API_H
@@ -0,0 +1,353 @@
+#ifndef PHYSICS_ENGINE_CELL_LIST_ACCELERATION_CALCULATION_H
+#define PHYSICS_ENGINE_CELL_LIST_ACCELERATION_CALCULATION_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "acceleration_calculation.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A short-range implementation of the calculation of accelerations of N bodies, which only considers pairs
+	 * of bodies within a cutoff radius.
+	 * @details The bodies are assigned to the cells of a uniform grid, whose cells are hashed into a table of about
+	 * twice the number of bodies, so the memory is bounded for any spatial extent. From the cells a Verlet neighbour
+	 * list with the radius <code>cutoffRadius + skinDistance</code> is built. The list is reused by subsequent calls,
+	 * e.g. of <code>BodiesSystem::update</code>, until a body moved more than half of the skin distance since the
+	 * last build, or the number of bodies or the position storage changes.
+	 *
+	 * The pair force is a functor which is inlined into the inner loop. It must provide the member function
+	 * <code>float operator()(float distanceSquared, float squaredSofteningFactor, float targetMass,
+	 * float sourceMass) const</code>, which returns the factor <code>f</code> of the acceleration
+	 * <code>f * (position of source - position of target)</code> received by the target. A positive factor attracts.
+	 * The force laws of <code>force_laws.h</code>, e.g. <code>LennardJonesForceLaw</code>, are such functors.
+	 * @tparam TPairForce the type of the pair force functor.
+	 */
+	template<typename TPairForce>
+	class CellListAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		private:
+			/**
+			 * The pair force functor.
+			 */
+			TPairForce pairForce_;
+
+			/**
+			 * The cutoff radius of the pair force.
+			 */
+			float cutoffRadius_;
+
+			/**
+			 * The skin distance added to the cutoff radius for the neighbour list.
+			 */
+			float skinDistance_;
+
+			/**
+			 * The positions of the bodies at the last build of the neighbour list.
+			 */
+			std::vector<float> referencePositions_;
+
+			/**
+			 * The position storage of the last build of the neighbour list.
+			 */
+			const float *pLastPositions_;
+
+			/**
+			 * The index of the first neighbour of each body in <code>neighbours_</code>, plus the total count.
+			 */
+			std::vector<size_t> neighbourOffsets_;
+
+			/**
+			 * The neighbour list of all bodies, the neighbours of a body are stored contiguously.
+			 */
+			std::vector<size_t> neighbours_;
+
+			/**
+			 * The hash bucket of each body.
+			 */
+			std::vector<size_t> bucketOfBody_;
+
+			/**
+			 * The index of the first body of each hash bucket in <code>bodiesSortedByBucket_</code>, plus the total count.
+			 */
+			std::vector<size_t> bucketOffsets_;
+
+			/**
+			 * The indices of the bodies sorted by their hash buckets.
+			 */
+			std::vector<size_t> bodiesSortedByBucket_;
+
+			/**
+			 * The number of builds of the neighbour list so far.
+			 */
+			size_t numNeighbourListBuilds_;
+
+			/**
+			 * @brief Calculates the integer coordinate of a grid cell along one axis.
+			 * @param coordinate the coordinate of a position.
+			 * @param inverseCellSize the inverse edge length of a cell.
+			 * @return the integer coordinate of the cell.
+			 */
+			static inline std::int64_t calcCellCoordinate(const float coordinate, const float inverseCellSize) {
+				return static_cast<std::int64_t>(std::floor(coordinate * inverseCellSize));
+			}
+
+			/**
+			 * @brief Hashes the passed cell into a bucket of the hash table.
+			 * @param x the x coordinate of the cell.
+			 * @param y the y coordinate of the cell.
+			 * @param z the z coordinate of the cell.
+			 * @param bucketMask the number of buckets minus one, the number of buckets is a power of two.
+			 * @return the bucket of the cell.
+			 */
+			static inline size_t hashCell(const std::int64_t x, const std::int64_t y, const std::int64_t z,
+										  const size_t bucketMask) {
+				const auto hash = (static_cast<std::uint64_t>(x) * 73856093u) ^
+								  (static_cast<std::uint64_t>(y) * 19349663u) ^
+								  (static_cast<std::uint64_t>(z) * 83492791u);
+				return static_cast<size_t>(hash) & bucketMask;
+			}
+
+			/**
+			 * @brief Checks if the neighbour list has to be rebuilt for the passed bodies.
+			 * @param bodies the bodies.
+			 * @param numBodies the number of bodies.
+			 * @return <code>true</code> if the neighbour list has to be rebuilt, <code>false</code> otherwise.
+			 */
+			bool isRebuildRequired(const Bodies<float, float, float> &bodies, const size_t numBodies) const {
+				if ((bodies.positions != pLastPositions_) || ((numBodies * 3) != referencePositions_.size())) {
+					return true;
+				}
+				const float *const referencePositions = referencePositions_.data();
+				float maxSquaredDisplacement = 0.0f;
+				// @formatter:off
+				#pragma omp parallel for reduction(max:maxSquaredDisplacement) default(none) shared(bodies, numBodies, referencePositions)
+				// @formatter:on
+				// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+				for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+					const float displacementX = bodies.positions[(i * 3)] - referencePositions[(i * 3)];
+					const float displacementY = bodies.positions[(i * 3) + 1] - referencePositions[(i * 3) + 1];
+					const float displacementZ = bodies.positions[(i * 3) + 2] - referencePositions[(i * 3) + 2];
+					maxSquaredDisplacement = std::max(
+							maxSquaredDisplacement,
+							(displacementX * displacementX) + (displacementY * displacementY) +
+							(displacementZ * displacementZ)
+					);
+				}
+				const float halfSkinDistance = 0.5f * skinDistance_;
+				return (halfSkinDistance * halfSkinDistance) < maxSquaredDisplacement;
+			}
+
+			/**
+			 * @brief Builds the neighbour list of the passed bodies from scratch.
+			 * @param bodies the bodies.
+			 * @param numBodies the number of bodies.
+			 */
+			void buildNeighbourList(const Bodies<float, float, float> &bodies, const size_t numBodies) {
+				const float listRadius = cutoffRadius_ + skinDistance_;
+				const float squaredListRadius = listRadius * listRadius;
+				const float inverseCellSize = 1.0f / listRadius;
+				size_t numBuckets = 1;
+				while (numBuckets < (2 * numBodies)) {
+					numBuckets <<= 1;
+				}
+				const size_t bucketMask = numBuckets - 1;
+
+				// 1. sort the bodies by the hash buckets of their cells (counting sort)
+				referencePositions_.assign(bodies.positions, bodies.positions + (numBodies * 3));
+				pLastPositions_ = bodies.positions;
+				bucketOfBody_.resize(numBodies);
+				bucketOffsets_.assign(numBuckets + 1, 0);
+				bodiesSortedByBucket_.resize(numBodies);
+				for (size_t i = 0; i < numBodies; ++i) {
+					const size_t bucket = hashCell(
+							calcCellCoordinate(bodies.positions[(i * 3)], inverseCellSize),
+							calcCellCoordinate(bodies.positions[(i * 3) + 1], inverseCellSize),
+							calcCellCoordinate(bodies.positions[(i * 3) + 2], inverseCellSize),
+							bucketMask
+					);
+					bucketOfBody_[i] = bucket;
+					++bucketOffsets_[bucket + 1];
+				}
+				for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
+					bucketOffsets_[bucket + 1] += bucketOffsets_[bucket];
+				}
+				{
+					std::vector<size_t> &fillLevels = neighbourOffsets_; // reused as a temporary
+					fillLevels.assign(bucketOffsets_.begin(), bucketOffsets_.end() - 1);
+					for (size_t i = 0; i < numBodies; ++i) {
+						bodiesSortedByBucket_[fillLevels[bucketOfBody_[i]]++] = i;
+					}
+				}
+
+				// 2. count and then fill the neighbours of each body in the 27 surrounding cells
+				const size_t *const bucketOffsets = bucketOffsets_.data();
+				const size_t *const bodiesSortedByBucket = bodiesSortedByBucket_.data();
+				const auto forEachNeighbour = [&bodies, bucketOffsets, bodiesSortedByBucket, inverseCellSize,
+						squaredListRadius, bucketMask](const size_t i, auto &&consumer) {
+					const std::int64_t cell[3] = {
+							calcCellCoordinate(bodies.positions[(i * 3)], inverseCellSize),
+							calcCellCoordinate(bodies.positions[(i * 3) + 1], inverseCellSize),
+							calcCellCoordinate(bodies.positions[(i * 3) + 2], inverseCellSize)
+					};
+					// different cells may share a bucket, so each bucket must only be visited once
+					size_t buckets[27];
+					size_t numBuckets = 0;
+					for (std::int64_t dx = -1; dx <= 1; ++dx) {
+						for (std::int64_t dy = -1; dy <= 1; ++dy) {
+							for (std::int64_t dz = -1; dz <= 1; ++dz) {
+								buckets[numBuckets++] = hashCell(cell[0] + dx, cell[1] + dy, cell[2] + dz, bucketMask);
+							}
+						}
+					}
+					std::sort(buckets, buckets + numBuckets);
+					numBuckets = static_cast<size_t>(std::unique(buckets, buckets + numBuckets) - buckets);
+					for (size_t b = 0; b < numBuckets; ++b) {
+						for (size_t k = bucketOffsets[buckets[b]]; k < bucketOffsets[buckets[b] + 1]; ++k) {
+							const size_t j = bodiesSortedByBucket[k];
+							if (i != j) {
+								const float distanceVectorXCoordinate =
+										bodies.positions[(j * 3)] - bodies.positions[(i * 3)];
+								const float distanceVectorYCoordinate =
+										bodies.positions[(j * 3) + 1] - bodies.positions[(i * 3) + 1];
+								const float distanceVectorZCoordinate =
+										bodies.positions[(j * 3) + 2] - bodies.positions[(i * 3) + 2];
+								const float squaredDistance =
+										(distanceVectorXCoordinate * distanceVectorXCoordinate) +
+										(distanceVectorYCoordinate * distanceVectorYCoordinate) +
+										(distanceVectorZCoordinate * distanceVectorZCoordinate);
+								if (squaredDistance < squaredListRadius) { // also removes bodies of colliding cells
+									consumer(j);
+								}
+							}
+						}
+					}
+				};
+
+				neighbourOffsets_.assign(numBodies + 1, 0);
+				size_t *const neighbourOffsets = neighbourOffsets_.data();
+				// @formatter:off
+				#pragma omp parallel for schedule(dynamic, 256) default(none) shared(numBodies, neighbourOffsets, forEachNeighbour)
+				// @formatter:on
+				// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+				for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+					size_t numNeighbours = 0;
+					forEachNeighbour(static_cast<size_t>(i), [&numNeighbours](const size_t) { ++numNeighbours; });
+					neighbourOffsets[i + 1] = numNeighbours;
+				}
+				for (size_t i = 0; i < numBodies; ++i) {
+					neighbourOffsets_[i + 1] += neighbourOffsets_[i];
+				}
+				neighbours_.resize(neighbourOffsets_[numBodies]);
+				size_t *const neighbours = neighbours_.data();
+				// @formatter:off
+				#pragma omp parallel for schedule(dynamic, 256) default(none) shared(numBodies, neighbourOffsets, neighbours, forEachNeighbour)
+				// @formatter:on
+				for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+					size_t next = neighbourOffsets[i];
+					forEachNeighbour(static_cast<size_t>(i), [neighbours, &next](const size_t j) { neighbours[next++] = j; });
+				}
+				++numNeighbourListBuilds_;
+			}
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Creates a new instance of this class by the parameters.
+			 * @param pairForce the pair force functor.
+			 * @param cutoffRadius the cutoff radius, pairs of bodies with a larger distance do not interact.
+			 * @param skinDistance the skin distance, which is added to the cutoff radius for the neighbour list. The
+			 * 					larger it is, the longer the neighbour list can be reused, but the more pairs are
+			 * 					visited.
+			 * @throws std::invalid_argument if the cutoff radius is not positive or the skin distance is negative.
+			 */
+			CellListAccelerationCalculationImpl(const TPairForce &pairForce, const float cutoffRadius,
+												const float skinDistance) :
+					pairForce_(pairForce),
+					cutoffRadius_(cutoffRadius),
+					skinDistance_(skinDistance),
+					pLastPositions_(nullptr),
+					numNeighbourListBuilds_(0) {
+				if (!(0.0f < cutoffRadius) || !(0.0f <= skinDistance)) {
+					// let it crash
+					throw std::invalid_argument("The cutoff radius must be positive and the skin distance >= 0.");
+				}
+			}
+
+			/**
+			 * @brief Returns the number of builds of the neighbour list so far.
+			 * @return the number of builds of the neighbour list so far.
+			 */
+			[[nodiscard]] inline size_t getNumNeighbourListBuilds() const {
+				return numNeighbourListBuilds_;
+			}
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies. The <code>accelerations</code>
+			 * 					parameter must be a pointer to an allocated storage which is large enough to store
+			 * 					<code>numBodies * vector dimension</code>.
+			 * @param squaredSofteningFactor the squared softening factor, which is passed to the pair force.
+			 */
+			void calcAccelerations(
+					const Bodies<float, float, float> &bodies,
+					const size_t numBodies,
+					float *const accelerations,
+					const float squaredSofteningFactor
+			) override {
+				if (isRebuildRequired(bodies, numBodies)) {
+					buildNeighbourList(bodies, numBodies);
+				}
+
+				const size_t *const neighbourOffsets = neighbourOffsets_.data();
+				const size_t *const neighbours = neighbours_.data();
+				const TPairForce &pairForce = pairForce_;
+				const float squaredCutoffRadius = cutoffRadius_ * cutoffRadius_;
+				// @formatter:off
+				#pragma omp parallel for schedule(dynamic, 256) default(none) shared(bodies, numBodies, accelerations, squaredSofteningFactor, neighbourOffsets, neighbours, pairForce, squaredCutoffRadius)
+				// @formatter:on
+				// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+				for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+					const size_t xCoordinateIndexBody1 = i * 3;
+					const size_t yCoordinateIndexBody1 = xCoordinateIndexBody1 + 1;
+					const size_t zCoordinateIndexBody1 = xCoordinateIndexBody1 + 2;
+					float accelerationVector[3] = {0.0f, 0.0f, 0.0f};
+					for (size_t k = neighbourOffsets[i]; k < neighbourOffsets[i + 1]; ++k) {
+						const size_t j = neighbours[k];
+						const float distanceVectorXCoordinate =
+								bodies.positions[(j * 3)] - bodies.positions[xCoordinateIndexBody1];
+						const float distanceVectorYCoordinate =
+								bodies.positions[(j * 3) + 1] - bodies.positions[yCoordinateIndexBody1];
+						const float distanceVectorZCoordinate =
+								bodies.positions[(j * 3) + 2] - bodies.positions[zCoordinateIndexBody1];
+						const float squaredDistance = (distanceVectorXCoordinate * distanceVectorXCoordinate) +
+													  (distanceVectorYCoordinate * distanceVectorYCoordinate) +
+													  (distanceVectorZCoordinate * distanceVectorZCoordinate);
+						if (squaredDistance < squaredCutoffRadius) {
+							const float factor = pairForce(squaredDistance, squaredSofteningFactor,
+														   bodies.masses[i], bodies.masses[j]);
+							accelerationVector[0] += factor * distanceVectorXCoordinate;
+							accelerationVector[1] += factor * distanceVectorYCoordinate;
+							accelerationVector[2] += factor * distanceVectorZCoordinate;
+						}
+					}
+					// false sharing is ok here
+					accelerations[xCoordinateIndexBody1] = accelerationVector[0];
+					accelerations[yCoordinateIndexBody1] = accelerationVector[1];
+					accelerations[zCoordinateIndexBody1] = accelerationVector[2];
+				}
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_CELL_LIST_ACCELERATION_CALCULATION_H
@@ -0,0 +1,90 @@
+#ifndef PHYSICS_ENGINE_COLLISION_HANDLING_H
+#define PHYSICS_ENGINE_COLLISION_HANDLING_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+
+#include "bodies.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief Contains the constants to specify how colliding bodies are resolved.
+	 */
+	enum class CollisionResolution {
+
+		/**
+		 * The constant to specify perfectly inelastic collisions, i.e. colliding bodies are merged into one body,
+		 * which conserves the mass, the momentum and the center of mass.
+		 */
+		MERGE,
+
+		/**
+		 * The constant to specify that colliding bodies bounce off each other. The normal component of their relative
+		 * velocity is reversed and scaled by the coefficient of restitution.
+		 */
+		BOUNCE
+	};
+
+	/**
+	 * @brief This functional interface declares the method for the detection and resolution of collisions of N
+	 * bodies within a time step.
+	 */
+	class ICollisionHandling {
+
+		public:
+			/**
+			 * @brief The default destructor.
+			 */
+			virtual ~ICollisionHandling() = default;
+
+			/**
+			 * @brief Detects and resolves the collisions of the given bodies, which moved along straight lines from the
+			 * previous positions to their current positions within the time step.
+			 * @details Merged bodies are removed by compacting the masses, positions and velocities of the remaining
+			 * bodies in place, so the order of the remaining bodies is preserved.
+			 * @param bodies the bodies whose collisions are to be handled.
+			 * @param numBodies the number of bodies.
+			 * @param previousPositions the positions of the bodies at the beginning of the time step. The number of
+			 * 							elements must be <code>numBodies * vector dimension</code>.
+			 * @param timeStep the time step.
+			 * @return the number of bodies after the resolution of the collisions.
+			 */
+			virtual size_t handleCollisions(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *previousPositions,
+					float timeStep
+			) = 0;
+
+			/**
+			 * @brief Returns the indices which the remaining bodies had before the last call of
+			 * <code>handleCollisions</code>, e.g. to keep track of the IDs of the bodies.
+			 * @details Only valid if the last call removed bodies, i.e. returned less than the passed number of bodies,
+			 * and until the next call.
+			 * @return the previous indices of the remaining bodies in ascending order.
+			 */
+			[[nodiscard]] virtual const size_t *getRemainingBodyIndices() const = 0;
+	};
+
+	/**
+	 * @brief Creates a collision handling with a sweep-and-prune broad phase and a continuous narrow phase.
+	 * @details The returned collision handling should be destroyed with <code>delete</code> by the caller.
+	 * The bodies are spheres whose radii follow from their masses and the passed density.
+	 * @param resolution the specification of the resolution of colliding bodies.
+	 * @param bodyDensity the density of the bodies.
+	 * @param coefficientOfRestitution the coefficient of restitution in <code>[0, 1]</code> of bouncing bodies.
+	 * @return the pointer to the created collision handling.
+	 * @throws std::invalid_argument if the density is not positive or the coefficient of restitution is out of range.
+	 */
+	ICollisionHandling *createCollisionHandling(
+			const CollisionResolution &resolution,
+			float bodyDensity,
+			float coefficientOfRestitution = 0.5f
+	);
+}
+
+#endif //PHYSICS_ENGINE_COLLISION_HANDLING_H
@@ -0,0 +1,68 @@
+#ifndef PHYSICS_ENGINE_DIAGNOSTICS_H
+#define PHYSICS_ENGINE_DIAGNOSTICS_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+
+#include "bodies.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief The conserved quantities of a system of bodies at one point in time, which validate long runs.
+	 * @details All quantities are summed up in double precision with compensated summation, so their drift remains
+	 * measurable, although the bodies are stored in single precision.
+	 */
+	struct Diagnostics {
+
+		/**
+		 * The total kinetic energy <code>sum(m * v^2) / 2</code>.
+		 */
+		double kineticEnergy = 0.0;
+
+		/**
+		 * The total potential energy of all pairs of bodies, <code>NaN</code> if the acceleration calculation does
+		 * not calculate potentials.
+		 */
+		double potentialEnergy = 0.0;
+
+		/**
+		 * The sum of the kinetic and the potential energy.
+		 */
+		double totalEnergy = 0.0;
+
+		/**
+		 * The total linear momentum <code>sum(m * v)</code>.
+		 */
+		double linearMomentum[3] = {0.0, 0.0, 0.0};
+
+		/**
+		 * The total angular momentum <code>sum(m * (r x v))</code> with respect to the origin.
+		 */
+		double angularMomentum[3] = {0.0, 0.0, 0.0};
+	};
+
+	/**
+	 * @brief Calculates the kinetic energy, the linear momentum and the angular momentum of the given bodies by a
+	 * parallel reduction. The potential energy is not changed.
+	 * @param bodies the bodies.
+	 * @param numBodies the number of bodies.
+	 * @param[out] diagnostics the diagnostics, whose kinetic energy and momenta are to be set.
+	 */
+	void calcMotionDiagnostics(const Bodies<float, float, float> &bodies, size_t numBodies, Diagnostics &diagnostics);
+
+	/**
+	 * @brief Calculates the total potential energy from the potential energies of the single bodies by a parallel
+	 * reduction.
+	 * @param potentials the potential energy of each body with all other bodies.
+	 * @param numBodies the number of bodies.
+	 * @return the total potential energy, i.e. half of the sum of the passed potential energies, since each pair is
+	 * contained twice.
+	 */
+	double calcTotalPotentialEnergy(const float *potentials, size_t numBodies);
+}
+
+#endif //PHYSICS_ENGINE_DIAGNOSTICS_H
@@ -0,0 +1,639 @@
+#ifndef PHYSICS_ENGINE_FORCE_LAWS_H
+#define PHYSICS_ENGINE_FORCE_LAWS_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cmath>
+#include <string>
+
+#include "astronomical_algorithms.h"
+
+/**
+ * The qualifier of the functions of the force laws, which are also callable from CUDA device code.
+ */
+#ifdef __CUDACC__
+#define PHYSICS_FORCE_LAW_FUNCTION __host__ __device__ inline
+#else
+#define PHYSICS_FORCE_LAW_FUNCTION inline
+#endif
+
+/**
+ * Converts the passed tokens into a string literal.
+ */
+#define PHYSICS_STRINGIFY(...) #__VA_ARGS__
+
+/**
+ * Expands the passed macro invocation and converts the result into a string literal.
+ */
+#define PHYSICS_EXPAND_AND_STRINGIFY(...) PHYSICS_STRINGIFY(__VA_ARGS__)
+
+/*
+ * The pair terms of the force laws. Each force law is defined exactly once as a macro in the common subset of C++,
+ * CUDA and OpenCL C. The macro is expanded into the C++/CUDA functions below and stringified into the OpenCL source
+ * of the force law, so all backends evaluate the same definition. The acceleration received by a target body from a
+ * source body is
+ *
+ *   distance factor(r^2, softening^2, parameters) * strength factor(target mass, source mass, parameters) * (p_s - p_t)
+ *
+ * The distance factor is symmetric, so backends using Newton's third law evaluate it only once per pair. The
+ * potential energy of a pair is symmetric as well. The distances are evaluated by <code>rsqrt</code>, i.e. the
+ * reciprocal square root, which is a single instruction on GPUs and <code>1 / sqrt</code> in C++.
+ */
+
+/**
+ * The softening kernels of the force laws which decay like <code>1 / r</code>, selected by the constants of
+ * <code>physics::SofteningKernel</code>: 0 is no softening, 1 the Plummer softening
+ * <code>1 / (r^2 + eps^2)^(1/2)</code> and 2 the cubic spline softening of Monaghan and Lattanzio (as in GADGET-2),
+ * which is exactly Newtonian beyond the spline softening length <code>h = 2.8 * eps</code>. The selection is
+ * uniform for all pairs, so the branches are predicted (resp. folded into constants by the OpenCL compiler).
+ */
+#define PHYSICS_SOFTENING_KERNELS_SOURCE(QUALIFIER) \
+	QUALIFIER float calcCubicSplineSoftenedInverseCubedDistance(const float distanceSquared, \
+																const float squaredSofteningFactor) { \
+		const float squaredSplineLength = 7.84f * squaredSofteningFactor; \
+		if (squaredSplineLength <= distanceSquared) { \
+			const float inverseDistance = rsqrt(distanceSquared); \
+			return inverseDistance * inverseDistance * inverseDistance; \
+		} \
+		const float inverseSplineLength = rsqrt(squaredSplineLength); \
+		const float inverseCubedSplineLength = inverseSplineLength * inverseSplineLength * inverseSplineLength; \
+		const float u = sqrt(distanceSquared * inverseSplineLength * inverseSplineLength); \
+		if (u < 0.5f) { \
+			return inverseCubedSplineLength * (10.666666667f + ((u * u) * ((32.0f * u) - 38.4f))); \
+		} \
+		return inverseCubedSplineLength * (21.333333333f - (48.0f * u) + (38.4f * u * u) - \
+										   (10.666666667f * u * u * u) - (0.066666667f / (u * u * u))); \
+	} \
+	QUALIFIER float calcCubicSplineSoftenedInverseDistance(const float distanceSquared, \
+														   const float squaredSofteningFactor) { \
+		const float squaredSplineLength = 7.84f * squaredSofteningFactor; \
+		if (squaredSplineLength <= distanceSquared) { \
+			return rsqrt(distanceSquared); \
+		} \
+		const float inverseSplineLength = rsqrt(squaredSplineLength); \
+		const float u = sqrt(distanceSquared * inverseSplineLength * inverseSplineLength); \
+		if (u < 0.5f) { \
+			return inverseSplineLength * (2.8f - ((u * u) * (5.333333333f + ((u * u) * ((6.4f * u) - 9.6f))))); \
+		} \
+		return inverseSplineLength * \
+			   (3.2f - (0.066666667f / u) - \
+				((u * u) * (10.666666667f + (u * (-16.0f + (u * (9.6f - (2.133333333f * u)))))))); \
+	} \
+	QUALIFIER float calcSoftenedInverseCubedDistance(const float distanceSquared, const float squaredSofteningFactor, \
+													 const int softeningKernel) { \
+		if (2 == softeningKernel) { \
+			return calcCubicSplineSoftenedInverseCubedDistance(distanceSquared, squaredSofteningFactor); \
+		} \
+		const float inverseDistance = \
+				rsqrt(distanceSquared + ((0 == softeningKernel) ? 0.0f : squaredSofteningFactor)); \
+		return inverseDistance * inverseDistance * inverseDistance; \
+	} \
+	QUALIFIER float calcSoftenedInverseDistance(const float distanceSquared, const float squaredSofteningFactor, \
+												const int softeningKernel) { \
+		if (2 == softeningKernel) { \
+			return calcCubicSplineSoftenedInverseDistance(distanceSquared, squaredSofteningFactor); \
+		} \
+		return rsqrt(distanceSquared + ((0 == softeningKernel) ? 0.0f : squaredSofteningFactor)); \
+	}
+
+/**
+ * Newtonian gravity with a selectable softening kernel: <code>G * m_s / (r^2 + eps^2)^(3/2)</code> for the Plummer
+ * softening.
+ */
+#define PHYSICS_NEWTONIAN_FORCE_LAW_SOURCE(QUALIFIER) \
+	QUALIFIER float calcNewtonianDistanceFactor(const float distanceSquared, const float squaredSofteningFactor, \
+												const int softeningKernel) { \
+		return calcSoftenedInverseCubedDistance(distanceSquared, squaredSofteningFactor, softeningKernel); \
+	} \
+	QUALIFIER float calcNewtonianStrengthFactor(const float targetMass, const float sourceMass, \
+												const float gravitationalConstant) { \
+		(void) targetMass; \
+		return gravitationalConstant * sourceMass; \
+	} \
+	QUALIFIER float calcNewtonianPotential(const float distanceSquared, const float squaredSofteningFactor, \
+										   const float targetMass, const float sourceMass, \
+										   const float gravitationalConstant, const int softeningKernel) { \
+		return -gravitationalConstant * targetMass * sourceMass * \
+			   calcSoftenedInverseDistance(distanceSquared, squaredSofteningFactor, softeningKernel); \
+	}
+
+/**
+ * Newtonian gravity with the cubic spline softening, i.e. the Newtonian force law with the fixed softening kernel 2.
+ */
+#define PHYSICS_SPLINE_SOFTENED_NEWTONIAN_FORCE_LAW_SOURCE(QUALIFIER) \
+	QUALIFIER float calcSplineSoftenedNewtonianDistanceFactor(const float distanceSquared, \
+															  const float squaredSofteningFactor) { \
+		return calcCubicSplineSoftenedInverseCubedDistance(distanceSquared, squaredSofteningFactor); \
+	} \
+	QUALIFIER float calcSplineSoftenedNewtonianStrengthFactor(const float targetMass, const float sourceMass, \
+															  const float gravitationalConstant) { \
+		(void) targetMass; \
+		return gravitationalConstant * sourceMass; \
+	} \
+	QUALIFIER float calcSplineSoftenedNewtonianPotential(const float distanceSquared, \
+														 const float squaredSofteningFactor, const float targetMass, \
+														 const float sourceMass, const float gravitationalConstant) { \
+		return -gravitationalConstant * targetMass * sourceMass * \
+			   calcCubicSplineSoftenedInverseDistance(distanceSquared, squaredSofteningFactor); \
+	}
+
+/**
+ * The Coulomb force with a selectable softening kernel: <code>-k * q_t * q_s / (r^2 + eps^2)^(3/2)</code> for the
+ * Plummer softening, i.e. like charges repel each other. The masses of the bodies carry the charges.
+ */
+#define PHYSICS_COULOMB_FORCE_LAW_SOURCE(QUALIFIER) \
+	QUALIFIER float calcCoulombDistanceFactor(const float distanceSquared, const float squaredSofteningFactor, \
+											  const int softeningKernel) { \
+		return calcSoftenedInverseCubedDistance(distanceSquared, squaredSofteningFactor, softeningKernel); \
+	} \
+	QUALIFIER float calcCoulombStrengthFactor(const float targetCharge, const float sourceCharge, \
+											  const float coulombConstant) { \
+		return -coulombConstant * targetCharge * sourceCharge; \
+	} \
+	QUALIFIER float calcCoulombPotential(const float distanceSquared, const float squaredSofteningFactor, \
+										 const float targetCharge, const float sourceCharge, \
+										 const float coulombConstant, const int softeningKernel) { \
+		return coulombConstant * targetCharge * sourceCharge * \
+			   calcSoftenedInverseDistance(distanceSquared, squaredSofteningFactor, softeningKernel); \
+	}
+
+/**
+ * The Yukawa (screened Coulomb) force with Plummer softening, whose potential is
+ * <code>k * q_t * q_s * exp(-r / lambda) / r</code>. The masses of the bodies carry the charges.
+ */
+#define PHYSICS_YUKAWA_FORCE_LAW_SOURCE(QUALIFIER) \
+	QUALIFIER float calcYukawaDistanceFactor(const float distanceSquared, const float squaredSofteningFactor, \
+											 const float inverseScreeningLength) { \
+		const float softenedDistanceSquared = distanceSquared + squaredSofteningFactor; \
+		const float inverseDistance = rsqrt(softenedDistanceSquared); \
+		const float scaledDistance = inverseScreeningLength * softenedDistanceSquared * inverseDistance; \
+		return exp(-scaledDistance) * (1.0f + scaledDistance) * inverseDistance * inverseDistance * inverseDistance; \
+	} \
+	QUALIFIER float calcYukawaStrengthFactor(const float targetCharge, const float sourceCharge, \
+											 const float couplingConstant) { \
+		return -couplingConstant * targetCharge * sourceCharge; \
+	} \
+	QUALIFIER float calcYukawaPotential(const float distanceSquared, const float squaredSofteningFactor, \
+										const float targetCharge, const float sourceCharge, \
+										const float inverseScreeningLength, const float couplingConstant) { \
+		const float softenedDistanceSquared = distanceSquared + squaredSofteningFactor; \
+		const float inverseDistance = rsqrt(softenedDistanceSquared); \
+		return couplingConstant * targetCharge * sourceCharge * \
+			   exp(-inverseScreeningLength * softenedDistanceSquared * inverseDistance) * inverseDistance; \
+	}
+
+/**
+ * The Lennard-Jones force <code>24 * epsilon * (2 * (sigma / r)^12 - (sigma / r)^6) / r</code> with Plummer
+ * softening. It does not depend on the source mass; the force is divided by the target mass.
+ */
+#define PHYSICS_LENNARD_JONES_FORCE_LAW_SOURCE(QUALIFIER) \
+	QUALIFIER float calcLennardJonesDistanceFactor(const float distanceSquared, const float squaredSofteningFactor, \
+												   const float wellDepth, const float squaredZeroCrossingDistance) { \
+		const float inverseSquaredDistance = 1.0f / (distanceSquared + squaredSofteningFactor); \
+		const float squaredRatio = squaredZeroCrossingDistance * inverseSquaredDistance; \
+		const float ratioPow6 = squaredRatio * squaredRatio * squaredRatio; \
+		return -24.0f * wellDepth * ((2.0f * ratioPow6 * ratioPow6) - ratioPow6) * inverseSquaredDistance; \
+	} \
+	QUALIFIER float calcLennardJonesStrengthFactor(const float targetMass, const float sourceMass) { \
+		(void) sourceMass; \
+		return 1.0f / targetMass; \
+	} \
+	QUALIFIER float calcLennardJonesPotential(const float distanceSquared, const float squaredSofteningFactor, \
+											  const float wellDepth, const float squaredZeroCrossingDistance) { \
+		const float squaredRatio = squaredZeroCrossingDistance / (distanceSquared + squaredSofteningFactor); \
+		const float ratioPow6 = squaredRatio * squaredRatio * squaredRatio; \
+		return 4.0f * wellDepth * ((ratioPow6 * ratioPow6) - ratioPow6); \
+	}
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief Namespace for the functions generated from the definitions of the force laws.
+	 */
+	namespace forcelaws {
+#ifndef __CUDACC__
+		using std::sqrt;
+		using std::exp;
+#endif
+
+		/**
+		 * @brief Calculates the reciprocal square root, which is the native instruction in CUDA device code and as
+		 * OpenCL built-in function.
+		 * @param value the value, which must not be negative.
+		 * @return <code>1 / sqrt(value)</code>.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float rsqrt(const float value) {
+#ifdef __CUDA_ARCH__
+			return rsqrtf(value);
+#else
+			return 1.0f / sqrt(value);
+#endif
+		}
+
+		PHYSICS_SOFTENING_KERNELS_SOURCE(PHYSICS_FORCE_LAW_FUNCTION)
+
+		PHYSICS_NEWTONIAN_FORCE_LAW_SOURCE(PHYSICS_FORCE_LAW_FUNCTION)
+
+		PHYSICS_SPLINE_SOFTENED_NEWTONIAN_FORCE_LAW_SOURCE(PHYSICS_FORCE_LAW_FUNCTION)
+
+		PHYSICS_COULOMB_FORCE_LAW_SOURCE(PHYSICS_FORCE_LAW_FUNCTION)
+
+		PHYSICS_YUKAWA_FORCE_LAW_SOURCE(PHYSICS_FORCE_LAW_FUNCTION)
+
+		PHYSICS_LENNARD_JONES_FORCE_LAW_SOURCE(PHYSICS_FORCE_LAW_FUNCTION)
+
+		/**
+		 * @brief Converts the passed float into an exact OpenCL C float literal.
+		 * @param value the value to be converted.
+		 * @return the hexadecimal float literal of the passed value.
+		 */
+		std::string toOpenClFloatLiteral(float value);
+
+		/**
+		 * @brief Creates the OpenCL source of a force law, which defines the macros
+		 * <code>FORCE_LAW_DISTANCE_FACTOR(distanceSquared, squaredSofteningFactor)</code> and
+		 * <code>FORCE_LAW_STRENGTH_FACTOR(targetMass, sourceMass)</code> used by the OpenCL kernels.
+		 * @param definition the stringified definition of the force law.
+		 * @param distanceFactorCall the call of the distance factor function in terms of the macro parameters.
+		 * @param strengthFactorCall the call of the strength factor function in terms of the macro parameters.
+		 * @return the OpenCL source of the force law.
+		 */
+		std::string createOpenClSource(const char *definition, const std::string &distanceFactorCall,
+									   const std::string &strengthFactorCall);
+	}
+
+	/**
+	 * @brief Contains the constants to specify the softening of the force laws which decay like <code>1 / r</code>.
+	 * @details The softening replaces the singular force at small distances by the force of a smoothed mass
+	 * distribution, whose size is given by the softening factor <code>eps</code> passed to the acceleration
+	 * calculations.
+	 */
+	enum class SofteningKernel {
+
+		/**
+		 * The constant to specify the unsoftened force, which ignores the softening factor.
+		 */
+		NONE = 0,
+
+		/**
+		 * The constant to specify the Plummer softening <code>1 / (r^2 + eps^2)^(3/2)</code>, which is the force of a
+		 * Plummer sphere of scale length <code>eps</code>.
+		 */
+		PLUMMER = 1,
+
+		/**
+		 * The constant to specify the cubic spline softening of Monaghan and Lattanzio, which is exactly Newtonian
+		 * beyond <code>2.8 * eps</code> and has the same potential minimum as the Plummer softening.
+		 */
+		CUBIC_SPLINE = 2
+	};
+
+	/*
+	 * The force laws are policies of the acceleration calculations. A force law is a functor, which provides:
+	 *
+	 *   float calcDistanceFactor(float distanceSquared, float squaredSofteningFactor) const
+	 *   float calcStrengthFactor(float targetMass, float sourceMass) const
+	 *   float operator()(float distanceSquared, float squaredSofteningFactor, float targetMass, float sourceMass) const
+	 *   float calcPotentialEnergy(float distanceSquared, float squaredSofteningFactor, float targetMass,
+	 *                             float sourceMass) const
+	 *   std::string createOpenClSource() const
+	 *
+	 * The backends are instantiated per force law, so the force law is inlined into the inner loop.
+	 */
+
+	/**
+	 * @brief Newtonian gravity with a selectable softening kernel, by default the Plummer softening.
+	 */
+	struct NewtonianForceLaw {
+
+		/**
+		 * The gravitational constant.
+		 */
+		float gravitationalConstant = static_cast<float>(GRAVITATIONAL_CONSTANT);
+
+		/**
+		 * The softening kernel.
+		 */
+		SofteningKernel softeningKernel = SofteningKernel::PLUMMER;
+
+		/**
+		 * @brief Calculates the symmetric distance-dependent factor of the pair term.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the distance factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcDistanceFactor(const float distanceSquared,
+															const float squaredSofteningFactor) const {
+			return forcelaws::calcNewtonianDistanceFactor(distanceSquared, squaredSofteningFactor,
+														  static_cast<int>(softeningKernel));
+		}
+
+		/**
+		 * @brief Calculates the factor of the pair term, which depends on the masses (resp. charges) of the two bodies.
+		 * @return the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcStrengthFactor(const float targetMass, const float sourceMass) const {
+			return forcelaws::calcNewtonianStrengthFactor(targetMass, sourceMass, gravitationalConstant);
+		}
+
+		/**
+		 * @brief Calculates the factor <code>f</code> of the acceleration <code>f * (p_s - p_t)</code> received by the
+		 * target body.
+		 * @return the product of the distance factor and the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float operator()(const float distanceSquared, const float squaredSofteningFactor,
+													const float targetMass, const float sourceMass) const {
+			return calcDistanceFactor(distanceSquared, squaredSofteningFactor) *
+				   calcStrengthFactor(targetMass, sourceMass);
+		}
+
+		/**
+		 * @brief Calculates the potential energy of a pair of bodies, which is symmetric.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the potential energy of the pair.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcPotentialEnergy(const float distanceSquared, const float squaredSofteningFactor,
+															 const float targetMass, const float sourceMass) const {
+			return forcelaws::calcNewtonianPotential(distanceSquared, squaredSofteningFactor, targetMass, sourceMass,
+													 gravitationalConstant, static_cast<int>(softeningKernel));
+		}
+
+		/**
+		 * @brief Creates the OpenCL source of this force law with its parameters.
+		 * @return the OpenCL source, which defines the macros used by the OpenCL kernels.
+		 */
+		[[nodiscard]] std::string createOpenClSource() const;
+	};
+
+	/**
+	 * @brief Newtonian gravity with cubic spline softening, which is the Newtonian force law with the fixed softening
+	 * kernel <code>SofteningKernel::CUBIC_SPLINE</code>.
+	 */
+	struct SplineSoftenedNewtonianForceLaw {
+
+		/**
+		 * The gravitational constant.
+		 */
+		float gravitationalConstant = static_cast<float>(GRAVITATIONAL_CONSTANT);
+
+		/**
+		 * @brief Calculates the symmetric distance-dependent factor of the pair term.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the distance factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcDistanceFactor(const float distanceSquared,
+															const float squaredSofteningFactor) const {
+			return forcelaws::calcSplineSoftenedNewtonianDistanceFactor(distanceSquared, squaredSofteningFactor);
+		}
+
+		/**
+		 * @brief Calculates the factor of the pair term, which depends on the masses (resp. charges) of the two bodies.
+		 * @return the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcStrengthFactor(const float targetMass, const float sourceMass) const {
+			return forcelaws::calcSplineSoftenedNewtonianStrengthFactor(targetMass, sourceMass, gravitationalConstant);
+		}
+
+		/**
+		 * @brief Calculates the factor <code>f</code> of the acceleration <code>f * (p_s - p_t)</code> received by the
+		 * target body.
+		 * @return the product of the distance factor and the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float operator()(const float distanceSquared, const float squaredSofteningFactor,
+													const float targetMass, const float sourceMass) const {
+			return calcDistanceFactor(distanceSquared, squaredSofteningFactor) *
+				   calcStrengthFactor(targetMass, sourceMass);
+		}
+
+		/**
+		 * @brief Calculates the potential energy of a pair of bodies, which is symmetric.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the potential energy of the pair.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcPotentialEnergy(const float distanceSquared, const float squaredSofteningFactor,
+															 const float targetMass, const float sourceMass) const {
+			return forcelaws::calcSplineSoftenedNewtonianPotential(distanceSquared, squaredSofteningFactor, targetMass,
+																	 sourceMass, gravitationalConstant);
+		}
+
+		/**
+		 * @brief Creates the OpenCL source of this force law with its parameters.
+		 * @return the OpenCL source, which defines the macros used by the OpenCL kernels.
+		 */
+		[[nodiscard]] std::string createOpenClSource() const;
+	};
+
+	/**
+	 * @brief The Coulomb force with a selectable softening kernel, by default the Plummer softening. The masses of
+	 * the bodies carry the charges and the result is the force per unit inertial mass.
+	 */
+	struct CoulombForceLaw {
+
+		/**
+		 * The Coulomb constant.
+		 */
+		float coulombConstant = 8.9875517923e+9f;
+
+		/**
+		 * The softening kernel.
+		 */
+		SofteningKernel softeningKernel = SofteningKernel::PLUMMER;
+
+		/**
+		 * @brief Calculates the symmetric distance-dependent factor of the pair term.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the distance factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcDistanceFactor(const float distanceSquared,
+															const float squaredSofteningFactor) const {
+			return forcelaws::calcCoulombDistanceFactor(distanceSquared, squaredSofteningFactor,
+														static_cast<int>(softeningKernel));
+		}
+
+		/**
+		 * @brief Calculates the factor of the pair term, which depends on the masses (resp. charges) of the two bodies.
+		 * @return the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcStrengthFactor(const float targetCharge, const float sourceCharge) const {
+			return forcelaws::calcCoulombStrengthFactor(targetCharge, sourceCharge, coulombConstant);
+		}
+
+		/**
+		 * @brief Calculates the factor <code>f</code> of the acceleration <code>f * (p_s - p_t)</code> received by the
+		 * target body.
+		 * @return the product of the distance factor and the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float operator()(const float distanceSquared, const float squaredSofteningFactor,
+													const float targetCharge, const float sourceCharge) const {
+			return calcDistanceFactor(distanceSquared, squaredSofteningFactor) *
+				   calcStrengthFactor(targetCharge, sourceCharge);
+		}
+
+		/**
+		 * @brief Calculates the potential energy of a pair of bodies, which is symmetric.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the potential energy of the pair.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcPotentialEnergy(const float distanceSquared, const float squaredSofteningFactor,
+															 const float targetMass, const float sourceMass) const {
+			return forcelaws::calcCoulombPotential(distanceSquared, squaredSofteningFactor, targetMass, sourceMass,
+												   coulombConstant, static_cast<int>(softeningKernel));
+		}
+
+		/**
+		 * @brief Creates the OpenCL source of this force law with its parameters.
+		 * @return the OpenCL source, which defines the macros used by the OpenCL kernels.
+		 */
+		[[nodiscard]] std::string createOpenClSource() const;
+	};
+
+	/**
+	 * @brief The Yukawa (screened Coulomb) force. The masses of the bodies carry the charges and the result is the
+	 * force per unit inertial mass.
+	 */
+	struct YukawaForceLaw {
+
+		/**
+		 * The coupling constant.
+		 */
+		float couplingConstant = 1.0f;
+
+		/**
+		 * The screening length <code>lambda</code>.
+		 */
+		float screeningLength = 1.0f;
+
+		/**
+		 * @brief Calculates the symmetric distance-dependent factor of the pair term.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the distance factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcDistanceFactor(const float distanceSquared,
+															const float squaredSofteningFactor) const {
+			return forcelaws::calcYukawaDistanceFactor(distanceSquared, squaredSofteningFactor,
+													   1.0f / screeningLength);
+		}
+
+		/**
+		 * @brief Calculates the factor of the pair term, which depends on the masses (resp. charges) of the two bodies.
+		 * @return the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcStrengthFactor(const float targetCharge, const float sourceCharge) const {
+			return forcelaws::calcYukawaStrengthFactor(targetCharge, sourceCharge, couplingConstant);
+		}
+
+		/**
+		 * @brief Calculates the factor <code>f</code> of the acceleration <code>f * (p_s - p_t)</code> received by the
+		 * target body.
+		 * @return the product of the distance factor and the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float operator()(const float distanceSquared, const float squaredSofteningFactor,
+													const float targetCharge, const float sourceCharge) const {
+			return calcDistanceFactor(distanceSquared, squaredSofteningFactor) *
+				   calcStrengthFactor(targetCharge, sourceCharge);
+		}
+
+		/**
+		 * @brief Calculates the potential energy of a pair of bodies, which is symmetric.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the potential energy of the pair.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcPotentialEnergy(const float distanceSquared, const float squaredSofteningFactor,
+															 const float targetMass, const float sourceMass) const {
+			return forcelaws::calcYukawaPotential(distanceSquared, squaredSofteningFactor, targetMass, sourceMass,
+												  1.0f / screeningLength, couplingConstant);
+		}
+
+		/**
+		 * @brief Creates the OpenCL source of this force law with its parameters.
+		 * @return the OpenCL source, which defines the macros used by the OpenCL kernels.
+		 */
+		[[nodiscard]] std::string createOpenClSource() const;
+	};
+
+	/**
+	 * @brief The Lennard-Jones force.
+	 */
+	struct LennardJonesForceLaw {
+
+		/**
+		 * The depth of the potential well <code>epsilon</code>.
+		 */
+		float wellDepth = 1.0f;
+
+		/**
+		 * The distance <code>sigma</code> at which the potential is zero.
+		 */
+		float zeroCrossingDistance = 1.0f;
+
+		/**
+		 * @brief Calculates the symmetric distance-dependent factor of the pair term.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the distance factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcDistanceFactor(const float distanceSquared,
+															const float squaredSofteningFactor) const {
+			return forcelaws::calcLennardJonesDistanceFactor(distanceSquared, squaredSofteningFactor, wellDepth,
+															 zeroCrossingDistance * zeroCrossingDistance);
+		}
+
+		/**
+		 * @brief Calculates the factor of the pair term, which depends on the masses (resp. charges) of the two bodies.
+		 * @return the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcStrengthFactor(const float targetMass, const float sourceMass) const {
+			return forcelaws::calcLennardJonesStrengthFactor(targetMass, sourceMass);
+		}
+
+		/**
+		 * @brief Calculates the factor <code>f</code> of the acceleration <code>f * (p_s - p_t)</code> received by the
+		 * target body.
+		 * @return the product of the distance factor and the strength factor.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float operator()(const float distanceSquared, const float squaredSofteningFactor,
+													const float targetMass, const float sourceMass) const {
+			return calcDistanceFactor(distanceSquared, squaredSofteningFactor) *
+				   calcStrengthFactor(targetMass, sourceMass);
+		}
+
+		/**
+		 * @brief Calculates the potential energy of a pair of bodies, which is symmetric.
+		 * @param distanceSquared the squared distance between the two bodies.
+		 * @param squaredSofteningFactor the squared softening factor.
+		 * @return the potential energy of the pair.
+		 */
+		PHYSICS_FORCE_LAW_FUNCTION float calcPotentialEnergy(const float distanceSquared, const float squaredSofteningFactor,
+															 const float /*targetMass*/, const float /*sourceMass*/) const {
+			return forcelaws::calcLennardJonesPotential(distanceSquared, squaredSofteningFactor, wellDepth,
+													   zeroCrossingDistance * zeroCrossingDistance);
+		}
+
+		/**
+		 * @brief Creates the OpenCL source of this force law with its parameters.
+		 * @return the OpenCL source, which defines the macros used by the OpenCL kernels.
+		 */
+		[[nodiscard]] std::string createOpenClSource() const;
+	};
+}
+
+/**
+ * Instantiates the passed class template for each force law, e.g. in the translation unit of a backend.
+ */
+#define PHYSICS_INSTANTIATE_FOR_ALL_FORCE_LAWS(CLASS_TEMPLATE) \
+	template class CLASS_TEMPLATE<physics::NewtonianForceLaw>; \
+	template class CLASS_TEMPLATE<physics::SplineSoftenedNewtonianForceLaw>; \
+	template class CLASS_TEMPLATE<physics::CoulombForceLaw>; \
+	template class CLASS_TEMPLATE<physics::YukawaForceLaw>; \
+	template class CLASS_TEMPLATE<physics::LennardJonesForceLaw>;
+
+#endif //PHYSICS_ENGINE_FORCE_LAWS_H
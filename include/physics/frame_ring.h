@@ -0,0 +1,224 @@
+#ifndef PHYSICS_ENGINE_FRAME_RING_H
+#define PHYSICS_ENGINE_FRAME_RING_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "bodies.h"
+#include "bodies_snapshot.h"
+#include "body_reordering.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A lock-free ring of immutable frames, which one producer (the system of bodies) publishes and any number
+	 * of consumers (e.g. a renderer, an exporter, a recorder) read concurrently.
+	 * @details Each slot of the ring holds a snapshot of the bodies and counts its readers. A consumer acquires the
+	 * latest frame by incrementing the counter of its slot and validating its sequence number, and releases it by
+	 * decrementing the counter, so neither side ever waits for the other. The producer writes a new frame into a slot,
+	 * which is neither the latest one nor acquired by a consumer, and skips the frame if there is no such slot. A slow
+	 * consumer therefore misses frames instead of stalling the producer, which it detects by gaps in the sequence
+	 * numbers. The storage of the slots is reused, so publishing allocates no memory unless the number of bodies
+	 * grows.
+	 */
+	class FrameRing {
+
+		private:
+			/**
+			 * The sequence number of a slot, which is being written or was never written.
+			 */
+			static constexpr uint64_t INVALID_SEQUENCE_NUMBER = 0;
+
+			/**
+			 * The index of the latest slot before the first frame is published.
+			 */
+			static constexpr size_t NO_SLOT = SIZE_MAX;
+
+			/**
+			 * @brief A slot of the ring. The counters are aligned to cache lines, so the consumers of different slots
+			 * do not share them.
+			 */
+			struct alignas(64) Slot {
+
+				/**
+				 * The number of consumers, which hold or try to acquire the frame of this slot.
+				 */
+				std::atomic<size_t> numReaders{0};
+
+				/**
+				 * The sequence number of the frame of this slot, <code>INVALID_SEQUENCE_NUMBER</code> while it is
+				 * written.
+				 */
+				std::atomic<uint64_t> sequenceNumber{INVALID_SEQUENCE_NUMBER};
+
+				/**
+				 * The frame, which is immutable as long as a consumer holds it.
+				 */
+				BodiesSnapshot snapshot;
+			};
+
+			/**
+			 * The number of slots.
+			 */
+			size_t capacity_;
+
+			/**
+			 * The slots.
+			 */
+			std::unique_ptr<Slot[]> slots_;
+
+			/**
+			 * The index of the slot of the latest frame, <code>NO_SLOT</code> before the first frame is published.
+			 */
+			std::atomic<size_t> latestSlotIndex_;
+
+			/**
+			 * The index of the slot, which was written last by the producer, where the search of a free slot starts.
+			 */
+			size_t lastWrittenSlotIndex_;
+
+			/**
+			 * The number of frames offered by the producer, i.e. the sequence number of the last one.
+			 */
+			uint64_t numOfferedFrames_;
+
+			/**
+			 * The number of frames, which were skipped since all slots were held by consumers.
+			 */
+			std::atomic<size_t> numDroppedFrames_;
+
+		public:
+			/**
+			 * @brief A frame acquired from the ring, which is released by the destructor. A frame must not outlive
+			 * its ring.
+			 */
+			class Frame {
+
+				private:
+					/**
+					 * The slot of the frame, <code>nullptr</code> if the frame is empty.
+					 */
+					Slot *pSlot_;
+
+					/**
+					 * The sequence number of the frame.
+					 */
+					uint64_t sequenceNumber_;
+
+					/**
+					 * @brief The parameterized constructor. Creates a frame of an acquired slot.
+					 * @param pSlot the acquired slot.
+					 * @param sequenceNumber the sequence number of the frame of the slot.
+					 */
+					Frame(Slot *pSlot, uint64_t sequenceNumber) noexcept;
+
+					friend class FrameRing;
+
+				public:
+					/**
+					 * @brief The default constructor. Creates an empty frame.
+					 */
+					Frame() noexcept;
+
+					/**
+					 * @brief The deleted copy constructor, since a frame releases its slot exactly once.
+					 */
+					Frame(const Frame &) = delete;
+
+					/**
+					 * @brief The deleted copy assignment, since a frame releases its slot exactly once.
+					 */
+					Frame &operator=(const Frame &) = delete;
+
+					/**
+					 * @brief The move constructor. The moved-from frame is empty.
+					 */
+					Frame(Frame &&other) noexcept;
+
+					/**
+					 * @brief The move assignment, which releases the frame held before. The moved-from frame is empty.
+					 */
+					Frame &operator=(Frame &&other) noexcept;
+
+					/**
+					 * @brief The destructor, which releases the slot.
+					 */
+					~Frame();
+
+					/**
+					 * @brief Returns whether this frame holds a snapshot.
+					 * @return <code>true</code> if this frame is not empty.
+					 */
+					[[nodiscard]] inline bool isValid() const {
+						return nullptr != pSlot_;
+					}
+
+					/**
+					 * @brief Returns the sequence number of this frame, which counts the frames offered by the
+					 * producer from 1.
+					 * @return the sequence number, 0 if this frame is empty.
+					 */
+					[[nodiscard]] inline uint64_t getSequenceNumber() const {
+						return sequenceNumber_;
+					}
+
+					/**
+					 * @brief Returns the snapshot of this frame, which must not be empty.
+					 * @return the snapshot of the bodies.
+					 */
+					[[nodiscard]] inline const BodiesSnapshot &getSnapshot() const {
+						return pSlot_->snapshot;
+					}
+			};
+
+			/**
+			 * @brief The parameterized constructor. Creates a new ring by the parameters.
+			 * @param capacity the number of slots, i.e. at least the number of frames held by the consumers at the
+			 * 					same time plus 2, so no frame is skipped.
+			 * @throws std::invalid_argument if the capacity is less than 2.
+			 */
+			explicit FrameRing(size_t capacity);
+
+			/**
+			 * @brief Publishes a frame of the passed bodies, which is only called by the producer.
+			 * @details The bodies are copied into a free slot, which becomes the latest frame. If all slots except
+			 * the latest one are held by consumers, the frame is skipped, but its sequence number is consumed.
+			 * @param bodies the bodies to be copied.
+			 * @param numBodies the number of bodies.
+			 * @param bodyReordering the reordering of the bodies, which provides their original IDs.
+			 * @return <code>true</code> if the frame was published, <code>false</code> if it was skipped.
+			 */
+			bool publish(const Bodies<float, float, float> &bodies, size_t numBodies,
+						 const BodyReordering &bodyReordering);
+
+			/**
+			 * @brief Acquires the latest frame, which may be called by any number of consumers concurrently.
+			 * @return the latest frame, which is empty if no frame was published yet.
+			 */
+			[[nodiscard]] Frame acquireLatest();
+
+			/**
+			 * @brief Returns the number of slots.
+			 * @return the capacity.
+			 */
+			[[nodiscard]] inline size_t getCapacity() const {
+				return capacity_;
+			}
+
+			/**
+			 * @brief Returns the number of frames, which were skipped since all slots were held by consumers.
+			 * @return the number of dropped frames.
+			 */
+			[[nodiscard]] inline size_t getNumDroppedFrames() const {
+				return numDroppedFrames_.load(std::memory_order_relaxed);
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_FRAME_RING_H
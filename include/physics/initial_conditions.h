@@ -0,0 +1,138 @@
+#ifndef PHYSICS_ENGINE_INITIAL_CONDITIONS_H
+#define PHYSICS_ENGINE_INITIAL_CONDITIONS_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <cstdint>
+
+#include "astronomical_algorithms.h"
+#include "bodies.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief Contains the constants to specify the initial conditions generated by <code>generateScenario</code>.
+	 */
+	enum class Scenario {
+
+		/**
+		 * The constant to specify bodies at rest, which are uniformly distributed in the square
+		 * <code>[-scaleRadius, scaleRadius)^2</code> of the plane <code>z = 0</code>.
+		 */
+		UNIFORM_SQUARE,
+
+		/**
+		 * The constant to specify a <strong>cold collapse</strong>, i.e. bodies at rest, which are uniformly
+		 * distributed in a sphere of the radius <code>scaleRadius</code>.
+		 */
+		COLD_COLLAPSE,
+
+		/**
+		 * The constant to specify a <strong>Plummer sphere</strong> of the scale radius <code>scaleRadius</code> in
+		 * equilibrium, whose velocities are sampled from its isotropic distribution function (Aarseth, Hénon &amp;
+		 * Wielen 1974).
+		 */
+		PLUMMER_SPHERE,
+
+		/**
+		 * The constant to specify a <strong>Hernquist sphere</strong> of the scale radius <code>scaleRadius</code>,
+		 * which resembles the cusp of a galaxy or a dark matter halo. The velocities are Maxwellian with the isotropic
+		 * dispersion of the Jeans equation (Hernquist 1990, 1993) and less than the escape velocity.
+		 */
+		HERNQUIST_SPHERE,
+
+		/**
+		 * The constant to specify a <strong>King sphere</strong> of the core radius <code>scaleRadius</code> and the
+		 * central potential <code>kingCentralPotential</code> in equilibrium, which resembles a globular cluster with
+		 * a tidal radius. The velocities are sampled from the lowered Maxwellian distribution function (King 1966).
+		 */
+		KING_SPHERE,
+
+		/**
+		 * The constant to specify a thin <strong>exponential disk</strong> of the scale length
+		 * <code>scaleRadius</code> on circular orbits, optionally around a central body. The circular velocities are
+		 * approximated by the enclosed mass of a spherical distribution.
+		 */
+		EXPONENTIAL_DISK,
+
+		/**
+		 * The constant to specify <strong>hierarchical clusters</strong>, i.e. <code>numClusters</code> small Plummer
+		 * spheres, whose centers and bulk velocities are drawn from a Plummer sphere of the scale radius
+		 * <code>scaleRadius</code>.
+		 */
+		HIERARCHICAL_CLUSTERS
+	};
+
+	/**
+	 * @brief The parameters of the generated initial conditions. Parameters which do not apply to a scenario are
+	 * ignored.
+	 */
+	struct ScenarioParameters {
+
+		/**
+		 * The seed of the random numbers. The same seed generates the same bodies independently of the number of
+		 * threads.
+		 */
+		uint64_t seed = 0;
+
+		/**
+		 * The total mass of the bodies, which is divided equally between them, except the central body of a disk.
+		 */
+		float totalMass = 1.0f;
+
+		/**
+		 * The scale radius (resp. length) of the scenario, see the constants of <code>Scenario</code>.
+		 */
+		float scaleRadius = 1.0f;
+
+		/**
+		 * The gravitational constant of the force law, which determines the velocities in equilibrium.
+		 */
+		float gravitationalConstant = static_cast<float>(GRAVITATIONAL_CONSTANT);
+
+		/**
+		 * The dimensionless central potential <code>W0</code> of a King sphere, i.e. its concentration, in
+		 * <code>(0, 16]</code>.
+		 */
+		float kingCentralPotential = 6.0f;
+
+		/**
+		 * The mass of the central body of a disk, which is the first body, 0 for a disk without central body.
+		 */
+		float centralMass = 0.0f;
+
+		/**
+		 * The scale height of a disk relative to its scale length.
+		 */
+		float diskScaleHeightRatio = 0.1f;
+
+		/**
+		 * The number of clusters of hierarchical clusters.
+		 */
+		size_t numClusters = 16;
+
+		/**
+		 * The scale radius of a single cluster of hierarchical clusters relative to <code>scaleRadius</code>.
+		 */
+		float clusterScaleRadiusRatio = 0.05f;
+	};
+
+	/**
+	 * @brief Generates the initial conditions of the specified scenario by a parallel loop.
+	 * @details Each body draws its random numbers from its own stream, which is derived from the seed and the index
+	 * of the body, so the bodies do not depend on the number of threads or their schedule. The bodies are moved into
+	 * their center-of-mass frame, except the uniform square.
+	 * @param scenario the specification of the scenario.
+	 * @param[out] bodies the bodies to be set.
+	 * @param numBodies the number of bodies.
+	 * @param parameters the parameters of the scenario.
+	 * @throws std::invalid_argument if a parameter of the scenario is out of its range.
+	 */
+	void generateScenario(Scenario scenario, const Bodies<float, float, float> &bodies, size_t numBodies,
+						  const ScenarioParameters &parameters = ScenarioParameters());
+}
+
+#endif //PHYSICS_ENGINE_INITIAL_CONDITIONS_H
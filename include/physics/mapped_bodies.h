@@ -0,0 +1,115 @@
+#ifndef PHYSICS_ENGINE_MAPPED_BODIES_H
+#define PHYSICS_ENGINE_MAPPED_BODIES_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <string>
+
+#include "bodies.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief Bodies and their accelerations stored in a memory-mapped file, for body counts exceeding the RAM.
+	 * @details The file contains the masses, positions, velocities and accelerations of the bodies one after another,
+	 * each array aligned to a page. The pages are loaded on demand and written back by the operating system, so
+	 * only the recently touched pages occupy the RAM. An out-of-core acceleration calculation streams the bodies tile
+	 * by tile, which keeps these pages few. An existing file of the same number of bodies is reused, so the bodies
+	 * persist between runs. Memory-mapped bodies are only supported on POSIX systems.
+	 */
+	class MappedBodies {
+
+		private:
+			/**
+			 * The mapping of the file, <code>nullptr</code> if there are no bodies.
+			 */
+			void *pMapping_;
+
+			/**
+			 * The size of the mapping in bytes.
+			 */
+			size_t mappingSize_;
+
+			/**
+			 * The number of bodies.
+			 */
+			size_t numBodies_;
+
+			/**
+			 * The byte offset of each array within the mapping, in the order masses, positions, velocities,
+			 * accelerations.
+			 */
+			size_t offsets_[4];
+
+			/**
+			 * @brief Unmaps the file.
+			 */
+			void unmap();
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Maps the passed file, which is created or resized if its size does
+			 * not fit the number of bodies.
+			 * @param filePath the path of the file.
+			 * @param numBodies the number of bodies.
+			 * @throws std::runtime_error if the file cannot be mapped, or memory mapping is not supported.
+			 */
+			MappedBodies(const std::string &filePath, size_t numBodies);
+
+			/**
+			 * @brief The deleted copy constructor, since the mapping is owned exclusively.
+			 */
+			MappedBodies(const MappedBodies &) = delete;
+
+			/**
+			 * @brief The deleted copy assignment, since the mapping is owned exclusively.
+			 */
+			MappedBodies &operator=(const MappedBodies &) = delete;
+
+			/**
+			 * @brief The move constructor. The moved-from instance has no bodies.
+			 */
+			MappedBodies(MappedBodies &&other) noexcept;
+
+			/**
+			 * @brief The move assignment. The moved-from instance has no bodies.
+			 */
+			MappedBodies &operator=(MappedBodies &&other) noexcept;
+
+			/**
+			 * @brief The destructor, which unmaps the file. The operating system writes back the modified pages.
+			 */
+			~MappedBodies();
+
+			/**
+			 * @brief Returns the bodies, which point into the mapping.
+			 * @return the bodies.
+			 */
+			[[nodiscard]] Bodies<float, float, float> getBodies() const;
+
+			/**
+			 * @brief Returns the accelerations of the bodies, which point into the mapping.
+			 * @return the accelerations, <code>numBodies * vector dimension</code> elements.
+			 */
+			[[nodiscard]] float *getAccelerations() const;
+
+			/**
+			 * @brief Returns the number of bodies.
+			 * @return the number of bodies.
+			 */
+			[[nodiscard]] inline size_t getNumBodies() const {
+				return numBodies_;
+			}
+
+			/**
+			 * @brief Writes the modified pages back to the file and waits for the completion.
+			 * @throws std::runtime_error if the pages cannot be written.
+			 */
+			void flush() const;
+	};
+}
+
+#endif //PHYSICS_ENGINE_MAPPED_BODIES_H
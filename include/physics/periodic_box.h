@@ -0,0 +1,49 @@
+#ifndef PHYSICS_ENGINE_PERIODIC_BOX_H
+#define PHYSICS_ENGINE_PERIODIC_BOX_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cmath>
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A cubic box with periodic boundaries, whose minimum corner is the origin.
+	 * @details A body which leaves the box through a face enters it again through the opposite face, so each body
+	 * stands for an infinite lattice of images. The integrators wrap the positions into the box, the acceleration
+	 * calculations pair a body only with the nearest image of another body (minimum image convention) and add the
+	 * remaining images, e.g. by Ewald summation.
+	 */
+	struct PeriodicBox {
+
+		/**
+		 * The edge length of the box.
+		 */
+		float edgeLength = 1.0f;
+
+		/**
+		 * @brief Wraps the passed coordinate into the box.
+		 * @param coordinate the coordinate of a position.
+		 * @return the coordinate of the image inside the box, in <code>[0, edgeLength)</code>.
+		 */
+		[[nodiscard]] inline float wrapCoordinate(const float coordinate) const {
+			const float wrappedCoordinate = coordinate - (edgeLength * std::floor(coordinate / edgeLength));
+			// the rounding of tiny negative coordinates may end up exactly at the upper face
+			return (wrappedCoordinate < edgeLength) ? wrappedCoordinate : 0.0f;
+		}
+
+		/**
+		 * @brief Applies the minimum image convention to the passed coordinate of a distance vector.
+		 * @param distance the coordinate of the distance vector between two bodies.
+		 * @return the coordinate of the distance vector to the nearest image, in
+		 * <code>[-edgeLength / 2, edgeLength / 2]</code>.
+		 */
+		[[nodiscard]] inline float applyMinimumImage(const float distance) const {
+			return distance - (edgeLength * std::nearbyint(distance / edgeLength));
+		}
+	};
+}
+
+#endif //PHYSICS_ENGINE_PERIODIC_BOX_H
@@ -5,6 +5,7 @@
 #include <cstddef>
 
 #include "bodies.h"
+#include "diagnostics.h"
 
 /**
  * @brief Namespace for physics-related functions and classes.
@@ -36,6 +37,29 @@ namespace physics {
 					const float *accelerations,
 					float timeStep
 			) = 0;
+
+			/**
+			 * @brief Updates the positions and velocities of the given bodies and calculates the kinetic energy and
+			 * the momenta of the bodies <strong>before</strong> the update, i.e. at the same time as the accelerations.
+			 * @details The default implementation calculates the diagnostics in a separate pass; implementations
+			 * should fuse the reduction into their update loop.
+			 * @param bodies the bodies whose positions and velocities are to be updated.
+			 * @param numBodies the number of bodies.
+			 * @param accelerations the current accelerations of the bodies. The number of elements in
+			 * 						<code>accelerations</code> parameter must be <code>numBodies * vector dimension</code>.
+			 * @param timeStep the time step.
+			 * @param[out] diagnostics the diagnostics, whose kinetic energy and momenta are to be set.
+			 */
+			virtual void updatePositionAndVelocityWithDiagnostics(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *accelerations,
+					float timeStep,
+					Diagnostics &diagnostics
+			) {
+				calcMotionDiagnostics(bodies, numBodies, diagnostics);
+				updatePositionAndVelocity(bodies, numBodies, accelerations, timeStep);
+			}
 	};
 }
 
@@ -0,0 +1,68 @@
+#ifndef PHYSICS_ENGINE_UPDATE_CONTEXT_H
+#define PHYSICS_ENGINE_UPDATE_CONTEXT_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <vector>
+
+#include "arena.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief The resources of one update of a system of bodies, which are passed to the calculations.
+	 * @details The context provides one scratch arena per thread. The arenas are reset at the beginning of each update,
+	 * so a calculation must not keep pointers into them beyond its call.
+	 */
+	class UpdateContext {
+
+		private:
+			/**
+			 * The scratch arena of each thread.
+			 */
+			std::vector<Arena> arenas_;
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Creates a new context by the parameters.
+			 * @param numThreads the number of threads, which should be at least the maximum number of OpenMP threads.
+			 * @param capacityPerThread the initial capacity of each scratch arena in bytes.
+			 * @param useHugePages <code>true</code> if large scratch arenas should be backed by huge pages.
+			 */
+			explicit UpdateContext(size_t numThreads, size_t capacityPerThread = 0, bool useHugePages = false);
+
+			/**
+			 * @brief Returns the number of threads, i.e. of scratch arenas.
+			 * @return the number of threads.
+			 */
+			[[nodiscard]] inline size_t getNumThreads() const {
+				return arenas_.size();
+			}
+
+			/**
+			 * @brief Returns the scratch arena of the passed thread.
+			 * @param threadIndex the index of the thread, e.g. <code>omp_get_thread_num()</code>, which must be less
+			 * than the number of threads.
+			 * @return the scratch arena of the passed thread.
+			 */
+			[[nodiscard]] inline Arena &getArena(const size_t threadIndex) {
+				return arenas_[threadIndex];
+			}
+
+			/**
+			 * @brief Releases the allocations of all scratch arenas.
+			 */
+			void reset();
+
+			/**
+			 * @brief Returns the sum of the peak usages of all scratch arenas.
+			 * @return the peak usage of the scratch memory in bytes.
+			 */
+			[[nodiscard]] size_t getPeakUsage() const;
+	};
+}
+
+#endif //PHYSICS_ENGINE_UPDATE_CONTEXT_H
@@ -0,0 +1,612 @@
+// Python.h must be included first, since it may change the configuration of the standard library headers.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/bodies_system.h"
+#include "openmp_euler_position_velocity_calculation.h"
+
+/*
+ * The Python module physics_engine, which is written against the CPython API only, so it needs no further
+ * dependencies. The bodies are allocated by the module and their arrays are exposed by the buffer protocol, so
+ * numpy.asarray(bodies.positions) is a writable (n, 3) float32 view without a copy. The calculations release the GIL,
+ * so other Python threads keep running during an update.
+ */
+
+using namespace physics;
+
+namespace {
+
+	/**
+	 * @brief A view of a float array owned by another Python object, which implements the buffer protocol.
+	 */
+	struct FloatArrayObject {
+		PyObject_HEAD
+
+		/**
+		 * The owner of the array, which is kept alive by this view.
+		 */
+		PyObject *pOwner;
+
+		/**
+		 * The elements of the array.
+		 */
+		float *pData;
+
+		/**
+		 * The number of dimensions, 1 or 2.
+		 */
+		int numDimensions;
+
+		/**
+		 * The extents of the dimensions.
+		 */
+		Py_ssize_t shape[2];
+
+		/**
+		 * The strides of the dimensions in bytes.
+		 */
+		Py_ssize_t strides[2];
+	};
+
+	/**
+	 * @brief The Python object of bodies, whose arrays are owned by the module.
+	 */
+	struct BodiesObject {
+		PyObject_HEAD
+
+		/**
+		 * The number of bodies.
+		 */
+		size_t numBodies;
+
+		/**
+		 * The masses, <code>numBodies</code> elements.
+		 */
+		float *pMasses;
+
+		/**
+		 * The positions, <code>numBodies * 3</code> elements.
+		 */
+		float *pPositions;
+
+		/**
+		 * The velocities, <code>numBodies * 3</code> elements.
+		 */
+		float *pVelocities;
+	};
+
+	/**
+	 * @brief The Python object of an acceleration calculation.
+	 */
+	struct AccelerationCalculationObject {
+		PyObject_HEAD
+
+		/**
+		 * The owned acceleration calculation.
+		 */
+		IAccelerationCalculation *pAccelerationCalculation;
+	};
+
+	/**
+	 * @brief The Python object of a system of bodies.
+	 */
+	struct BodiesSystemObject {
+		PyObject_HEAD
+
+		/**
+		 * The owned system of bodies.
+		 */
+		BodiesSystem *pBodiesSystem;
+
+		/**
+		 * The bodies of the system, which are kept alive by the system.
+		 */
+		PyObject *pBodies;
+
+		/**
+		 * Whether an update runs without the GIL, so a concurrent call from another Python thread is rejected.
+		 */
+		bool isUpdating;
+	};
+
+	/**
+	 * The types of the module, which are created by the initialization of the module.
+	 */
+	PyTypeObject *pFloatArrayType = nullptr;
+	PyTypeObject *pBodiesType = nullptr;
+
+	/**
+	 * @brief Raises the Python exception of the passed C++ exception.
+	 * @param pException the C++ exception.
+	 * @return <code>nullptr</code>, to be returned by the calling function.
+	 */
+	PyObject *raisePythonException(const std::exception_ptr &pException) {
+		try {
+			std::rethrow_exception(pException);
+		} catch (const std::invalid_argument &exception) {
+			PyErr_SetString(PyExc_ValueError, exception.what());
+		} catch (const std::bad_alloc &) {
+			PyErr_NoMemory();
+		} catch (const std::exception &exception) {
+			PyErr_SetString(PyExc_RuntimeError, exception.what());
+		} catch (...) {
+			PyErr_SetString(PyExc_RuntimeError, "Unknown C++ exception.");
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Converts the passed Python integer into an implementation of the acceleration calculation.
+	 * @param implementationValue the value of the constant, e.g. <code>physics_engine.OPEN_MP</code>.
+	 * @param[out] implementation the implementation.
+	 * @return <code>false</code> with a Python exception if the value is no implementation.
+	 */
+	bool toImplementation(const int implementationValue, AccelerationCalculationImplementation &implementation) {
+		if ((implementationValue < static_cast<int>(AccelerationCalculationImplementation::SEQUENTIAL)) ||
+			(static_cast<int>(AccelerationCalculationImplementation::EWALD) < implementationValue)) {
+			PyErr_SetString(PyExc_ValueError, "Unknown implementation of the acceleration calculation.");
+			return false;
+		}
+		implementation = static_cast<AccelerationCalculationImplementation>(implementationValue);
+		return true;
+	}
+
+	/**
+	 * @brief Creates a view of a float array owned by the passed object.
+	 * @param pOwner the owner of the array.
+	 * @param pData the elements of the array.
+	 * @param numRows the number of rows.
+	 * @param numColumns the number of columns, 0 for a one-dimensional array.
+	 * @return the new view, <code>nullptr</code> with a Python exception if it cannot be created.
+	 */
+	PyObject *createFloatArray(PyObject *const pOwner, float *const pData, const size_t numRows,
+							   const size_t numColumns) {
+		auto *const pFloatArray = PyObject_New(FloatArrayObject, pFloatArrayType);
+		if (nullptr == pFloatArray) {
+			return nullptr;
+		}
+		Py_INCREF(pOwner);
+		pFloatArray->pOwner = pOwner;
+		pFloatArray->pData = pData;
+		pFloatArray->numDimensions = (0 == numColumns) ? 1 : 2;
+		pFloatArray->shape[0] = static_cast<Py_ssize_t>(numRows);
+		pFloatArray->shape[1] = static_cast<Py_ssize_t>(numColumns);
+		pFloatArray->strides[0] = static_cast<Py_ssize_t>(sizeof(float) * ((0 == numColumns) ? 1 : numColumns));
+		pFloatArray->strides[1] = static_cast<Py_ssize_t>(sizeof(float));
+		return reinterpret_cast<PyObject *>(pFloatArray);
+	}
+
+	void deallocFloatArray(PyObject *const pSelf) {
+		auto *const pFloatArray = reinterpret_cast<FloatArrayObject *>(pSelf);
+		PyTypeObject *const pType = Py_TYPE(pSelf);
+		Py_XDECREF(pFloatArray->pOwner);
+		PyObject_Free(pSelf);
+		// instances of heap types hold a reference to their type
+		Py_DECREF(pType);
+	}
+
+	int getFloatArrayBuffer(PyObject *const pSelf, Py_buffer *const pView, const int flags) {
+		auto *const pFloatArray = reinterpret_cast<FloatArrayObject *>(pSelf);
+		Py_ssize_t numElements = pFloatArray->shape[0];
+		if (2 == pFloatArray->numDimensions) {
+			numElements *= pFloatArray->shape[1];
+		}
+		Py_INCREF(pSelf);
+		pView->obj = pSelf;
+		pView->buf = pFloatArray->pData;
+		pView->len = numElements * static_cast<Py_ssize_t>(sizeof(float));
+		pView->itemsize = sizeof(float);
+		pView->readonly = 0;
+		pView->format = (0 != (flags & PyBUF_FORMAT)) ? const_cast<char *>("f") : nullptr;
+		// the arrays are C-contiguous, so a consumer which asks for no shape gets a flat array of bytes
+		pView->ndim = (0 != (flags & PyBUF_ND)) ? pFloatArray->numDimensions : 1;
+		pView->shape = (0 != (flags & PyBUF_ND)) ? pFloatArray->shape : nullptr;
+		pView->strides = (PyBUF_STRIDES == (flags & PyBUF_STRIDES)) ? pFloatArray->strides : nullptr;
+		pView->suboffsets = nullptr;
+		pView->internal = nullptr;
+		return 0;
+	}
+
+	PyType_Slot floatArraySlots[] = {
+			{Py_tp_doc, const_cast<char *>("A writable float32 view of an array of the bodies, see numpy.asarray.")},
+			{Py_tp_dealloc, reinterpret_cast<void *>(&deallocFloatArray)},
+			{Py_bf_getbuffer, reinterpret_cast<void *>(&getFloatArrayBuffer)},
+			{0, nullptr}
+	};
+
+	PyType_Spec floatArraySpec = {
+			"physics_engine.FloatArray", sizeof(FloatArrayObject), 0, Py_TPFLAGS_DEFAULT, floatArraySlots
+	};
+
+	int initBodies(PyObject *const pSelf, PyObject *const pArguments, PyObject *const pKeywords) {
+		auto *const pBodies = reinterpret_cast<BodiesObject *>(pSelf);
+		static const char *keywords[] = {"num_bodies", nullptr};
+		Py_ssize_t numBodies = 0;
+		if (!PyArg_ParseTupleAndKeywords(pArguments, pKeywords, "n", const_cast<char **>(keywords), &numBodies)) {
+			return -1;
+		}
+		if (numBodies < 0) {
+			PyErr_SetString(PyExc_ValueError, "The number of bodies must not be negative.");
+			return -1;
+		}
+		if (nullptr != pBodies->pMasses) {
+			PyErr_SetString(PyExc_RuntimeError, "The bodies are already initialized.");
+			return -1;
+		}
+		const auto numElements = static_cast<size_t>(numBodies);
+		// zero-initialized, so bodies which are not set by the caller are at rest in the origin
+		pBodies->pMasses = new(std::nothrow) float[numElements]();
+		pBodies->pPositions = new(std::nothrow) float[numElements * 3]();
+		pBodies->pVelocities = new(std::nothrow) float[numElements * 3]();
+		pBodies->numBodies = numElements;
+		if ((nullptr == pBodies->pMasses) || (nullptr == pBodies->pPositions) || (nullptr == pBodies->pVelocities)) {
+			PyErr_NoMemory();
+			return -1;
+		}
+		return 0;
+	}
+
+	void deallocBodies(PyObject *const pSelf) {
+		auto *const pBodies = reinterpret_cast<BodiesObject *>(pSelf);
+		PyTypeObject *const pType = Py_TYPE(pSelf);
+		delete[] pBodies->pMasses;
+		delete[] pBodies->pPositions;
+		delete[] pBodies->pVelocities;
+		pType->tp_free(pSelf);
+		Py_DECREF(pType);
+	}
+
+	PyObject *getMasses(PyObject *const pSelf, void *) {
+		auto *const pBodies = reinterpret_cast<BodiesObject *>(pSelf);
+		return createFloatArray(pSelf, pBodies->pMasses, pBodies->numBodies, 0);
+	}
+
+	PyObject *getPositions(PyObject *const pSelf, void *) {
+		auto *const pBodies = reinterpret_cast<BodiesObject *>(pSelf);
+		return createFloatArray(pSelf, pBodies->pPositions, pBodies->numBodies, 3);
+	}
+
+	PyObject *getVelocities(PyObject *const pSelf, void *) {
+		auto *const pBodies = reinterpret_cast<BodiesObject *>(pSelf);
+		return createFloatArray(pSelf, pBodies->pVelocities, pBodies->numBodies, 3);
+	}
+
+	PyObject *getNumBodiesOfBodies(PyObject *const pSelf, void *) {
+		return PyLong_FromSize_t(reinterpret_cast<BodiesObject *>(pSelf)->numBodies);
+	}
+
+	PyGetSetDef bodiesGetSets[] = {
+			{"masses", &getMasses, nullptr, "The masses as a float32 buffer of shape (n,).", nullptr},
+			{"positions", &getPositions, nullptr, "The positions as a float32 buffer of shape (n, 3).", nullptr},
+			{"velocities", &getVelocities, nullptr, "The velocities as a float32 buffer of shape (n, 3).", nullptr},
+			{"num_bodies", &getNumBodiesOfBodies, nullptr, "The number of bodies.", nullptr},
+			{nullptr, nullptr, nullptr, nullptr, nullptr}
+	};
+
+	PyType_Slot bodiesSlots[] = {
+			{Py_tp_doc, const_cast<char *>("Bodies(num_bodies)\n\nThe masses, positions and velocities of bodies, "
+										   "which are exposed without a copy by the buffer protocol.")},
+			{Py_tp_new, reinterpret_cast<void *>(&PyType_GenericNew)},
+			{Py_tp_init, reinterpret_cast<void *>(&initBodies)},
+			{Py_tp_dealloc, reinterpret_cast<void *>(&deallocBodies)},
+			{Py_tp_getset, bodiesGetSets},
+			{0, nullptr}
+	};
+
+	PyType_Spec bodiesSpec = {
+			"physics_engine.Bodies", sizeof(BodiesObject), 0, Py_TPFLAGS_DEFAULT, bodiesSlots
+	};
+
+	/**
+	 * @brief Returns the bodies of the passed Python object.
+	 * @param pObject the Python object, which must be an instance of <code>physics_engine.Bodies</code>.
+	 * @return the bodies, <code>nullptr</code> with a Python exception if the object are no bodies.
+	 */
+	BodiesObject *toBodies(PyObject *const pObject) {
+		if (!PyObject_TypeCheck(pObject, pBodiesType)) {
+			PyErr_SetString(PyExc_TypeError, "Expected an instance of physics_engine.Bodies.");
+			return nullptr;
+		}
+		return reinterpret_cast<BodiesObject *>(pObject);
+	}
+
+	int initAccelerationCalculation(PyObject *const pSelf, PyObject *const pArguments, PyObject *const pKeywords) {
+		auto *const pCalculation = reinterpret_cast<AccelerationCalculationObject *>(pSelf);
+		static const char *keywords[] = {"implementation", nullptr};
+		int implementationValue = static_cast<int>(AccelerationCalculationImplementation::OPEN_MP);
+		AccelerationCalculationImplementation implementation;
+		if (!PyArg_ParseTupleAndKeywords(pArguments, pKeywords, "|i", const_cast<char **>(keywords),
+										 &implementationValue) ||
+			!toImplementation(implementationValue, implementation)) {
+			return -1;
+		}
+		// another thread may calculate accelerations with the current calculation while the GIL is released
+		if (nullptr != pCalculation->pAccelerationCalculation) {
+			PyErr_SetString(PyExc_RuntimeError, "The acceleration calculation is already initialized.");
+			return -1;
+		}
+		try {
+			pCalculation->pAccelerationCalculation = createAccelerationCalculation(implementation);
+		} catch (...) {
+			raisePythonException(std::current_exception());
+			return -1;
+		}
+		return 0;
+	}
+
+	void deallocAccelerationCalculation(PyObject *const pSelf) {
+		PyTypeObject *const pType = Py_TYPE(pSelf);
+		delete reinterpret_cast<AccelerationCalculationObject *>(pSelf)->pAccelerationCalculation;
+		pType->tp_free(pSelf);
+		Py_DECREF(pType);
+	}
+
+	PyObject *calcAccelerations(PyObject *const pSelf, PyObject *const pArguments, PyObject *const pKeywords) {
+		auto *const pCalculation = reinterpret_cast<AccelerationCalculationObject *>(pSelf);
+		static const char *keywords[] = {"bodies", "accelerations", "squared_softening_factor", nullptr};
+		PyObject *pBodiesObject = nullptr;
+		PyObject *pAccelerationsObject = nullptr;
+		Py_buffer accelerations;
+		float squaredSofteningFactor = 0.01f;
+		if (!PyArg_ParseTupleAndKeywords(pArguments, pKeywords, "OO|f", const_cast<char **>(keywords),
+										 &pBodiesObject, &pAccelerationsObject, &squaredSofteningFactor) ||
+			(0 != PyObject_GetBuffer(pAccelerationsObject, &accelerations,
+									 PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS))) {
+			return nullptr;
+		}
+		// the buffer is released by all paths below
+		std::unique_ptr<Py_buffer, void (*)(Py_buffer *)> pAccelerations(&accelerations, &PyBuffer_Release);
+		const BodiesObject *const pBodies = toBodies(pBodiesObject);
+		if (nullptr == pBodies) {
+			return nullptr;
+		}
+		if (nullptr == pCalculation->pAccelerationCalculation) {
+			PyErr_SetString(PyExc_RuntimeError, "The acceleration calculation is not initialized.");
+			return nullptr;
+		}
+		// without a format the buffer holds unsigned bytes, and e.g. a float64 buffer must not be reinterpreted
+		if ((nullptr == accelerations.format) || (0 != std::strcmp(accelerations.format, "f")) ||
+			(static_cast<Py_ssize_t>(sizeof(float)) != accelerations.itemsize) ||
+			(accelerations.len < static_cast<Py_ssize_t>(sizeof(float) * pBodies->numBodies * 3))) {
+			PyErr_SetString(PyExc_ValueError, "The accelerations must be a C-contiguous buffer of n * 3 float32.");
+			return nullptr;
+		}
+		const Bodies<float, float, float> bodies{pBodies->pMasses, pBodies->pPositions, pBodies->pVelocities};
+		IAccelerationCalculation *const pAccelerationCalculation = pCalculation->pAccelerationCalculation;
+		std::exception_ptr pException;
+		Py_BEGIN_ALLOW_THREADS
+			try {
+				pAccelerationCalculation->calcAccelerations(bodies, pBodies->numBodies,
+															static_cast<float *>(accelerations.buf),
+															squaredSofteningFactor);
+			} catch (...) {
+				pException = std::current_exception();
+			}
+		Py_END_ALLOW_THREADS
+		if (nullptr != pException) {
+			return raisePythonException(pException);
+		}
+		Py_RETURN_NONE;
+	}
+
+	PyMethodDef accelerationCalculationMethods[] = {
+			{"calc_accelerations", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(&calcAccelerations)),
+					METH_VARARGS | METH_KEYWORDS,
+					"calc_accelerations(bodies, accelerations, squared_softening_factor=0.01)\n\n"
+					"Writes the accelerations of the bodies into the passed float32 buffer of n * 3 elements, e.g. a "
+					"NumPy array, without the GIL."},
+			{nullptr, nullptr, 0, nullptr}
+	};
+
+	PyType_Slot accelerationCalculationSlots[] = {
+			{Py_tp_doc, const_cast<char *>("AccelerationCalculation(implementation=OPEN_MP)\n\n"
+										   "An acceleration calculation of Newtonian gravity.")},
+			{Py_tp_new, reinterpret_cast<void *>(&PyType_GenericNew)},
+			{Py_tp_init, reinterpret_cast<void *>(&initAccelerationCalculation)},
+			{Py_tp_dealloc, reinterpret_cast<void *>(&deallocAccelerationCalculation)},
+			{Py_tp_methods, accelerationCalculationMethods},
+			{0, nullptr}
+	};
+
+	PyType_Spec accelerationCalculationSpec = {
+			"physics_engine.AccelerationCalculation", sizeof(AccelerationCalculationObject), 0, Py_TPFLAGS_DEFAULT,
+			accelerationCalculationSlots
+	};
+
+	int initBodiesSystem(PyObject *const pSelf, PyObject *const pArguments, PyObject *const pKeywords) {
+		auto *const pSystem = reinterpret_cast<BodiesSystemObject *>(pSelf);
+		static const char *keywords[] = {"bodies", "implementation", "softening_factor", nullptr};
+		PyObject *pBodiesObject = nullptr;
+		int implementationValue = static_cast<int>(AccelerationCalculationImplementation::OPEN_MP);
+		float softeningFactor = 0.1f;
+		AccelerationCalculationImplementation implementation;
+		if (!PyArg_ParseTupleAndKeywords(pArguments, pKeywords, "O|if", const_cast<char **>(keywords),
+										 &pBodiesObject, &implementationValue, &softeningFactor) ||
+			!toImplementation(implementationValue, implementation)) {
+			return -1;
+		}
+		const BodiesObject *const pBodies = toBodies(pBodiesObject);
+		if (nullptr == pBodies) {
+			return -1;
+		}
+		if (nullptr != pSystem->pBodiesSystem) {
+			PyErr_SetString(PyExc_RuntimeError, "The system is already initialized.");
+			return -1;
+		}
+		try {
+			pSystem->pBodiesSystem = new BodiesSystem(
+					{pBodies->pMasses, pBodies->pPositions, pBodies->pVelocities},
+					pBodies->numBodies,
+					std::unique_ptr<IAccelerationCalculation>(createAccelerationCalculation(implementation)),
+					std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(),
+					softeningFactor
+			);
+		} catch (...) {
+			raisePythonException(std::current_exception());
+			return -1;
+		}
+		Py_INCREF(pBodiesObject);
+		pSystem->pBodies = pBodiesObject;
+		return 0;
+	}
+
+	void deallocBodiesSystem(PyObject *const pSelf) {
+		auto *const pSystem = reinterpret_cast<BodiesSystemObject *>(pSelf);
+		PyTypeObject *const pType = Py_TYPE(pSelf);
+		// the system waits for a pending update, before the bodies may be destroyed
+		delete pSystem->pBodiesSystem;
+		Py_XDECREF(pSystem->pBodies);
+		pType->tp_free(pSelf);
+		Py_DECREF(pType);
+	}
+
+	PyObject *updateBodiesSystem(PyObject *const pSelf, PyObject *const pArguments, PyObject *const pKeywords) {
+		auto *const pSystem = reinterpret_cast<BodiesSystemObject *>(pSelf);
+		static const char *keywords[] = {"time_step", "num_updates", nullptr};
+		float timeStep = 0.1f;
+		Py_ssize_t numUpdates = 1;
+		if (!PyArg_ParseTupleAndKeywords(pArguments, pKeywords, "|fn", const_cast<char **>(keywords), &timeStep,
+										 &numUpdates)) {
+			return nullptr;
+		}
+		if (nullptr == pSystem->pBodiesSystem) {
+			PyErr_SetString(PyExc_RuntimeError, "The system is not initialized.");
+			return nullptr;
+		}
+		// the flag is only accessed with the GIL, so a second Python thread cannot enter an update
+		if (pSystem->isUpdating) {
+			PyErr_SetString(PyExc_RuntimeError, "The system is updated by another thread.");
+			return nullptr;
+		}
+		pSystem->isUpdating = true;
+		BodiesSystem *const pBodiesSystem = pSystem->pBodiesSystem;
+		std::exception_ptr pException;
+		Py_BEGIN_ALLOW_THREADS
+			try {
+				for (Py_ssize_t i = 0; i < numUpdates; ++i) {
+					pBodiesSystem->update(timeStep);
+				}
+			} catch (...) {
+				pException = std::current_exception();
+			}
+		Py_END_ALLOW_THREADS
+		pSystem->isUpdating = false;
+		if (nullptr != pException) {
+			return raisePythonException(pException);
+		}
+		Py_RETURN_NONE;
+	}
+
+	PyObject *getBodiesOfBodiesSystem(PyObject *const pSelf, void *) {
+		PyObject *const pBodies = reinterpret_cast<BodiesSystemObject *>(pSelf)->pBodies;
+		if (nullptr == pBodies) {
+			Py_RETURN_NONE;
+		}
+		Py_INCREF(pBodies);
+		return pBodies;
+	}
+
+	PyObject *getNumBodiesOfBodiesSystem(PyObject *const pSelf, void *) {
+		const BodiesSystem *const pBodiesSystem = reinterpret_cast<BodiesSystemObject *>(pSelf)->pBodiesSystem;
+		return PyLong_FromSize_t((nullptr != pBodiesSystem) ? pBodiesSystem->getNumBodies() : 0);
+	}
+
+	PyMethodDef bodiesSystemMethods[] = {
+			{"update", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(&updateBodiesSystem)),
+					METH_VARARGS | METH_KEYWORDS,
+					"update(time_step=0.1, num_updates=1)\n\n"
+					"Updates the bodies in place by the passed number of time steps without the GIL."},
+			{nullptr, nullptr, 0, nullptr}
+	};
+
+	PyGetSetDef bodiesSystemGetSets[] = {
+			{"bodies", &getBodiesOfBodiesSystem, nullptr, "The bodies, which are updated in place.", nullptr},
+			{"num_bodies", &getNumBodiesOfBodiesSystem, nullptr, "The number of bodies.", nullptr},
+			{nullptr, nullptr, nullptr, nullptr, nullptr}
+	};
+
+	PyType_Slot bodiesSystemSlots[] = {
+			{Py_tp_doc, const_cast<char *>("BodiesSystem(bodies, implementation=OPEN_MP, softening_factor=0.1)\n\n"
+										   "A system of Newtonian gravity, which integrates the bodies in place by "
+										   "the Euler method.")},
+			{Py_tp_new, reinterpret_cast<void *>(&PyType_GenericNew)},
+			{Py_tp_init, reinterpret_cast<void *>(&initBodiesSystem)},
+			{Py_tp_dealloc, reinterpret_cast<void *>(&deallocBodiesSystem)},
+			{Py_tp_methods, bodiesSystemMethods},
+			{Py_tp_getset, bodiesSystemGetSets},
+			{0, nullptr}
+	};
+
+	PyType_Spec bodiesSystemSpec = {
+			"physics_engine.BodiesSystem", sizeof(BodiesSystemObject), 0, Py_TPFLAGS_DEFAULT, bodiesSystemSlots
+	};
+
+	/**
+	 * @brief Creates the type of the passed specification and adds it to the module.
+	 * @param pModule the module.
+	 * @param pSpec the specification of the type.
+	 * @param name the name of the type within the module.
+	 * @return the type, which is also referenced by the module, <code>nullptr</code> with a Python exception if it
+	 * cannot be created.
+	 */
+	PyTypeObject *addType(PyObject *const pModule, PyType_Spec *const pSpec, const char *const name) {
+		PyObject *const pType = PyType_FromSpec(pSpec);
+		if ((nullptr == pType) || (PyModule_AddObject(pModule, name, pType) < 0)) {
+			Py_XDECREF(pType);
+			return nullptr;
+		}
+		return reinterpret_cast<PyTypeObject *>(pType);
+	}
+
+	PyModuleDef physicsEngineModule = {
+			PyModuleDef_HEAD_INIT, "physics_engine",
+			"N-body simulations of the physics engine, whose arrays are shared with NumPy without copies.", -1,
+			nullptr, nullptr, nullptr, nullptr, nullptr
+	};
+}
+
+PyMODINIT_FUNC PyInit_physics_engine() {
+	PyObject *const pModule = PyModule_Create(&physicsEngineModule);
+	if (nullptr == pModule) {
+		return nullptr;
+	}
+	pFloatArrayType = addType(pModule, &floatArraySpec, "FloatArray");
+	pBodiesType = addType(pModule, &bodiesSpec, "Bodies");
+	if ((nullptr == pFloatArrayType) || (nullptr == pBodiesType) ||
+		(nullptr == addType(pModule, &accelerationCalculationSpec, "AccelerationCalculation")) ||
+		(nullptr == addType(pModule, &bodiesSystemSpec, "BodiesSystem"))) {
+		Py_DECREF(pModule);
+		return nullptr;
+	}
+	const struct {
+		const char *name;
+		AccelerationCalculationImplementation implementation;
+	} implementations[] = {
+			{"SEQUENTIAL", AccelerationCalculationImplementation::SEQUENTIAL},
+			{"OPEN_MP", AccelerationCalculationImplementation::OPEN_MP},
+			{"OPEN_CL", AccelerationCalculationImplementation::OPEN_CL},
+			{"CUDA", AccelerationCalculationImplementation::CUDA},
+			{"TREE_PM", AccelerationCalculationImplementation::TREE_PM},
+			{"OUT_OF_CORE", AccelerationCalculationImplementation::OUT_OF_CORE},
+			{"HETEROGENEOUS", AccelerationCalculationImplementation::HETEROGENEOUS},
+			{"OPEN_CL_MULTI_DEVICE", AccelerationCalculationImplementation::OPEN_CL_MULTI_DEVICE},
+			{"SMALL_N", AccelerationCalculationImplementation::SMALL_N},
+			{"EWALD", AccelerationCalculationImplementation::EWALD}
+	};
+	for (const auto &[name, implementation]: implementations) {
+		if (PyModule_AddIntConstant(pModule, name, static_cast<int>(implementation)) < 0) {
+			Py_DECREF(pModule);
+			return nullptr;
+		}
+	}
+	return pModule;
+}
@@ -0,0 +1,43 @@
+// FORCE_LAW_DISTANCE_FACTOR and FORCE_LAW_STRENGTH_FACTOR are defined by the source of the force law, and
+// COMPRESSED_TILE_SIZE by the host, which prepends both to this kernel (see compressed_position_tiles.h)
+kernel void calcAccelerationsFromCompressedTiles(
+    global const float* masses,
+    global const float* positions,
+    global const float* tileHeaders,
+    global const half* packedBodies,
+    global float* accelerations,
+    const ulong numBodies,
+    const float softeningFactorSquared
+) {
+    const size_t threadIndex = get_global_id(0);
+    if (numBodies <= threadIndex) {
+        return;
+    }
+    const float3 targetPosition = vload3(threadIndex, positions);
+    const float targetMass = masses[threadIndex];
+
+    float3 forceVector = (float3) (0.0f, 0.0f, 0.0f);
+    const size_t numTiles = (numBodies + COMPRESSED_TILE_SIZE - 1) / COMPRESSED_TILE_SIZE;
+    for (size_t tile = 0; tile < numTiles; ++tile) {
+        // the origin, the scale of the positions and the scale of the masses of the tile
+        const float8 header = vload8(tile, tileHeaders);
+        const size_t begin = tile * COMPRESSED_TILE_SIZE;
+        const size_t end = min((size_t) numBodies, begin + COMPRESSED_TILE_SIZE);
+        for (size_t i = begin; i < end; ++i) {
+            if (threadIndex != i) {
+                // the halves are converted to floats by the load, so the accumulation stays in float
+                const float4 packedBody = vload_half4(i, packedBodies);
+
+                // the distance vector points from body 1 to body 2
+                const float3 distanceVector = (header.s012 + (header.s3 * packedBody.xyz)) - targetPosition;
+                const float distanceSquared = dot(distanceVector, distanceVector);
+
+                const float receivedForce = FORCE_LAW_DISTANCE_FACTOR(distanceSquared, softeningFactorSquared) *
+                                            FORCE_LAW_STRENGTH_FACTOR(targetMass, header.s4 * packedBody.w);
+                forceVector += receivedForce * distanceVector;
+            }
+        }
+    }
+    // false sharing is ok here
+    vstore3(forceVector, threadIndex, accelerations);
+}
@@ -1,46 +1,60 @@
-kernel void calcAccelerations(
+// FORCE_LAW_DISTANCE_FACTOR and FORCE_LAW_STRENGTH_FACTOR are defined by the source of the force law, which the host
+// prepends to this kernel (see physics/force_laws.h)
+// The kernel calculates the accelerations of the target batch caused by the source batch, so the host can launch it
+// as soon as both batches are uploaded (see opencl_pipeline.h).
+kernel void calcAccelerationsOfBatch(
     global const float* masses,
     global const float* positions,
     global float* accelerations,
-    const ulong numBodies,
-    const float softeningFactorSquared
+    const ulong targetBegin,
+    const ulong targetEnd,
+    const ulong sourceBegin,
+    const ulong sourceEnd,
+    const float softeningFactorSquared,
+    const int isFirstSourceBatch
 ) {
-    const size_t threadIndex           = get_global_id(0);
+    const size_t threadIndex           = targetBegin + get_global_id(0);
+    if (targetEnd <= threadIndex) {
+        return;
+    }
 	const size_t xCoordinateIndexBody1 = threadIndex * 3;
  	const size_t yCoordinateIndexBody1 = xCoordinateIndexBody1 + 1;
-	const size_t zCoordinateIndexBody1 = xCoordinateIndexBody1 + 2;   
+	const size_t zCoordinateIndexBody1 = xCoordinateIndexBody1 + 2;
 
     float forceVector[3] = {0.0f, 0.0f, 0.0f};
-    for (size_t i = 0; (i < numBodies) && (threadIndex < numBodies); ++i) {
+    for (size_t i = sourceBegin; i < sourceEnd; ++i) {
         if (threadIndex != i) {
             const size_t xCoordinateIndexBody2 = i * 3;
             const size_t yCoordinateIndexBody2 = xCoordinateIndexBody2 + 1;
-            const size_t zCoordinateIndexBody2 = xCoordinateIndexBody2 + 2;     
-           
-            const float distanceVectorXCoordinate = positions[xCoordinateIndexBody1] - positions[xCoordinateIndexBody2];
-            const float distanceVectorYCoordinate = positions[yCoordinateIndexBody1] - positions[yCoordinateIndexBody2];
-			const float distanceVectorZCoordinate = positions[zCoordinateIndexBody1] - positions[zCoordinateIndexBody2];
-            
-            const float distance = sqrt(
-                (distanceVectorXCoordinate * distanceVectorXCoordinate) + 
+            const size_t zCoordinateIndexBody2 = xCoordinateIndexBody2 + 2;
+
+            // the distance vector points from body 1 to body 2
+            const float distanceVectorXCoordinate = positions[xCoordinateIndexBody2] - positions[xCoordinateIndexBody1];
+            const float distanceVectorYCoordinate = positions[yCoordinateIndexBody2] - positions[yCoordinateIndexBody1];
+			const float distanceVectorZCoordinate = positions[zCoordinateIndexBody2] - positions[zCoordinateIndexBody1];
+
+            const float distanceSquared =
+                (distanceVectorXCoordinate * distanceVectorXCoordinate) +
                 (distanceVectorYCoordinate * distanceVectorYCoordinate) +
-                (distanceVectorZCoordinate * distanceVectorZCoordinate)
-            ) + softeningFactorSquared; // to avoid zero in the following divisions 
-            
-            const float normalizedDistanceVectorXCoordinate = distanceVectorXCoordinate / distance;
-			const float normalizedDistanceVectorYCoordinate = distanceVectorYCoordinate / distance;
-			const float normalizedDistanceVectorZCoordinate = distanceVectorZCoordinate / distance;
-            const float receivedForce = masses[i] / (distance * distance);
+                (distanceVectorZCoordinate * distanceVectorZCoordinate);
+
+            const float receivedForce = FORCE_LAW_DISTANCE_FACTOR(distanceSquared, softeningFactorSquared) *
+                                        FORCE_LAW_STRENGTH_FACTOR(masses[threadIndex], masses[i]);
             // It is possible to write directly in to the accelerations array here, but the false sharing will
 			// reduce in this loop significantly the performance
-			forceVector[0] += (receivedForce * normalizedDistanceVectorXCoordinate);
-			forceVector[1] += (receivedForce * normalizedDistanceVectorYCoordinate);
-			forceVector[2] += (receivedForce * normalizedDistanceVectorZCoordinate);
-            
+			forceVector[0] += (receivedForce * distanceVectorXCoordinate);
+			forceVector[1] += (receivedForce * distanceVectorYCoordinate);
+			forceVector[2] += (receivedForce * distanceVectorZCoordinate);
         }
     }
-    // false sharing is ok here
-	accelerations[xCoordinateIndexBody1] = 6.67430e-11 * forceVector[0];
-	accelerations[yCoordinateIndexBody1] = 6.67430e-11 * forceVector[1];
-	accelerations[zCoordinateIndexBody1] = 6.67430e-11 * forceVector[2];
+    // false sharing is ok here, the kernels of one target batch run in order on the same queue
+    if (isFirstSourceBatch) {
+	    accelerations[xCoordinateIndexBody1] = forceVector[0];
+	    accelerations[yCoordinateIndexBody1] = forceVector[1];
+	    accelerations[zCoordinateIndexBody1] = forceVector[2];
+    } else {
+	    accelerations[xCoordinateIndexBody1] += forceVector[0];
+	    accelerations[yCoordinateIndexBody1] += forceVector[1];
+	    accelerations[zCoordinateIndexBody1] += forceVector[2];
+    }
 }
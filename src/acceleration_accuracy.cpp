@@ -0,0 +1,107 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "acceleration_accuracy.h"
+#include "compensated_sum.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Returns the passed percentile of the sorted values by the nearest rank.
+	 */
+	double getPercentile(const std::vector<double> &sortedValues, const double percentile) {
+		const auto rank = static_cast<size_t>(std::ceil(percentile * static_cast<double>(sortedValues.size())));
+		return sortedValues[std::clamp<size_t>(rank, 1, sortedValues.size()) - 1];
+	}
+}
+
+void physics::calcReferenceAccelerations(const Bodies<float, float, float> &bodies, const size_t numBodies,
+										 const float squaredSofteningFactor, double *const accelerations,
+										 const double gravitationalConstant) {
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, squaredSofteningFactor, accelerations, gravitationalConstant) schedule(dynamic, 64)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long target = 0; target < static_cast<long long>(numBodies); ++target) {
+		CompensatedSum sums[3];
+		for (size_t source = 0; source < numBodies; ++source) {
+			if (static_cast<size_t>(target) == source) {
+				continue;
+			}
+			double difference[3];
+			double squaredDistance = squaredSofteningFactor;
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				difference[dimension] = static_cast<double>(bodies.positions[(source * 3) + dimension]) -
+										bodies.positions[(target * 3) + dimension];
+				squaredDistance += difference[dimension] * difference[dimension];
+			}
+			const double factor = gravitationalConstant * bodies.masses[source] /
+								  (squaredDistance * std::sqrt(squaredDistance));
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				sums[dimension].add(factor * difference[dimension]);
+			}
+		}
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			accelerations[(target * 3) + dimension] = sums[dimension].getValue();
+		}
+	}
+}
+
+AccelerationAccuracy physics::compareAccelerations(const float *const accelerations,
+												   const double *const referenceAccelerations,
+												   const size_t numBodies) {
+	AccelerationAccuracy accuracy;
+	if (0 == numBodies) {
+		return accuracy;
+	}
+	std::vector<double> relativeErrors(numBodies);
+	for (size_t i = 0; i < numBodies; ++i) {
+		double squaredError = 0.0;
+		double squaredReference = 0.0;
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const double reference = referenceAccelerations[(i * 3) + dimension];
+			const double error = accelerations[(i * 3) + dimension] - reference;
+			squaredError += error * error;
+			squaredReference += reference * reference;
+		}
+		// a body without acceleration has no relative error, unless it is accelerated
+		if (0.0 < squaredReference) {
+			relativeErrors[i] = std::sqrt(squaredError / squaredReference);
+		} else {
+			relativeErrors[i] = (0.0 < squaredError) ? std::numeric_limits<double>::infinity() : 0.0;
+		}
+		if (std::isnan(relativeErrors[i])) {
+			// a NaN would not be sorted, but is the largest error of all
+			relativeErrors[i] = std::numeric_limits<double>::infinity();
+		}
+	}
+	std::sort(relativeErrors.begin(), relativeErrors.end());
+	accuracy.medianRelativeError = getPercentile(relativeErrors, 0.5);
+	accuracy.p90RelativeError = getPercentile(relativeErrors, 0.9);
+	accuracy.p99RelativeError = getPercentile(relativeErrors, 0.99);
+	accuracy.maxRelativeError = relativeErrors.back();
+	return accuracy;
+}
+
+AccelerationAccuracy physics::measureAccelerationAccuracy(IAccelerationCalculation &accelerationCalculation,
+														  const Bodies<float, float, float> &bodies,
+														  const size_t numBodies,
+														  const float squaredSofteningFactor,
+														  const double *const referenceAccelerations,
+														  float *const accelerations) {
+	const auto startTime = std::chrono::steady_clock::now();
+	accelerationCalculation.calcAccelerations(bodies, numBodies, accelerations, squaredSofteningFactor);
+	const auto endTime = std::chrono::steady_clock::now();
+	AccelerationAccuracy accuracy = compareAccelerations(accelerations, referenceAccelerations, numBodies);
+	accuracy.seconds = std::chrono::duration<double>(endTime - startTime).count();
+	if (0.0 < accuracy.seconds) {
+		accuracy.interactionsPerSecond = static_cast<double>(numBodies) * static_cast<double>(numBodies) /
+										 accuracy.seconds;
+	}
+	return accuracy;
+}
@@ -0,0 +1,97 @@
+#ifndef PHYSICS_ENGINE_ACCELERATION_ACCURACY_H
+#define PHYSICS_ENGINE_ACCELERATION_ACCURACY_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+
+#include "physics/acceleration_calculation.h"
+#include "physics/astronomical_algorithms.h"
+#include "physics/bodies.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief The accuracy and the throughput of one acceleration calculation compared with the reference
+	 * accelerations.
+	 * @details The relative error of a body is <code>|a - a_ref| / |a_ref|</code>, so its percentiles describe the
+	 * bodies and are not dominated by the largest accelerations.
+	 */
+	struct AccelerationAccuracy {
+
+		/**
+		 * The median of the relative errors of the bodies.
+		 */
+		double medianRelativeError = 0.0;
+
+		/**
+		 * The 90th percentile of the relative errors of the bodies.
+		 */
+		double p90RelativeError = 0.0;
+
+		/**
+		 * The 99th percentile of the relative errors of the bodies.
+		 */
+		double p99RelativeError = 0.0;
+
+		/**
+		 * The maximum of the relative errors of the bodies.
+		 */
+		double maxRelativeError = 0.0;
+
+		/**
+		 * The wall-clock time of the acceleration calculation in seconds.
+		 */
+		double seconds = 0.0;
+
+		/**
+		 * The throughput in pairwise interactions <code>N^2</code> per second, which also measures approximations
+		 * by the work of a direct sum.
+		 */
+		double interactionsPerSecond = 0.0;
+	};
+
+	/**
+	 * @brief Calculates the reference accelerations of Newtonian gravity with Plummer softening, i.e. the direct sum
+	 * of all pairs in double precision with compensated summation, by a parallel loop over the targets.
+	 * @details Each target sums its sources sequentially, so the reference does not depend on the number of threads.
+	 * @param bodies the bodies.
+	 * @param numBodies the number of bodies.
+	 * @param squaredSofteningFactor the squared softening factor.
+	 * @param[out] accelerations the reference accelerations, <code>numBodies * 3</code> elements.
+	 * @param gravitationalConstant the gravitational constant, by default the one of the Newtonian force law.
+	 */
+	void calcReferenceAccelerations(const Bodies<float, float, float> &bodies, size_t numBodies,
+									float squaredSofteningFactor, double *accelerations,
+									double gravitationalConstant = GRAVITATIONAL_CONSTANT);
+
+	/**
+	 * @brief Calculates the relative errors of the passed accelerations compared with the reference accelerations.
+	 * @param accelerations the accelerations to be compared, <code>numBodies * 3</code> elements.
+	 * @param referenceAccelerations the reference accelerations, <code>numBodies * 3</code> elements.
+	 * @param numBodies the number of bodies.
+	 * @return the percentiles of the relative errors, without the time and the throughput.
+	 */
+	AccelerationAccuracy compareAccelerations(const float *accelerations, const double *referenceAccelerations,
+											  size_t numBodies);
+
+	/**
+	 * @brief Measures the time of one acceleration calculation and compares its accelerations with the reference
+	 * accelerations.
+	 * @param accelerationCalculation the acceleration calculation to be measured.
+	 * @param bodies the bodies.
+	 * @param numBodies the number of bodies.
+	 * @param squaredSofteningFactor the squared softening factor.
+	 * @param referenceAccelerations the reference accelerations, see <code>calcReferenceAccelerations</code>.
+	 * @param[out] accelerations the calculated accelerations, <code>numBodies * 3</code> elements.
+	 * @return the accuracy and the throughput of the acceleration calculation.
+	 */
+	AccelerationAccuracy measureAccelerationAccuracy(IAccelerationCalculation &accelerationCalculation,
+													 const Bodies<float, float, float> &bodies, size_t numBodies,
+													 float squaredSofteningFactor,
+													 const double *referenceAccelerations, float *accelerations);
+}
+
+#endif //PHYSICS_ENGINE_ACCELERATION_ACCURACY_H
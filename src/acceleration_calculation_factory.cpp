@@ -1,27 +1,135 @@
 // Reminder: Always include standard library and system headers before including your own headers.
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 #include "physics/acceleration_calculation_factory.h"
 #include "sequential_acceleration_calculation.h"
 #include "openmp_acceleration_calculation.h"
 #include "opencl_acceleration_calculation.h"
+#include "tree_pm_acceleration_calculation.h"
+#include "out_of_core_acceleration_calculation.h"
+#include "heterogeneous_acceleration_calculation.h"
+#include "multi_device_opencl_acceleration_calculation.h"
+#include "small_n_acceleration_calculation.h"
+#include "ewald_acceleration_calculation.h"
 #include "cudamodule/cuda_acceleration_calculation.h"
 
 using namespace physics;
 
 IAccelerationCalculation *
 physics::createAccelerationCalculation(const AccelerationCalculationImplementation &implementation) {
+	return createAccelerationCalculation(implementation, NewtonianForceLaw());
+}
+
+template<typename TForceLaw>
+IAccelerationCalculation *
+physics::createAccelerationCalculation(const AccelerationCalculationImplementation &implementation,
+									   const TForceLaw &forceLaw) {
 	switch (implementation) {
 		case AccelerationCalculationImplementation::SEQUENTIAL:
-			return new SequentialAccelerationCalculationImpl();
+			return new BasicSequentialAccelerationCalculationImpl<TForceLaw>(forceLaw);
 		case AccelerationCalculationImplementation::OPEN_MP:
-			return new OpenMpAccelerationCalculationImpl();
+			return new BasicOpenMpAccelerationCalculationImpl<TForceLaw>(forceLaw);
 		case AccelerationCalculationImplementation::OPEN_CL:
-			return new OpenClAccelerationCalculationImpl();
+			return new BasicOpenClAccelerationCalculationImpl<TForceLaw>(forceLaw);
 		case AccelerationCalculationImplementation::CUDA:
-			return new CudaAccelerationCalculationImpl();
+			return new BasicCudaAccelerationCalculationImpl<TForceLaw>(forceLaw);
+		case AccelerationCalculationImplementation::TREE_PM:
+			if constexpr (std::is_same_v<TForceLaw, NewtonianForceLaw>) {
+				return new TreePmAccelerationCalculationImpl(forceLaw);
+			} else {
+				// let it crash
+				throw std::invalid_argument("The TreePM implementation supports only Newtonian gravity.");
+			}
+		case AccelerationCalculationImplementation::OUT_OF_CORE:
+			return new BasicOutOfCoreAccelerationCalculationImpl<TForceLaw>(forceLaw);
+		case AccelerationCalculationImplementation::HETEROGENEOUS:
+			return new HeterogeneousAccelerationCalculationImpl(
+					std::make_unique<BasicOpenMpAccelerationCalculationImpl<TForceLaw>>(forceLaw),
+					std::make_unique<BasicOpenClAccelerationCalculationImpl<TForceLaw>>(forceLaw));
+		case AccelerationCalculationImplementation::OPEN_CL_MULTI_DEVICE:
+			return new BasicMultiDeviceOpenClAccelerationCalculationImpl<TForceLaw>(forceLaw);
+		case AccelerationCalculationImplementation::SMALL_N:
+			return new BasicSmallNAccelerationCalculationImpl<TForceLaw>(forceLaw);
+		case AccelerationCalculationImplementation::EWALD:
+			// let it crash
+			throw std::invalid_argument("The Ewald implementation needs a periodic box.");
 		default:
 			// let it crash
 			throw std::runtime_error("Unknown implementation of an acceleration calculation.");
 	}
-}
\ No newline at end of file
+}
+
+template<typename TForceLaw>
+IAccelerationCalculation *
+physics::createAccelerationCalculation(const AccelerationCalculationImplementation &implementation,
+									   const TForceLaw &forceLaw, const size_t numBodies) {
+	const bool isCpuImplementation = (AccelerationCalculationImplementation::SEQUENTIAL == implementation) ||
+									 (AccelerationCalculationImplementation::OPEN_MP == implementation);
+	if (isCpuImplementation && (numBodies <= BasicSmallNAccelerationCalculationImpl<TForceLaw>::MAX_NUM_BODIES)) {
+		return new BasicSmallNAccelerationCalculationImpl<TForceLaw>(forceLaw);
+	}
+	return createAccelerationCalculation(implementation, forceLaw);
+}
+
+template<typename TForceLaw>
+IAccelerationCalculation *
+physics::createAccelerationCalculation(const AccelerationCalculationImplementation &implementation,
+									   const TForceLaw &forceLaw, const PeriodicBox &periodicBox) {
+	if (AccelerationCalculationImplementation::EWALD != implementation) {
+		// let it crash
+		throw std::invalid_argument("Only the Ewald implementation supports periodic boundaries.");
+	}
+	if constexpr (IS_EWALD_SUMMABLE<TForceLaw>) {
+		return new BasicEwaldAccelerationCalculationImpl<TForceLaw>(forceLaw, periodicBox);
+	} else {
+		// let it crash
+		throw std::invalid_argument("The Ewald implementation supports only force laws which decay like 1 / r.");
+	}
+}
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<NewtonianForceLaw>(
+		const AccelerationCalculationImplementation &, const NewtonianForceLaw &);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<SplineSoftenedNewtonianForceLaw>(
+		const AccelerationCalculationImplementation &, const SplineSoftenedNewtonianForceLaw &);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<CoulombForceLaw>(
+		const AccelerationCalculationImplementation &, const CoulombForceLaw &);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<YukawaForceLaw>(
+		const AccelerationCalculationImplementation &, const YukawaForceLaw &);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<LennardJonesForceLaw>(
+		const AccelerationCalculationImplementation &, const LennardJonesForceLaw &);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<NewtonianForceLaw>(
+		const AccelerationCalculationImplementation &, const NewtonianForceLaw &, size_t);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<SplineSoftenedNewtonianForceLaw>(
+		const AccelerationCalculationImplementation &, const SplineSoftenedNewtonianForceLaw &, size_t);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<CoulombForceLaw>(
+		const AccelerationCalculationImplementation &, const CoulombForceLaw &, size_t);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<YukawaForceLaw>(
+		const AccelerationCalculationImplementation &, const YukawaForceLaw &, size_t);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<LennardJonesForceLaw>(
+		const AccelerationCalculationImplementation &, const LennardJonesForceLaw &, size_t);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<NewtonianForceLaw>(
+		const AccelerationCalculationImplementation &, const NewtonianForceLaw &, const PeriodicBox &);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<SplineSoftenedNewtonianForceLaw>(
+		const AccelerationCalculationImplementation &, const SplineSoftenedNewtonianForceLaw &, const PeriodicBox &);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<CoulombForceLaw>(
+		const AccelerationCalculationImplementation &, const CoulombForceLaw &, const PeriodicBox &);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<YukawaForceLaw>(
+		const AccelerationCalculationImplementation &, const YukawaForceLaw &, const PeriodicBox &);
+
+template IAccelerationCalculation *physics::createAccelerationCalculation<LennardJonesForceLaw>(
+		const AccelerationCalculationImplementation &, const LennardJonesForceLaw &, const PeriodicBox &);
@@ -0,0 +1,151 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "physics/arena.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The size of a huge page on x86-64 and most AArch64 systems.
+	 */
+	constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+	/**
+	 * @brief Rounds the passed size up to a multiple of the passed alignment.
+	 */
+	constexpr size_t alignUp(const size_t size, const size_t alignment) {
+		return ((size + alignment - 1) / alignment) * alignment;
+	}
+}
+
+Arena::Arena(const size_t capacity, const bool useHugePages) :
+		pBlock_(nullptr),
+		capacity_(0),
+		usage_(0),
+		overflowUsage_(0),
+		peakUsage_(0),
+		pOverflowBlocks_(nullptr),
+		useHugePages_(useHugePages),
+		isHugePageBacked_(false),
+		isMapped_(false) {
+	allocateBlock(capacity);
+}
+
+Arena::Arena(Arena &&other) noexcept:
+		pBlock_(std::exchange(other.pBlock_, nullptr)),
+		capacity_(std::exchange(other.capacity_, 0)),
+		usage_(std::exchange(other.usage_, 0)),
+		overflowUsage_(std::exchange(other.overflowUsage_, 0)),
+		peakUsage_(std::exchange(other.peakUsage_, 0)),
+		pOverflowBlocks_(std::exchange(other.pOverflowBlocks_, nullptr)),
+		useHugePages_(other.useHugePages_),
+		isHugePageBacked_(std::exchange(other.isHugePageBacked_, false)),
+		isMapped_(std::exchange(other.isMapped_, false)) {
+}
+
+Arena &Arena::operator=(Arena &&other) noexcept {
+	if (this != &other) {
+		releaseBlocks();
+		pBlock_ = std::exchange(other.pBlock_, nullptr);
+		capacity_ = std::exchange(other.capacity_, 0);
+		usage_ = std::exchange(other.usage_, 0);
+		overflowUsage_ = std::exchange(other.overflowUsage_, 0);
+		peakUsage_ = std::exchange(other.peakUsage_, 0);
+		pOverflowBlocks_ = std::exchange(other.pOverflowBlocks_, nullptr);
+		useHugePages_ = other.useHugePages_;
+		isHugePageBacked_ = std::exchange(other.isHugePageBacked_, false);
+		isMapped_ = std::exchange(other.isMapped_, false);
+	}
+	return *this;
+}
+
+Arena::~Arena() {
+	releaseBlocks();
+}
+
+void Arena::allocateBlock(const size_t capacity) {
+	if (0 == capacity) {
+		return;
+	}
+#ifdef __linux__
+	if (useHugePages_ && (HUGE_PAGE_SIZE <= capacity)) {
+		const size_t hugePageCapacity = alignUp(capacity, HUGE_PAGE_SIZE);
+		void *const pMemory = mmap(nullptr, hugePageCapacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+								   -1, 0);
+		if (MAP_FAILED == pMemory) {
+			// let it crash
+			throw std::bad_alloc();
+		}
+		// only a hint, the kernel falls back to normal pages if transparent huge pages are disabled
+		isHugePageBacked_ = (0 == madvise(pMemory, hugePageCapacity, MADV_HUGEPAGE));
+		pBlock_ = static_cast<std::byte *>(pMemory);
+		capacity_ = hugePageCapacity;
+		isMapped_ = true;
+		return;
+	}
+#endif
+	capacity_ = alignUp(capacity, ALIGNMENT);
+	pBlock_ = static_cast<std::byte *>(::operator new(capacity_, std::align_val_t{ALIGNMENT}));
+	isHugePageBacked_ = false;
+	isMapped_ = false;
+}
+
+void Arena::releaseBlocks() {
+	while (nullptr != pOverflowBlocks_) {
+		std::byte *const pPrevious = *reinterpret_cast<std::byte **>(pOverflowBlocks_);
+		::operator delete(pOverflowBlocks_, std::align_val_t{ALIGNMENT});
+		pOverflowBlocks_ = pPrevious;
+	}
+	if (nullptr != pBlock_) {
+		// the aligned capacity of a deleted block may reach the huge page size, so the capacity does not tell
+#ifdef __linux__
+		if (isMapped_) {
+			munmap(pBlock_, capacity_);
+		} else {
+			::operator delete(pBlock_, std::align_val_t{ALIGNMENT});
+		}
+#else
+		::operator delete(pBlock_, std::align_val_t{ALIGNMENT});
+#endif
+	}
+	pBlock_ = nullptr;
+	capacity_ = 0;
+	isHugePageBacked_ = false;
+	isMapped_ = false;
+}
+
+void *Arena::allocate(const size_t numBytes) {
+	const size_t alignedNumBytes = alignUp(std::max<size_t>(1, numBytes), ALIGNMENT);
+	if (alignedNumBytes <= (capacity_ - usage_)) {
+		void *const pMemory = pBlock_ + usage_;
+		usage_ += alignedNumBytes;
+		peakUsage_ = std::max(peakUsage_, getUsage());
+		return pMemory;
+	}
+	// the first aligned bytes of an overflow block link to the previous overflow block
+	auto *const pOverflowBlock = static_cast<std::byte *>(
+			::operator new(ALIGNMENT + alignedNumBytes, std::align_val_t{ALIGNMENT}));
+	*reinterpret_cast<std::byte **>(pOverflowBlock) = pOverflowBlocks_;
+	pOverflowBlocks_ = pOverflowBlock;
+	overflowUsage_ += alignedNumBytes;
+	peakUsage_ = std::max(peakUsage_, getUsage());
+	return pOverflowBlock + ALIGNMENT;
+}
+
+void Arena::reset() {
+	if (nullptr != pOverflowBlocks_) {
+		// one block for the peak usage, so the following steps do not overflow anymore
+		const size_t peakUsage = peakUsage_;
+		releaseBlocks();
+		allocateBlock(peakUsage);
+	}
+	usage_ = 0;
+	overflowUsage_ = 0;
+}
@@ -0,0 +1,137 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <utility>
+
+#include "async_update_worker.h"
+#include "physics/async_update.h"
+
+using namespace physics;
+
+AsyncUpdateWorker::AsyncUpdateWorker() :
+		numSubmittedJobs_(0),
+		numFinishedJobs_(0),
+		numHandedOffJobs_(0),
+		failedTicket_(0),
+		isStopping_(false),
+		thread_(&AsyncUpdateWorker::run, this) {
+}
+
+AsyncUpdateWorker::~AsyncUpdateWorker() {
+	{
+		const std::lock_guard<std::mutex> lock(mutex_);
+		isStopping_ = true;
+	}
+	condition_.notify_all();
+	thread_.join();
+}
+
+void AsyncUpdateWorker::run() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		condition_.wait(lock, [this]() { return (nullptr != job_) || isStopping_; });
+		if (nullptr == job_) {
+			return;
+		}
+		// the job runs without the lock, so the state of the worker can be queried meanwhile
+		const std::function<void()> job = std::move(job_);
+		job_ = nullptr;
+		lock.unlock();
+		std::exception_ptr exception;
+		try {
+			job();
+		} catch (...) {
+			exception = std::current_exception();
+		}
+		lock.lock();
+		++numFinishedJobs_;
+		if (nullptr != exception) {
+			exception_ = exception;
+			failedTicket_ = numFinishedJobs_;
+		}
+		const size_t ticket = numFinishedJobs_;
+		const std::coroutine_handle<> continuation = std::exchange(continuation_, nullptr);
+		if (continuation) {
+			// the continuation may submit the next job, which is run after the continuation is suspended again
+			lock.unlock();
+			continuation.resume();
+			lock.lock();
+		}
+		// other threads are released only now, so they do not race with the continuation
+		numHandedOffJobs_ = ticket;
+		condition_.notify_all();
+	}
+}
+
+size_t AsyncUpdateWorker::getNumFinishedJobsOfCaller() const {
+	return (std::this_thread::get_id() == thread_.get_id()) ? numFinishedJobs_ : numHandedOffJobs_;
+}
+
+size_t AsyncUpdateWorker::submit(std::function<void()> job) {
+	std::unique_lock<std::mutex> lock(mutex_);
+	condition_.wait(lock, [this]() { return getNumFinishedJobsOfCaller() == numSubmittedJobs_; });
+	job_ = std::move(job);
+	const size_t ticket = ++numSubmittedJobs_;
+	condition_.notify_all();
+	return ticket;
+}
+
+bool AsyncUpdateWorker::isFinished(const size_t ticket) {
+	const std::lock_guard<std::mutex> lock(mutex_);
+	return ticket <= getNumFinishedJobsOfCaller();
+}
+
+void AsyncUpdateWorker::wait(const size_t ticket) {
+	std::unique_lock<std::mutex> lock(mutex_);
+	condition_.wait(lock, [this, ticket]() { return ticket <= getNumFinishedJobsOfCaller(); });
+}
+
+void AsyncUpdateWorker::waitForAll() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	condition_.wait(lock, [this]() { return getNumFinishedJobsOfCaller() == numSubmittedJobs_; });
+}
+
+bool AsyncUpdateWorker::suspend(const size_t ticket, const std::coroutine_handle<> continuation) {
+	const std::lock_guard<std::mutex> lock(mutex_);
+	// the continuation of a finished job would never be resumed, even if other threads still wait for the job
+	if (ticket <= numFinishedJobs_) {
+		return false;
+	}
+	continuation_ = continuation;
+	return true;
+}
+
+void AsyncUpdateWorker::rethrowIfFailed(const size_t ticket) {
+	const std::lock_guard<std::mutex> lock(mutex_);
+	if (ticket == failedTicket_) {
+		std::rethrow_exception(exception_);
+	}
+}
+
+AsyncUpdate::AsyncUpdate(AsyncUpdateWorker *const pWorker, const size_t ticket) :
+		pWorker_(pWorker),
+		ticket_(ticket) {
+}
+
+bool AsyncUpdate::isReady() const {
+	return pWorker_->isFinished(ticket_);
+}
+
+void AsyncUpdate::wait() const {
+	pWorker_->wait(ticket_);
+}
+
+void AsyncUpdate::get() const {
+	pWorker_->wait(ticket_);
+	pWorker_->rethrowIfFailed(ticket_);
+}
+
+bool AsyncUpdate::await_ready() const {
+	return pWorker_->isFinished(ticket_);
+}
+
+bool AsyncUpdate::await_suspend(const std::coroutine_handle<> continuation) const {
+	return pWorker_->suspend(ticket_, continuation);
+}
+
+void AsyncUpdate::await_resume() const {
+	pWorker_->rethrowIfFailed(ticket_);
+}
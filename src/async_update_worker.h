@@ -0,0 +1,158 @@
+#ifndef PHYSICS_ENGINE_ASYNC_UPDATE_WORKER_H
+#define PHYSICS_ENGINE_ASYNC_UPDATE_WORKER_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A thread which runs one job after another, e.g. the asynchronous updates of a system of bodies.
+	 * @details At most one job is pending at a time. After a job is finished, the thread resumes the coroutine which
+	 * awaits it, if any, before it runs the next job. Other threads, which wait for the job, are released only after
+	 * the coroutine is suspended again or completed, so they never run concurrently to it. The destructor waits for
+	 * the pending job.
+	 */
+	class AsyncUpdateWorker {
+
+		private:
+			/**
+			 * The mutex of all following members except the thread.
+			 */
+			std::mutex mutex_;
+
+			/**
+			 * The condition of a submitted or a finished job.
+			 */
+			std::condition_variable condition_;
+
+			/**
+			 * The pending job, which is empty if there is none.
+			 */
+			std::function<void()> job_;
+
+			/**
+			 * The number of submitted jobs, i.e. the ticket of the last job.
+			 */
+			size_t numSubmittedJobs_;
+
+			/**
+			 * The number of finished jobs.
+			 */
+			size_t numFinishedJobs_;
+
+			/**
+			 * The number of finished jobs whose continuation, if any, was suspended again or completed, i.e. the number
+			 * of jobs which are finished for any thread except the worker.
+			 */
+			size_t numHandedOffJobs_;
+
+			/**
+			 * The exception of the last failed job.
+			 */
+			std::exception_ptr exception_;
+
+			/**
+			 * The ticket of the last failed job, zero if no job failed.
+			 */
+			size_t failedTicket_;
+
+			/**
+			 * The coroutine which awaits the pending job.
+			 */
+			std::coroutine_handle<> continuation_;
+
+			/**
+			 * Whether the thread should stop after the pending job.
+			 */
+			bool isStopping_;
+
+			/**
+			 * The thread which runs the jobs, started last, since it accesses all other members.
+			 */
+			std::thread thread_;
+
+			/**
+			 * @brief Runs the jobs until the worker is stopped.
+			 */
+			void run();
+
+			/**
+			 * @brief Returns the number of jobs which are finished for the calling thread. A continuation, which runs on
+			 * the worker, sees its job finished, while all other threads see it finished after the continuation.
+			 * @return the number of finished jobs.
+			 */
+			[[nodiscard]] size_t getNumFinishedJobsOfCaller() const;
+
+		public:
+			/**
+			 * @brief The default constructor, which starts the thread.
+			 */
+			AsyncUpdateWorker();
+
+			/**
+			 * @brief The deleted copy constructor, since the thread is owned exclusively.
+			 */
+			AsyncUpdateWorker(const AsyncUpdateWorker &) = delete;
+
+			/**
+			 * @brief The deleted copy assignment, since the thread is owned exclusively.
+			 */
+			AsyncUpdateWorker &operator=(const AsyncUpdateWorker &) = delete;
+
+			/**
+			 * @brief The destructor, which waits for the pending job and stops the thread.
+			 */
+			~AsyncUpdateWorker();
+
+			/**
+			 * @brief Submits a job, after the pending job is finished.
+			 * @param job the job to be run by the thread.
+			 * @return the ticket of the job.
+			 */
+			size_t submit(std::function<void()> job);
+
+			/**
+			 * @brief Returns whether the job of the passed ticket is finished.
+			 * @param ticket the ticket of the job.
+			 * @return <code>true</code> if the job is finished.
+			 */
+			[[nodiscard]] bool isFinished(size_t ticket);
+
+			/**
+			 * @brief Blocks until the job of the passed ticket is finished.
+			 * @param ticket the ticket of the job.
+			 */
+			void wait(size_t ticket);
+
+			/**
+			 * @brief Blocks until all submitted jobs are finished.
+			 */
+			void waitForAll();
+
+			/**
+			 * @brief Registers the coroutine which awaits the job of the passed ticket.
+			 * @param ticket the ticket of the job.
+			 * @param continuation the coroutine to be resumed by the thread after the job.
+			 * @return <code>false</code> if the job is already finished, so the coroutine is not registered.
+			 */
+			bool suspend(size_t ticket, std::coroutine_handle<> continuation);
+
+			/**
+			 * @brief Rethrows the exception of the job of the passed ticket, if it failed.
+			 * @param ticket the ticket of a finished job.
+			 */
+			void rethrowIfFailed(size_t ticket);
+	};
+}
+
+#endif //PHYSICS_ENGINE_ASYNC_UPDATE_WORKER_H
@@ -0,0 +1,16 @@
+#include "physics/bodies_snapshot.h"
+
+using namespace physics;
+
+void BodiesSnapshot::capture(const Bodies<float, float, float> &bodies, const size_t numBodies,
+							 const BodyReordering &bodyReordering) {
+	// assign reuses the capacity of the previous capture
+	masses_.assign(bodies.masses, bodies.masses + numBodies);
+	positions_.assign(bodies.positions, bodies.positions + (numBodies * 3));
+	velocities_.assign(bodies.velocities, bodies.velocities + (numBodies * 3));
+	originalIds_.resize(numBodies);
+	for (size_t i = 0; i < numBodies; ++i) {
+		originalIds_[i] = bodyReordering.getOriginalId(i);
+	}
+	numBodies_ = numBodies;
+}
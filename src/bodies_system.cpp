@@ -1,40 +1,228 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <omp.h>
+
 #include "physics/bodies_system.h"
+#include "async_update_worker.h"
 
 using namespace physics;
 
 BodiesSystem::BodiesSystem(
 		const Bodies<float, float, float> &bodies,
 		const size_t numBodies,
-		IAccelerationCalculation *pAccelerationCalculation,
-		IPositionVelocityCalculation *pPositionVelocityCalculation,
-		float softeningFactor
+		std::unique_ptr<IAccelerationCalculation> pAccelerationCalculation,
+		std::unique_ptr<IPositionVelocityCalculation> pPositionVelocityCalculation,
+		float softeningFactor,
+		std::unique_ptr<ICollisionHandling> pCollisionHandling
 ) : bodies_(bodies),
 	numBodies_(numBodies),
-	pAccelerationCalculation_(pAccelerationCalculation),
-	pPositionVelocityCalculation_(pPositionVelocityCalculation),
+	pAccelerationCalculation_(std::move(pAccelerationCalculation)),
+	pPositionVelocityCalculation_(std::move(pPositionVelocityCalculation)),
+	pCollisionHandling_(std::move(pCollisionHandling)),
 	squaredSofteningFactor_(softeningFactor * softeningFactor),
-	accelerations_(new float[numBodies * 3]) {
+	// zero-initialized, so implementations which accumulate into the accelerations start from a defined state
+	accelerations_(std::make_unique<float[]>(numBodies * 3)),
+	previousPositions_((nullptr != pCollisionHandling_) ? std::make_unique<float[]>(numBodies * 3) : nullptr),
+	potentials_(nullptr),
+	updateContext_(omp_get_max_threads()),
+	diagnosticsInterval_(0),
+	numUpdates_(0),
+	diagnostics_(),
+	bodyReordering_(numBodies),
+	reorderingInterval_(0),
+	numUpdatesSinceReorderingEnabled_(0),
+	pFrontSnapshot_(nullptr),
+	pBackSnapshot_(nullptr),
+	pFrameRing_(nullptr),
+	pAsyncUpdateWorker_(nullptr) {
+	if ((nullptr == pAccelerationCalculation_) || (nullptr == pPositionVelocityCalculation_)) {
+		// let it crash
+		throw std::invalid_argument("A bodies system needs an acceleration and a position and velocity calculation.");
+	}
+}
+
+// the pending update of the moved-from system refers to it, so it is waited for before any member is moved
+BodiesSystem::BodiesSystem(BodiesSystem &&other) noexcept :
+		bodies_((other.waitForAsyncUpdate(), other.bodies_)),
+		numBodies_(other.numBodies_),
+		pAccelerationCalculation_(std::move(other.pAccelerationCalculation_)),
+		pPositionVelocityCalculation_(std::move(other.pPositionVelocityCalculation_)),
+		pCollisionHandling_(std::move(other.pCollisionHandling_)),
+		squaredSofteningFactor_(other.squaredSofteningFactor_),
+		accelerations_(std::move(other.accelerations_)),
+		previousPositions_(std::move(other.previousPositions_)),
+		potentials_(std::move(other.potentials_)),
+		updateContext_(std::move(other.updateContext_)),
+		diagnosticsInterval_(other.diagnosticsInterval_),
+		numUpdates_(other.numUpdates_),
+		diagnostics_(std::move(other.diagnostics_)),
+		bodyReordering_(std::move(other.bodyReordering_)),
+		reorderingInterval_(other.reorderingInterval_),
+		numUpdatesSinceReorderingEnabled_(other.numUpdatesSinceReorderingEnabled_),
+		pFrontSnapshot_(std::move(other.pFrontSnapshot_)),
+		pBackSnapshot_(std::move(other.pBackSnapshot_)),
+		pFrameRing_(std::move(other.pFrameRing_)),
+		pAsyncUpdateWorker_(std::move(other.pAsyncUpdateWorker_)) {
+}
+
+BodiesSystem &BodiesSystem::operator=(BodiesSystem &&other) noexcept {
+	if (this == &other) {
+		return *this;
+	}
+	// the pending updates of both systems refer to their members, which are replaced resp. moved away
+	waitForAsyncUpdate();
+	other.waitForAsyncUpdate();
+	bodies_ = other.bodies_;
+	numBodies_ = other.numBodies_;
+	pAccelerationCalculation_ = std::move(other.pAccelerationCalculation_);
+	pPositionVelocityCalculation_ = std::move(other.pPositionVelocityCalculation_);
+	pCollisionHandling_ = std::move(other.pCollisionHandling_);
+	squaredSofteningFactor_ = other.squaredSofteningFactor_;
+	accelerations_ = std::move(other.accelerations_);
+	previousPositions_ = std::move(other.previousPositions_);
+	potentials_ = std::move(other.potentials_);
+	updateContext_ = std::move(other.updateContext_);
+	diagnosticsInterval_ = other.diagnosticsInterval_;
+	numUpdates_ = other.numUpdates_;
+	diagnostics_ = std::move(other.diagnostics_);
+	bodyReordering_ = std::move(other.bodyReordering_);
+	reorderingInterval_ = other.reorderingInterval_;
+	numUpdatesSinceReorderingEnabled_ = other.numUpdatesSinceReorderingEnabled_;
+	pFrontSnapshot_ = std::move(other.pFrontSnapshot_);
+	pBackSnapshot_ = std::move(other.pBackSnapshot_);
+	pFrameRing_ = std::move(other.pFrameRing_);
+	pAsyncUpdateWorker_ = std::move(other.pAsyncUpdateWorker_);
+	return *this;
+}
+
+// the worker is an incomplete type in the header, so the destructor is defined here
+
+BodiesSystem::~BodiesSystem() = default;
+
+void BodiesSystem::setDiagnosticsEnabled(const bool enabled, const size_t interval) {
+	waitForAsyncUpdate();
+	if (enabled && (0 == interval)) {
+		// let it crash
+		throw std::invalid_argument("The interval of the diagnostics must be positive.");
+	}
+	diagnosticsInterval_ = enabled ? interval : 0;
+	numUpdates_ = 0;
+	if (enabled && (nullptr == potentials_) && pAccelerationCalculation_->isPotentialCalculationSupported()) {
+		potentials_ = std::make_unique<float[]>(numBodies_);
+	}
+}
 
+void BodiesSystem::setReorderingEnabled(const bool enabled, const SpaceFillingCurve curve, const size_t interval) {
+	waitForAsyncUpdate();
+	if (enabled && (0 == interval)) {
+		// let it crash
+		throw std::invalid_argument("The interval of the reordering must be positive.");
+	}
+	reorderingInterval_ = enabled ? interval : 0;
+	numUpdatesSinceReorderingEnabled_ = 0;
+	bodyReordering_.setCurve(curve);
 }
 
-BodiesSystem::~BodiesSystem() {
-	delete[] accelerations_;
-	accelerations_ = nullptr;
+void BodiesSystem::setFramePublishingEnabled(const bool enabled, const size_t capacity) {
+	waitForAsyncUpdate();
+	pFrameRing_ = enabled ? std::make_shared<FrameRing>(capacity) : nullptr;
+}
+
+void BodiesSystem::setScratchMemory(const size_t capacityPerThread, const bool useHugePages) {
+	waitForAsyncUpdate();
+	updateContext_ = UpdateContext(omp_get_max_threads(), capacityPerThread, useHugePages);
 }
 
 void BodiesSystem::update(const float timeStep) {
+	waitForAsyncUpdate();
+	step(timeStep);
+}
+
+AsyncUpdate BodiesSystem::updateAsync(const float timeStep) {
+	waitForAsyncUpdate();
+	if (nullptr == pAsyncUpdateWorker_) {
+		pAsyncUpdateWorker_ = std::make_unique<AsyncUpdateWorker>();
+	}
+	// a buffer which is still held by a caller must not be overwritten
+	if ((nullptr == pBackSnapshot_) || (1 < pBackSnapshot_.use_count())) {
+		pBackSnapshot_ = std::make_shared<BodiesSnapshot>();
+	}
+	pBackSnapshot_->capture(bodies_, numBodies_, bodyReordering_);
+	std::swap(pFrontSnapshot_, pBackSnapshot_);
+	return {pAsyncUpdateWorker_.get(), pAsyncUpdateWorker_->submit([this, timeStep]() { step(timeStep); })};
+}
+
+void BodiesSystem::waitForAsyncUpdate() {
+	if (nullptr != pAsyncUpdateWorker_) {
+		pAsyncUpdateWorker_->waitForAll();
+	}
+}
+
+void BodiesSystem::step(const float timeStep) {
+	const bool calcDiagnostics = (0 != diagnosticsInterval_) && (0 == (numUpdates_ % diagnosticsInterval_));
+	++numUpdates_;
+	updateContext_.reset();
+	// 0. restore the locality of the bodies
+	if ((0 != reorderingInterval_) && (0 == (numUpdatesSinceReorderingEnabled_++ % reorderingInterval_))) {
+		bodyReordering_.reorder(bodies_, numBodies_);
+	}
 	// 1. calc accelerations
-	pAccelerationCalculation_->calcAccelerations(
-			bodies_,
-			numBodies_,
-			accelerations_,
-			squaredSofteningFactor_
-	);
+	if (calcDiagnostics && (nullptr != potentials_)) {
+		pAccelerationCalculation_->calcAccelerationsAndPotentials(
+				bodies_,
+				numBodies_,
+				accelerations_.get(),
+				potentials_.get(),
+				squaredSofteningFactor_
+		);
+	} else {
+		pAccelerationCalculation_->calcAccelerationsInContext(
+				bodies_,
+				numBodies_,
+				accelerations_.get(),
+				squaredSofteningFactor_,
+				updateContext_
+		);
+	}
+	if (nullptr != pCollisionHandling_) {
+		std::copy(bodies_.positions, bodies_.positions + (numBodies_ * 3), previousPositions_.get());
+	}
 	// 2. apply accelerations
-	pPositionVelocityCalculation_->updatePositionAndVelocity(
-			bodies_,
-			numBodies_,
-			accelerations_,
-			timeStep
-	);
-}
\ No newline at end of file
+	if (calcDiagnostics) {
+		pPositionVelocityCalculation_->updatePositionAndVelocityWithDiagnostics(
+				bodies_,
+				numBodies_,
+				accelerations_.get(),
+				timeStep,
+				diagnostics_
+		);
+		diagnostics_.potentialEnergy = (nullptr != potentials_)
+									   ? calcTotalPotentialEnergy(potentials_.get(), numBodies_)
+									   : std::numeric_limits<double>::quiet_NaN();
+		diagnostics_.totalEnergy = diagnostics_.kineticEnergy + diagnostics_.potentialEnergy;
+	} else {
+		pPositionVelocityCalculation_->updatePositionAndVelocity(
+				bodies_,
+				numBodies_,
+				accelerations_.get(),
+				timeStep
+		);
+	}
+	// 3. resolve collisions
+	if (nullptr != pCollisionHandling_) {
+		const size_t numRemainingBodies = pCollisionHandling_->handleCollisions(bodies_, numBodies_,
+																				 previousPositions_.get(), timeStep);
+		if (numRemainingBodies < numBodies_) {
+			bodyReordering_.removeBodies(pCollisionHandling_->getRemainingBodyIndices(), numRemainingBodies);
+		}
+		numBodies_ = numRemainingBodies;
+	}
+	// 4. publish the state to the observers, a frame is skipped if they hold all others
+	if (nullptr != pFrameRing_) {
+		pFrameRing_->publish(bodies_, numBodies_, bodyReordering_);
+	}
+}
@@ -0,0 +1,121 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "physics/body_reordering.h"
+#include "radix_sort.h"
+#include "space_filling_curves.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Gathers the elements of the passed array in the order of the sorted indices, using the buffer as
+	 * workspace.
+	 */
+	void permute(
+			float *const values,
+			const size_t numComponents,
+			const std::pair<std::uint64_t, size_t> *const keysAndIndices,
+			const size_t numBodies,
+			float *const buffer
+	) {
+		// @formatter:off
+		#pragma omp parallel for default(none) shared(values, numComponents, keysAndIndices, numBodies, buffer)
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+			const size_t source = keysAndIndices[i].second * numComponents;
+			for (size_t component = 0; component < numComponents; ++component) {
+				buffer[(i * numComponents) + component] = values[source + component];
+			}
+		}
+		std::copy(buffer, buffer + (numBodies * numComponents), values);
+	}
+}
+
+BodyReordering::BodyReordering(const size_t numBodies, const SpaceFillingCurve curve) :
+		curve_(curve),
+		originalIds_(numBodies),
+		indices_(numBodies) {
+	for (size_t i = 0; i < numBodies; ++i) {
+		originalIds_[i] = i;
+		indices_[i] = i;
+	}
+}
+
+void BodyReordering::reorder(const Bodies<float, float, float> &bodies, const size_t numBodies) {
+	if (numBodies != originalIds_.size()) {
+		// let it crash
+		throw std::invalid_argument("The number of bodies differs from the number of bodies of the reordering.");
+	}
+	keysAndIndices_.resize(numBodies);
+	sortBuffer_.resize(numBodies);
+	permutationBuffer_.resize(numBodies * 3);
+	originalIdsBuffer_.resize(numBodies);
+
+	// 1. the bounding cube of all bodies
+	float minX = std::numeric_limits<float>::max(), minY = minX, minZ = minX;
+	float maxX = std::numeric_limits<float>::lowest(), maxY = maxX, maxZ = maxX;
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies) reduction(min:minX, minY, minZ) reduction(max:maxX, maxY, maxZ)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+		const size_t xCoordinateIndex = i * 3;
+		minX = std::min(minX, bodies.positions[xCoordinateIndex]);
+		minY = std::min(minY, bodies.positions[xCoordinateIndex + 1]);
+		minZ = std::min(minZ, bodies.positions[xCoordinateIndex + 2]);
+		maxX = std::max(maxX, bodies.positions[xCoordinateIndex]);
+		maxY = std::max(maxY, bodies.positions[xCoordinateIndex + 1]);
+		maxZ = std::max(maxZ, bodies.positions[xCoordinateIndex + 2]);
+	}
+	const float cubeSize = std::max({maxX - minX, maxY - minY, maxZ - minZ});
+	const float inverseCubeSize = (0.0f < cubeSize) ? (1.0f / cubeSize) : 0.0f;
+
+	// 2. sort the bodies along the curve
+	const bool isHilbertCurve = (SpaceFillingCurve::HILBERT == curve_);
+	std::pair<std::uint64_t, size_t> *const keysAndIndices = keysAndIndices_.data();
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, minX, minY, minZ, inverseCubeSize, isHilbertCurve, keysAndIndices)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+		const size_t xCoordinateIndex = i * 3;
+		const std::uint32_t x = calcGridCoordinate(bodies.positions[xCoordinateIndex], minX, inverseCubeSize);
+		const std::uint32_t y = calcGridCoordinate(bodies.positions[xCoordinateIndex + 1], minY, inverseCubeSize);
+		const std::uint32_t z = calcGridCoordinate(bodies.positions[xCoordinateIndex + 2], minZ, inverseCubeSize);
+		keysAndIndices[i] = {isHilbertCurve ? calcHilbertKey(x, y, z) : calcMortonKey(x, y, z), static_cast<size_t>(i)};
+	}
+	radixSortByKeys(keysAndIndices, sortBuffer_.data(), numBodies, 3 * MORTON_KEY_BITS_PER_AXIS, histograms_);
+
+	// 3. permute the bodies and their original IDs
+	permute(bodies.masses, 1, keysAndIndices, numBodies, permutationBuffer_.data());
+	permute(bodies.positions, 3, keysAndIndices, numBodies, permutationBuffer_.data());
+	permute(bodies.velocities, 3, keysAndIndices, numBodies, permutationBuffer_.data());
+	for (size_t i = 0; i < numBodies; ++i) {
+		originalIdsBuffer_[i] = originalIds_[keysAndIndices[i].second];
+		indices_[originalIdsBuffer_[i]] = i;
+	}
+	std::swap(originalIds_, originalIdsBuffer_);
+}
+
+void BodyReordering::removeBodies(const size_t *const remainingBodyIndices, const size_t numRemainingBodies) {
+	for (const size_t originalId: originalIds_) {
+		indices_[originalId] = NO_INDEX;
+	}
+	// the remaining indices are ascending, so the compaction may be done in place
+	for (size_t i = 0; i < numRemainingBodies; ++i) {
+		originalIds_[i] = originalIds_[remainingBodyIndices[i]];
+		indices_[originalIds_[i]] = i;
+	}
+	originalIds_.resize(numRemainingBodies);
+}
+
+std::optional<size_t> BodyReordering::findBody(const size_t originalId) const {
+	if ((indices_.size() <= originalId) || (NO_INDEX == indices_[originalId])) {
+		return std::nullopt;
+	}
+	return indices_[originalId];
+}
@@ -0,0 +1,213 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "physics/c_api.h"
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/bodies_system.h"
+#include "openmp_euler_position_velocity_calculation.h"
+
+using namespace physics;
+
+static_assert(PHYSICS_ENGINE_SMALL_N == static_cast<int32_t>(AccelerationCalculationImplementation::SMALL_N),
+			  "The implementations of the C API must match the implementations of the acceleration calculation.");
+
+/**
+ * @brief A system of bodies, which owns the bodies integrated in place by the system.
+ */
+struct physics_engine_system {
+
+	/**
+	 * The masses, positions and velocities, whose storage is referenced by the system.
+	 */
+	std::vector<float> masses, positions, velocities;
+
+	/**
+	 * The system of bodies.
+	 */
+	std::unique_ptr<BodiesSystem> pBodiesSystem;
+};
+
+/**
+ * @brief An acceleration calculation.
+ */
+struct physics_engine_acceleration_calculation {
+
+	/**
+	 * The acceleration calculation.
+	 */
+	std::unique_ptr<IAccelerationCalculation> pAccelerationCalculation;
+};
+
+namespace {
+
+	/**
+	 * The message of the last error of each thread.
+	 */
+	thread_local std::string lastErrorMessage;
+
+	/**
+	 * @brief Stores the message of the passed error and returns its status.
+	 */
+	physics_engine_status fail(const physics_engine_status status, const char *const message) {
+		try {
+			lastErrorMessage = message;
+		} catch (...) {
+			// the status suffices if not even the message can be stored
+		}
+		return status;
+	}
+
+	/**
+	 * @brief Translates the current exception into a status, so no exception crosses the C API.
+	 */
+	physics_engine_status failByCurrentException() {
+		try {
+			throw;
+		} catch (const std::invalid_argument &exception) {
+			return fail(PHYSICS_ENGINE_INVALID_ARGUMENT, exception.what());
+		} catch (const std::bad_alloc &) {
+			return fail(PHYSICS_ENGINE_OUT_OF_MEMORY, "Out of memory.");
+		} catch (const std::exception &exception) {
+			return fail(PHYSICS_ENGINE_FAILURE, exception.what());
+		} catch (...) {
+			return fail(PHYSICS_ENGINE_FAILURE, "Unknown error.");
+		}
+	}
+
+	/**
+	 * @brief Converts the passed value into an implementation of the acceleration calculation.
+	 * @throws std::invalid_argument if the value is no implementation of the C API.
+	 */
+	AccelerationCalculationImplementation toImplementation(const int32_t implementation) {
+		if ((implementation < PHYSICS_ENGINE_SEQUENTIAL) || (PHYSICS_ENGINE_SMALL_N < implementation)) {
+			// let it crash
+			throw std::invalid_argument("Unknown implementation of the acceleration calculation.");
+		}
+		return static_cast<AccelerationCalculationImplementation>(implementation);
+	}
+}
+
+uint32_t physics_engine_get_abi_version(void) {
+	return PHYSICS_ENGINE_ABI_VERSION;
+}
+
+const char *physics_engine_get_last_error_message(void) {
+	return lastErrorMessage.c_str();
+}
+
+physics_engine_status physics_engine_system_create(const float *const masses, const float *const positions,
+												   const float *const velocities, const size_t num_bodies,
+												   const int32_t implementation, const float softening_factor,
+												   physics_engine_system **const system) {
+	if ((nullptr == system) || ((0 < num_bodies) &&
+								((nullptr == masses) || (nullptr == positions) || (nullptr == velocities)))) {
+		return fail(PHYSICS_ENGINE_INVALID_ARGUMENT, "The bodies and the system must not be null.");
+	}
+	try {
+		auto pSystem = std::make_unique<physics_engine_system>();
+		pSystem->masses.assign(masses, masses + num_bodies);
+		pSystem->positions.assign(positions, positions + (num_bodies * 3));
+		pSystem->velocities.assign(velocities, velocities + (num_bodies * 3));
+		pSystem->pBodiesSystem = std::make_unique<BodiesSystem>(
+				Bodies<float, float, float>{pSystem->masses.data(), pSystem->positions.data(),
+											pSystem->velocities.data()},
+				num_bodies,
+				std::unique_ptr<IAccelerationCalculation>(
+						createAccelerationCalculation(toImplementation(implementation))),
+				std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(),
+				softening_factor
+		);
+		*system = pSystem.release();
+		return PHYSICS_ENGINE_OK;
+	} catch (...) {
+		return failByCurrentException();
+	}
+}
+
+void physics_engine_system_destroy(physics_engine_system *const system) {
+	delete system;
+}
+
+physics_engine_status physics_engine_system_step(physics_engine_system *const system, const float time_step,
+												 const size_t num_steps) {
+	if (nullptr == system) {
+		return fail(PHYSICS_ENGINE_INVALID_ARGUMENT, "The system must not be null.");
+	}
+	try {
+		for (size_t i = 0; i < num_steps; ++i) {
+			system->pBodiesSystem->update(time_step);
+		}
+		return PHYSICS_ENGINE_OK;
+	} catch (...) {
+		return failByCurrentException();
+	}
+}
+
+size_t physics_engine_system_get_num_bodies(const physics_engine_system *const system) {
+	return (nullptr != system) ? system->pBodiesSystem->getNumBodies() : 0;
+}
+
+physics_engine_status physics_engine_system_read(const physics_engine_system *const system, float *const masses,
+												 float *const positions, float *const velocities) {
+	if (nullptr == system) {
+		return fail(PHYSICS_ENGINE_INVALID_ARGUMENT, "The system must not be null.");
+	}
+	const size_t numBodies = system->pBodiesSystem->getNumBodies();
+	if (nullptr != masses) {
+		std::copy_n(system->masses.data(), numBodies, masses);
+	}
+	if (nullptr != positions) {
+		std::copy_n(system->positions.data(), numBodies * 3, positions);
+	}
+	if (nullptr != velocities) {
+		std::copy_n(system->velocities.data(), numBodies * 3, velocities);
+	}
+	return PHYSICS_ENGINE_OK;
+}
+
+physics_engine_status physics_engine_acceleration_calculation_create(
+		const int32_t implementation, physics_engine_acceleration_calculation **const acceleration_calculation) {
+	if (nullptr == acceleration_calculation) {
+		return fail(PHYSICS_ENGINE_INVALID_ARGUMENT, "The acceleration calculation must not be null.");
+	}
+	try {
+		auto pCalculation = std::make_unique<physics_engine_acceleration_calculation>();
+		pCalculation->pAccelerationCalculation.reset(createAccelerationCalculation(toImplementation(implementation)));
+		*acceleration_calculation = pCalculation.release();
+		return PHYSICS_ENGINE_OK;
+	} catch (...) {
+		return failByCurrentException();
+	}
+}
+
+void physics_engine_acceleration_calculation_destroy(
+		physics_engine_acceleration_calculation *const acceleration_calculation) {
+	delete acceleration_calculation;
+}
+
+physics_engine_status physics_engine_calc_accelerations(
+		physics_engine_acceleration_calculation *const acceleration_calculation, const float *const masses,
+		const float *const positions, const size_t num_bodies, const float squared_softening_factor,
+		float *const accelerations) {
+	if ((nullptr == acceleration_calculation) || ((0 < num_bodies) &&
+												  ((nullptr == masses) || (nullptr == positions) ||
+												   (nullptr == accelerations)))) {
+		return fail(PHYSICS_ENGINE_INVALID_ARGUMENT, "The acceleration calculation and the arrays must not be null.");
+	}
+	try {
+		// the acceleration calculation only reads the masses and positions
+		const Bodies<float, float, float> bodies{const_cast<float *>(masses), const_cast<float *>(positions),
+												 nullptr};
+		acceleration_calculation->pAccelerationCalculation->calcAccelerations(bodies, num_bodies, accelerations,
+																			  squared_softening_factor);
+		return PHYSICS_ENGINE_OK;
+	} catch (...) {
+		return failByCurrentException();
+	}
+}
@@ -0,0 +1,63 @@
+#ifndef PHYSICS_ENGINE_COMPENSATED_SUM_H
+#define PHYSICS_ENGINE_COMPENSATED_SUM_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cmath>
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A sum with the compensation of Kahan and Neumaier, whose error does not grow with the number of summands.
+	 */
+	class CompensatedSum {
+
+		private:
+			/**
+			 * The uncompensated sum.
+			 */
+			double sum_ = 0.0;
+
+			/**
+			 * The accumulated rounding errors of the sum.
+			 */
+			double compensation_ = 0.0;
+
+		public:
+			/**
+			 * @brief Adds the passed value to this sum.
+			 * @param value the value to be added.
+			 */
+			inline void add(const double value) {
+				const double sum = sum_ + value;
+				// the rounding error of the addition is recovered from the larger operand
+				if (std::abs(value) <= std::abs(sum_)) {
+					compensation_ += (sum_ - sum) + value;
+				} else {
+					compensation_ += (value - sum) + sum_;
+				}
+				sum_ = sum;
+			}
+
+			/**
+			 * @brief Adds the passed sum to this sum, e.g. the partial sum of another thread.
+			 * @param other the sum to be added.
+			 */
+			inline void add(const CompensatedSum &other) {
+				add(other.sum_);
+				compensation_ += other.compensation_;
+			}
+
+			/**
+			 * @brief Returns the compensated value of this sum.
+			 * @return the compensated value of this sum.
+			 */
+			[[nodiscard]] inline double getValue() const {
+				return sum_ + compensation_;
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_COMPENSATED_SUM_H
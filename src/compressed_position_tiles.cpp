@@ -0,0 +1,65 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <omp.h>
+
+#include "compressed_position_tiles.h"
+
+using namespace physics;
+
+void CompressedPositionTiles::compress(const Bodies<float, float, float> &bodies, const size_t numBodies) {
+	numBodies_ = numBodies;
+	tileHeaders_.resize(getNumTiles() * NUM_HEADER_FLOATS);
+	packedBodies_.resize(numBodies * 4);
+	const auto numTiles = static_cast<long long>(getNumTiles());
+	float *const tileHeaders = tileHeaders_.data();
+	std::uint16_t *const packedBodies = packedBodies_.data();
+	// omp_get_num_procs seems to return the number of logical (!) cores
+	omp_set_num_threads(static_cast<int>(std::min<size_t>(std::max<size_t>(1, numTiles), omp_get_num_procs())));
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, numTiles, tileHeaders, packedBodies)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long tile = 0; tile < numTiles; ++tile) {
+		const size_t begin = tile * TILE_SIZE;
+		const size_t end = std::min(numBodies, begin + TILE_SIZE);
+
+		// 1. the center and the extent of the tile and its largest mass
+		float min[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+						std::numeric_limits<float>::max()};
+		float max[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+						std::numeric_limits<float>::lowest()};
+		float maxMass = 0.0f;
+		for (size_t i = begin; i < end; ++i) {
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				min[dimension] = std::min(min[dimension], bodies.positions[(i * 3) + dimension]);
+				max[dimension] = std::max(max[dimension], bodies.positions[(i * 3) + dimension]);
+			}
+			maxMass = std::max(maxMass, std::abs(bodies.masses[i]));
+		}
+		// maps the largest mass exactly to 2^15 below the largest half of 65504, so equal masses stay exact and small
+		// masses are normal halves instead of subnormal ones
+		const float massScale = std::ldexp(maxMass, -15);
+		float *const header = tileHeaders + (tile * NUM_HEADER_FLOATS);
+		float positionScale = 0.0f;
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			header[dimension] = 0.5f * (min[dimension] + max[dimension]);
+			positionScale = std::max(positionScale, 0.5f * (max[dimension] - min[dimension]));
+		}
+		header[3] = positionScale;
+		header[4] = massScale;
+		std::fill(header + 5, header + NUM_HEADER_FLOATS, 0.0f);
+
+		// 2. the bodies relative to the tile, all in [-1, 1]
+		const float inversePositionScale = (0.0f < positionScale) ? (1.0f / positionScale) : 0.0f;
+		const float inverseMassScale = (0.0f < massScale) ? (1.0f / massScale) : 0.0f;
+		for (size_t i = begin; i < end; ++i) {
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				const float offset = bodies.positions[(i * 3) + dimension] - header[dimension];
+				packedBodies[(i * 4) + dimension] = convertFloatToHalf(offset * inversePositionScale);
+			}
+			packedBodies[(i * 4) + 3] = convertFloatToHalf(bodies.masses[i] * inverseMassScale);
+		}
+	}
+}
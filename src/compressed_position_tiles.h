@@ -0,0 +1,145 @@
+#ifndef PHYSICS_ENGINE_COMPRESSED_POSITION_TILES_H
+#define PHYSICS_ENGINE_COMPRESSED_POSITION_TILES_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "physics/bodies.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief Converts the passed float into an IEEE 754 half-precision float, rounded to nearest even.
+	 * @param value the float to be converted, whose magnitude should not exceed the range of a half.
+	 * @return the bits of the half.
+	 */
+	inline std::uint16_t convertFloatToHalf(const float value) {
+		const auto bits = std::bit_cast<std::uint32_t>(value);
+		const std::uint32_t sign = (bits >> 16) & 0x8000;
+		const std::uint32_t magnitude = bits & 0x7fffffff;
+		if (0x47800000 <= magnitude) {
+			// too large for a half, or not a number
+			return static_cast<std::uint16_t>(sign | ((0x7f800000 < magnitude) ? 0x7e00 : 0x7c00));
+		}
+		if (magnitude < 0x38800000) {
+			// a subnormal half, which the addition of 0.5 rounds to a multiple of 2^-24 in the lower bits
+			const float shifted = std::bit_cast<float>(magnitude) + 0.5f;
+			return static_cast<std::uint16_t>(sign | (std::bit_cast<std::uint32_t>(shifted) - 0x3f000000));
+		}
+		// a normal half, whose exponent is rebiased from 127 to 15
+		const std::uint32_t isMantissaOdd = (magnitude >> 13) & 1;
+		return static_cast<std::uint16_t>(sign | ((magnitude - 0x38000000 + 0xfff + isMantissaOdd) >> 13));
+	}
+
+	/**
+	 * @brief Converts the passed finite IEEE 754 half-precision float into a float without branches.
+	 * @param half the bits of the half.
+	 * @return the float.
+	 */
+	inline float convertHalfToFloat(const std::uint16_t half) {
+		// the multiplication rebiases the exponent from 15 to 127 and normalizes subnormal halves
+		const float magnitude = std::bit_cast<float>(static_cast<std::uint32_t>(half & 0x7fff) << 13) * 0x1p112f;
+		return std::bit_cast<float>(
+				std::bit_cast<std::uint32_t>(magnitude) | (static_cast<std::uint32_t>(half & 0x8000) << 16));
+	}
+
+	/**
+	 * @brief The bodies packed into tiles of half-precision positions and masses, to halve the memory traffic of the
+	 * source bodies of pairwise loops.
+	 * @details Each tile has a header of eight floats: the origin of its positions, the scale of its positions, the
+	 * scale of its masses and three floats of padding. Each body has four halves: its position relative to the origin
+	 * and its mass, both divided by the scales of its tile. The positions are in <code>[-1, 1]</code>, while the
+	 * largest mass is exactly <code>2^15</code>, so the masses use the whole exponent range of a half and keep its full
+	 * precision down to <code>2^-29</code> of the largest mass, e.g. the planets next to the sun. That are 8
+	 * instead of 16 bytes per body.
+	 */
+	class CompressedPositionTiles {
+
+		private:
+			/**
+			 * The headers of the tiles.
+			 */
+			std::vector<float> tileHeaders_;
+
+			/**
+			 * The four halves of each body.
+			 */
+			std::vector<std::uint16_t> packedBodies_;
+
+			/**
+			 * The number of bodies.
+			 */
+			size_t numBodies_ = 0;
+
+		public:
+			/**
+			 * The number of bodies of a tile, whose decompressed bodies fit into 4 KiB.
+			 */
+			static constexpr size_t TILE_SIZE = 256;
+
+			/**
+			 * The number of floats of a tile header.
+			 */
+			static constexpr size_t NUM_HEADER_FLOATS = 8;
+
+			/**
+			 * @brief Packs the passed bodies into the tiles.
+			 * @param bodies the bodies to be packed.
+			 * @param numBodies the number of bodies.
+			 */
+			void compress(const Bodies<float, float, float> &bodies, size_t numBodies);
+
+			/**
+			 * @brief Unpacks a tile into absolute positions and masses.
+			 * @param tile the index of the tile.
+			 * @param[out] decompressed the x, y, z coordinates and the mass of each body of the tile, i.e. up to
+			 * <code>4 * TILE_SIZE</code> floats.
+			 * @return the number of bodies of the tile.
+			 */
+			inline size_t decompressTile(const size_t tile, float *const decompressed) const {
+				const float *const header = tileHeaders_.data() + (tile * NUM_HEADER_FLOATS);
+				const size_t begin = tile * TILE_SIZE;
+				const size_t numTileBodies = ((begin + TILE_SIZE) < numBodies_) ? TILE_SIZE : (numBodies_ - begin);
+				const std::uint16_t *const packedBodies = packedBodies_.data() + (begin * 4);
+				for (size_t i = 0; i < numTileBodies; ++i) {
+					decompressed[i * 4] = header[0] + (header[3] * convertHalfToFloat(packedBodies[i * 4]));
+					decompressed[(i * 4) + 1] = header[1] + (header[3] * convertHalfToFloat(packedBodies[(i * 4) + 1]));
+					decompressed[(i * 4) + 2] = header[2] + (header[3] * convertHalfToFloat(packedBodies[(i * 4) + 2]));
+					decompressed[(i * 4) + 3] = header[4] * convertHalfToFloat(packedBodies[(i * 4) + 3]);
+				}
+				return numTileBodies;
+			}
+
+			/**
+			 * @brief Returns the number of tiles.
+			 * @return the number of tiles.
+			 */
+			[[nodiscard]] inline size_t getNumTiles() const {
+				return (numBodies_ + TILE_SIZE - 1) / TILE_SIZE;
+			}
+
+			/**
+			 * @brief Returns the headers of the tiles.
+			 * @return <code>NUM_HEADER_FLOATS</code> floats per tile.
+			 */
+			[[nodiscard]] inline const float *getTileHeaders() const {
+				return tileHeaders_.data();
+			}
+
+			/**
+			 * @brief Returns the packed bodies.
+			 * @return four halves per body.
+			 */
+			[[nodiscard]] inline const std::uint16_t *getPackedBodies() const {
+				return packedBodies_.data();
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_COMPRESSED_POSITION_TILES_H
@@ -0,0 +1,53 @@
+#include "physics/diagnostics.h"
+#include "motion_diagnostics_accumulator.h"
+
+using namespace physics;
+
+void physics::calcMotionDiagnostics(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		Diagnostics &diagnostics
+) {
+	MotionDiagnosticsAccumulator accumulator;
+	// @formatter:off
+	#pragma omp parallel default(none) shared(bodies, numBodies, accumulator)
+	// @formatter:on
+	{
+		MotionDiagnosticsAccumulator threadAccumulator;
+		// @formatter:off
+		#pragma omp for nowait
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+			threadAccumulator.addBody(bodies.masses[i], &bodies.positions[i * 3], &bodies.velocities[i * 3]);
+		}
+		// @formatter:off
+		#pragma omp critical
+		// @formatter:on
+		accumulator.add(threadAccumulator);
+	}
+	accumulator.store(diagnostics);
+}
+
+double physics::calcTotalPotentialEnergy(const float *const potentials, const size_t numBodies) {
+	CompensatedSum sum;
+	// @formatter:off
+	#pragma omp parallel default(none) shared(potentials, numBodies, sum)
+	// @formatter:on
+	{
+		CompensatedSum threadSum;
+		// @formatter:off
+		#pragma omp for nowait
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+			threadSum.add(potentials[i]);
+		}
+		// @formatter:off
+		#pragma omp critical
+		// @formatter:on
+		sum.add(threadSum);
+	}
+	// each pair is contained in the potentials of both of its bodies
+	return 0.5 * sum.getValue();
+}
@@ -0,0 +1,312 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <omp.h>
+
+#include "ewald_acceleration_calculation.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The splitting parameter of the Ewald summation in units of the inverse edge length of the box.
+	 */
+	constexpr double EWALD_SPLITTING = 2.0;
+
+	/**
+	 * The maximum index of the images of the real-space sum per axis.
+	 */
+	constexpr int MAX_REAL_SPACE_IMAGE = 3;
+
+	/**
+	 * The squared cutoff radius of the real-space sum in box lengths, beyond which <code>erfc</code> vanishes in
+	 * single precision.
+	 */
+	constexpr double SQUARED_REAL_SPACE_CUTOFF = 2.6 * 2.6;
+
+	/**
+	 * The maximum index of the wave vectors of the reciprocal-space sum per axis.
+	 */
+	constexpr int MAX_WAVE_VECTOR = 3;
+
+	/**
+	 * The squared cutoff of the wave vectors of the reciprocal-space sum in inverse box lengths, beyond which the
+	 * Gaussian factor vanishes in single precision.
+	 */
+	constexpr int SQUARED_WAVE_VECTOR_CUTOFF = 10;
+
+	/**
+	 * @brief Calculates the Ewald correction of a unit mass in a unit box, i.e. the field and the potential of all
+	 * of its images and the background minus the field and the potential of the unit mass itself.
+	 * @param position the distance vector from the unit mass.
+	 * @param[out] correction the x, y and z component of the correction of the field, which points towards the unit
+	 * 					mass like <code>position / |position|^3</code>, and the correction of the potential
+	 * 					<code>1 / |position|</code>.
+	 */
+	void calcEwaldCorrection(const double *const position, double *const correction) {
+		constexpr double alpha = EWALD_SPLITTING;
+		double field[3] = {0.0, 0.0, 0.0};
+		double potential = 0.0;
+
+		// the real-space sum over the images, whose unscreened part is removed again below
+		for (int nx = -MAX_REAL_SPACE_IMAGE; nx <= MAX_REAL_SPACE_IMAGE; ++nx) {
+			for (int ny = -MAX_REAL_SPACE_IMAGE; ny <= MAX_REAL_SPACE_IMAGE; ++ny) {
+				for (int nz = -MAX_REAL_SPACE_IMAGE; nz <= MAX_REAL_SPACE_IMAGE; ++nz) {
+					const double distanceVector[3] = {position[0] - nx, position[1] - ny, position[2] - nz};
+					const double distanceSquared = (distanceVector[0] * distanceVector[0]) +
+												   (distanceVector[1] * distanceVector[1]) +
+												   (distanceVector[2] * distanceVector[2]);
+					if ((0.0 < distanceSquared) && (distanceSquared <= SQUARED_REAL_SPACE_CUTOFF)) {
+						const double distance = std::sqrt(distanceSquared);
+						const double screening = std::erfc(alpha * distance);
+						const double gaussian = (2.0 * alpha * distance / std::sqrt(std::numbers::pi)) *
+												std::exp(-alpha * alpha * distanceSquared);
+						const double fieldFactor = (screening + gaussian) / (distanceSquared * distance);
+						for (size_t dimension = 0; dimension < 3; ++dimension) {
+							field[dimension] += fieldFactor * distanceVector[dimension];
+						}
+						potential += screening / distance;
+					}
+				}
+			}
+		}
+
+		// the reciprocal-space sum over the wave vectors
+		for (int hx = -MAX_WAVE_VECTOR; hx <= MAX_WAVE_VECTOR; ++hx) {
+			for (int hy = -MAX_WAVE_VECTOR; hy <= MAX_WAVE_VECTOR; ++hy) {
+				for (int hz = -MAX_WAVE_VECTOR; hz <= MAX_WAVE_VECTOR; ++hz) {
+					const int squaredWaveVector = (hx * hx) + (hy * hy) + (hz * hz);
+					if ((0 < squaredWaveVector) && (squaredWaveVector <= SQUARED_WAVE_VECTOR_CUTOFF)) {
+						const double gaussian = std::exp(-std::numbers::pi * std::numbers::pi * squaredWaveVector /
+														 (alpha * alpha)) / squaredWaveVector;
+						const double phase = 2.0 * std::numbers::pi *
+											 ((hx * position[0]) + (hy * position[1]) + (hz * position[2]));
+						const double fieldFactor = 2.0 * gaussian * std::sin(phase);
+						field[0] += fieldFactor * hx;
+						field[1] += fieldFactor * hy;
+						field[2] += fieldFactor * hz;
+						potential += gaussian * std::cos(phase) / std::numbers::pi;
+					}
+				}
+			}
+		}
+
+		// the uniform background, which neutralizes the unit mass
+		potential -= std::numbers::pi / (alpha * alpha);
+
+		// the unit mass itself is paired with the nearest image by the force law
+		const double distanceSquared = (position[0] * position[0]) + (position[1] * position[1]) +
+									   (position[2] * position[2]);
+		if (0.0 < distanceSquared) {
+			const double distance = std::sqrt(distanceSquared);
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				field[dimension] -= position[dimension] / (distanceSquared * distance);
+			}
+			potential -= 1.0 / distance;
+		} else {
+			// the limit of (erfc(alpha * r) - 1) / r, the field vanishes by symmetry
+			potential -= 2.0 * alpha / std::sqrt(std::numbers::pi);
+		}
+
+		correction[0] = field[0];
+		correction[1] = field[1];
+		correction[2] = field[2];
+		correction[3] = potential;
+	}
+
+	/**
+	 * @brief Interpolates the tabulated Ewald correction trilinearly.
+	 * @details The table covers the first octant, the other octants follow by the symmetry of the box: each
+	 * component of the field is odd in its own coordinate and even in the others, the potential is even.
+	 * @param correctionTable the table of the Ewald correction.
+	 * @param tableSize the number of intervals per axis of the table.
+	 * @param tableScale the number of intervals per unit of length.
+	 * @param distanceVector the distance vector of the nearest images.
+	 * @param[out] correction the correction of the field and of the potential, for a unit box.
+	 */
+	inline void interpolateCorrection(const float *const correctionTable, const size_t tableSize,
+									  const float tableScale, const float *const distanceVector,
+									  float *const correction) {
+		const size_t numGridPoints = tableSize + 1;
+		size_t indices[3];
+		float fractions[3];
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const float gridCoordinate = std::min(std::abs(distanceVector[dimension]) * tableScale,
+												  static_cast<float>(tableSize));
+			indices[dimension] = std::min(static_cast<size_t>(gridCoordinate), tableSize - 1);
+			fractions[dimension] = gridCoordinate - static_cast<float>(indices[dimension]);
+		}
+
+		correction[0] = correction[1] = correction[2] = correction[3] = 0.0f;
+		for (size_t corner = 0; corner < 8; ++corner) {
+			const size_t offsetX = corner >> 2, offsetY = (corner >> 1) & 1, offsetZ = corner & 1;
+			const float weight = (offsetX ? fractions[0] : (1.0f - fractions[0])) *
+								 (offsetY ? fractions[1] : (1.0f - fractions[1])) *
+								 (offsetZ ? fractions[2] : (1.0f - fractions[2]));
+			const float *const gridPoint = correctionTable + (4 * (((((indices[0] + offsetX) * numGridPoints) +
+																	   indices[1] + offsetY) * numGridPoints) +
+																	 indices[2] + offsetZ));
+			correction[0] += weight * gridPoint[0];
+			correction[1] += weight * gridPoint[1];
+			correction[2] += weight * gridPoint[2];
+			correction[3] += weight * gridPoint[3];
+		}
+
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			if (distanceVector[dimension] < 0.0f) {
+				correction[dimension] = -correction[dimension];
+			}
+		}
+	}
+}
+
+template<typename TForceLaw>
+BasicEwaldAccelerationCalculationImpl<TForceLaw>::BasicEwaldAccelerationCalculationImpl(
+		const TForceLaw &forceLaw,
+		const PeriodicBox &periodicBox,
+		const size_t tableSize
+) : forceLaw_(forceLaw),
+	periodicBox_(periodicBox),
+	tableSize_(tableSize),
+	selfPotential_(0.0f) {
+	if (!(0.0f < periodicBox.edgeLength) || (0 == tableSize)) {
+		// let it crash
+		throw std::invalid_argument("The periodic box must have a positive edge length and a table size.");
+	}
+
+	const size_t numGridPoints = tableSize + 1;
+	const size_t numTableEntries = numGridPoints * numGridPoints * numGridPoints;
+	correctionTable_.resize(4 * numTableEntries);
+	// data members cannot be listed in the data-sharing clauses, hence the local copy
+	float *const correctionTable = correctionTable_.data();
+	// omp_get_num_procs seems to return the number of logical (!) cores
+	omp_set_num_threads(omp_get_num_procs());
+	// @formatter:off
+	#pragma omp parallel for schedule(dynamic, 64) default(none) shared(numGridPoints, numTableEntries, tableSize, correctionTable)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long entry = 0; entry < static_cast<long long>(numTableEntries); ++entry) {
+		const size_t gridPoint[3] = {
+				entry / (numGridPoints * numGridPoints), (entry / numGridPoints) % numGridPoints, entry % numGridPoints
+		};
+		const double position[3] = {
+				0.5 * static_cast<double>(gridPoint[0]) / static_cast<double>(tableSize),
+				0.5 * static_cast<double>(gridPoint[1]) / static_cast<double>(tableSize),
+				0.5 * static_cast<double>(gridPoint[2]) / static_cast<double>(tableSize)
+		};
+		double correction[4];
+		calcEwaldCorrection(position, correction);
+		for (size_t component = 0; component < 4; ++component) {
+			correctionTable[(entry * 4) + component] = static_cast<float>(correction[component]);
+		}
+	}
+	selfPotential_ = correctionTable_[3];
+}
+
+template<typename TForceLaw>
+template<bool CalcPotentials>
+void BasicEwaldAccelerationCalculationImpl<TForceLaw>::sweep(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	// data members cannot be listed in the data-sharing clauses, hence the local copies
+	const TForceLaw forceLaw = forceLaw_;
+	const PeriodicBox periodicBox = periodicBox_;
+	const float *const correctionTable = correctionTable_.data();
+	const size_t tableSize = tableSize_;
+	const float selfPotential = selfPotential_;
+	// the correction of the unit box is scaled to the box: the field by 1 / L^2, the potential by 1 / L
+	const float inverseEdgeLength = 1.0f / periodicBox.edgeLength;
+	const float fieldScale = inverseEdgeLength * inverseEdgeLength;
+	const float tableScale = 2.0f * static_cast<float>(tableSize) * inverseEdgeLength;
+	// omp_get_num_procs seems to return the number of logical (!) cores
+	omp_set_num_threads(static_cast<int>(std::min<size_t>(std::max<size_t>(1, numBodies), omp_get_num_procs())));
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, accelerations, potentials, squaredSofteningFactor, forceLaw, periodicBox, correctionTable, tableSize, selfPotential, inverseEdgeLength, fieldScale, tableScale)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+		const float targetPosition[3] = {
+				bodies.positions[i * 3], bodies.positions[(i * 3) + 1], bodies.positions[(i * 3) + 2]
+		};
+		const float targetMass = bodies.masses[i];
+		float forceVector[3] = {0.0f, 0.0f, 0.0f};
+		float potential = 0.0f;
+		for (size_t j = 0; j < numBodies; ++j) {
+			if (static_cast<size_t>(i) != j) {
+				// the distance vector points from the target to the nearest image of the source
+				const float distanceVector[3] = {
+						periodicBox.applyMinimumImage(bodies.positions[j * 3] - targetPosition[0]),
+						periodicBox.applyMinimumImage(bodies.positions[(j * 3) + 1] - targetPosition[1]),
+						periodicBox.applyMinimumImage(bodies.positions[(j * 3) + 2] - targetPosition[2])
+				};
+				const float distanceSquared = (distanceVector[0] * distanceVector[0]) +
+											  (distanceVector[1] * distanceVector[1]) +
+											  (distanceVector[2] * distanceVector[2]);
+				const float sourceMass = bodies.masses[j];
+				float correction[4];
+				interpolateCorrection(correctionTable, tableSize, tableScale, distanceVector, correction);
+
+				const float receivedForce = forceLaw(distanceSquared, squaredSofteningFactor, targetMass, sourceMass);
+				// the distance factor of the force laws is 1 / r^3 beyond the softening, so the correction is
+				// weighted by the strength factor only
+				const float correctionStrength = forceLaw.calcStrengthFactor(targetMass, sourceMass) * fieldScale;
+				forceVector[0] += (receivedForce * distanceVector[0]) + (correctionStrength * correction[0]);
+				forceVector[1] += (receivedForce * distanceVector[1]) + (correctionStrength * correction[1]);
+				forceVector[2] += (receivedForce * distanceVector[2]) + (correctionStrength * correction[2]);
+				if constexpr (CalcPotentials) {
+					// the potential energy at the unit distance without softening is the strength of the 1 / r
+					// potential
+					potential += forceLaw.calcPotentialEnergy(distanceSquared, squaredSofteningFactor, targetMass,
+															  sourceMass) +
+								 (forceLaw.calcPotentialEnergy(1.0f, 0.0f, targetMass, sourceMass) *
+								  inverseEdgeLength * correction[3]);
+				}
+			}
+		}
+		accelerations[i * 3] = forceVector[0];
+		accelerations[(i * 3) + 1] = forceVector[1];
+		accelerations[(i * 3) + 2] = forceVector[2];
+		if constexpr (CalcPotentials) {
+			// the energy with the own images, of which the total potential energy contains one half per body
+			potential += forceLaw.calcPotentialEnergy(1.0f, 0.0f, targetMass, targetMass) * inverseEdgeLength *
+						 selfPotential;
+			potentials[i] = potential;
+		}
+	}
+}
+
+template<typename TForceLaw>
+void BasicEwaldAccelerationCalculationImpl<TForceLaw>::calcAccelerations(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		const float squaredSofteningFactor
+) {
+	sweep<false>(bodies, numBodies, accelerations, nullptr, squaredSofteningFactor);
+}
+
+template<typename TForceLaw>
+bool BasicEwaldAccelerationCalculationImpl<TForceLaw>::isPotentialCalculationSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicEwaldAccelerationCalculationImpl<TForceLaw>::calcAccelerationsAndPotentials(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	sweep<true>(bodies, numBodies, accelerations, potentials, squaredSofteningFactor);
+}
+
+template class physics::BasicEwaldAccelerationCalculationImpl<physics::NewtonianForceLaw>;
+template class physics::BasicEwaldAccelerationCalculationImpl<physics::SplineSoftenedNewtonianForceLaw>;
+template class physics::BasicEwaldAccelerationCalculationImpl<physics::CoulombForceLaw>;
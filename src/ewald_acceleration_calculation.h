@@ -0,0 +1,159 @@
+#ifndef PHYSICS_ENGINE_EWALD_ACCELERATION_CALCULATION_H
+#define PHYSICS_ENGINE_EWALD_ACCELERATION_CALCULATION_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "physics/acceleration_calculation.h"
+#include "physics/force_laws.h"
+#include "physics/periodic_box.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * Whether the passed force law can be summed over the periodic images by the Ewald method, i.e. whether it
+	 * decays like <code>1 / r</code>. The screened and the short-range force laws only need the nearest image.
+	 */
+	template<typename TForceLaw>
+	inline constexpr bool IS_EWALD_SUMMABLE = std::is_same_v<TForceLaw, NewtonianForceLaw> ||
+											  std::is_same_v<TForceLaw, SplineSoftenedNewtonianForceLaw> ||
+											  std::is_same_v<TForceLaw, CoulombForceLaw>;
+
+	/**
+	 * @brief An <strong>Ewald summation</strong> implementation of the calculation of accelerations of N bodies in a
+	 * periodic box.
+	 * @details Each body interacts with all periodic images of all other bodies and with its own images. As in the
+	 * method of Hernquist, Bouchet and Suto, the pair term is split into the force law between the nearest images,
+	 * which keeps the softening, and the Ewald correction, i.e. the sum over all other images minus a uniform
+	 * background, which neutralizes the mean mass (resp. charge) density. The correction is a smooth function of the
+	 * distance vector, which the constructor sums up once in real and reciprocal space for the first octant of a
+	 * unit box in parallel. Its table is interpolated trilinearly per pair, so a pair costs little more than a pair of
+	 * the OpenMP implementation. The positions of the bodies need not be wrapped into the box. The template is
+	 * explicitly instantiated for the force laws of <code>IS_EWALD_SUMMABLE</code> in its translation unit.
+	 * @tparam TForceLaw the force law between two bodies, which is inlined into the inner loop.
+	 */
+	template<typename TForceLaw>
+	class BasicEwaldAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		private:
+			/**
+			 * The force law between two bodies.
+			 */
+			TForceLaw forceLaw_;
+
+			/**
+			 * The periodic box.
+			 */
+			PeriodicBox periodicBox_;
+
+			/**
+			 * The number of intervals per axis of the table of the Ewald correction.
+			 */
+			size_t tableSize_;
+
+			/**
+			 * The Ewald correction of the field and of the potential of a unit mass in a unit box at the grid points
+			 * of the first octant <code>[0, 1/2]^3</code>, four elements per grid point and the grid points in
+			 * row-major order.
+			 */
+			std::vector<float> correctionTable_;
+
+			/**
+			 * The potential of a unit mass in a unit box with its own images and the background, i.e. the correction
+			 * of the potential at the distance zero.
+			 */
+			float selfPotential_;
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potentials of the given bodies in one sweep.
+			 * @tparam CalcPotentials <code>true</code> to calculate the potentials in the same sweep.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies.
+			 * @param[out] potentials the potential energies of the passed bodies, only used if
+			 * 					<code>CalcPotentials</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			template<bool CalcPotentials>
+			void sweep(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			);
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Creates a new instance of this class by the parameters and
+			 * tabulates the Ewald correction.
+			 * @param forceLaw the force law between two bodies.
+			 * @param periodicBox the periodic box.
+			 * @param tableSize the number of intervals per axis of the table of the Ewald correction, which covers
+			 * 					half of the box.
+			 * @throws std::invalid_argument if the edge length of the box is not positive or the table size is zero.
+			 */
+			BasicEwaldAccelerationCalculationImpl(const TForceLaw &forceLaw, const PeriodicBox &periodicBox,
+												  size_t tableSize = 32);
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies. The <code>accelerations</code>
+			 * 					parameter must be a pointer to an allocated storage which is large enough to store
+			 * 					<code>numBodies * vector dimension</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerations(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the potentials are calculated as a byproduct.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isPotentialCalculationSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations and the potential energies of the given bodies in the same sweep.
+			 * @details The potential energy of a body includes the energy with its own images, so the total potential
+			 * energy of a single body is not zero.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies.
+			 * @param[out] potentials the potential energy of each body with all other bodies and all images.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerationsAndPotentials(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns the periodic box.
+			 * @return the periodic box.
+			 */
+			[[nodiscard]] inline const PeriodicBox &getPeriodicBox() const {
+				return periodicBox_;
+			}
+	};
+
+	/**
+	 * @brief The Ewald summation implementation of the calculation of gravitational accelerations in a periodic box.
+	 */
+	using EwaldAccelerationCalculationImpl = BasicEwaldAccelerationCalculationImpl<NewtonianForceLaw>;
+}
+
+#endif //PHYSICS_ENGINE_EWALD_ACCELERATION_CALCULATION_H
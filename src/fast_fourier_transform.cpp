@@ -0,0 +1,114 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+#include <omp.h>
+
+#include "fast_fourier_transform.h"
+
+using namespace physics;
+
+FastFourierTransform3d::FastFourierTransform3d(const size_t meshSize) :
+		meshSize_(meshSize),
+		twiddleFactors_(meshSize / 2),
+		bitReversedIndices_(meshSize),
+		lineBuffers_(static_cast<size_t>(omp_get_max_threads()) * meshSize) {
+	if ((meshSize < 2) || (0 != (meshSize & (meshSize - 1)))) {
+		// let it crash
+		throw std::invalid_argument("The mesh size of the fast Fourier transform must be a power of two.");
+	}
+
+	for (size_t k = 0; k < (meshSize / 2); ++k) {
+		const double angle = -2.0 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(meshSize);
+		twiddleFactors_[k] = {std::cos(angle), std::sin(angle)};
+	}
+
+	size_t numBits = 0;
+	while ((static_cast<size_t>(1) << numBits) < meshSize) {
+		++numBits;
+	}
+	for (size_t i = 0; i < meshSize; ++i) {
+		size_t reversed = 0;
+		for (size_t bit = 0; bit < numBits; ++bit) {
+			if (i & (static_cast<size_t>(1) << bit)) {
+				reversed |= static_cast<size_t>(1) << (numBits - 1 - bit);
+			}
+		}
+		bitReversedIndices_[i] = reversed;
+	}
+}
+
+void FastFourierTransform3d::transformLine(std::complex<double> *const line, const bool inverse) const {
+	for (size_t i = 0; i < meshSize_; ++i) {
+		if (i < bitReversedIndices_[i]) {
+			std::swap(line[i], line[bitReversedIndices_[i]]);
+		}
+	}
+	// iterative Cooley-Tukey butterflies
+	for (size_t length = 2; length <= meshSize_; length <<= 1) {
+		const size_t halfLength = length / 2;
+		const size_t twiddleStride = meshSize_ / length;
+		for (size_t begin = 0; begin < meshSize_; begin += length) {
+			for (size_t k = 0; k < halfLength; ++k) {
+				const std::complex<double> &twiddleFactor = twiddleFactors_[k * twiddleStride];
+				const std::complex<double> rotated = line[begin + k + halfLength] *
+													(inverse ? std::conj(twiddleFactor) : twiddleFactor);
+				line[begin + k + halfLength] = line[begin + k] - rotated;
+				line[begin + k] += rotated;
+			}
+		}
+	}
+}
+
+void FastFourierTransform3d::transformAxis(std::complex<double> *const mesh, const size_t stride,
+										   const bool inverse) const {
+	const size_t n = meshSize_;
+	const int numThreads = static_cast<int>(lineBuffers_.size() / n);
+	std::complex<double> *const lineBuffers = lineBuffers_.data();
+	// @formatter:off
+	#pragma omp parallel num_threads(numThreads) default(none) shared(mesh, stride, inverse, n, lineBuffers)
+	// @formatter:on
+	{
+		std::complex<double> *const line = &lineBuffers[static_cast<size_t>(omp_get_thread_num()) * n];
+		// @formatter:off
+		#pragma omp for
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long lineIndex = 0; lineIndex < static_cast<long long>(n * n); ++lineIndex) {
+			// the first element of the line: the two coordinates orthogonal to the transformed axis
+			const size_t outer = static_cast<size_t>(lineIndex) / n;
+			const size_t inner = static_cast<size_t>(lineIndex) % n;
+			const size_t first = (stride == 1) ? (lineIndex * n)
+												: ((stride == n) ? ((outer * n * n) + inner) : ((outer * n) + inner));
+			for (size_t k = 0; k < n; ++k) {
+				line[k] = mesh[first + (k * stride)];
+			}
+			transformLine(line, inverse);
+			for (size_t k = 0; k < n; ++k) {
+				mesh[first + (k * stride)] = line[k];
+			}
+		}
+	}
+}
+
+void FastFourierTransform3d::forward(std::complex<double> *const mesh) const {
+	transformAxis(mesh, 1, false);
+	transformAxis(mesh, meshSize_, false);
+	transformAxis(mesh, meshSize_ * meshSize_, false);
+}
+
+void FastFourierTransform3d::inverse(std::complex<double> *const mesh) const {
+	transformAxis(mesh, 1, true);
+	transformAxis(mesh, meshSize_, true);
+	transformAxis(mesh, meshSize_ * meshSize_, true);
+
+	const size_t numElements = meshSize_ * meshSize_ * meshSize_;
+	const double normalization = 1.0 / static_cast<double>(numElements);
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(mesh, numElements, normalization)
+	// @formatter:on
+	for (long long i = 0; i < static_cast<long long>(numElements); ++i) {
+		mesh[i] *= normalization;
+	}
+}
@@ -0,0 +1,89 @@
+#ifndef PHYSICS_ENGINE_FAST_FOURIER_TRANSFORM_H
+#define PHYSICS_ENGINE_FAST_FOURIER_TRANSFORM_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief An in-place radix-2 fast Fourier transform of a cubic three-dimensional mesh.
+	 * @details The mesh is stored in row-major order, i.e. the index of the element <code>(x, y, z)</code> is
+	 * <code>(x * n + y) * n + z</code>. The lines of each axis are transformed in parallel by OpenMP, at most by as
+	 * many threads as were available at the construction. A transform must not be run concurrently to another one.
+	 */
+	class FastFourierTransform3d {
+
+		private:
+			/**
+			 * The number of mesh points per axis, a power of two.
+			 */
+			size_t meshSize_;
+
+			/**
+			 * The twiddle factors <code>exp(-2 * pi * i * k / n)</code> for <code>k</code> in <code>[0, n / 2)</code>.
+			 */
+			std::vector<std::complex<double>> twiddleFactors_;
+
+			/**
+			 * The bit reversed index of each index in <code>[0, n)</code>.
+			 */
+			std::vector<size_t> bitReversedIndices_;
+
+			/**
+			 * The line buffers of the threads, <code>n</code> elements per thread, so a transform does not allocate.
+			 */
+			mutable std::vector<std::complex<double>> lineBuffers_;
+
+			/**
+			 * @brief Transforms the passed contiguous line of <code>n</code> elements in place.
+			 * @param line the line to be transformed.
+			 * @param inverse <code>true</code> for the inverse transform (without normalization).
+			 */
+			void transformLine(std::complex<double> *line, bool inverse) const;
+
+			/**
+			 * @brief Transforms all lines of the mesh along one axis.
+			 * @param mesh the mesh to be transformed.
+			 * @param stride the distance between two consecutive elements of a line.
+			 * @param inverse <code>true</code> for the inverse transform (without normalization).
+			 */
+			void transformAxis(std::complex<double> *mesh, size_t stride, bool inverse) const;
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Precomputes the twiddle factors for the passed mesh size.
+			 * @param meshSize the number of mesh points per axis, must be a power of two.
+			 * @throws std::invalid_argument if the mesh size is not a power of two.
+			 */
+			explicit FastFourierTransform3d(size_t meshSize);
+
+			/**
+			 * @brief Returns the number of mesh points per axis.
+			 * @return the number of mesh points per axis.
+			 */
+			[[nodiscard]] inline size_t getMeshSize() const {
+				return meshSize_;
+			}
+
+			/**
+			 * @brief Transforms the passed mesh of <code>n * n * n</code> elements in place into the frequency domain.
+			 * @param mesh the mesh to be transformed.
+			 */
+			void forward(std::complex<double> *mesh) const;
+
+			/**
+			 * @brief Transforms the passed mesh of <code>n * n * n</code> elements in place back into the spatial
+			 * domain. The result is normalized, i.e. <code>inverse(forward(x)) == x</code>.
+			 * @param mesh the mesh to be transformed.
+			 */
+			void inverse(std::complex<double> *mesh) const;
+	};
+}
+
+#endif //PHYSICS_ENGINE_FAST_FOURIER_TRANSFORM_H
@@ -0,0 +1,90 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstdio>
+#include <string>
+
+#include "physics/force_laws.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The stringified definitions of the softening kernels and of the force laws, which are expanded with an empty
+	 * function qualifier for OpenCL.
+	 */
+	const char *const SOFTENING_KERNELS_OPENCL_DEFINITION =
+			PHYSICS_EXPAND_AND_STRINGIFY(PHYSICS_SOFTENING_KERNELS_SOURCE());
+	const char *const NEWTONIAN_FORCE_LAW_OPENCL_DEFINITION =
+			PHYSICS_EXPAND_AND_STRINGIFY(PHYSICS_NEWTONIAN_FORCE_LAW_SOURCE());
+	const char *const SPLINE_SOFTENED_NEWTONIAN_FORCE_LAW_OPENCL_DEFINITION =
+			PHYSICS_EXPAND_AND_STRINGIFY(PHYSICS_SPLINE_SOFTENED_NEWTONIAN_FORCE_LAW_SOURCE());
+	const char *const COULOMB_FORCE_LAW_OPENCL_DEFINITION =
+			PHYSICS_EXPAND_AND_STRINGIFY(PHYSICS_COULOMB_FORCE_LAW_SOURCE());
+	const char *const YUKAWA_FORCE_LAW_OPENCL_DEFINITION =
+			PHYSICS_EXPAND_AND_STRINGIFY(PHYSICS_YUKAWA_FORCE_LAW_SOURCE());
+	const char *const LENNARD_JONES_FORCE_LAW_OPENCL_DEFINITION =
+			PHYSICS_EXPAND_AND_STRINGIFY(PHYSICS_LENNARD_JONES_FORCE_LAW_SOURCE());
+}
+
+std::string forcelaws::toOpenClFloatLiteral(const float value) {
+	// the hexadecimal notation is exact and independent of the locale
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%af", static_cast<double>(value));
+	return "(" + std::string(buffer) + ")";
+}
+
+std::string forcelaws::createOpenClSource(const char *const definition, const std::string &distanceFactorCall,
+										  const std::string &strengthFactorCall) {
+	// the softening kernels are shared by the force laws, rsqrt is an OpenCL built-in function
+	return std::string(SOFTENING_KERNELS_OPENCL_DEFINITION) + "\n" + definition + "\n" +
+		   "#define FORCE_LAW_DISTANCE_FACTOR(distanceSquared, squaredSofteningFactor) " + distanceFactorCall + "\n" +
+		   "#define FORCE_LAW_STRENGTH_FACTOR(targetMass, sourceMass) " + strengthFactorCall + "\n";
+}
+
+std::string NewtonianForceLaw::createOpenClSource() const {
+	return forcelaws::createOpenClSource(
+			NEWTONIAN_FORCE_LAW_OPENCL_DEFINITION,
+			"calcNewtonianDistanceFactor((distanceSquared), (squaredSofteningFactor), " +
+			std::to_string(static_cast<int>(softeningKernel)) + ")",
+			"calcNewtonianStrengthFactor((targetMass), (sourceMass), " +
+			forcelaws::toOpenClFloatLiteral(gravitationalConstant) + ")"
+	);
+}
+
+std::string SplineSoftenedNewtonianForceLaw::createOpenClSource() const {
+	return forcelaws::createOpenClSource(
+			SPLINE_SOFTENED_NEWTONIAN_FORCE_LAW_OPENCL_DEFINITION,
+			"calcSplineSoftenedNewtonianDistanceFactor((distanceSquared), (squaredSofteningFactor))",
+			"calcSplineSoftenedNewtonianStrengthFactor((targetMass), (sourceMass), " +
+			forcelaws::toOpenClFloatLiteral(gravitationalConstant) + ")"
+	);
+}
+
+std::string CoulombForceLaw::createOpenClSource() const {
+	return forcelaws::createOpenClSource(
+			COULOMB_FORCE_LAW_OPENCL_DEFINITION,
+			"calcCoulombDistanceFactor((distanceSquared), (squaredSofteningFactor), " +
+			std::to_string(static_cast<int>(softeningKernel)) + ")",
+			"calcCoulombStrengthFactor((targetMass), (sourceMass), " +
+			forcelaws::toOpenClFloatLiteral(coulombConstant) + ")"
+	);
+}
+
+std::string YukawaForceLaw::createOpenClSource() const {
+	return forcelaws::createOpenClSource(
+			YUKAWA_FORCE_LAW_OPENCL_DEFINITION,
+			"calcYukawaDistanceFactor((distanceSquared), (squaredSofteningFactor), " +
+			forcelaws::toOpenClFloatLiteral(1.0f / screeningLength) + ")",
+			"calcYukawaStrengthFactor((targetMass), (sourceMass), " +
+			forcelaws::toOpenClFloatLiteral(couplingConstant) + ")"
+	);
+}
+
+std::string LennardJonesForceLaw::createOpenClSource() const {
+	return forcelaws::createOpenClSource(
+			LENNARD_JONES_FORCE_LAW_OPENCL_DEFINITION,
+			"calcLennardJonesDistanceFactor((distanceSquared), (squaredSofteningFactor), " +
+			forcelaws::toOpenClFloatLiteral(wellDepth) + ", " +
+			forcelaws::toOpenClFloatLiteral(zeroCrossingDistance * zeroCrossingDistance) + ")",
+			"calcLennardJonesStrengthFactor((targetMass), (sourceMass))"
+	);
+}
@@ -0,0 +1,100 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <stdexcept>
+#include <utility>
+
+#include "physics/frame_ring.h"
+
+using namespace physics;
+
+FrameRing::Frame::Frame() noexcept:
+		pSlot_(nullptr),
+		sequenceNumber_(INVALID_SEQUENCE_NUMBER) {
+}
+
+FrameRing::Frame::Frame(Slot *const pSlot, const uint64_t sequenceNumber) noexcept:
+		pSlot_(pSlot),
+		sequenceNumber_(sequenceNumber) {
+}
+
+FrameRing::Frame::Frame(Frame &&other) noexcept:
+		pSlot_(std::exchange(other.pSlot_, nullptr)),
+		sequenceNumber_(std::exchange(other.sequenceNumber_, INVALID_SEQUENCE_NUMBER)) {
+}
+
+FrameRing::Frame &FrameRing::Frame::operator=(Frame &&other) noexcept {
+	if (this != &other) {
+		if (nullptr != pSlot_) {
+			pSlot_->numReaders.fetch_sub(1, std::memory_order_release);
+		}
+		pSlot_ = std::exchange(other.pSlot_, nullptr);
+		sequenceNumber_ = std::exchange(other.sequenceNumber_, INVALID_SEQUENCE_NUMBER);
+	}
+	return *this;
+}
+
+FrameRing::Frame::~Frame() {
+	if (nullptr != pSlot_) {
+		// the reads of the snapshot happen before the producer may overwrite it
+		pSlot_->numReaders.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+FrameRing::FrameRing(const size_t capacity) :
+		capacity_(capacity),
+		slots_(nullptr),
+		latestSlotIndex_(NO_SLOT),
+		lastWrittenSlotIndex_(0),
+		numOfferedFrames_(0),
+		numDroppedFrames_(0) {
+	if (capacity < 2) {
+		// let it crash
+		throw std::invalid_argument("A frame ring needs at least 2 slots.");
+	}
+	slots_ = std::make_unique<Slot[]>(capacity);
+}
+
+bool FrameRing::publish(const Bodies<float, float, float> &bodies, const size_t numBodies,
+						const BodyReordering &bodyReordering) {
+	const uint64_t sequenceNumber = ++numOfferedFrames_;
+	const size_t latestSlotIndex = latestSlotIndex_.load(std::memory_order_relaxed);
+	for (size_t offset = 1; offset <= capacity_; ++offset) {
+		const size_t slotIndex = (lastWrittenSlotIndex_ + offset) % capacity_;
+		Slot &slot = slots_[slotIndex];
+		if ((latestSlotIndex == slotIndex) || (0 != slot.numReaders.load(std::memory_order_relaxed))) {
+			continue;
+		}
+		// Invalidate the slot before checking its readers, while a consumer increments the readers before
+		// validating the slot. The sequential consistency guarantees that at least one of both sees the other, so
+		// either the consumer fails to acquire the slot or the slot is not overwritten.
+		slot.sequenceNumber.store(INVALID_SEQUENCE_NUMBER, std::memory_order_seq_cst);
+		if (0 != slot.numReaders.load(std::memory_order_seq_cst)) {
+			// a consumer still holds the old frame, which stays intact, but cannot be acquired anymore
+			continue;
+		}
+		slot.snapshot.capture(bodies, numBodies, bodyReordering);
+		slot.sequenceNumber.store(sequenceNumber, std::memory_order_release);
+		latestSlotIndex_.store(slotIndex, std::memory_order_release);
+		lastWrittenSlotIndex_ = slotIndex;
+		return true;
+	}
+	numDroppedFrames_.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+FrameRing::Frame FrameRing::acquireLatest() {
+	while (true) {
+		const size_t slotIndex = latestSlotIndex_.load(std::memory_order_acquire);
+		if (NO_SLOT == slotIndex) {
+			return Frame();
+		}
+		Slot &slot = slots_[slotIndex];
+		slot.numReaders.fetch_add(1, std::memory_order_seq_cst);
+		const uint64_t sequenceNumber = slot.sequenceNumber.load(std::memory_order_seq_cst);
+		if (INVALID_SEQUENCE_NUMBER != sequenceNumber) {
+			// the slot may have been rewritten with a newer frame in the meantime, which is complete as well
+			return Frame(&slot, sequenceNumber);
+		}
+		// the producer overwrites the slot, which is not the latest one anymore
+		slot.numReaders.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
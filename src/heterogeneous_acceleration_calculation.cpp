@@ -0,0 +1,74 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <utility>
+
+#include "heterogeneous_acceleration_calculation.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Returns the seconds since the passed time point.
+	 */
+	inline double calcSecondsSince(const std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+HeterogeneousAccelerationCalculationImpl::HeterogeneousAccelerationCalculationImpl(
+		std::unique_ptr<IAccelerationCalculation> pHostCalculation,
+		std::unique_ptr<IAccelerationCalculation> pDeviceCalculation,
+		const float initialDeviceShare
+) :
+		pHostCalculation_(std::move(pHostCalculation)),
+		pDeviceCalculation_(std::move(pDeviceCalculation)),
+		// the device is the first worker, so it gets the first target bodies
+		loadBalancer_(std::vector<float>{initialDeviceShare, 1.0f - initialDeviceShare}),
+		boundaries_(3, 0),
+		durations_(2, 0.0) {
+	if ((nullptr == pHostCalculation_) || (nullptr == pDeviceCalculation_)) {
+		// let it crash
+		throw std::invalid_argument("The heterogeneous calculation needs a host and a device calculation.");
+	}
+	if (!pHostCalculation_->isTargetRangeSupported() || !pDeviceCalculation_->isTargetRangeSupported()) {
+		// let it crash
+		throw std::invalid_argument("The calculations of the heterogeneous calculation must support target ranges.");
+	}
+}
+
+void HeterogeneousAccelerationCalculationImpl::calcAccelerations(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		const float squaredSofteningFactor
+) {
+	loadBalancer_.partition(numBodies, boundaries_);
+	const size_t numDeviceTargets = boundaries_[1];
+	durations_[0] = 0.0;
+	durations_[1] = 0.0;
+
+	// the device is driven by its own thread, since its calculation blocks until the accelerations are downloaded
+	std::future<void> deviceCalculation;
+	if (0 < numDeviceTargets) {
+		deviceCalculation = std::async(std::launch::async, [&]() {
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			pDeviceCalculation_->calcAccelerationsOfTargetRange(bodies, numBodies, 0, numDeviceTargets, accelerations,
+																squaredSofteningFactor);
+			durations_[0] = calcSecondsSince(start);
+		});
+	}
+	if (numDeviceTargets < numBodies) {
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		pHostCalculation_->calcAccelerationsOfTargetRange(bodies, numBodies, numDeviceTargets, numBodies,
+														  accelerations, squaredSofteningFactor);
+		durations_[1] = calcSecondsSince(start);
+	}
+	// the destructor of the future would wait as well, but get rethrows the exceptions of the device
+	if (deviceCalculation.valid()) {
+		deviceCalculation.get();
+	}
+
+	loadBalancer_.update(boundaries_, durations_);
+}
@@ -0,0 +1,110 @@
+#ifndef PHYSICS_ENGINE_HETEROGENEOUS_ACCELERATION_CALCULATION_H
+#define PHYSICS_ENGINE_HETEROGENEOUS_ACCELERATION_CALCULATION_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "physics/acceleration_calculation.h"
+#include "load_balancer.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A <strong>heterogeneous</strong> implementation of the calculation of accelerations of N bodies, which
+	 * splits the target bodies of each calculation between a host and a device calculation, e.g. OpenMP and OpenCL.
+	 * @details The device calculation runs on its own thread for the first target bodies, while the host calculation
+	 * runs on the calling thread for the remaining target bodies. After each calculation the split is balanced by the
+	 * measured rates of both sides, see <code>LoadBalancer</code>. Hence the split adapts to the hardware, the number
+	 * of bodies and the load of the host.
+	 */
+	class HeterogeneousAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		private:
+			/**
+			 * The calculation of the target bodies on the calling thread.
+			 */
+			std::unique_ptr<IAccelerationCalculation> pHostCalculation_;
+
+			/**
+			 * The calculation of the target bodies on the thread of the device.
+			 */
+			std::unique_ptr<IAccelerationCalculation> pDeviceCalculation_;
+
+			/**
+			 * The balancer of the target bodies between the device, the first worker, and the host.
+			 */
+			LoadBalancer loadBalancer_;
+
+			/**
+			 * The ranges of the target bodies of the device and the host of the last calculation.
+			 */
+			std::vector<size_t> boundaries_;
+
+			/**
+			 * The durations of the device and the host of the last calculation in seconds.
+			 */
+			std::vector<double> durations_;
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Creates a new heterogeneous calculation by the parameters.
+			 * @param pHostCalculation the calculation of the target bodies on the calling thread.
+			 * @param pDeviceCalculation the calculation of the target bodies on the thread of the device.
+			 * @param initialDeviceShare the share of the target bodies which are calculated by the device in the first
+			 * calculation.
+			 * @throws std::invalid_argument if a calculation is missing or does not support target ranges, or if the
+			 * share is not within <code>[0, 1]</code>.
+			 */
+			HeterogeneousAccelerationCalculationImpl(std::unique_ptr<IAccelerationCalculation> pHostCalculation,
+													 std::unique_ptr<IAccelerationCalculation> pDeviceCalculation,
+													 float initialDeviceShare = 0.5f);
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies by both calculations at the same time.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies. The <code>accelerations</code>
+			 * 					parameter must be a pointer to an allocated storage which is large enough to store
+			 * 					<code>numBodies * vector dimension</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerations(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns the share of the target bodies which are calculated by the device in the next
+			 * calculation.
+			 * @return the share of the device within <code>[0, 1]</code>.
+			 */
+			[[nodiscard]] inline float getDeviceShare() const {
+				return loadBalancer_.getShare(0);
+			}
+
+			/**
+			 * @brief Returns the duration of the last host calculation.
+			 * @return the duration in seconds, zero if the host had no target bodies.
+			 */
+			[[nodiscard]] inline double getLastHostDuration() const {
+				return durations_[1];
+			}
+
+			/**
+			 * @brief Returns the duration of the last device calculation.
+			 * @return the duration in seconds, zero if the device had no target bodies.
+			 */
+			[[nodiscard]] inline double getLastDeviceDuration() const {
+				return durations_[0];
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_HETEROGENEOUS_ACCELERATION_CALCULATION_H
@@ -0,0 +1,510 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "physics/initial_conditions.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The fractions of the total mass of the Plummer and the Hernquist sphere, whose radii are sampled. Their heavy
+	 * tails are truncated at about 39 scale radii, so a few outliers do not blow up the bounding box of a tree.
+	 */
+	constexpr double PLUMMER_TRUNCATION_MASS_FRACTION = 0.999;
+	constexpr double HERNQUIST_TRUNCATION_MASS_FRACTION = 0.95;
+
+	/**
+	 * The fraction of the escape velocity, below which the speeds of a Hernquist sphere are sampled, so the
+	 * approximated velocities bind all bodies.
+	 */
+	constexpr double HERNQUIST_MAX_ESCAPE_VELOCITY_FRACTION = 0.95;
+
+	/**
+	 * The salt of the streams of the clusters, which separates them from the streams of the bodies.
+	 */
+	constexpr uint64_t CLUSTER_STREAM_SALT = 0xC2B2AE3D27D4EB4FULL;
+
+	/**
+	 * @brief A stream of random numbers (SplitMix64), which is cheap to create for each body, so the bodies of a
+	 * parallel loop are independent of the threads.
+	 */
+	class RandomStream {
+
+		private:
+			/**
+			 * The state, which is advanced by the golden ratio for each number.
+			 */
+			uint64_t state_;
+
+			static uint64_t mix(uint64_t value) {
+				value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+				return value ^ (value >> 31);
+			}
+
+		public:
+			RandomStream(const uint64_t seed, const uint64_t streamIndex) :
+					state_(mix(seed) ^ mix(streamIndex + 0x9E3779B97F4A7C15ULL)) {
+			}
+
+			/**
+			 * @brief Returns a uniformly distributed number in the open interval <code>(0, 1)</code>, so its
+			 * logarithm is finite.
+			 */
+			double nextUniform() {
+				state_ += 0x9E3779B97F4A7C15ULL;
+				return (static_cast<double>(mix(state_) >> 11) + 0.5) * 0x1.0p-53;
+			}
+
+			/**
+			 * @brief Returns a normally distributed number by the Box-Muller method.
+			 */
+			double nextGaussian() {
+				const double radius = std::sqrt(-2.0 * std::log(nextUniform()));
+				return radius * std::cos(2.0 * std::numbers::pi * nextUniform());
+			}
+
+			/**
+			 * @brief Sets the passed vector to an isotropically distributed vector of the passed length.
+			 */
+			void nextVector(const double length, double vector[3]) {
+				const double z = (2.0 * nextUniform()) - 1.0;
+				const double azimuth = 2.0 * std::numbers::pi * nextUniform();
+				const double radius = std::sqrt(std::max(0.0, 1.0 - (z * z)));
+				vector[0] = length * radius * std::cos(azimuth);
+				vector[1] = length * radius * std::sin(azimuth);
+				vector[2] = length * z;
+			}
+	};
+
+	void setBody(const Bodies<float, float, float> &bodies, const size_t index, const double mass,
+				 const double position[3], const double velocity[3]) {
+		bodies.masses[index] = static_cast<float>(mass);
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			bodies.positions[(index * 3) + dimension] = static_cast<float>(position[dimension]);
+			bodies.velocities[(index * 3) + dimension] = static_cast<float>(velocity[dimension]);
+		}
+	}
+
+	/**
+	 * @brief Samples a body of a Plummer sphere by the method of Aarseth, Hénon & Wielen (1974).
+	 * @param random the stream of the body.
+	 * @param gravitationalMass the product of the gravitational constant and the mass of the sphere.
+	 * @param scaleRadius the scale radius of the sphere.
+	 * @param[out] position the position relative to the center.
+	 * @param[out] velocity the velocity relative to the center.
+	 */
+	void samplePlummerBody(RandomStream &random, const double gravitationalMass, const double scaleRadius,
+						   double position[3], double velocity[3]) {
+		const double massFraction = PLUMMER_TRUNCATION_MASS_FRACTION * random.nextUniform();
+		const double radius = scaleRadius / std::sqrt(std::pow(massFraction, -2.0 / 3.0) - 1.0);
+		// von Neumann rejection of q = v / v_esc, whose density q^2 (1 - q^2)^3.5 is less than 0.1
+		double q;
+		double y;
+		do {
+			q = random.nextUniform();
+			y = 0.1 * random.nextUniform();
+		} while (y > (q * q * std::pow(1.0 - (q * q), 3.5)));
+		const double escapeVelocity = std::sqrt(
+				2.0 * gravitationalMass / std::sqrt((radius * radius) + (scaleRadius * scaleRadius)));
+		random.nextVector(radius, position);
+		random.nextVector(q * escapeVelocity, velocity);
+	}
+
+	/**
+	 * @brief Samples a body of a Hernquist sphere, whose speed is Maxwellian with the isotropic dispersion of the
+	 * Jeans equation (Hernquist 1990, eq. 10).
+	 */
+	void sampleHernquistBody(RandomStream &random, const double gravitationalMass, const double scaleRadius,
+							 double position[3], double velocity[3]) {
+		const double sqrtMassFraction = std::sqrt(HERNQUIST_TRUNCATION_MASS_FRACTION * random.nextUniform());
+		const double x = sqrtMassFraction / (1.0 - sqrtMassFraction);
+		const double radius = scaleRadius * x;
+		const double squaredDispersion = std::max(0.0, (gravitationalMass / (12.0 * scaleRadius)) *
+				((12.0 * x * std::pow(1.0 + x, 3.0) * std::log1p(1.0 / x)) -
+				 ((x / (1.0 + x)) * (25.0 + (52.0 * x) + (42.0 * x * x) + (12.0 * x * x * x)))));
+		const double dispersion = std::sqrt(squaredDispersion);
+		const double maxSpeed = HERNQUIST_MAX_ESCAPE_VELOCITY_FRACTION *
+								std::sqrt(2.0 * gravitationalMass / (radius + scaleRadius));
+		double squaredSpeed;
+		do {
+			squaredSpeed = 0.0;
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				velocity[dimension] = dispersion * random.nextGaussian();
+				squaredSpeed += velocity[dimension] * velocity[dimension];
+			}
+		} while (squaredSpeed >= (maxSpeed * maxSpeed));
+		random.nextVector(radius, position);
+	}
+
+	/**
+	 * @brief The King model in its natural units, i.e. the core radius, the velocity dispersion of the lowered
+	 * Maxwellian and <code>G = 1</code>, which is tabulated by integrating Poisson's equation from the center to the
+	 * tidal radius.
+	 */
+	struct KingModel {
+
+		/**
+		 * The radii in ascending order.
+		 */
+		std::vector<double> radii;
+
+		/**
+		 * The masses enclosed by the radii.
+		 */
+		std::vector<double> masses;
+
+		/**
+		 * The dimensionless potentials at the radii, 0 at the tidal radius.
+		 */
+		std::vector<double> potentials;
+
+		/**
+		 * @brief Returns the density of the lowered Maxwellian at the passed potential, relative to an arbitrary
+		 * normalization.
+		 */
+		static double calcDensity(const double potential) {
+			if (potential <= 0.0) {
+				return 0.0;
+			}
+			return (std::exp(potential) * std::erf(std::sqrt(potential))) -
+				   (std::sqrt(4.0 * potential / std::numbers::pi) * (1.0 + (2.0 * potential / 3.0)));
+		}
+
+		explicit KingModel(const double centralPotential) {
+			const double centralDensity = calcDensity(centralPotential);
+			// d^2 psi / dr^2 = -9 rho(psi) / rho(W0) - (2 / r) d psi / dr, by the definition of the core radius
+			const auto calcDerivatives = [centralDensity](const double radius, const double potential,
+														  const double gradient, double &potentialDerivative,
+														  double &gradientDerivative) {
+				potentialDerivative = gradient;
+				gradientDerivative = (-9.0 * calcDensity(potential) / centralDensity) - (2.0 * gradient / radius);
+			};
+			radii.push_back(0.0);
+			masses.push_back(0.0);
+			potentials.push_back(centralPotential);
+			// the series expansion psi = W0 - 1.5 r^2 avoids the singularity of the center
+			double radius = 1e-4;
+			double potential = centralPotential - (1.5 * radius * radius);
+			double gradient = -3.0 * radius;
+			while (true) {
+				// the steps grow with the radius, since the profile flattens
+				const double step = 0.005 * std::max(radius, 0.01);
+				double k1p, k1g, k2p, k2g, k3p, k3g, k4p, k4g;
+				calcDerivatives(radius, potential, gradient, k1p, k1g);
+				calcDerivatives(radius + (0.5 * step), potential + (0.5 * step * k1p), gradient + (0.5 * step * k1g),
+								k2p, k2g);
+				calcDerivatives(radius + (0.5 * step), potential + (0.5 * step * k2p), gradient + (0.5 * step * k2g),
+								k3p, k3g);
+				calcDerivatives(radius + step, potential + (step * k3p), gradient + (step * k3g), k4p, k4g);
+				const double nextPotential = potential + (step * (k1p + (2.0 * k2p) + (2.0 * k3p) + k4p) / 6.0);
+				const double nextGradient = gradient + (step * (k1g + (2.0 * k2g) + (2.0 * k3g) + k4g) / 6.0);
+				if (nextPotential <= 0.0) {
+					// the tidal radius is interpolated between the last two steps
+					const double fraction = potential / (potential - nextPotential);
+					const double tidalRadius = radius + (fraction * step);
+					const double tidalGradient = gradient + (fraction * (nextGradient - gradient));
+					radii.push_back(tidalRadius);
+					masses.push_back(-tidalRadius * tidalRadius * tidalGradient);
+					potentials.push_back(0.0);
+					return;
+				}
+				radius += step;
+				potential = nextPotential;
+				gradient = nextGradient;
+				radii.push_back(radius);
+				masses.push_back(-radius * radius * gradient);
+				potentials.push_back(potential);
+			}
+		}
+
+		/**
+		 * @brief Samples a body of the model.
+		 * @param random the stream of the body.
+		 * @param[out] position the position in units of the core radius.
+		 * @param[out] velocity the velocity in units of the velocity dispersion.
+		 */
+		void sampleBody(RandomStream &random, double position[3], double velocity[3]) const {
+			const double mass = masses.back() * random.nextUniform();
+			const size_t upperIndex = std::max<size_t>(
+					1, std::upper_bound(masses.begin(), masses.end(), mass) - masses.begin());
+			const size_t index = std::min(upperIndex, masses.size() - 1);
+			const double fraction = (mass - masses[index - 1]) / (masses[index] - masses[index - 1]);
+			const double radius = radii[index - 1] + (fraction * (radii[index] - radii[index - 1]));
+			const double potential = potentials[index - 1] + (fraction * (potentials[index] - potentials[index - 1]));
+			// von Neumann rejection of the speed, whose density v^2 (exp(psi - v^2 / 2) - 1) is bounded by both
+			// v^2 exp(psi - v^2 / 2) and v^2 (psi - v^2 / 2) exp(psi)
+			const double maxSpeed = std::sqrt(2.0 * potential);
+			const double bound = std::min((1.0 <= potential) ? (2.0 * std::exp(potential - 1.0)) : (2.0 * potential),
+										  0.5 * potential * potential * std::exp(potential));
+			double speed = 0.0;
+			if (0.0 < potential) {
+				double y;
+				do {
+					speed = maxSpeed * random.nextUniform();
+					y = bound * random.nextUniform();
+				} while (y > (speed * speed * std::expm1(potential - (0.5 * speed * speed))));
+			}
+			random.nextVector(radius, position);
+			random.nextVector(speed, velocity);
+		}
+	};
+
+	void generateUniformSquare(const Bodies<float, float, float> &bodies, const size_t numBodies,
+							   const ScenarioParameters &parameters) {
+		const double mass = parameters.totalMass / static_cast<double>(numBodies);
+		const double halfSize = parameters.scaleRadius;
+		const uint64_t seed = parameters.seed;
+		// @formatter:off
+		#pragma omp parallel for default(none) shared(bodies, numBodies, mass, halfSize, seed)
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+			RandomStream random(seed, i);
+			const double position[3] = {halfSize * ((2.0 * random.nextUniform()) - 1.0),
+										halfSize * ((2.0 * random.nextUniform()) - 1.0), 0.0};
+			const double velocity[3] = {0.0, 0.0, 0.0};
+			setBody(bodies, i, mass, position, velocity);
+		}
+	}
+
+	void generateColdCollapse(const Bodies<float, float, float> &bodies, const size_t numBodies,
+							  const ScenarioParameters &parameters) {
+		const double mass = parameters.totalMass / static_cast<double>(numBodies);
+		const double radius = parameters.scaleRadius;
+		const uint64_t seed = parameters.seed;
+		// @formatter:off
+		#pragma omp parallel for default(none) shared(bodies, numBodies, mass, radius, seed)
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+			RandomStream random(seed, i);
+			double position[3];
+			random.nextVector(radius * std::cbrt(random.nextUniform()), position);
+			const double velocity[3] = {0.0, 0.0, 0.0};
+			setBody(bodies, i, mass, position, velocity);
+		}
+	}
+
+	void generatePlummerSphere(const Bodies<float, float, float> &bodies, const size_t numBodies,
+							   const ScenarioParameters &parameters) {
+		const double mass = parameters.totalMass / static_cast<double>(numBodies);
+		const double gravitationalMass = static_cast<double>(parameters.gravitationalConstant) * parameters.totalMass;
+		const double scaleRadius = parameters.scaleRadius;
+		const uint64_t seed = parameters.seed;
+		// @formatter:off
+		#pragma omp parallel for default(none) shared(bodies, numBodies, mass, gravitationalMass, scaleRadius, seed)
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+			RandomStream random(seed, i);
+			double position[3];
+			double velocity[3];
+			samplePlummerBody(random, gravitationalMass, scaleRadius, position, velocity);
+			setBody(bodies, i, mass, position, velocity);
+		}
+	}
+
+	void generateHernquistSphere(const Bodies<float, float, float> &bodies, const size_t numBodies,
+								 const ScenarioParameters &parameters) {
+		const double mass = parameters.totalMass / static_cast<double>(numBodies);
+		// the truncated sphere is bound by the mass of its sampled part
+		const double gravitationalMass = static_cast<double>(parameters.gravitationalConstant) * parameters.totalMass /
+										 HERNQUIST_TRUNCATION_MASS_FRACTION;
+		const double scaleRadius = parameters.scaleRadius;
+		const uint64_t seed = parameters.seed;
+		// @formatter:off
+		#pragma omp parallel for default(none) shared(bodies, numBodies, mass, gravitationalMass, scaleRadius, seed)
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+			RandomStream random(seed, i);
+			double position[3];
+			double velocity[3];
+			sampleHernquistBody(random, gravitationalMass, scaleRadius, position, velocity);
+			setBody(bodies, i, mass, position, velocity);
+		}
+	}
+
+	void generateKingSphere(const Bodies<float, float, float> &bodies, const size_t numBodies,
+							const ScenarioParameters &parameters) {
+		if ((parameters.kingCentralPotential <= 0.0f) || (16.0f < parameters.kingCentralPotential)) {
+			// let it crash
+			throw std::invalid_argument("The central potential of a King sphere must be in (0, 16].");
+		}
+		const KingModel kingModel(parameters.kingCentralPotential);
+		const double mass = parameters.totalMass / static_cast<double>(numBodies);
+		const double lengthUnit = parameters.scaleRadius;
+		// the velocities are scaled, so the mass of the model in its natural units becomes the total mass
+		const double velocityUnit = std::sqrt(static_cast<double>(parameters.gravitationalConstant) *
+											  parameters.totalMass / (lengthUnit * kingModel.masses.back()));
+		const uint64_t seed = parameters.seed;
+		// @formatter:off
+		#pragma omp parallel for default(none) shared(bodies, numBodies, kingModel, mass, lengthUnit, velocityUnit, seed)
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+			RandomStream random(seed, i);
+			double position[3];
+			double velocity[3];
+			kingModel.sampleBody(random, position, velocity);
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				position[dimension] *= lengthUnit;
+				velocity[dimension] *= velocityUnit;
+			}
+			setBody(bodies, i, mass, position, velocity);
+		}
+	}
+
+	void generateExponentialDisk(const Bodies<float, float, float> &bodies, const size_t numBodies,
+								 const ScenarioParameters &parameters) {
+		if ((parameters.centralMass < 0.0f) || (parameters.diskScaleHeightRatio < 0.0f)) {
+			// let it crash
+			throw std::invalid_argument("The central mass and the scale height of a disk must not be negative.");
+		}
+		const size_t firstDiskBody = (0.0f < parameters.centralMass) ? 1 : 0;
+		if (1 == firstDiskBody) {
+			const double origin[3] = {0.0, 0.0, 0.0};
+			setBody(bodies, 0, parameters.centralMass, origin, origin);
+		}
+		if (firstDiskBody == numBodies) {
+			return;
+		}
+		const double diskMass = parameters.totalMass;
+		const double mass = diskMass / static_cast<double>(numBodies - firstDiskBody);
+		const double gravitationalConstant = parameters.gravitationalConstant;
+		const double centralMass = parameters.centralMass;
+		const double scaleLength = parameters.scaleRadius;
+		const double scaleHeight = parameters.diskScaleHeightRatio * scaleLength;
+		const uint64_t seed = parameters.seed;
+		// @formatter:off
+		#pragma omp parallel for default(none) shared(bodies, numBodies, firstDiskBody, diskMass, mass, gravitationalConstant, centralMass, scaleLength, scaleHeight, seed)
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = static_cast<long long>(firstDiskBody); i < static_cast<long long>(numBodies); ++i) {
+			RandomStream random(seed, i);
+			// the radius of an exponential disk is gamma distributed with the shape 2
+			const double x = -std::log(random.nextUniform() * random.nextUniform());
+			const double radius = scaleLength * x;
+			const double azimuth = 2.0 * std::numbers::pi * random.nextUniform();
+			// the inverse of the cumulative distribution of the vertical sech^2 profile
+			const double height = scaleHeight * std::atanh((2.0 * random.nextUniform()) - 1.0);
+			const double enclosedMass = centralMass + (diskMass * (1.0 - ((1.0 + x) * std::exp(-x))));
+			const double circularVelocity = std::sqrt(gravitationalConstant * enclosedMass / radius);
+			const double position[3] = {radius * std::cos(azimuth), radius * std::sin(azimuth), height};
+			const double velocity[3] = {-circularVelocity * std::sin(azimuth), circularVelocity * std::cos(azimuth),
+										0.0};
+			setBody(bodies, i, mass, position, velocity);
+		}
+	}
+
+	void generateHierarchicalClusters(const Bodies<float, float, float> &bodies, const size_t numBodies,
+									  const ScenarioParameters &parameters) {
+		if ((0 == parameters.numClusters) || (parameters.clusterScaleRadiusRatio <= 0.0f)) {
+			// let it crash
+			throw std::invalid_argument("Hierarchical clusters need at least one cluster with a positive radius.");
+		}
+		const size_t numClusters = parameters.numClusters;
+		const double gravitationalConstant = parameters.gravitationalConstant;
+		// the clusters move like the bodies of a Plummer sphere of the total mass
+		std::vector<double> clusterPositions(numClusters * 3);
+		std::vector<double> clusterVelocities(numClusters * 3);
+		for (size_t cluster = 0; cluster < numClusters; ++cluster) {
+			RandomStream random(parameters.seed ^ CLUSTER_STREAM_SALT, cluster);
+			samplePlummerBody(random, gravitationalConstant * parameters.totalMass, parameters.scaleRadius,
+							  &clusterPositions[cluster * 3], &clusterVelocities[cluster * 3]);
+		}
+		const double mass = parameters.totalMass / static_cast<double>(numBodies);
+		const double clusterScaleRadius = static_cast<double>(parameters.clusterScaleRadiusRatio) *
+										  parameters.scaleRadius;
+		const uint64_t seed = parameters.seed;
+		// @formatter:off
+		#pragma omp parallel for default(none) shared(bodies, numBodies, numClusters, clusterPositions, clusterVelocities, gravitationalConstant, mass, clusterScaleRadius, seed)
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+			const size_t cluster = static_cast<size_t>(i) % numClusters;
+			const size_t numClusterBodies = (numBodies / numClusters) + ((cluster < (numBodies % numClusters)) ? 1 : 0);
+			RandomStream random(seed, i);
+			double position[3];
+			double velocity[3];
+			samplePlummerBody(random, gravitationalConstant * mass * static_cast<double>(numClusterBodies),
+							  clusterScaleRadius, position, velocity);
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				position[dimension] += clusterPositions[(cluster * 3) + dimension];
+				velocity[dimension] += clusterVelocities[(cluster * 3) + dimension];
+			}
+			setBody(bodies, i, mass, position, velocity);
+		}
+	}
+
+	/**
+	 * @brief Moves the bodies into their center-of-mass frame. The sums run sequentially in double precision, so
+	 * they do not depend on the number of threads.
+	 */
+	void moveToCenterOfMassFrame(const Bodies<float, float, float> &bodies, const size_t numBodies) {
+		double totalMass = 0.0;
+		double centerOfMass[3] = {0.0, 0.0, 0.0};
+		double centerOfMassVelocity[3] = {0.0, 0.0, 0.0};
+		for (size_t i = 0; i < numBodies; ++i) {
+			totalMass += bodies.masses[i];
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				centerOfMass[dimension] +=
+						static_cast<double>(bodies.masses[i]) * bodies.positions[(i * 3) + dimension];
+				centerOfMassVelocity[dimension] +=
+						static_cast<double>(bodies.masses[i]) * bodies.velocities[(i * 3) + dimension];
+			}
+		}
+		for (size_t i = 0; i < numBodies; ++i) {
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				bodies.positions[(i * 3) + dimension] -= static_cast<float>(centerOfMass[dimension] / totalMass);
+				bodies.velocities[(i * 3) + dimension] -=
+						static_cast<float>(centerOfMassVelocity[dimension] / totalMass);
+			}
+		}
+	}
+}
+
+void physics::generateScenario(const Scenario scenario, const Bodies<float, float, float> &bodies,
+							   const size_t numBodies, const ScenarioParameters &parameters) {
+	if ((parameters.totalMass <= 0.0f) || (parameters.scaleRadius <= 0.0f) ||
+		(parameters.gravitationalConstant < 0.0f)) {
+		// let it crash
+		throw std::invalid_argument("The total mass and the scale radius must be positive.");
+	}
+	if (0 == numBodies) {
+		return;
+	}
+	switch (scenario) {
+		case Scenario::UNIFORM_SQUARE:
+			generateUniformSquare(bodies, numBodies, parameters);
+			// the uniform square is kept as generated, since its bodies are at rest anyway
+			return;
+		case Scenario::COLD_COLLAPSE:
+			generateColdCollapse(bodies, numBodies, parameters);
+			break;
+		case Scenario::PLUMMER_SPHERE:
+			generatePlummerSphere(bodies, numBodies, parameters);
+			break;
+		case Scenario::HERNQUIST_SPHERE:
+			generateHernquistSphere(bodies, numBodies, parameters);
+			break;
+		case Scenario::KING_SPHERE:
+			generateKingSphere(bodies, numBodies, parameters);
+			break;
+		case Scenario::EXPONENTIAL_DISK:
+			generateExponentialDisk(bodies, numBodies, parameters);
+			break;
+		case Scenario::HIERARCHICAL_CLUSTERS:
+			generateHierarchicalClusters(bodies, numBodies, parameters);
+			break;
+		default:
+			// let it crash
+			throw std::invalid_argument("Unknown scenario.");
+	}
+	moveToCenterOfMassFrame(bodies, numBodies);
+}
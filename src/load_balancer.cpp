@@ -0,0 +1,75 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "load_balancer.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Raises the passed shares to the minimum share and normalizes their sum to one.
+	 */
+	void normalizeShares(std::vector<float> &shares) {
+		for (float &share: shares) {
+			share = std::max(share, LoadBalancer::MIN_SHARE);
+		}
+		const float sum = std::accumulate(shares.begin(), shares.end(), 0.0f);
+		for (float &share: shares) {
+			share /= sum;
+		}
+	}
+}
+
+LoadBalancer::LoadBalancer(const size_t numWorkers) :
+		shares_(numWorkers, (0 < numWorkers) ? (1.0f / static_cast<float>(numWorkers)) : 0.0f),
+		rates_(numWorkers, 0.0) {
+	if (0 == numWorkers) {
+		// let it crash
+		throw std::invalid_argument("A load balancer needs at least one worker.");
+	}
+}
+
+LoadBalancer::LoadBalancer(const std::vector<float> &initialShares) :
+		shares_(initialShares),
+		rates_(initialShares.size(), 0.0) {
+	if (shares_.empty() ||
+		std::any_of(shares_.begin(), shares_.end(), [](const float share) { return !(0.0f <= share); }) ||
+		(0.0f >= std::accumulate(shares_.begin(), shares_.end(), 0.0f))) {
+		// let it crash
+		throw std::invalid_argument("The shares of a load balancer must be non-negative and must not all be zero.");
+	}
+	normalizeShares(shares_);
+}
+
+void LoadBalancer::partition(const size_t numItems, std::vector<size_t> &boundaries) const {
+	boundaries.resize(shares_.size() + 1);
+	boundaries[0] = 0;
+	double cumulativeShare = 0.0;
+	for (size_t worker = 0; (worker + 1) < shares_.size(); ++worker) {
+		cumulativeShare += shares_[worker];
+		const auto boundary = static_cast<size_t>(std::llround(cumulativeShare * static_cast<double>(numItems)));
+		boundaries[worker + 1] = std::clamp(boundary, boundaries[worker], numItems);
+	}
+	boundaries.back() = numItems;
+}
+
+void LoadBalancer::update(const std::vector<size_t> &boundaries, const std::vector<double> &durations) {
+	for (size_t worker = 0; worker < shares_.size(); ++worker) {
+		if ((boundaries[worker + 1] == boundaries[worker]) || !(0.0 < durations[worker])) {
+			return;
+		}
+	}
+	double sumOfRates = 0.0;
+	for (size_t worker = 0; worker < shares_.size(); ++worker) {
+		rates_[worker] = static_cast<double>(boundaries[worker + 1] - boundaries[worker]) / durations[worker];
+		sumOfRates += rates_[worker];
+	}
+	for (size_t worker = 0; worker < shares_.size(); ++worker) {
+		const auto balancedShare = static_cast<float>(rates_[worker] / sumOfRates);
+		shares_[worker] += SMOOTHING_FACTOR * (balancedShare - shares_[worker]);
+	}
+	normalizeShares(shares_);
+}
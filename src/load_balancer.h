@@ -0,0 +1,104 @@
+#ifndef PHYSICS_ENGINE_LOAD_BALANCER_H
+#define PHYSICS_ENGINE_LOAD_BALANCER_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief Splits a range of items between workers of different speeds, e.g. the target bodies of an acceleration
+	 * calculation between devices.
+	 * @details Each worker gets a share of the items. After each step the shares are moved towards the shares at
+	 * which all workers would have finished at the same time, according to the measured rates of the workers, i.e.
+	 * the number of items per second. The work per item is assumed to be the same for all items.
+	 */
+	class LoadBalancer {
+
+		private:
+			/**
+			 * The shares of the workers, whose sum is one.
+			 */
+			std::vector<float> shares_;
+
+			/**
+			 * The rates of the workers of the last update.
+			 */
+			std::vector<double> rates_;
+
+		public:
+			/**
+			 * The minimum share of each worker, so the rate of a worker is still measured after it turned out to be
+			 * slow.
+			 */
+			static constexpr float MIN_SHARE = 0.01f;
+
+			/**
+			 * The weight of the last measurement in the shares, which smooths the noise of the measurements.
+			 */
+			static constexpr float SMOOTHING_FACTOR = 0.5f;
+
+			/**
+			 * @brief The parameterized constructor. Creates a new load balancer with equal shares.
+			 * @param numWorkers the number of workers.
+			 * @throws std::invalid_argument if the number of workers is zero.
+			 */
+			explicit LoadBalancer(size_t numWorkers);
+
+			/**
+			 * @brief The parameterized constructor. Creates a new load balancer with the passed initial shares.
+			 * @param initialShares the initial shares of the workers, which are normalized and raised to the minimum
+			 * share.
+			 * @throws std::invalid_argument if there are no shares, a share is negative or all shares are zero.
+			 */
+			explicit LoadBalancer(const std::vector<float> &initialShares);
+
+			/**
+			 * @brief Splits the passed number of items into consecutive ranges by the shares of the workers.
+			 * @param numItems the number of items.
+			 * @param[out] boundaries the begin of the range of each worker followed by the number of items, i.e. the
+			 * range of worker <code>k</code> is <code>[boundaries[k], boundaries[k + 1])</code>.
+			 */
+			void partition(size_t numItems, std::vector<size_t> &boundaries) const;
+
+			/**
+			 * @brief Moves the shares towards the shares at which all workers would have finished at the same time.
+			 * @details Without a measurement of each worker, e.g. if a range was empty, the shares are kept.
+			 * @param boundaries the ranges of the workers of the measured step, as by <code>partition</code>.
+			 * @param durations the measured duration of each worker in seconds.
+			 */
+			void update(const std::vector<size_t> &boundaries, const std::vector<double> &durations);
+
+			/**
+			 * @brief Returns the number of workers.
+			 * @return the number of workers.
+			 */
+			[[nodiscard]] inline size_t getNumWorkers() const {
+				return shares_.size();
+			}
+
+			/**
+			 * @brief Returns the share of the passed worker.
+			 * @param worker the index of the worker.
+			 * @return the share within <code>[0, 1]</code>.
+			 */
+			[[nodiscard]] inline float getShare(const size_t worker) const {
+				return shares_[worker];
+			}
+
+			/**
+			 * @brief Returns the rate of the passed worker of the last update.
+			 * @param worker the index of the worker.
+			 * @return the number of items per second, zero before the first update.
+			 */
+			[[nodiscard]] inline double getRate(const size_t worker) const {
+				return rates_[worker];
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_LOAD_BALANCER_H
@@ -0,0 +1,128 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PHYSICS_ENGINE_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "physics/mapped_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The alignment of the arrays within the file, which is a multiple of the page size of common systems.
+	 */
+	constexpr size_t ARRAY_ALIGNMENT = 64 * 1024;
+
+	/**
+	 * @brief Rounds the passed size up to a multiple of the passed alignment.
+	 */
+	constexpr size_t alignUp(const size_t size, const size_t alignment) {
+		return ((size + alignment - 1) / alignment) * alignment;
+	}
+}
+
+MappedBodies::MappedBodies(const std::string &filePath, const size_t numBodies) :
+		pMapping_(nullptr),
+		mappingSize_(0),
+		numBodies_(numBodies),
+		offsets_{0, 0, 0, 0} {
+	const size_t numFloatsPerArray[4] = {numBodies, numBodies * 3, numBodies * 3, numBodies * 3};
+	for (size_t array = 0; array < 4; ++array) {
+		offsets_[array] = mappingSize_;
+		mappingSize_ += alignUp(numFloatsPerArray[array] * sizeof(float), ARRAY_ALIGNMENT);
+	}
+	if (0 == numBodies) {
+		return;
+	}
+#ifdef PHYSICS_ENGINE_HAS_MMAP
+	const int fileDescriptor = open(filePath.c_str(), O_RDWR | O_CREAT, 0644);
+	if (fileDescriptor < 0) {
+		// let it crash
+		throw std::runtime_error("The file of the bodies cannot be opened: " + filePath);
+	}
+	struct stat fileStatus{};
+	const bool isSizeValid = (0 == fstat(fileDescriptor, &fileStatus))
+							 && (static_cast<size_t>(fileStatus.st_size) == mappingSize_);
+	if (!isSizeValid && (0 != ftruncate(fileDescriptor, static_cast<off_t>(mappingSize_)))) {
+		close(fileDescriptor);
+		// let it crash
+		throw std::runtime_error("The file of the bodies cannot be resized: " + filePath);
+	}
+	void *const pMapping = mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+	// the mapping keeps the file open
+	close(fileDescriptor);
+	if (MAP_FAILED == pMapping) {
+		// let it crash
+		throw std::runtime_error("The file of the bodies cannot be mapped: " + filePath);
+	}
+	pMapping_ = pMapping;
+#else
+	// let it crash
+	throw std::runtime_error("Memory-mapped bodies are only supported on POSIX systems: " + filePath);
+#endif
+}
+
+MappedBodies::MappedBodies(MappedBodies &&other) noexcept:
+		pMapping_(std::exchange(other.pMapping_, nullptr)),
+		mappingSize_(std::exchange(other.mappingSize_, 0)),
+		numBodies_(std::exchange(other.numBodies_, 0)),
+		offsets_{other.offsets_[0], other.offsets_[1], other.offsets_[2], other.offsets_[3]} {
+}
+
+MappedBodies &MappedBodies::operator=(MappedBodies &&other) noexcept {
+	if (this != &other) {
+		unmap();
+		pMapping_ = std::exchange(other.pMapping_, nullptr);
+		mappingSize_ = std::exchange(other.mappingSize_, 0);
+		numBodies_ = std::exchange(other.numBodies_, 0);
+		for (size_t array = 0; array < 4; ++array) {
+			offsets_[array] = other.offsets_[array];
+		}
+	}
+	return *this;
+}
+
+MappedBodies::~MappedBodies() {
+	unmap();
+}
+
+void MappedBodies::unmap() {
+#ifdef PHYSICS_ENGINE_HAS_MMAP
+	if (nullptr != pMapping_) {
+		munmap(pMapping_, mappingSize_);
+	}
+#endif
+	pMapping_ = nullptr;
+}
+
+Bodies<float, float, float> MappedBodies::getBodies() const {
+	if (nullptr == pMapping_) {
+		return {nullptr, nullptr, nullptr};
+	}
+	auto *const pBytes = static_cast<std::byte *>(pMapping_);
+	return {reinterpret_cast<float *>(pBytes + offsets_[0]), reinterpret_cast<float *>(pBytes + offsets_[1]),
+			reinterpret_cast<float *>(pBytes + offsets_[2])};
+}
+
+float *MappedBodies::getAccelerations() const {
+	if (nullptr == pMapping_) {
+		return nullptr;
+	}
+	return reinterpret_cast<float *>(static_cast<std::byte *>(pMapping_) + offsets_[3]);
+}
+
+void MappedBodies::flush() const {
+#ifdef PHYSICS_ENGINE_HAS_MMAP
+	if ((nullptr != pMapping_) && (0 != msync(pMapping_, mappingSize_, MS_SYNC))) {
+		// let it crash
+		throw std::runtime_error("The bodies cannot be written back to their file.");
+	}
+#endif
+}
@@ -0,0 +1,69 @@
+#ifndef PHYSICS_ENGINE_MOTION_DIAGNOSTICS_ACCUMULATOR_H
+#define PHYSICS_ENGINE_MOTION_DIAGNOSTICS_ACCUMULATOR_H
+
+#include "physics/diagnostics.h"
+#include "compensated_sum.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief Accumulates the kinetic energy, the linear momentum and the angular momentum of bodies with compensated
+	 * summation. Each thread accumulates its bodies into its own accumulator, the accumulators are combined at the
+	 * end of the parallel region.
+	 */
+	class MotionDiagnosticsAccumulator {
+
+		private:
+			/**
+			 * The kinetic energy, the linear momentum and the angular momentum.
+			 */
+			CompensatedSum sums_[7];
+
+		public:
+			/**
+			 * @brief Adds a body.
+			 * @param mass the mass of the body.
+			 * @param position the position of the body.
+			 * @param velocity the velocity of the body.
+			 */
+			inline void addBody(const float mass, const float *position, const float *velocity) {
+				const double m = mass;
+				const double r[3] = {position[0], position[1], position[2]};
+				const double v[3] = {velocity[0], velocity[1], velocity[2]};
+				sums_[0].add(0.5 * m * ((v[0] * v[0]) + (v[1] * v[1]) + (v[2] * v[2])));
+				sums_[1].add(m * v[0]);
+				sums_[2].add(m * v[1]);
+				sums_[3].add(m * v[2]);
+				sums_[4].add(m * ((r[1] * v[2]) - (r[2] * v[1])));
+				sums_[5].add(m * ((r[2] * v[0]) - (r[0] * v[2])));
+				sums_[6].add(m * ((r[0] * v[1]) - (r[1] * v[0])));
+			}
+
+			/**
+			 * @brief Adds the bodies of another accumulator.
+			 * @param other the other accumulator.
+			 */
+			inline void add(const MotionDiagnosticsAccumulator &other) {
+				for (size_t k = 0; k < 7; ++k) {
+					sums_[k].add(other.sums_[k]);
+				}
+			}
+
+			/**
+			 * @brief Stores the accumulated kinetic energy and momenta into the passed diagnostics.
+			 * @param[out] diagnostics the diagnostics.
+			 */
+			inline void store(Diagnostics &diagnostics) const {
+				diagnostics.kineticEnergy = sums_[0].getValue();
+				for (size_t dimension = 0; dimension < 3; ++dimension) {
+					diagnostics.linearMomentum[dimension] = sums_[1 + dimension].getValue();
+					diagnostics.angularMomentum[dimension] = sums_[4 + dimension].getValue();
+				}
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_MOTION_DIAGNOSTICS_ACCUMULATOR_H
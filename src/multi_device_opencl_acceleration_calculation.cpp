@@ -0,0 +1,174 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+
+#include "multi_device_opencl_acceleration_calculation.h"
+#include "commons/text_file_reading.h"
+#include "config.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Returns the seconds since the passed time point.
+	 */
+	inline double calcSecondsSince(const std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	/**
+	 * @brief Splits the passed device into sub-devices of the passed number of compute units.
+	 * @return the sub-devices, which are empty if the device does not support the fission.
+	 */
+	std::vector<cl_device_id> createSubDevices(const cl_device_id device, const cl_uint numComputeUnitsPerSubDevice) {
+		const cl_device_partition_property properties[] = {
+				CL_DEVICE_PARTITION_EQUALLY, static_cast<cl_device_partition_property>(numComputeUnitsPerSubDevice), 0
+		};
+		cl_uint numSubDevices = 0;
+		if ((CL_SUCCESS != clCreateSubDevices(device, properties, 0, nullptr, &numSubDevices)) ||
+			(0 == numSubDevices)) {
+			return {};
+		}
+		std::vector<cl_device_id> subDevices(numSubDevices);
+		if (CL_SUCCESS != clCreateSubDevices(device, properties, numSubDevices, subDevices.data(), nullptr)) {
+			return {};
+		}
+		return subDevices;
+	}
+
+	/**
+	 * @brief Creates a pipeline for each of the passed devices.
+	 */
+	template<typename TForceLaw>
+	std::vector<std::unique_ptr<OpenClPipeline>> createPipelines(const std::vector<cl_device_id> &devices,
+																 const TForceLaw &forceLaw) {
+		// the kernel uses the macros of the force law, so its source has to be prepended
+		const std::string kernelSourceCode = forceLaw.createOpenClSource() +
+											 commons::io::readTextFile(
+													 RESOURCES_FOLDER_PATH"calc_accelerations_kernel.cl");
+		std::vector<std::unique_ptr<OpenClPipeline>> pPipelines;
+		for (const cl_device_id device: devices) {
+			pPipelines.push_back(std::make_unique<OpenClPipeline>(device, kernelSourceCode,
+																  "calcAccelerationsOfBatch"));
+		}
+		return pPipelines;
+	}
+}
+
+template<typename TForceLaw>
+BasicMultiDeviceOpenClAccelerationCalculationImpl<TForceLaw>::BasicMultiDeviceOpenClAccelerationCalculationImpl(
+		const TForceLaw &forceLaw,
+		const cl_uint numComputeUnitsPerSubDevice
+) :
+		loadBalancer_(1) {
+	const std::vector<cl_device_id> eligibleDevices = findEligibleOpenClDevices();
+	if (eligibleDevices.empty()) {
+		// let it crash
+		throw std::runtime_error("No OpenCL-compatible processors found on this system");
+	}
+	std::vector<cl_device_id> devices;
+	for (const cl_device_id device: eligibleDevices) {
+		const std::vector<cl_device_id> subDevices = (0 < numComputeUnitsPerSubDevice) ?
+													 createSubDevices(device, numComputeUnitsPerSubDevice) :
+													 std::vector<cl_device_id>();
+		if (subDevices.empty()) {
+			devices.push_back(device);
+		} else {
+			devices.insert(devices.end(), subDevices.begin(), subDevices.end());
+			subDevices_.insert(subDevices_.end(), subDevices.begin(), subDevices.end());
+		}
+	}
+	try {
+		pPipelines_ = createPipelines(devices, forceLaw);
+	} catch (...) {
+		// the destructor is not called, if the constructor throws
+		for (const cl_device_id subDevice: subDevices_) {
+			clReleaseDevice(subDevice);
+		}
+		throw;
+	}
+	loadBalancer_ = LoadBalancer(devices.size());
+	durations_.assign(devices.size(), 0.0);
+}
+
+template<typename TForceLaw>
+BasicMultiDeviceOpenClAccelerationCalculationImpl<TForceLaw>::BasicMultiDeviceOpenClAccelerationCalculationImpl(
+		const std::vector<cl_device_id> &devices,
+		const TForceLaw &forceLaw
+) :
+		loadBalancer_(1) {
+	if (devices.empty()) {
+		// let it crash
+		throw std::invalid_argument("The multi-device calculation needs at least one device.");
+	}
+	pPipelines_ = createPipelines(devices, forceLaw);
+	loadBalancer_ = LoadBalancer(devices.size());
+	durations_.assign(devices.size(), 0.0);
+}
+
+template<typename TForceLaw>
+BasicMultiDeviceOpenClAccelerationCalculationImpl<TForceLaw>::~BasicMultiDeviceOpenClAccelerationCalculationImpl() {
+	// the contexts of the pipelines retain their devices, so they are released first
+	pPipelines_.clear();
+	for (const cl_device_id subDevice: subDevices_) {
+		clReleaseDevice(subDevice);
+	}
+	subDevices_.clear();
+}
+
+template<typename TForceLaw>
+void BasicMultiDeviceOpenClAccelerationCalculationImpl<TForceLaw>::calcAccelerations(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *accelerations,
+		const float squaredSofteningFactor
+) {
+	calcAccelerationsOfTargetRange(bodies, numBodies, 0, numBodies, accelerations, squaredSofteningFactor);
+}
+
+template<typename TForceLaw>
+bool BasicMultiDeviceOpenClAccelerationCalculationImpl<TForceLaw>::isTargetRangeSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicMultiDeviceOpenClAccelerationCalculationImpl<TForceLaw>::calcAccelerationsOfTargetRange(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const size_t targetBegin,
+		const size_t targetEnd,
+		float *accelerations,
+		const float squaredSofteningFactor
+) {
+	if (targetEnd <= targetBegin) {
+		return;
+	}
+	loadBalancer_.partition(targetEnd - targetBegin, boundaries_);
+	const auto calcOnDevice = [&](const size_t device) {
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		pPipelines_[device]->calcAccelerations(bodies.masses, bodies.positions, numBodies,
+											   targetBegin + boundaries_[device], targetBegin + boundaries_[device + 1],
+											   accelerations, squaredSofteningFactor);
+		durations_[device] = calcSecondsSince(start);
+	};
+
+	// each pipeline blocks until its accelerations are downloaded, so each device is driven by its own thread, and the
+	// destructors of the futures wait for the devices, even if the calling thread throws
+	std::vector<std::future<void>> deviceCalculations;
+	deviceCalculations.reserve(pPipelines_.size());
+	for (size_t device = 1; device < pPipelines_.size(); ++device) {
+		durations_[device] = 0.0;
+		deviceCalculations.push_back(std::async(std::launch::async, calcOnDevice, device));
+	}
+	durations_[0] = 0.0;
+	calcOnDevice(0);
+	for (std::future<void> &deviceCalculation: deviceCalculations) {
+		deviceCalculation.get();
+	}
+
+	loadBalancer_.update(boundaries_, durations_);
+}
+
+PHYSICS_INSTANTIATE_FOR_ALL_FORCE_LAWS(physics::BasicMultiDeviceOpenClAccelerationCalculationImpl)
@@ -0,0 +1,166 @@
+#ifndef PHYSICS_ENGINE_MULTI_DEVICE_OPENCL_ACCELERATION_CALCULATION_H
+#define PHYSICS_ENGINE_MULTI_DEVICE_OPENCL_ACCELERATION_CALCULATION_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "physics/acceleration_calculation.h"
+#include "physics/force_laws.h"
+#include "load_balancer.h"
+#include "opencl_pipeline.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief An <strong>OpenCL-accelerated</strong> implementation of the calculation of accelerations of N bodies,
+	 * which uses all eligible OpenCL devices at the same time.
+	 * @details Each device has its own context, queues and copy of all bodies, see <code>OpenClPipeline</code>. The
+	 * target bodies are split into one consecutive range per device by the measured rates of the devices, see
+	 * <code>LoadBalancer</code>, and each device downloads the accelerations of its range into the output. The
+	 * devices are driven by one thread each, the first device by the calling thread. Optionally, each device is
+	 * split by device fission into sub-devices of a fixed number of compute units, e.g. to test several devices with
+	 * one CPU device of PoCL. The template is explicitly instantiated for each force law in its translation unit.
+	 * @tparam TForceLaw the force law between two bodies.
+	 */
+	template<typename TForceLaw>
+	class BasicMultiDeviceOpenClAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		private:
+			/**
+			 * The sub-devices created by device fission, which are owned by this calculation.
+			 */
+			std::vector<cl_device_id> subDevices_;
+
+			/**
+			 * The pipeline of each device.
+			 */
+			std::vector<std::unique_ptr<OpenClPipeline>> pPipelines_;
+
+			/**
+			 * The balancer of the target bodies between the devices.
+			 */
+			LoadBalancer loadBalancer_;
+
+			/**
+			 * The ranges of the target bodies of the devices of the last calculation.
+			 */
+			std::vector<size_t> boundaries_;
+
+			/**
+			 * The durations of the devices of the last calculation in seconds.
+			 */
+			std::vector<double> durations_;
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Creates a calculation on all eligible devices.
+			 * @param forceLaw the force law between two bodies, which is compiled into the kernel.
+			 * @param numComputeUnitsPerSubDevice the number of compute units of the sub-devices into which each
+			 * device is split, or zero to use the devices as a whole. Devices which do not support the fission are
+			 * used as a whole.
+			 * @throws std::runtime_error if there is no eligible device.
+			 */
+			explicit BasicMultiDeviceOpenClAccelerationCalculationImpl(const TForceLaw &forceLaw = TForceLaw(),
+																	   cl_uint numComputeUnitsPerSubDevice = 0);
+
+			/**
+			 * @brief The parameterized constructor. Creates a calculation on the passed devices.
+			 * @param devices the devices, which must outlive this calculation.
+			 * @param forceLaw the force law between two bodies, which is compiled into the kernel.
+			 * @throws std::invalid_argument if there are no devices.
+			 */
+			BasicMultiDeviceOpenClAccelerationCalculationImpl(const std::vector<cl_device_id> &devices,
+															  const TForceLaw &forceLaw);
+
+			/**
+			 * @brief The deleted copy constructor, since the sub-devices are owned exclusively.
+			 */
+			BasicMultiDeviceOpenClAccelerationCalculationImpl(
+					const BasicMultiDeviceOpenClAccelerationCalculationImpl &) = delete;
+
+			/**
+			 * @brief The deleted copy assignment, since the sub-devices are owned exclusively.
+			 */
+			BasicMultiDeviceOpenClAccelerationCalculationImpl &operator=(
+					const BasicMultiDeviceOpenClAccelerationCalculationImpl &) = delete;
+
+			/**
+			 * @brief The destructor, which releases the pipelines and the sub-devices.
+			 */
+			~BasicMultiDeviceOpenClAccelerationCalculationImpl() override;
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies. The <code>accelerations</code>
+			 * 					parameter must be a pointer to an allocated storage which is large enough to store
+			 * 					<code>numBodies * vector dimension</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerations(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the accelerations of a range of target bodies can be calculated.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isTargetRangeSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations of the target bodies of the passed range caused by all bodies, whose
+			 * range is split between the devices.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param targetBegin the index of the first target body.
+			 * @param targetEnd the index after the last target body, at most <code>numBodies</code>.
+			 * @param[in, out] accelerations the accelerations of all passed bodies, of which only the elements of the
+			 * 					target bodies are written.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerationsOfTargetRange(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					size_t targetBegin,
+					size_t targetEnd,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns the number of used devices, including sub-devices.
+			 * @return the number of devices.
+			 */
+			[[nodiscard]] inline size_t getNumDevices() const {
+				return pPipelines_.size();
+			}
+
+			/**
+			 * @brief Returns the share of the target bodies which are calculated by the passed device in the next
+			 * calculation.
+			 * @param device the index of the device.
+			 * @return the share of the device within <code>[0, 1]</code>.
+			 */
+			[[nodiscard]] inline float getDeviceShare(const size_t device) const {
+				return loadBalancer_.getShare(device);
+			}
+	};
+
+	/**
+	 * @brief The multi-device OpenCL-accelerated implementation of the calculation of gravitational accelerations of
+	 * N bodies.
+	 */
+	using MultiDeviceOpenClAccelerationCalculationImpl =
+			BasicMultiDeviceOpenClAccelerationCalculationImpl<NewtonianForceLaw>;
+}
+
+#endif //PHYSICS_ENGINE_MULTI_DEVICE_OPENCL_ACCELERATION_CALCULATION_H
@@ -0,0 +1,259 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+#include "octree.h"
+#include "space_filling_curves.h"
+
+using namespace physics;
+
+Octree::Octree(const size_t leafCapacity, const float maxLeafGrowth) :
+		leafCapacity_(std::max<size_t>(1, leafCapacity)),
+		maxLeafGrowth_(std::max(0.0f, maxLeafGrowth)),
+		builtLeafSizeSum_(0.0),
+		pBuiltPositions_(nullptr),
+		numBuiltBodies_(0) {
+
+}
+
+void Octree::build(const Bodies<float, float, float> &bodies, const size_t numBodies, Arena *const pScratchArena) {
+	nodes_.clear();
+	nodesByLevel_.clear();
+	levelOffsets_.clear();
+	bodyIndices_.resize(numBodies);
+	pBuiltPositions_ = bodies.positions;
+	numBuiltBodies_ = numBodies;
+	builtLeafSizeSum_ = 0.0;
+	if (0 == numBodies) {
+		return;
+	}
+	std::pair<std::uint64_t, size_t> *keysAndIndices;
+	if (nullptr != pScratchArena) {
+		keysAndIndices = pScratchArena->allocate<std::pair<std::uint64_t, size_t>>(numBodies);
+	} else {
+		keysAndIndices_.resize(numBodies);
+		keysAndIndices = keysAndIndices_.data();
+	}
+
+	// 1. the bounding cube of all bodies
+	float min[3] = {
+			std::numeric_limits<float>::max(),
+			std::numeric_limits<float>::max(),
+			std::numeric_limits<float>::max()
+	};
+	float max[3] = {
+			std::numeric_limits<float>::lowest(),
+			std::numeric_limits<float>::lowest(),
+			std::numeric_limits<float>::lowest()
+	};
+	for (size_t i = 0; i < numBodies; ++i) {
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			min[dimension] = std::min(min[dimension], bodies.positions[(i * 3) + dimension]);
+			max[dimension] = std::max(max[dimension], bodies.positions[(i * 3) + dimension]);
+		}
+	}
+	const float cubeSize = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+	const float inverseCubeSize = (0.0f < cubeSize) ? (1.0f / cubeSize) : 0.0f;
+
+	// 2. sort the bodies along the Morton curve
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, min, inverseCubeSize, keysAndIndices)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+		const size_t xCoordinateIndex = i * 3;
+		// the arena does not construct the pairs
+		std::construct_at(
+				&keysAndIndices[i],
+				calcMortonKey(
+						calcGridCoordinate(bodies.positions[xCoordinateIndex], min[0], inverseCubeSize),
+						calcGridCoordinate(bodies.positions[xCoordinateIndex + 1], min[1], inverseCubeSize),
+						calcGridCoordinate(bodies.positions[xCoordinateIndex + 2], min[2], inverseCubeSize)
+				),
+				static_cast<size_t>(i)
+		);
+	}
+	std::sort(keysAndIndices, keysAndIndices + numBodies);
+	for (size_t i = 0; i < numBodies; ++i) {
+		bodyIndices_[i] = keysAndIndices[i].second;
+	}
+
+	// 3. build the nodes top down
+	nodes_.push_back(OctreeNode{{}, 0.0f, {}, {}, 0, 0, 0, numBodies});
+	buildSubtree(bodies, keysAndIndices, 0, 0);
+
+	// 4. the order of the refits and the reference of the quality
+	sortNodesByLevel();
+	builtLeafSizeSum_ = calcLeafSizeSum();
+}
+
+void Octree::sortNodesByLevel() {
+	// breadth-first, since the children of a node are stored contiguously
+	nodesByLevel_.push_back(0);
+	levelOffsets_.push_back(0);
+	levelOffsets_.push_back(1);
+	while (levelOffsets_[levelOffsets_.size() - 2] < levelOffsets_.back()) {
+		const size_t levelBegin = levelOffsets_[levelOffsets_.size() - 2];
+		const size_t levelEnd = levelOffsets_.back();
+		for (size_t k = levelBegin; k < levelEnd; ++k) {
+			const OctreeNode &node = nodes_[nodesByLevel_[k]];
+			for (size_t child = node.firstChild; child < (node.firstChild + node.numChildren); ++child) {
+				nodesByLevel_.push_back(child);
+			}
+		}
+		levelOffsets_.push_back(nodesByLevel_.size());
+	}
+	// the last level is empty
+	levelOffsets_.pop_back();
+}
+
+double Octree::calcLeafSizeSum() const {
+	double leafSizeSum = 0.0;
+	const OctreeNode *const nodes = nodes_.data();
+	const auto numNodes = static_cast<long long>(nodes_.size());
+	// @formatter:off
+	#pragma omp parallel for reduction(+:leafSizeSum) default(none) shared(nodes, numNodes)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long k = 0; k < numNodes; ++k) {
+		const OctreeNode &node = nodes[k];
+		if (0 == node.numChildren) {
+			leafSizeSum += std::max({
+					node.boundingBoxMax[0] - node.boundingBoxMin[0],
+					node.boundingBoxMax[1] - node.boundingBoxMin[1],
+					node.boundingBoxMax[2] - node.boundingBoxMin[2]
+			});
+		}
+	}
+	return leafSizeSum;
+}
+
+void Octree::refit(const Bodies<float, float, float> &bodies) {
+	if (levelOffsets_.empty()) {
+		return; // there are no nodes
+	}
+	OctreeNode *const nodes = nodes_.data();
+	const size_t *const nodesByLevel = nodesByLevel_.data();
+	// the deepest level first, so the children of a node are calculated before the node
+	for (size_t level = levelOffsets_.size() - 1; 0 < level; --level) {
+		const auto levelBegin = static_cast<long long>(levelOffsets_[level - 1]);
+		const auto levelEnd = static_cast<long long>(levelOffsets_[level]);
+		// @formatter:off
+		#pragma omp parallel for schedule(dynamic, 256) default(none) shared(bodies, nodes, nodesByLevel, levelBegin, levelEnd)
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long k = levelBegin; k < levelEnd; ++k) {
+			OctreeNode &node = nodes[nodesByLevel[k]];
+			if (0 == node.numChildren) {
+				calcLeafMoments(bodies, node);
+			} else {
+				combineChildMoments(node);
+			}
+		}
+	}
+}
+
+bool Octree::update(const Bodies<float, float, float> &bodies, const size_t numBodies, Arena *const pScratchArena) {
+	if (nodes_.empty() || (bodies.positions != pBuiltPositions_) || (numBodies != numBuiltBodies_)) {
+		build(bodies, numBodies, pScratchArena);
+		return true;
+	}
+	refit(bodies);
+	if ((builtLeafSizeSum_ * (1.0 + maxLeafGrowth_)) < calcLeafSizeSum()) {
+		build(bodies, numBodies, pScratchArena);
+		return true;
+	}
+	return false;
+}
+
+void Octree::buildSubtree(const Bodies<float, float, float> &bodies,
+						  const std::pair<std::uint64_t, size_t> *const keysAndIndices, const size_t nodeIndex,
+						  const unsigned int level) {
+	const size_t firstBody = nodes_[nodeIndex].firstBody;
+	const size_t endBody = firstBody + nodes_[nodeIndex].numBodies;
+	if ((nodes_[nodeIndex].numBodies <= leafCapacity_) || (MORTON_KEY_BITS_PER_AXIS <= level)) {
+		calcLeafMoments(bodies, nodes_[nodeIndex]);
+		return;
+	}
+
+	// The bodies of each octant form a contiguous range, because the bodies are sorted by their Morton keys.
+	const unsigned int shift = 3 * (MORTON_KEY_BITS_PER_AXIS - 1 - level);
+	size_t childRanges[8][2];
+	size_t numChildren = 0;
+	for (size_t begin = firstBody; begin < endBody;) {
+		const std::uint64_t octant = (keysAndIndices[begin].first >> shift) & 7;
+		size_t end = begin + 1;
+		while ((end < endBody) && (((keysAndIndices[end].first >> shift) & 7) == octant)) {
+			++end;
+		}
+		childRanges[numChildren][0] = begin;
+		childRanges[numChildren][1] = end - begin;
+		++numChildren;
+		begin = end;
+	}
+
+	const size_t firstChild = nodes_.size();
+	nodes_[nodeIndex].firstChild = firstChild;
+	nodes_[nodeIndex].numChildren = numChildren;
+	for (size_t child = 0; child < numChildren; ++child) {
+		nodes_.push_back(OctreeNode{{}, 0.0f, {}, {}, 0, 0, childRanges[child][0], childRanges[child][1]});
+	}
+	for (size_t child = 0; child < numChildren; ++child) {
+		buildSubtree(bodies, keysAndIndices, firstChild + child, level + 1);
+	}
+
+	// the monopole moment and bounding box of an inner node are the combination of those of its children
+	// (note: nodes_ may have been reallocated by the recursion, so a reference can only be taken now)
+	combineChildMoments(nodes_[nodeIndex]);
+}
+
+void Octree::combineChildMoments(OctreeNode &node) const {
+	double weightedPositionSum[3] = {0.0, 0.0, 0.0};
+	double massSum = 0.0;
+	for (size_t dimension = 0; dimension < 3; ++dimension) {
+		node.boundingBoxMin[dimension] = std::numeric_limits<float>::max();
+		node.boundingBoxMax[dimension] = std::numeric_limits<float>::lowest();
+	}
+	for (size_t child = node.firstChild; child < (node.firstChild + node.numChildren); ++child) {
+		const OctreeNode &childNode = nodes_[child];
+		massSum += childNode.mass;
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			weightedPositionSum[dimension] += static_cast<double>(childNode.mass) * childNode.centerOfMass[dimension];
+			node.boundingBoxMin[dimension] = std::min(node.boundingBoxMin[dimension], childNode.boundingBoxMin[dimension]);
+			node.boundingBoxMax[dimension] = std::max(node.boundingBoxMax[dimension], childNode.boundingBoxMax[dimension]);
+		}
+	}
+	node.mass = static_cast<float>(massSum);
+	for (size_t dimension = 0; dimension < 3; ++dimension) {
+		node.centerOfMass[dimension] = (0.0 < massSum)
+									   ? static_cast<float>(weightedPositionSum[dimension] / massSum)
+									   : 0.5f * (node.boundingBoxMin[dimension] + node.boundingBoxMax[dimension]);
+	}
+}
+
+void Octree::calcLeafMoments(const Bodies<float, float, float> &bodies, OctreeNode &node) const {
+	double weightedPositionSum[3] = {0.0, 0.0, 0.0};
+	double massSum = 0.0;
+	for (size_t dimension = 0; dimension < 3; ++dimension) {
+		node.boundingBoxMin[dimension] = std::numeric_limits<float>::max();
+		node.boundingBoxMax[dimension] = std::numeric_limits<float>::lowest();
+	}
+	for (size_t k = node.firstBody; k < (node.firstBody + node.numBodies); ++k) {
+		const size_t bodyIndex = bodyIndices_[k];
+		const double mass = bodies.masses[bodyIndex];
+		massSum += mass;
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const float coordinate = bodies.positions[(bodyIndex * 3) + dimension];
+			weightedPositionSum[dimension] += mass * coordinate;
+			node.boundingBoxMin[dimension] = std::min(node.boundingBoxMin[dimension], coordinate);
+			node.boundingBoxMax[dimension] = std::max(node.boundingBoxMax[dimension], coordinate);
+		}
+	}
+	node.mass = static_cast<float>(massSum);
+	for (size_t dimension = 0; dimension < 3; ++dimension) {
+		node.centerOfMass[dimension] = (0.0 < massSum)
+									   ? static_cast<float>(weightedPositionSum[dimension] / massSum)
+									   : 0.5f * (node.boundingBoxMin[dimension] + node.boundingBoxMax[dimension]);
+	}
+}
@@ -0,0 +1,218 @@
+#ifndef PHYSICS_ENGINE_OCTREE_H
+#define PHYSICS_ENGINE_OCTREE_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "physics/arena.h"
+#include "physics/bodies.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A node of an octree. Each node stores the monopole moment and the tight bounding box of its bodies.
+	 */
+	struct OctreeNode {
+
+		/**
+		 * The center of mass of the bodies contained in this node.
+		 */
+		float centerOfMass[3];
+
+		/**
+		 * The total mass of the bodies contained in this node.
+		 */
+		float mass;
+
+		/**
+		 * The minimum corner of the tight bounding box of the bodies contained in this node.
+		 */
+		float boundingBoxMin[3];
+
+		/**
+		 * The maximum corner of the tight bounding box of the bodies contained in this node.
+		 */
+		float boundingBoxMax[3];
+
+		/**
+		 * The index of the first child node. The children of a node are stored contiguously.
+		 */
+		size_t firstChild;
+
+		/**
+		 * The number of child nodes. Zero for a leaf.
+		 */
+		size_t numChildren;
+
+		/**
+		 * The index of the first body of this node in the body index array of the octree.
+		 */
+		size_t firstBody;
+
+		/**
+		 * The number of bodies contained in this node.
+		 */
+		size_t numBodies;
+	};
+
+	/**
+	 * @brief A linear octree built from the Morton-sorted positions of N bodies.
+	 * @details The nodes are stored in depth-first order, the root is the first node. Each leaf contains at most
+	 * <code>leafCapacity</code> bodies, unless the maximum depth of the Morton keys is reached.
+	 * Between the time steps the octree can be refitted instead of rebuilt: the leaves keep their bodies, and the
+	 * bounding boxes and monopole moments are recalculated bottom-up from the moved bodies. A body which left the
+	 * region of its leaf stretches the box of the leaf, so the refitted octree remains exact, but its nodes overlap
+	 * more and the walks open more nodes. Therefore the octree is rebuilt once the sum of the sizes of the leaves
+	 * exceeds the sum after the last build by the passed growth.
+	 */
+	class Octree {
+
+		private:
+			/**
+			 * The maximum number of bodies per leaf.
+			 */
+			size_t leafCapacity_;
+
+			/**
+			 * The nodes of the octree, the root is the first node.
+			 */
+			std::vector<OctreeNode> nodes_;
+
+			/**
+			 * The indices of the bodies sorted by their Morton keys. Each node references a contiguous range of it.
+			 */
+			std::vector<size_t> bodyIndices_;
+
+			/**
+			 * The pairs of Morton key and body index, used as a workspace for the sorting if no scratch arena is
+			 * passed to the build.
+			 */
+			std::vector<std::pair<std::uint64_t, size_t>> keysAndIndices_;
+
+			/**
+			 * The indices of the nodes sorted by their levels, the root first.
+			 */
+			std::vector<size_t> nodesByLevel_;
+
+			/**
+			 * The offsets of the levels into the nodes sorted by their levels; the nodes of level <code>l</code> are
+			 * <code>[levelOffsets_[l], levelOffsets_[l + 1])</code>.
+			 */
+			std::vector<size_t> levelOffsets_;
+
+			/**
+			 * The maximum relative growth of the sum of the leaf sizes by refits until the octree is rebuilt.
+			 */
+			float maxLeafGrowth_;
+
+			/**
+			 * The sum of the sizes of the leaves after the last build, where the size is the maximum extent.
+			 */
+			double builtLeafSizeSum_;
+
+			/**
+			 * The positions the octree was built for, in order to detect other bodies.
+			 */
+			const float *pBuiltPositions_;
+
+			/**
+			 * The number of bodies the octree was built for.
+			 */
+			size_t numBuiltBodies_;
+
+			/**
+			 * @brief Creates the subtree of the passed node recursively and calculates its monopole moment.
+			 * @param bodies the bodies.
+			 * @param keysAndIndices the pairs of Morton key and body index, sorted by the keys.
+			 * @param nodeIndex the index of the node whose subtree is to be created.
+			 * @param level the level of the node, the root has the level zero.
+			 */
+			void buildSubtree(const Bodies<float, float, float> &bodies,
+							  const std::pair<std::uint64_t, size_t> *keysAndIndices, size_t nodeIndex,
+							  unsigned int level);
+
+			/**
+			 * @brief Calculates the monopole moment and the bounding box of the passed leaf from its bodies.
+			 * @param bodies the bodies.
+			 * @param node the leaf to be calculated.
+			 */
+			void calcLeafMoments(const Bodies<float, float, float> &bodies, OctreeNode &node) const;
+
+			/**
+			 * @brief Calculates the monopole moment and the bounding box of the passed inner node from its children.
+			 * @param node the inner node to be calculated, whose children are already calculated.
+			 */
+			void combineChildMoments(OctreeNode &node) const;
+
+			/**
+			 * @brief Sorts the nodes by their levels for the bottom-up refit.
+			 */
+			void sortNodesByLevel();
+
+			/**
+			 * @brief Calculates the sum of the sizes of the leaves, where the size is the maximum extent.
+			 * @return the sum of the sizes of the leaves.
+			 */
+			[[nodiscard]] double calcLeafSizeSum() const;
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Creates a new empty octree.
+			 * @param leafCapacity the maximum number of bodies per leaf.
+			 * @param maxLeafGrowth the maximum relative growth of the sum of the leaf sizes by refits, e.g.
+			 * 					<code>0.5</code> for 50 %, until <code>update</code> rebuilds the octree.
+			 */
+			explicit Octree(size_t leafCapacity = 8, float maxLeafGrowth = 0.5f);
+
+			/**
+			 * @brief Builds the octree from scratch for the passed bodies.
+			 * @param bodies the bodies to be inserted.
+			 * @param numBodies the number of bodies.
+			 * @param pScratchArena the optional arena for the workspace of the sorting, which is only used during the
+			 * 					build. If <code>nullptr</code>, the octree keeps its own workspace.
+			 */
+			void build(const Bodies<float, float, float> &bodies, size_t numBodies, Arena *pScratchArena = nullptr);
+
+			/**
+			 * @brief Recalculates the bounding boxes and the monopole moments of all nodes bottom-up from the current
+			 * positions and masses of the bodies, which are still assigned to their leaves. The nodes of each level
+			 * are calculated in parallel.
+			 * @param bodies the bodies the octree was built for, possibly moved.
+			 */
+			void refit(const Bodies<float, float, float> &bodies);
+
+			/**
+			 * @brief Refits the octree, or rebuilds it if it was built for other bodies, if the number of bodies
+			 * changed, or if the refit degraded the octree too much.
+			 * @param bodies the bodies to be inserted.
+			 * @param numBodies the number of bodies.
+			 * @param pScratchArena the optional arena for the workspace of a rebuild.
+			 * @return <code>true</code> if the octree was rebuilt, <code>false</code> if it was refitted.
+			 */
+			bool update(const Bodies<float, float, float> &bodies, size_t numBodies, Arena *pScratchArena = nullptr);
+
+			/**
+			 * @brief Returns the nodes of the octree. The root is the first node.
+			 * @return the nodes of the octree.
+			 */
+			[[nodiscard]] inline const std::vector<OctreeNode> &getNodes() const {
+				return nodes_;
+			}
+
+			/**
+			 * @brief Returns the indices of the bodies in the order referenced by the nodes.
+			 * @return the indices of the bodies in the order referenced by the nodes.
+			 */
+			[[nodiscard]] inline const std::vector<size_t> &getBodyIndices() const {
+				return bodyIndices_;
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_OCTREE_H
@@ -1,6 +1,8 @@
 // Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
 #include <stdexcept>
 #include <cassert>
+#include <string>
 
 #include "opencl_acceleration_calculation.h"
 #include "opencl/device_manager.h"
@@ -9,14 +11,22 @@
 
 using namespace physics;
 
-OpenClAccelerationCalculationImpl::OpenClAccelerationCalculationImpl() :
+template<typename TForceLaw>
+BasicOpenClAccelerationCalculationImpl<TForceLaw>::BasicOpenClAccelerationCalculationImpl(const TForceLaw &forceLaw) :
 		pContext_(nullptr),
 		pCommandQueue_(nullptr),
-		pProgram_(nullptr),
-		deviceMemoryAlreadyAllocated_(false),
+		pPipeline_(nullptr),
 		pMassesBuffer_(nullptr),
 		pPositionsBuffer_(nullptr),
-		pAccelerationsBuffer_(nullptr) {
+		pAccelerationsBuffer_(nullptr),
+		device_(nullptr),
+		forceLawSource_(forceLaw.createOpenClSource()),
+		isPositionCompressionEnabled_(false),
+		pCompressedProgram_(nullptr),
+		pTileHeadersBuffer_(nullptr),
+		pPackedBodiesBuffer_(nullptr),
+		compressedBodiesCapacity_(0),
+		compressedTilesCapacity_(0) {
 
 	const OpenClToolkit::DeviceManager &deviceManager = OpenClToolkit::DeviceManager::getInstance();
 	cl_device_id device;
@@ -34,50 +44,104 @@ OpenClAccelerationCalculationImpl::OpenClAccelerationCalculationImpl() :
 		);
 	}
 
+	device_ = device;
 	pContext_ = new OpenClToolkit::Context(device);
 	pCommandQueue_ = new OpenClToolkit::CommandQueue(*pContext_, device);
 
-	const std::string kernelSourceCode = commons::io::readTextFile(RESOURCES_FOLDER_PATH"calc_accelerations_kernel.cl");
-	pProgram_ = new OpenClToolkit::Program(kernelSourceCode.c_str(), "calcAccelerations", *pContext_, device);
+	// the kernel uses the macros of the force law, so its source has to be prepended
+	const std::string kernelSourceCode = forceLawSource_ +
+										 commons::io::readTextFile(RESOURCES_FOLDER_PATH"calc_accelerations_kernel.cl");
+	pPipeline_ = new OpenClPipeline(device, kernelSourceCode, "calcAccelerationsOfBatch");
 }
 
-OpenClAccelerationCalculationImpl::~OpenClAccelerationCalculationImpl() {
+template<typename TForceLaw>
+BasicOpenClAccelerationCalculationImpl<TForceLaw>::~BasicOpenClAccelerationCalculationImpl() {
 	delete pCommandQueue_;
 	pCommandQueue_ = nullptr;
-	delete pProgram_;
-	pProgram_ = nullptr;
+	delete pPipeline_;
+	pPipeline_ = nullptr;
 	delete pMassesBuffer_;
 	pMassesBuffer_ = nullptr;
 	delete pPositionsBuffer_;
 	pPositionsBuffer_ = nullptr;
 	delete pAccelerationsBuffer_;
 	pAccelerationsBuffer_ = nullptr;
+	delete pCompressedProgram_;
+	pCompressedProgram_ = nullptr;
+	delete pTileHeadersBuffer_;
+	pTileHeadersBuffer_ = nullptr;
+	delete pPackedBodiesBuffer_;
+	pPackedBodiesBuffer_ = nullptr;
 	delete pContext_;
 	pContext_ = nullptr;
 }
 
-void OpenClAccelerationCalculationImpl::calcAccelerations(
+template<typename TForceLaw>
+void BasicOpenClAccelerationCalculationImpl<TForceLaw>::calcAccelerations(
 		const Bodies<float, float, float> &bodies,
 		const size_t numBodies,
 		float *accelerations,
 		const float squaredSofteningFactor
 ) {
+	if (isPositionCompressionEnabled_) {
+		calcAccelerationsFromCompressedTiles(bodies, numBodies, accelerations, squaredSofteningFactor);
+		return;
+	}
+	// the uploads, the kernels and the downloads of the batches overlap
+	pPipeline_->calcAccelerations(bodies.masses, bodies.positions, numBodies, 0, numBodies, accelerations,
+								  squaredSofteningFactor);
+}
+
+template<typename TForceLaw>
+bool BasicOpenClAccelerationCalculationImpl<TForceLaw>::isTargetRangeSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicOpenClAccelerationCalculationImpl<TForceLaw>::calcAccelerationsOfTargetRange(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const size_t targetBegin,
+		const size_t targetEnd,
+		float *accelerations,
+		const float squaredSofteningFactor
+) {
+	if (isPositionCompressionEnabled_) {
+		// let it crash
+		throw std::logic_error("The compressed positions do not support target ranges.");
+	}
+	pPipeline_->calcAccelerations(bodies.masses, bodies.positions, numBodies, targetBegin, targetEnd, accelerations,
+								  squaredSofteningFactor);
+}
+
+template<typename TForceLaw>
+void BasicOpenClAccelerationCalculationImpl<TForceLaw>::calcAccelerationsFromCompressedTiles(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *accelerations,
+		const float squaredSofteningFactor
+) {
+	compressedPositionTiles_.compress(bodies, numBodies);
+	const size_t numTiles = compressedPositionTiles_.getNumTiles();
 	const size_t floatScalarBufferSize = sizeof(cl_float) * numBodies;
 	const size_t float3dVectorBufferSize = floatScalarBufferSize * 3; // reuse floatScalarBufferSize in this calculation
-	bool expected = false;
-	if (deviceMemoryAlreadyAllocated_.compare_exchange_strong(expected, true)) {
-		// allocate memory on the device
-		pMassesBuffer_ = new OpenClToolkit::ReadOnlyBuffer(*pContext_, floatScalarBufferSize);
-		pPositionsBuffer_ = new OpenClToolkit::ReadOnlyBuffer(*pContext_, float3dVectorBufferSize);
-		pAccelerationsBuffer_ = new OpenClToolkit::WriteOnlyBuffer(*pContext_, float3dVectorBufferSize);
-
-		// set the arguments of the kernel function:
-		pProgram_->setKernelArg(0, sizeof(cl_mem), *pMassesBuffer_);
-		pProgram_->setKernelArg(1, sizeof(cl_mem), *pPositionsBuffer_);
-		pProgram_->setKernelArg(2, sizeof(cl_mem), *pAccelerationsBuffer_);
-		pProgram_->setKernelArg(3, sizeof(cl_ulong), &numBodies);
-		pProgram_->setKernelArg(4, sizeof(cl_float), &squaredSofteningFactor);
+	const size_t tileHeadersBufferSize = sizeof(cl_float) * CompressedPositionTiles::NUM_HEADER_FLOATS * numTiles;
+	const size_t packedBodiesBufferSize = sizeof(cl_half) * 4 * numBodies;
+	if (nullptr == pCompressedProgram_) {
+		// the kernel uses the macros of the force law and the tile size, so they have to be prepended
+		const std::string kernelSourceCode =
+				forceLawSource_ +
+				"#define COMPRESSED_TILE_SIZE " + std::to_string(CompressedPositionTiles::TILE_SIZE) + "\n" +
+				commons::io::readTextFile(RESOURCES_FOLDER_PATH"calc_accelerations_compressed_kernel.cl");
+		pCompressedProgram_ = new OpenClToolkit::Program(kernelSourceCode.c_str(),
+														 "calcAccelerationsFromCompressedTiles", *pContext_, device_);
 	}
+	reserveCompressedBuffers(numBodies, numTiles);
+
+	// the number of bodies and the softening may change between the calls, so they are set every time
+	const cl_ulong numBodiesArgument = numBodies;
+	pCompressedProgram_->setKernelArg(5, sizeof(cl_ulong), &numBodiesArgument);
+	pCompressedProgram_->setKernelArg(6, sizeof(cl_float), &squaredSofteningFactor);
 
 	// transfer data into the device memory
 	try {
@@ -91,14 +155,24 @@ void OpenClAccelerationCalculationImpl::calcAccelerations(
 				*pPositionsBuffer_,
 				float3dVectorBufferSize
 		);
+		pCommandQueue_->enqueueCommandCopyBytesFromHostMemoryIntoDeviceMemory(
+				compressedPositionTiles_.getTileHeaders(),
+				*pTileHeadersBuffer_,
+				tileHeadersBufferSize
+		);
+		pCommandQueue_->enqueueCommandCopyBytesFromHostMemoryIntoDeviceMemory(
+				compressedPositionTiles_.getPackedBodies(),
+				*pPackedBodiesBuffer_,
+				packedBodiesBufferSize
+		);
 	} catch (const std::runtime_error &error) {
-		pProgram_->printDeviceMemoryInfo(true);
+		pCompressedProgram_->printDeviceMemoryInfo(true);
 		// rethrow
 		throw error;
 	}
 
 	// execute the program on the device
-	pCommandQueue_->enqueueCommandExecuteProgramOnDevice(*pProgram_, numBodies);
+	pCommandQueue_->enqueueCommandExecuteProgramOnDevice(*pCompressedProgram_, numBodies);
 
 	// get data back from the device memory
 	try {
@@ -108,8 +182,56 @@ void OpenClAccelerationCalculationImpl::calcAccelerations(
 				float3dVectorBufferSize
 		);
 	} catch (const std::runtime_error &error) {
-		pProgram_->printDeviceMemoryInfo(true);
+		pCompressedProgram_->printDeviceMemoryInfo(true);
 		// rethrow
 		throw error;
 	}
 }
+
+template<typename TForceLaw>
+void BasicOpenClAccelerationCalculationImpl<TForceLaw>::reserveCompressedBuffers(const size_t numBodies,
+																				  const size_t numTiles) {
+	if ((numBodies <= compressedBodiesCapacity_) && (numTiles <= compressedTilesCapacity_)) {
+		return;
+	}
+	// the buffers grow only, so alternating numbers of bodies do not reallocate them every time
+	const size_t bodiesCapacity = std::max(numBodies, compressedBodiesCapacity_);
+	const size_t tilesCapacity = std::max(numTiles, compressedTilesCapacity_);
+	delete pMassesBuffer_;
+	delete pPositionsBuffer_;
+	delete pAccelerationsBuffer_;
+	delete pTileHeadersBuffer_;
+	delete pPackedBodiesBuffer_;
+	pMassesBuffer_ = pPositionsBuffer_ = pTileHeadersBuffer_ = pPackedBodiesBuffer_ = nullptr;
+	pAccelerationsBuffer_ = nullptr;
+	compressedBodiesCapacity_ = compressedTilesCapacity_ = 0;
+
+	// allocate memory on the device, the masses and positions of the target bodies stay exact
+	pMassesBuffer_ = new OpenClToolkit::ReadOnlyBuffer(*pContext_, sizeof(cl_float) * bodiesCapacity);
+	pPositionsBuffer_ = new OpenClToolkit::ReadOnlyBuffer(*pContext_, sizeof(cl_float) * 3 * bodiesCapacity);
+	pAccelerationsBuffer_ = new OpenClToolkit::WriteOnlyBuffer(*pContext_, sizeof(cl_float) * 3 * bodiesCapacity);
+	pTileHeadersBuffer_ = new OpenClToolkit::ReadOnlyBuffer(
+			*pContext_, sizeof(cl_float) * CompressedPositionTiles::NUM_HEADER_FLOATS * tilesCapacity);
+	pPackedBodiesBuffer_ = new OpenClToolkit::ReadOnlyBuffer(*pContext_, sizeof(cl_half) * 4 * bodiesCapacity);
+
+	// set the arguments of the kernel function, which refer to the new buffers:
+	pCompressedProgram_->setKernelArg(0, sizeof(cl_mem), *pMassesBuffer_);
+	pCompressedProgram_->setKernelArg(1, sizeof(cl_mem), *pPositionsBuffer_);
+	pCompressedProgram_->setKernelArg(2, sizeof(cl_mem), *pTileHeadersBuffer_);
+	pCompressedProgram_->setKernelArg(3, sizeof(cl_mem), *pPackedBodiesBuffer_);
+	pCompressedProgram_->setKernelArg(4, sizeof(cl_mem), *pAccelerationsBuffer_);
+	compressedBodiesCapacity_ = bodiesCapacity;
+	compressedTilesCapacity_ = tilesCapacity;
+}
+
+template<typename TForceLaw>
+bool BasicOpenClAccelerationCalculationImpl<TForceLaw>::isPositionCompressionSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicOpenClAccelerationCalculationImpl<TForceLaw>::setPositionCompressionEnabled(const bool enabled) {
+	isPositionCompressionEnabled_ = enabled;
+}
+
+PHYSICS_INSTANTIATE_FOR_ALL_FORCE_LAWS(physics::BasicOpenClAccelerationCalculationImpl)
@@ -2,13 +2,16 @@
 #define PHYSICS_ENGINE_OPENCL_ACCELERATION_CALCULATION_H
 
 // Reminder: Always include standard library and system headers before including your own headers.
-#include <atomic>
+#include <string>
 
 #include "physics/acceleration_calculation.h"
+#include "physics/force_laws.h"
 #include "opencl/program.h"
 #include "opencl/command_queue.h"
 #include "opencl/read_only_buffer.h"
 #include "opencl/write_only_buffer.h"
+#include "compressed_position_tiles.h"
+#include "opencl_pipeline.h"
 
 /**
  * @brief Namespace for physics-related functions and classes.
@@ -16,9 +19,14 @@
 namespace physics {
 
 	/**
-	 * @brief An <strong>OpenCL-accelerated</strong> implementation of the calculation of gravitational accelerations of N bodies.
+	 * @brief An <strong>OpenCL-accelerated</strong> implementation of the calculation of accelerations of N bodies.
+	 * @details The OpenCL source of the force law is generated from the same definition as the C++ force law and is
+	 * prepended to the kernel source. The template is explicitly instantiated for each force law in its translation
+	 * unit.
+	 * @tparam TForceLaw the force law between two bodies.
 	 */
-	class OpenClAccelerationCalculationImpl : public IAccelerationCalculation {
+	template<typename TForceLaw>
+	class BasicOpenClAccelerationCalculationImpl : public IAccelerationCalculation {
 
 		private:
 			/**
@@ -32,17 +40,14 @@ namespace physics {
 			OpenClToolkit::CommandQueue *pCommandQueue_;
 
 			/**
-			  * The pointer to the OpenCL program that calculates the gravitational accelerations of N bodies.
-			  */
-			OpenClToolkit::Program *pProgram_;
-
-			/**
-			   * A boolean flag to indicate if the device memory is already allocated.
-			   */
-			std::atomic<bool> deviceMemoryAlreadyAllocated_;
+			 * The pointer to the pipeline that calculates the accelerations of N bodies, which overlaps the transfers
+			 * of the bodies with the kernels.
+			 */
+			OpenClPipeline *pPipeline_;
 
 			/**
-			  * The pointer to the read only buffer on the device for the masses of the bodies.
+			  * The pointer to the read only buffer on the device for the masses of the bodies, only used by the
+			  * compressed program.
 			  */
 			OpenClToolkit::ReadOnlyBuffer *pMassesBuffer_;
 
@@ -56,16 +61,86 @@ namespace physics {
 			 */
 			OpenClToolkit::WriteOnlyBuffer *pAccelerationsBuffer_;
 
+			/**
+			 * The device which executes the programs.
+			 */
+			cl_device_id device_;
+
+			/**
+			 * The OpenCL source of the force law, which is prepended to the kernel sources.
+			 */
+			std::string forceLawSource_;
+
+			/**
+			 * Whether the source bodies are read from compressed position tiles.
+			 */
+			bool isPositionCompressionEnabled_;
+
+			/**
+			 * The compressed position tiles of the source bodies, only used if the compression is enabled.
+			 */
+			CompressedPositionTiles compressedPositionTiles_;
+
+			/**
+			 * The pointer to the OpenCL program that reads the source bodies from compressed position tiles, which is
+			 * built when the compression is used for the first time.
+			 */
+			OpenClToolkit::Program *pCompressedProgram_;
+
+			/**
+			 * The pointer to the read only buffer on the device for the headers of the compressed position tiles.
+			 */
+			OpenClToolkit::ReadOnlyBuffer *pTileHeadersBuffer_;
+
+			/**
+			 * The pointer to the read only buffer on the device for the packed bodies of the compressed position tiles.
+			 */
+			OpenClToolkit::ReadOnlyBuffer *pPackedBodiesBuffer_;
+
+			/**
+			 * The number of bodies the buffers of the compressed program have room for.
+			 */
+			size_t compressedBodiesCapacity_;
+
+			/**
+			 * The number of compressed position tiles the buffer of the tile headers has room for.
+			 */
+			size_t compressedTilesCapacity_;
+
+			/**
+			 * @brief Builds the buffers of the compressed program anew and sets them as its kernel arguments, if they
+			 * are too small for the passed numbers of bodies and tiles.
+			 * @param numBodies the number of bodies.
+			 * @param numTiles the number of compressed position tiles.
+			 */
+			void reserveCompressedBuffers(size_t numBodies, size_t numTiles);
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies, whose source bodies are read from the compressed
+			 * position tiles.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[out] accelerations the accelerations of the passed bodies.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerationsFromCompressedTiles(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor
+			);
+
 		public:
 			/**
-			  * @brief The default constructor. Creates an new instance of this class.
+			  * @brief The parameterized constructor. Creates an new instance of this class.
+			  * @param forceLaw the force law between two bodies, which is compiled into the kernel.
 			  */
-			OpenClAccelerationCalculationImpl();
+			explicit BasicOpenClAccelerationCalculationImpl(const TForceLaw &forceLaw = TForceLaw());
 
 			/**
 			 * @brief The destructor.
 			 */
-			~OpenClAccelerationCalculationImpl() override;
+			~BasicOpenClAccelerationCalculationImpl() override;
 
 			/**
 			 * @brief Calculates the accelerations of the given bodies.
@@ -82,7 +157,52 @@ namespace physics {
 					float *accelerations,
 					float squaredSofteningFactor
 			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the accelerations of a range of target bodies can be calculated.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isTargetRangeSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations of the target bodies of the passed range caused by all bodies.
+			 * @details All bodies are uploaded, but only the accelerations of the target bodies are calculated and
+			 * downloaded.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param targetBegin the index of the first target body.
+			 * @param targetEnd the index after the last target body, at most <code>numBodies</code>.
+			 * @param[in, out] accelerations the accelerations of all passed bodies, of which only the elements of the
+			 * 					target bodies are written.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 * @throws std::logic_error if the position compression is enabled.
+			 */
+			void calcAccelerationsOfTargetRange(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					size_t targetBegin,
+					size_t targetEnd,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the source bodies may be read from compressed position tiles.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isPositionCompressionSupported() const override;
+
+			/**
+			 * @brief Enables or disables the compressed position tiles of the source bodies.
+			 * @param enabled <code>true</code> if the source bodies should be compressed.
+			 */
+			void setPositionCompressionEnabled(bool enabled) override;
 	};
+
+	/**
+	 * @brief The OpenCL-accelerated implementation of the calculation of gravitational accelerations of N bodies.
+	 */
+	using OpenClAccelerationCalculationImpl = BasicOpenClAccelerationCalculationImpl<NewtonianForceLaw>;
 }
 
 #endif //PHYSICS_ENGINE_OPENCL_ACCELERATION_CALCULATION_H
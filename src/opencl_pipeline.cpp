@@ -0,0 +1,280 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "opencl_pipeline.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Throws an exception, if the passed error code of the passed OpenCL function is not a success.
+	 */
+	void checkError(const cl_int errorCode, const char *const functionName) {
+		if (CL_SUCCESS != errorCode) {
+			// let it crash
+			throw std::runtime_error(std::string(functionName) + " failed with error code " +
+									 std::to_string(errorCode));
+		}
+	}
+
+	/**
+	 * @brief Returns the index of the first body of the passed batch.
+	 */
+	inline size_t calcBatchBegin(const size_t batch, const size_t numBatches, const size_t numBodies) {
+		return (batch * numBodies) / numBatches;
+	}
+}
+
+OpenClPipeline::OpenClPipeline(const cl_device_id device, const std::string &kernelSourceCode,
+							   const char *const kernelName) :
+		device_(device),
+		context_(nullptr),
+		uploadQueue_(nullptr),
+		computeQueue_(nullptr),
+		downloadQueue_(nullptr),
+		program_(nullptr),
+		kernel_(nullptr),
+		massesBuffer_(nullptr),
+		positionsBuffer_(nullptr),
+		accelerationsBuffer_(nullptr),
+		capacity_(0) {
+	try {
+		cl_int errorCode;
+		context_ = clCreateContext(nullptr, 1, &device_, nullptr, nullptr, &errorCode);
+		checkError(errorCode, "clCreateContext");
+		// three in-order queues, so the transfers and the kernels are only ordered by the events between them
+		for (cl_command_queue *const pQueue: {&uploadQueue_, &computeQueue_, &downloadQueue_}) {
+			*pQueue = clCreateCommandQueue(context_, device_, 0, &errorCode);
+			checkError(errorCode, "clCreateCommandQueue");
+		}
+
+		const char *pSourceCode = kernelSourceCode.c_str();
+		program_ = clCreateProgramWithSource(context_, 1, &pSourceCode, nullptr, &errorCode);
+		checkError(errorCode, "clCreateProgramWithSource");
+		if (CL_SUCCESS != clBuildProgram(program_, 1, &device_, nullptr, nullptr, nullptr)) {
+			size_t buildLogSize = 0;
+			clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &buildLogSize);
+			std::string buildLog(buildLogSize, '\0');
+			clGetProgramBuildInfo(program_, device_, CL_PROGRAM_BUILD_LOG, buildLogSize, buildLog.data(), nullptr);
+			// let it crash
+			throw std::runtime_error("The kernel " + std::string(kernelName) + " cannot be built:\n" + buildLog);
+		}
+		kernel_ = clCreateKernel(program_, kernelName, &errorCode);
+		checkError(errorCode, "clCreateKernel");
+	} catch (...) {
+		release();
+		throw;
+	}
+}
+
+OpenClPipeline::~OpenClPipeline() {
+	release();
+}
+
+void OpenClPipeline::release() {
+	// the commands may still use the host memory or the events, if a calculation failed
+	for (const cl_command_queue queue: {uploadQueue_, computeQueue_, downloadQueue_}) {
+		if (nullptr != queue) {
+			clFinish(queue);
+		}
+	}
+	releaseEvents();
+	for (const cl_mem buffer: {massesBuffer_, positionsBuffer_, accelerationsBuffer_}) {
+		if (nullptr != buffer) {
+			clReleaseMemObject(buffer);
+		}
+	}
+	massesBuffer_ = positionsBuffer_ = accelerationsBuffer_ = nullptr;
+	if (nullptr != kernel_) {
+		clReleaseKernel(kernel_);
+		kernel_ = nullptr;
+	}
+	if (nullptr != program_) {
+		clReleaseProgram(program_);
+		program_ = nullptr;
+	}
+	for (cl_command_queue *const pQueue: {&uploadQueue_, &computeQueue_, &downloadQueue_}) {
+		if (nullptr != *pQueue) {
+			clReleaseCommandQueue(*pQueue);
+			*pQueue = nullptr;
+		}
+	}
+	if (nullptr != context_) {
+		clReleaseContext(context_);
+		context_ = nullptr;
+	}
+}
+
+std::vector<cl_device_id> physics::findEligibleOpenClDevices() {
+	std::vector<cl_device_id> eligibleDevices;
+	cl_uint numPlatforms = 0;
+	if ((CL_SUCCESS != clGetPlatformIDs(0, nullptr, &numPlatforms)) || (0 == numPlatforms)) {
+		return eligibleDevices;
+	}
+	std::vector<cl_platform_id> platforms(numPlatforms);
+	checkError(clGetPlatformIDs(numPlatforms, platforms.data(), nullptr), "clGetPlatformIDs");
+	for (const cl_platform_id platform: platforms) {
+		cl_uint numDevices = 0;
+		// a platform without devices reports an error instead of zero devices
+		if ((CL_SUCCESS != clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, 0, nullptr, &numDevices)) ||
+			(0 == numDevices)) {
+			continue;
+		}
+		std::vector<cl_device_id> devices(numDevices);
+		checkError(clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, numDevices, devices.data(), nullptr),
+				   "clGetDeviceIDs");
+		for (const cl_device_id device: devices) {
+			cl_bool isAvailable = CL_FALSE, isCompilerAvailable = CL_FALSE;
+			clGetDeviceInfo(device, CL_DEVICE_AVAILABLE, sizeof(cl_bool), &isAvailable, nullptr);
+			clGetDeviceInfo(device, CL_DEVICE_COMPILER_AVAILABLE, sizeof(cl_bool), &isCompilerAvailable, nullptr);
+			if (isAvailable && isCompilerAvailable) {
+				eligibleDevices.push_back(device);
+			}
+		}
+	}
+	return eligibleDevices;
+}
+
+size_t OpenClPipeline::calcNumBatches(const size_t numBodies) {
+	return std::clamp<size_t>(numBodies / MIN_BATCH_SIZE, 1, MAX_NUM_BATCHES);
+}
+
+void OpenClPipeline::reserve(const size_t numBodies) {
+	if (numBodies <= capacity_) {
+		return;
+	}
+	for (const cl_mem buffer: {massesBuffer_, positionsBuffer_, accelerationsBuffer_}) {
+		if (nullptr != buffer) {
+			clReleaseMemObject(buffer);
+		}
+	}
+	massesBuffer_ = positionsBuffer_ = accelerationsBuffer_ = nullptr;
+	capacity_ = 0;
+
+	cl_int errorCode;
+	massesBuffer_ = clCreateBuffer(context_, CL_MEM_READ_ONLY, sizeof(cl_float) * numBodies, nullptr, &errorCode);
+	checkError(errorCode, "clCreateBuffer");
+	positionsBuffer_ = clCreateBuffer(context_, CL_MEM_READ_ONLY, sizeof(cl_float) * 3 * numBodies, nullptr,
+									  &errorCode);
+	checkError(errorCode, "clCreateBuffer");
+	// the kernels of the later source batches accumulate into the accelerations
+	accelerationsBuffer_ = clCreateBuffer(context_, CL_MEM_READ_WRITE, sizeof(cl_float) * 3 * numBodies, nullptr,
+										  &errorCode);
+	checkError(errorCode, "clCreateBuffer");
+	capacity_ = numBodies;
+}
+
+void OpenClPipeline::releaseEvents() {
+	for (std::vector<cl_event> *const pEvents: {&uploadEvents_, &kernelEvents_, &downloadEvents_}) {
+		for (const cl_event event: *pEvents) {
+			if (nullptr != event) {
+				clReleaseEvent(event);
+			}
+		}
+		pEvents->clear();
+	}
+}
+
+void OpenClPipeline::calcAccelerations(const float *const masses, const float *const positions,
+									   const size_t numBodies, const size_t targetBegin, const size_t targetEnd,
+									   float *const accelerations, const float squaredSofteningFactor) {
+	if (targetEnd <= targetBegin) {
+		return;
+	}
+	reserve(numBodies);
+	releaseEvents();
+	const size_t numBatches = calcNumBatches(numBodies);
+	uploadEvents_.assign(numBatches * 2, nullptr);
+	kernelEvents_.assign(numBatches, nullptr);
+	downloadEvents_.assign(numBatches, nullptr);
+
+	checkError(clSetKernelArg(kernel_, 0, sizeof(cl_mem), &massesBuffer_), "clSetKernelArg");
+	checkError(clSetKernelArg(kernel_, 1, sizeof(cl_mem), &positionsBuffer_), "clSetKernelArg");
+	checkError(clSetKernelArg(kernel_, 2, sizeof(cl_mem), &accelerationsBuffer_), "clSetKernelArg");
+	checkError(clSetKernelArg(kernel_, 7, sizeof(cl_float), &squaredSofteningFactor), "clSetKernelArg");
+
+	// the targets of a batch are clipped to the passed range, so batches outside of it are only sources
+	const auto calcBatchTargetBegin = [&](const size_t batch) {
+		return std::clamp(calcBatchBegin(batch, numBatches, numBodies), targetBegin, targetEnd);
+	};
+	// the compute queue is in-order, so only its first kernel of a batch has to wait for the upload
+	cl_uint numWaitEvents = 0;
+	const cl_event *pWaitEvents = nullptr;
+	// the arguments are copied by the enqueue, so the kernel object can be reused for every pair of batches
+	const auto enqueueKernel = [&](const size_t target, const size_t source, cl_event *const pEvent) {
+		const cl_ulong batchTargetBegin = calcBatchTargetBegin(target);
+		const cl_ulong batchTargetEnd = calcBatchTargetBegin(target + 1);
+		if (batchTargetEnd <= batchTargetBegin) {
+			return;
+		}
+		const cl_ulong sourceBegin = calcBatchBegin(source, numBatches, numBodies);
+		const cl_ulong sourceEnd = calcBatchBegin(source + 1, numBatches, numBodies);
+		// the first source batch overwrites the accelerations of the previous calculation
+		const cl_int isFirstSourceBatch = (0 == source) ? 1 : 0;
+		checkError(clSetKernelArg(kernel_, 3, sizeof(cl_ulong), &batchTargetBegin), "clSetKernelArg");
+		checkError(clSetKernelArg(kernel_, 4, sizeof(cl_ulong), &batchTargetEnd), "clSetKernelArg");
+		checkError(clSetKernelArg(kernel_, 5, sizeof(cl_ulong), &sourceBegin), "clSetKernelArg");
+		checkError(clSetKernelArg(kernel_, 6, sizeof(cl_ulong), &sourceEnd), "clSetKernelArg");
+		checkError(clSetKernelArg(kernel_, 8, sizeof(cl_int), &isFirstSourceBatch), "clSetKernelArg");
+		const size_t globalWorkSize = batchTargetEnd - batchTargetBegin;
+		checkError(clEnqueueNDRangeKernel(computeQueue_, kernel_, 1, nullptr, &globalWorkSize, nullptr,
+										  numWaitEvents, pWaitEvents, pEvent), "clEnqueueNDRangeKernel");
+		numWaitEvents = 0;
+		pWaitEvents = nullptr;
+	};
+	// the target is complete after its kernel of the last source batch, so it is downloaded while the kernels of
+	// the later targets run
+	const auto enqueueDownload = [&](const size_t target) {
+		if (nullptr == kernelEvents_[target]) {
+			return;
+		}
+		const size_t batchTargetBegin = calcBatchTargetBegin(target);
+		const size_t numTargetBodies = calcBatchTargetBegin(target + 1) - batchTargetBegin;
+		checkError(clEnqueueReadBuffer(downloadQueue_, accelerationsBuffer_, CL_FALSE,
+									   sizeof(cl_float) * 3 * batchTargetBegin, sizeof(cl_float) * 3 * numTargetBodies,
+									   accelerations + (batchTargetBegin * 3), 1, &kernelEvents_[target],
+									   &downloadEvents_[target]), "clEnqueueReadBuffer");
+		checkError(clFlush(downloadQueue_), "clFlush");
+	};
+
+	for (size_t batch = 0; batch < numBatches; ++batch) {
+		const size_t begin = calcBatchBegin(batch, numBatches, numBodies);
+		const size_t numBatchBodies = calcBatchBegin(batch + 1, numBatches, numBodies) - begin;
+		cl_event *const pUploadEvents = &uploadEvents_[batch * 2];
+		checkError(clEnqueueWriteBuffer(uploadQueue_, massesBuffer_, CL_FALSE, sizeof(cl_float) * begin,
+										sizeof(cl_float) * numBatchBodies, masses + begin, 0, nullptr,
+										&pUploadEvents[0]), "clEnqueueWriteBuffer");
+		checkError(clEnqueueWriteBuffer(uploadQueue_, positionsBuffer_, CL_FALSE, sizeof(cl_float) * 3 * begin,
+										sizeof(cl_float) * 3 * numBatchBodies, positions + (begin * 3), 0, nullptr,
+										&pUploadEvents[1]), "clEnqueueWriteBuffer");
+		checkError(clFlush(uploadQueue_), "clFlush");
+		// the upload queue is in-order as well, so if no kernel of this batch is launched, the first kernel of a
+		// later batch waits for this upload implicitly
+		numWaitEvents = 2;
+		pWaitEvents = pUploadEvents;
+
+		const bool isLastBatch = (batch + 1) == numBatches;
+		// the new batch as sources of the already uploaded targets
+		for (size_t target = 0; target < batch; ++target) {
+			enqueueKernel(target, batch, isLastBatch ? &kernelEvents_[target] : nullptr);
+			if (isLastBatch) {
+				enqueueDownload(target);
+			}
+		}
+		// the new batch as targets of all uploaded sources
+		for (size_t source = 0; source <= batch; ++source) {
+			enqueueKernel(batch, source, (isLastBatch && (source == batch)) ? &kernelEvents_[batch] : nullptr);
+		}
+		checkError(clFlush(computeQueue_), "clFlush");
+	}
+	enqueueDownload(numBatches - 1);
+
+	// the batches outside of the target range have no downloads
+	downloadEvents_.erase(std::remove(downloadEvents_.begin(), downloadEvents_.end(), nullptr),
+						  downloadEvents_.end());
+	checkError(clWaitForEvents(static_cast<cl_uint>(downloadEvents_.size()), downloadEvents_.data()),
+			   "clWaitForEvents");
+	releaseEvents();
+}
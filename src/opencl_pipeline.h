@@ -0,0 +1,191 @@
+#ifndef PHYSICS_ENGINE_OPENCL_PIPELINE_H
+#define PHYSICS_ENGINE_OPENCL_PIPELINE_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <string>
+#include <vector>
+
+#ifdef __APPLE__
+#include <OpenCL/opencl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A pipeline which overlaps the transfers of the bodies with the calculation of their accelerations on an
+	 * OpenCL device.
+	 * @details The bodies are split into batches. The uploads, the kernels and the downloads are enqueued without
+	 * blocking on three command queues and are ordered by events only, so batch <code>k + 1</code> is uploaded while
+	 * the kernels of batch <code>k</code> run and the accelerations of finished batches are downloaded while the
+	 * kernels of the later batches run. Since every target batch needs all source batches, the kernels are launched
+	 * per pair of a target and a source batch: as soon as a batch arrives, it is applied as sources to the already
+	 * uploaded targets and as targets to the already uploaded sources.
+	 * The toolkit has no events and no buffer offsets, so the pipeline uses the OpenCL API directly.
+	 */
+	class OpenClPipeline {
+
+		private:
+			/**
+			 * The device which executes the kernels.
+			 */
+			cl_device_id device_;
+
+			/**
+			 * The context of the device.
+			 */
+			cl_context context_;
+
+			/**
+			 * The in-order command queue of the uploads.
+			 */
+			cl_command_queue uploadQueue_;
+
+			/**
+			 * The in-order command queue of the kernels.
+			 */
+			cl_command_queue computeQueue_;
+
+			/**
+			 * The in-order command queue of the downloads.
+			 */
+			cl_command_queue downloadQueue_;
+
+			/**
+			 * The program of the kernel.
+			 */
+			cl_program program_;
+
+			/**
+			 * The kernel which calculates the accelerations of a target batch caused by a source batch.
+			 */
+			cl_kernel kernel_;
+
+			/**
+			 * The buffer on the device for the masses of the bodies, <code>nullptr</code> until the first calculation.
+			 */
+			cl_mem massesBuffer_;
+
+			/**
+			 * The buffer on the device for the positions of the bodies, <code>nullptr</code> until the first
+			 * calculation.
+			 */
+			cl_mem positionsBuffer_;
+
+			/**
+			 * The buffer on the device for the accelerations of the bodies, <code>nullptr</code> until the first
+			 * calculation.
+			 */
+			cl_mem accelerationsBuffer_;
+
+			/**
+			 * The number of bodies which fit into the buffers.
+			 */
+			size_t capacity_;
+
+			/**
+			 * The events of the uploads of the masses and the positions, two per batch.
+			 */
+			std::vector<cl_event> uploadEvents_;
+
+			/**
+			 * The events of the last kernels of the target batches, one per batch.
+			 */
+			std::vector<cl_event> kernelEvents_;
+
+			/**
+			 * The events of the downloads, one per batch.
+			 */
+			std::vector<cl_event> downloadEvents_;
+
+			/**
+			 * @brief Reallocates the buffers on the device, if they are too small for the passed number of bodies.
+			 * @param numBodies the number of bodies.
+			 */
+			void reserve(size_t numBodies);
+
+			/**
+			 * @brief Waits for the enqueued commands and releases all OpenCL objects.
+			 */
+			void release();
+
+			/**
+			 * @brief Releases the events of the last calculation.
+			 */
+			void releaseEvents();
+
+		public:
+			/**
+			 * The maximum number of batches, since the number of kernel launches grows quadratically with it.
+			 */
+			static constexpr size_t MAX_NUM_BATCHES = 8;
+
+			/**
+			 * The minimum number of bodies of a batch, so small systems are not split into launches which are too
+			 * small to occupy the device.
+			 */
+			static constexpr size_t MIN_BATCH_SIZE = 4'096;
+
+			/**
+			 * @brief The parameterized constructor. Creates a new pipeline by the parameters.
+			 * @param device the device which executes the kernels.
+			 * @param kernelSourceCode the OpenCL source code of the kernel including the source of the force law.
+			 * @param kernelName the name of the kernel, whose parameters are the masses, the positions and the
+			 * accelerations, the begin and the end of the targets, the begin and the end of the sources, the squared
+			 * softening factor and whether the accelerations are overwritten instead of accumulated.
+			 * @throws std::runtime_error if the context, the queues or the kernel cannot be created.
+			 */
+			OpenClPipeline(cl_device_id device, const std::string &kernelSourceCode, const char *kernelName);
+
+			/**
+			 * @brief The deleted copy constructor, since the OpenCL objects are owned exclusively.
+			 */
+			OpenClPipeline(const OpenClPipeline &) = delete;
+
+			/**
+			 * @brief The deleted copy assignment, since the OpenCL objects are owned exclusively.
+			 */
+			OpenClPipeline &operator=(const OpenClPipeline &) = delete;
+
+			/**
+			 * @brief The destructor, which releases all OpenCL objects.
+			 */
+			~OpenClPipeline();
+
+			/**
+			 * @brief Calculates the accelerations of the passed target bodies caused by all bodies and waits until they
+			 * are downloaded.
+			 * @details All bodies are uploaded, but only the batches which contain target bodies are calculated.
+			 * @param masses the masses of the bodies.
+			 * @param positions the positions of the bodies.
+			 * @param numBodies the number of bodies.
+			 * @param targetBegin the index of the first target body.
+			 * @param targetEnd the index after the last target body, at most <code>numBodies</code>.
+			 * @param[out] accelerations the accelerations of all bodies, of which only the elements of the target
+			 * bodies are written.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 * @throws std::runtime_error if a command cannot be enqueued or fails.
+			 */
+			void calcAccelerations(const float *masses, const float *positions, size_t numBodies, size_t targetBegin,
+								   size_t targetEnd, float *accelerations, float squaredSofteningFactor);
+
+			/**
+			 * @brief Returns the number of batches of the passed number of bodies.
+			 * @param numBodies the number of bodies.
+			 * @return the number of batches, at least one.
+			 */
+			[[nodiscard]] static size_t calcNumBatches(size_t numBodies);
+	};
+
+	/**
+	 * @brief Returns the devices of all OpenCL platforms which are available and have a compiler.
+	 * @return the eligible devices, which may be empty.
+	 */
+	std::vector<cl_device_id> findEligibleOpenClDevices();
+}
+
+#endif //PHYSICS_ENGINE_OPENCL_PIPELINE_H
@@ -1,64 +1,382 @@
 // Reminder: Always include standard library and system headers before including your own headers.
-#include <cmath>
+#include <algorithm>
 #include <omp.h>
+#include <stdexcept>
 
 #include "openmp_acceleration_calculation.h"
-#include "physics/astronomical_algorithms.h"
+#include "reproducible_sum.h"
 
 using namespace physics;
 
-void OpenMpAccelerationCalculationImpl::calcAccelerations(
+template<typename TForceLaw>
+BasicOpenMpAccelerationCalculationImpl<TForceLaw>::BasicOpenMpAccelerationCalculationImpl(const TForceLaw &forceLaw) :
+		forceLaw_(forceLaw),
+		isPositionCompressionEnabled_(false),
+		isDeterministicModeEnabled_(false) {
+}
+
+template<typename TForceLaw>
+template<bool CalcPotentials>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::sweep(
 		const Bodies<float, float, float> &bodies,
 		const size_t numBodies,
+		const size_t targetBegin,
+		const size_t targetEnd,
 		float *const accelerations,
+		float *const potentials,
 		const float squaredSofteningFactor
 ) {
 	if (1 < numBodies) {
+		// data members cannot be listed in the data-sharing clauses, hence the local copy
+		const TForceLaw forceLaw = forceLaw_;
 		// omp_get_num_procs seems to return the number of logical (!) cores
-		omp_set_num_threads(std::min(static_cast<int>(numBodies), omp_get_num_procs()));
+		omp_set_num_threads(static_cast<int>(std::min<size_t>(std::max<size_t>(1, targetEnd - targetBegin),
+															   omp_get_num_procs())));
 		// @formatter:off
-		#pragma omp parallel for default(none) shared(bodies, numBodies, accelerations, squaredSofteningFactor)
+		#pragma omp parallel for default(none) shared(bodies, numBodies, targetBegin, targetEnd, accelerations, potentials, squaredSofteningFactor, forceLaw)
 		//@formatter:on
 		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
-		for (int i = 0; i < static_cast<long long>(numBodies); ++i) {
+		for (long long i = static_cast<long long>(targetBegin); i < static_cast<long long>(targetEnd); ++i) {
 			const size_t xCoordinateIndexBody1 = i * 3;
 			const size_t yCoordinateIndexBody1 = xCoordinateIndexBody1 + 1;
 			const size_t zCoordinateIndexBody1 = xCoordinateIndexBody1 + 2;
+			const float targetMass = bodies.masses[i];
 			float forceVector[3] = {0.0, 0.0, 0.0};
+			float potential = 0.0f;
 			for (int j = 0; j < static_cast<long long>(numBodies); ++j) {
 				if (i != j) {
 					const size_t xCoordinateIndexBody2 = j * 3;
 					const size_t yCoordinateIndexBody2 = xCoordinateIndexBody2 + 1;
 					const size_t zCoordinateIndexBody2 = xCoordinateIndexBody2 + 2;
 
+					// the distance vector points from body 1 to body 2
 					const float distanceVectorXCoordinate =
-							bodies.positions[xCoordinateIndexBody1] - bodies.positions[xCoordinateIndexBody2];
+							bodies.positions[xCoordinateIndexBody2] - bodies.positions[xCoordinateIndexBody1];
 					const float distanceVectorYCoordinate =
-							bodies.positions[yCoordinateIndexBody1] - bodies.positions[yCoordinateIndexBody2];
+							bodies.positions[yCoordinateIndexBody2] - bodies.positions[yCoordinateIndexBody1];
 					const float distanceVectorZCoordinate =
-							bodies.positions[zCoordinateIndexBody1] - bodies.positions[zCoordinateIndexBody2];
-					const float distance = std::sqrt(
+							bodies.positions[zCoordinateIndexBody2] - bodies.positions[zCoordinateIndexBody1];
+					const float distanceSquared =
 							(distanceVectorXCoordinate * distanceVectorXCoordinate) +
 							(distanceVectorYCoordinate * distanceVectorYCoordinate) +
-							(distanceVectorZCoordinate * distanceVectorZCoordinate)
-					) + squaredSofteningFactor; // to avoid zero in the following divisions
-					const float normalizedDistanceVectorXCoordinate = distanceVectorXCoordinate / distance;
-					const float normalizedDistanceVectorYCoordinate = distanceVectorYCoordinate / distance;
-					const float normalizedDistanceVectorZCoordinate = distanceVectorZCoordinate / distance;
-					const float distanceSquared = distance * distance;
-
-					const float receivedForce = bodies.masses[j] / distanceSquared;
+							(distanceVectorZCoordinate * distanceVectorZCoordinate);
+
+					const float receivedForce = forceLaw(distanceSquared, squaredSofteningFactor, targetMass,
+														 bodies.masses[j]);
 					// It is possible to write directly in to the accelerations array here, but the false sharing will
 					// reduce in this loop significantly the performance
-					forceVector[0] += (receivedForce * normalizedDistanceVectorXCoordinate);
-					forceVector[1] += (receivedForce * normalizedDistanceVectorYCoordinate);
-					forceVector[2] += (receivedForce * normalizedDistanceVectorZCoordinate);
+					forceVector[0] += (receivedForce * distanceVectorXCoordinate);
+					forceVector[1] += (receivedForce * distanceVectorYCoordinate);
+					forceVector[2] += (receivedForce * distanceVectorZCoordinate);
+					if constexpr (CalcPotentials) {
+						potential += forceLaw.calcPotentialEnergy(distanceSquared, squaredSofteningFactor, targetMass,
+																  bodies.masses[j]);
+					}
 				}
 			}
 			// false sharing is ok here
-			accelerations[xCoordinateIndexBody1] = static_cast<float>(GRAVITATIONAL_CONSTANT * forceVector[0]);
-			accelerations[yCoordinateIndexBody1] = static_cast<float>(GRAVITATIONAL_CONSTANT * forceVector[1]);
-			accelerations[zCoordinateIndexBody1] = static_cast<float>(GRAVITATIONAL_CONSTANT * forceVector[2]);
+			accelerations[xCoordinateIndexBody1] = forceVector[0];
+			accelerations[yCoordinateIndexBody1] = forceVector[1];
+			accelerations[zCoordinateIndexBody1] = forceVector[2];
+			if constexpr (CalcPotentials) {
+				potentials[i] = potential;
+			}
+		}
+	} else if constexpr (CalcPotentials) {
+		std::fill(potentials, potentials + numBodies, 0.0f);
+	}
+}
+
+template<typename TForceLaw>
+template<bool CalcPotentials>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::sweepProbes(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *const probeMasses,
+		const float *const probePositions,
+		const size_t numProbes,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	// data members cannot be listed in the data-sharing clauses, hence the local copy
+	const TForceLaw forceLaw = forceLaw_;
+	// few probes must not pay for the start of idle threads
+	omp_set_num_threads(static_cast<int>(std::min<size_t>(std::max<size_t>(1, numProbes), omp_get_num_procs())));
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, probeMasses, probePositions, numProbes, accelerations, potentials, squaredSofteningFactor, forceLaw)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long i = 0; i < static_cast<long long>(numProbes); ++i) {
+		const float probePosition[3] = {
+				probePositions[i * 3], probePositions[(i * 3) + 1], probePositions[(i * 3) + 2]
+		};
+		const float probeMass = probeMasses[i];
+		float forceVector[3] = {0.0f, 0.0f, 0.0f};
+		float potential = 0.0f;
+		for (size_t j = 0; j < numBodies; ++j) {
+			// the distance vector points from the probe to the body
+			const float distanceVector[3] = {
+					bodies.positions[j * 3] - probePosition[0],
+					bodies.positions[(j * 3) + 1] - probePosition[1],
+					bodies.positions[(j * 3) + 2] - probePosition[2]
+			};
+			const float distanceSquared = (distanceVector[0] * distanceVector[0]) +
+										  (distanceVector[1] * distanceVector[1]) +
+										  (distanceVector[2] * distanceVector[2]);
+			// a body at the position of the probe is the probe itself
+			if (0.0f < distanceSquared) {
+				const float receivedForce = forceLaw(distanceSquared, squaredSofteningFactor, probeMass,
+													 bodies.masses[j]);
+				forceVector[0] += receivedForce * distanceVector[0];
+				forceVector[1] += receivedForce * distanceVector[1];
+				forceVector[2] += receivedForce * distanceVector[2];
+				if constexpr (CalcPotentials) {
+					potential += forceLaw.calcPotentialEnergy(distanceSquared, squaredSofteningFactor, probeMass,
+															  bodies.masses[j]);
+				}
+			}
+		}
+		accelerations[i * 3] = forceVector[0];
+		accelerations[(i * 3) + 1] = forceVector[1];
+		accelerations[(i * 3) + 2] = forceVector[2];
+		if constexpr (CalcPotentials) {
+			potentials[i] = potential;
 		}
 	}
 }
+
+template<typename TForceLaw>
+template<bool CalcPotentials>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::sweepCompressed(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const size_t targetBegin,
+		const size_t targetEnd,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	// the number of target bodies of a block, whose forces stay in the registers and the L1 cache
+	constexpr size_t targetBlockSize = 64;
+	compressedPositionTiles_.compress(bodies, numBodies);
+	// data members cannot be listed in the data-sharing clauses, hence the local copies
+	const TForceLaw forceLaw = forceLaw_;
+	const CompressedPositionTiles &tiles = compressedPositionTiles_;
+	const auto numTargetBlocks = static_cast<long long>((targetEnd - targetBegin + targetBlockSize - 1) /
+														 targetBlockSize);
+	// omp_get_num_procs seems to return the number of logical (!) cores
+	omp_set_num_threads(static_cast<int>(std::min<size_t>(std::max<size_t>(1, numTargetBlocks),
+														   omp_get_num_procs())));
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, targetBegin, targetEnd, accelerations, potentials, squaredSofteningFactor, forceLaw, tiles, numTargetBlocks)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long block = 0; block < numTargetBlocks; ++block) {
+		const size_t blockBegin = targetBegin + (block * targetBlockSize);
+		const size_t blockEnd = std::min(targetEnd, blockBegin + targetBlockSize);
+		float forces[targetBlockSize * 3] = {};
+		float blockPotentials[targetBlockSize] = {};
+		float sourceBodies[CompressedPositionTiles::TILE_SIZE * 4];
+		for (size_t tile = 0; tile < tiles.getNumTiles(); ++tile) {
+			const size_t sourceBegin = tile * CompressedPositionTiles::TILE_SIZE;
+			const size_t numSourceBodies = tiles.decompressTile(tile, sourceBodies);
+			for (size_t i = blockBegin; i < blockEnd; ++i) {
+				const float targetPosition[3] = {
+						bodies.positions[i * 3], bodies.positions[(i * 3) + 1], bodies.positions[(i * 3) + 2]
+				};
+				const float targetMass = bodies.masses[i];
+				float forceVector[3] = {0.0f, 0.0f, 0.0f};
+				float potential = 0.0f;
+				for (size_t j = 0; j < numSourceBodies; ++j) {
+					if ((sourceBegin + j) != i) {
+						// the distance vector points from the target to the source body
+						const float distanceVector[3] = {
+								sourceBodies[j * 4] - targetPosition[0],
+								sourceBodies[(j * 4) + 1] - targetPosition[1],
+								sourceBodies[(j * 4) + 2] - targetPosition[2]
+						};
+						const float distanceSquared = (distanceVector[0] * distanceVector[0]) +
+													  (distanceVector[1] * distanceVector[1]) +
+													  (distanceVector[2] * distanceVector[2]);
+						const float receivedForce = forceLaw(distanceSquared, squaredSofteningFactor, targetMass,
+															 sourceBodies[(j * 4) + 3]);
+						forceVector[0] += receivedForce * distanceVector[0];
+						forceVector[1] += receivedForce * distanceVector[1];
+						forceVector[2] += receivedForce * distanceVector[2];
+						if constexpr (CalcPotentials) {
+							// the potentials are calculated from the exact positions, see the interface
+							const size_t k = sourceBegin + j;
+							const float exactDistanceVector[3] = {
+									bodies.positions[k * 3] - targetPosition[0],
+									bodies.positions[(k * 3) + 1] - targetPosition[1],
+									bodies.positions[(k * 3) + 2] - targetPosition[2]
+							};
+							const float exactDistanceSquared = (exactDistanceVector[0] * exactDistanceVector[0]) +
+															   (exactDistanceVector[1] * exactDistanceVector[1]) +
+															   (exactDistanceVector[2] * exactDistanceVector[2]);
+							potential += forceLaw.calcPotentialEnergy(exactDistanceSquared, squaredSofteningFactor,
+																	  targetMass, bodies.masses[k]);
+						}
+					}
+				}
+				const size_t blockIndex = i - blockBegin;
+				forces[blockIndex * 3] += forceVector[0];
+				forces[(blockIndex * 3) + 1] += forceVector[1];
+				forces[(blockIndex * 3) + 2] += forceVector[2];
+				if constexpr (CalcPotentials) {
+					blockPotentials[blockIndex] += potential;
+				}
+			}
+		}
+		std::copy(forces, forces + ((blockEnd - blockBegin) * 3), accelerations + (blockBegin * 3));
+		if constexpr (CalcPotentials) {
+			std::copy(blockPotentials, blockPotentials + (blockEnd - blockBegin), potentials + blockBegin);
+		}
+	}
+}
+
+template<typename TForceLaw>
+template<bool CalcPotentials>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::sweepReproducibly(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const size_t targetBegin,
+		const size_t targetEnd,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	// data members cannot be listed in the data-sharing clauses, hence the local copy
+	const TForceLaw forceLaw = forceLaw_;
+	// omp_get_num_procs seems to return the number of logical (!) cores
+	omp_set_num_threads(static_cast<int>(std::min<size_t>(std::max<size_t>(1, targetEnd - targetBegin),
+														   omp_get_num_procs())));
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, targetBegin, targetEnd, accelerations, potentials, squaredSofteningFactor, forceLaw)
+	//@formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long i = static_cast<long long>(targetBegin); i < static_cast<long long>(targetEnd); ++i) {
+		// each target is summed up by one thread only, so the partition of the targets does not matter
+		calcAccelerationOfTargetReproducibly<CalcPotentials>(forceLaw, bodies, numBodies, static_cast<size_t>(i),
+															 accelerations, potentials, squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::calcAccelerations(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		const float squaredSofteningFactor
+) {
+	if (isDeterministicModeEnabled_) {
+		sweepReproducibly<false>(bodies, numBodies, 0, numBodies, accelerations, nullptr, squaredSofteningFactor);
+	} else if (isPositionCompressionEnabled_) {
+		sweepCompressed<false>(bodies, numBodies, 0, numBodies, accelerations, nullptr, squaredSofteningFactor);
+	} else {
+		sweep<false>(bodies, numBodies, 0, numBodies, accelerations, nullptr, squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+bool BasicOpenMpAccelerationCalculationImpl<TForceLaw>::isPotentialCalculationSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::calcAccelerationsAndPotentials(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	if (isDeterministicModeEnabled_) {
+		sweepReproducibly<true>(bodies, numBodies, 0, numBodies, accelerations, potentials, squaredSofteningFactor);
+	} else if (isPositionCompressionEnabled_) {
+		sweepCompressed<true>(bodies, numBodies, 0, numBodies, accelerations, potentials, squaredSofteningFactor);
+	} else {
+		sweep<true>(bodies, numBodies, 0, numBodies, accelerations, potentials, squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+bool BasicOpenMpAccelerationCalculationImpl<TForceLaw>::isTargetRangeSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::calcAccelerationsOfTargetRange(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const size_t targetBegin,
+		const size_t targetEnd,
+		float *const accelerations,
+		const float squaredSofteningFactor
+) {
+	if (isDeterministicModeEnabled_) {
+		sweepReproducibly<false>(bodies, numBodies, targetBegin, targetEnd, accelerations, nullptr,
+								 squaredSofteningFactor);
+	} else if (isPositionCompressionEnabled_) {
+		sweepCompressed<false>(bodies, numBodies, targetBegin, targetEnd, accelerations, nullptr,
+							   squaredSofteningFactor);
+	} else {
+		sweep<false>(bodies, numBodies, targetBegin, targetEnd, accelerations, nullptr, squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+bool BasicOpenMpAccelerationCalculationImpl<TForceLaw>::isProbeEvaluationSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::calcFieldAtProbes(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *const probeMasses,
+		const float *const probePositions,
+		const size_t numProbes,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	if (nullptr != potentials) {
+		sweepProbes<true>(bodies, numBodies, probeMasses, probePositions, numProbes, accelerations, potentials,
+						  squaredSofteningFactor);
+	} else {
+		sweepProbes<false>(bodies, numBodies, probeMasses, probePositions, numProbes, accelerations, nullptr,
+						   squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+bool BasicOpenMpAccelerationCalculationImpl<TForceLaw>::isPositionCompressionSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::setPositionCompressionEnabled(const bool enabled) {
+	if (enabled && isDeterministicModeEnabled_) {
+		// let it crash
+		throw std::logic_error("The position compression cannot be combined with the deterministic mode.");
+	}
+	isPositionCompressionEnabled_ = enabled;
+}
+
+template<typename TForceLaw>
+bool BasicOpenMpAccelerationCalculationImpl<TForceLaw>::isDeterministicModeSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicOpenMpAccelerationCalculationImpl<TForceLaw>::setDeterministicModeEnabled(const bool enabled) {
+	if (enabled && isPositionCompressionEnabled_) {
+		// let it crash
+		throw std::logic_error("The deterministic mode cannot be combined with the position compression.");
+	}
+	isDeterministicModeEnabled_ = enabled;
+}
+
+PHYSICS_INSTANTIATE_FOR_ALL_FORCE_LAWS(physics::BasicOpenMpAccelerationCalculationImpl)
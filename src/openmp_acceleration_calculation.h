@@ -2,6 +2,8 @@
 #define PHYSICS_ENGINE_OPENMP_ACCELERATION_CALCULATION_H
 
 #include "physics/acceleration_calculation.h"
+#include "physics/force_laws.h"
+#include "compressed_position_tiles.h"
 
 /**
  * @brief Namespace for physics-related functions and classes.
@@ -9,11 +11,141 @@
 namespace physics {
 
 	/**
-	 * @brief An <strong>OpenMP-accelerated</strong> implementation of the calculation of gravitational accelerations of N bodies.
+	 * @brief An <strong>OpenMP-accelerated</strong> implementation of the calculation of accelerations of N bodies.
+	 * @details The template is explicitly instantiated for each force law in its translation unit.
+	 * @tparam TForceLaw the force law between two bodies, which is inlined into the inner loop.
 	 */
-	class OpenMpAccelerationCalculationImpl : public IAccelerationCalculation {
+	template<typename TForceLaw>
+	class BasicOpenMpAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		private:
+			/**
+			 * The force law between two bodies.
+			 */
+			TForceLaw forceLaw_;
+
+			/**
+			 * Whether the source bodies are read from compressed position tiles.
+			 */
+			bool isPositionCompressionEnabled_;
+
+			/**
+			 * The compressed position tiles of the source bodies, only used if the compression is enabled.
+			 */
+			CompressedPositionTiles compressedPositionTiles_;
+
+			/**
+			 * Whether the contributions of the pairs are summed up reproducibly, which takes precedence over the
+			 * compression.
+			 */
+			bool isDeterministicModeEnabled_;
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potentials of the given target bodies in one sweep.
+			 * @tparam CalcPotentials <code>true</code> to calculate the potentials in the same sweep.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param targetBegin the index of the first target body.
+			 * @param targetEnd the index after the last target body.
+			 * @param[in, out] accelerations the accelerations of the passed bodies.
+			 * @param[out] potentials the potential energies of the passed bodies, only used if
+			 * 					<code>CalcPotentials</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			template<bool CalcPotentials>
+			void sweep(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					size_t targetBegin,
+					size_t targetEnd,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			);
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potentials of the given probes caused by the
+			 * bodies, which is parallelized over the probes.
+			 * @tparam CalcPotentials <code>true</code> to calculate the potentials in the same sweep.
+			 * @param bodies the source bodies.
+			 * @param numBodies the number of bodies.
+			 * @param probeMasses the masses (resp. charges) of the probes.
+			 * @param probePositions the positions of the probes.
+			 * @param numProbes the number of probes.
+			 * @param[out] accelerations the accelerations of the probes.
+			 * @param[out] potentials the potential energies of the probes, only used if <code>CalcPotentials</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			template<bool CalcPotentials>
+			void sweepProbes(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *probeMasses,
+					const float *probePositions,
+					size_t numProbes,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			);
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potentials of the given target bodies, whose
+			 * source bodies are read from the compressed position tiles.
+			 * @details Each thread processes blocks of target bodies. A block accumulates the forces of one tile of
+			 * source bodies after another, which is decompressed once per block into a buffer on the stack. The
+			 * potentials are calculated from the exact positions in the same sweep.
+			 * @tparam CalcPotentials <code>true</code> to calculate the potentials in the same sweep.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param targetBegin the index of the first target body.
+			 * @param targetEnd the index after the last target body.
+			 * @param[out] accelerations the accelerations of the passed bodies.
+			 * @param[out] potentials the potential energies of the passed bodies, only used if
+			 * 					<code>CalcPotentials</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			template<bool CalcPotentials>
+			void sweepCompressed(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					size_t targetBegin,
+					size_t targetEnd,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			);
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potentials of the given target bodies with
+			 * reproducible sums, which is parallelized over the target bodies.
+			 * @tparam CalcPotentials <code>true</code> to calculate the potentials in the same sweep.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param targetBegin the index of the first target body.
+			 * @param targetEnd the index after the last target body.
+			 * @param[out] accelerations the accelerations of the passed bodies.
+			 * @param[out] potentials the potential energies of the passed bodies, only used if
+			 * 					<code>CalcPotentials</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			template<bool CalcPotentials>
+			void sweepReproducibly(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					size_t targetBegin,
+					size_t targetEnd,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			);
 
 		public:
+			/**
+			 * @brief The parameterized constructor.
+			 * @param forceLaw the force law between two bodies.
+			 */
+			explicit BasicOpenMpAccelerationCalculationImpl(const TForceLaw &forceLaw = TForceLaw());
+
 			/**
 			 * @brief Calculates the accelerations of the given bodies.
 			 * @param bodies the bodies whose accelerations are to be calculated.
@@ -29,7 +161,118 @@ namespace physics {
 					float *accelerations,
 					float squaredSofteningFactor
 			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the potentials are calculated by the force law.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isPotentialCalculationSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations and the potential energies of the given bodies in the same sweep
+			 * over all pairs.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies, as by <code>calcAccelerations</code>.
+			 * @param[out] potentials the potential energy of each body with all other bodies. The number of elements
+			 * 					must be <code>numBodies</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerationsAndPotentials(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the accelerations of a range of target bodies can be calculated.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isTargetRangeSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations of the target bodies of the passed range caused by all bodies.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param targetBegin the index of the first target body.
+			 * @param targetEnd the index after the last target body, at most <code>numBodies</code>.
+			 * @param[in, out] accelerations the accelerations of all passed bodies, of which only the elements of the
+			 * 					target bodies are written.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerationsOfTargetRange(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					size_t targetBegin,
+					size_t targetEnd,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the field can be evaluated at probes.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isProbeEvaluationSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potential energies of probes caused by the passed
+			 * bodies by direct summation, which is parallelized over the probes.
+			 * @param bodies the source bodies.
+			 * @param numBodies the number of bodies.
+			 * @param probeMasses the masses (resp. charges) of the probes.
+			 * @param probePositions the positions of the probes, <code>numProbes * vector dimension</code> coordinates.
+			 * @param numProbes the number of probes.
+			 * @param[out] accelerations the accelerations of the probes, <code>numProbes * vector dimension</code>
+			 * 					elements.
+			 * @param[out] potentials the potential energies of the probes with all bodies, <code>numProbes</code>
+			 * 					elements, or <code>nullptr</code> if they are not needed.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcFieldAtProbes(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *probeMasses,
+					const float *probePositions,
+					size_t numProbes,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the source bodies may be read from compressed position tiles.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isPositionCompressionSupported() const override;
+
+			/**
+			 * @brief Enables or disables the compressed position tiles of the source bodies.
+			 * @param enabled <code>true</code> if the source bodies should be compressed.
+			 * @throws std::logic_error if the compression is enabled while the deterministic mode is enabled.
+			 */
+			void setPositionCompressionEnabled(bool enabled) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the pairs can be summed up reproducibly.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isDeterministicModeSupported() const override;
+
+			/**
+			 * @brief Enables or disables the deterministic mode, which does not depend on the number of threads.
+			 * @param enabled <code>true</code> if the calculation should be deterministic.
+			 * @throws std::logic_error if the mode is enabled while the position compression is enabled.
+			 */
+			void setDeterministicModeEnabled(bool enabled) override;
 	};
+
+	/**
+	 * @brief The OpenMP-accelerated implementation of the calculation of gravitational accelerations of N bodies.
+	 */
+	using OpenMpAccelerationCalculationImpl = BasicOpenMpAccelerationCalculationImpl<NewtonianForceLaw>;
 }
 
 #endif //PHYSICS_ENGINE_OPENMP_ACCELERATION_CALCULATION_H
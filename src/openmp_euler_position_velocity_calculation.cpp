@@ -1,34 +1,99 @@
 // Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
 #include <cmath>
 #include <omp.h>
 
 #include "openmp_euler_position_velocity_calculation.h"
+#include "motion_diagnostics_accumulator.h"
 
 using namespace physics;
 
-void OpenMpEulerPositionVelocityCalculationImpl::updatePositionAndVelocity(
+OpenMpEulerPositionVelocityCalculationImpl::OpenMpEulerPositionVelocityCalculationImpl() :
+		isPeriodic_(false),
+		periodicBox_() {
+}
+
+OpenMpEulerPositionVelocityCalculationImpl::OpenMpEulerPositionVelocityCalculationImpl(
+		const PeriodicBox &periodicBox
+) : isPeriodic_(true),
+	periodicBox_(periodicBox) {
+}
+
+template<bool CalcDiagnostics>
+void OpenMpEulerPositionVelocityCalculationImpl::update(
 		const Bodies<float, float, float> &bodies,
 		const size_t numBodies,
 		const float *accelerations,
-		const float timeStep
+		const float timeStep,
+		Diagnostics *const pDiagnostics
 ) {
+	MotionDiagnosticsAccumulator accumulator;
+	// data members cannot be listed in the data-sharing clauses, hence the local copies
+	const bool isPeriodic = isPeriodic_;
+	const PeriodicBox periodicBox = periodicBox_;
 	// omp_get_num_procs seems to return the number of logical (!) cores
-	omp_set_num_threads(std::min(static_cast<int>(numBodies), omp_get_num_procs()));
+	omp_set_num_threads(std::max(1, std::min(static_cast<int>(numBodies), omp_get_num_procs())));
 	// @formatter:off
-	#pragma omp parallel for default(none) shared(bodies, numBodies, accelerations, timeStep)
+	#pragma omp parallel default(none) shared(bodies, numBodies, accelerations, timeStep, accumulator, isPeriodic, periodicBox)
 	//@formatter:on
-	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
-	for (int i = 0; i < static_cast<long long>(numBodies); ++i) {
-		const size_t xCoordinateIndex = i * 3;
-		const size_t yCoordinateIndex = xCoordinateIndex + 1;
-		const size_t zCoordinateIndex = xCoordinateIndex + 2;
-
-		bodies.velocities[xCoordinateIndex] += (accelerations[xCoordinateIndex] * timeStep);
-		bodies.velocities[yCoordinateIndex] += (accelerations[yCoordinateIndex] * timeStep);
-		bodies.velocities[zCoordinateIndex] += (accelerations[zCoordinateIndex] * timeStep);
-
-		bodies.positions[xCoordinateIndex] += (bodies.velocities[xCoordinateIndex] * timeStep);
-		bodies.positions[yCoordinateIndex] += (bodies.velocities[yCoordinateIndex] * timeStep);
-		bodies.positions[zCoordinateIndex] += (bodies.velocities[zCoordinateIndex] * timeStep);
+	{
+		MotionDiagnosticsAccumulator threadAccumulator;
+		// @formatter:off
+		#pragma omp for nowait
+		//@formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (int i = 0; i < static_cast<long long>(numBodies); ++i) {
+			const size_t xCoordinateIndex = i * 3;
+			const size_t yCoordinateIndex = xCoordinateIndex + 1;
+			const size_t zCoordinateIndex = xCoordinateIndex + 2;
+
+			if constexpr (CalcDiagnostics) {
+				// the state before the update belongs to the same time as the accelerations and potentials
+				threadAccumulator.addBody(bodies.masses[i], &bodies.positions[xCoordinateIndex],
+										  &bodies.velocities[xCoordinateIndex]);
+			}
+
+			bodies.velocities[xCoordinateIndex] += (accelerations[xCoordinateIndex] * timeStep);
+			bodies.velocities[yCoordinateIndex] += (accelerations[yCoordinateIndex] * timeStep);
+			bodies.velocities[zCoordinateIndex] += (accelerations[zCoordinateIndex] * timeStep);
+
+			bodies.positions[xCoordinateIndex] += (bodies.velocities[xCoordinateIndex] * timeStep);
+			bodies.positions[yCoordinateIndex] += (bodies.velocities[yCoordinateIndex] * timeStep);
+			bodies.positions[zCoordinateIndex] += (bodies.velocities[zCoordinateIndex] * timeStep);
+
+			if (isPeriodic) {
+				bodies.positions[xCoordinateIndex] = periodicBox.wrapCoordinate(bodies.positions[xCoordinateIndex]);
+				bodies.positions[yCoordinateIndex] = periodicBox.wrapCoordinate(bodies.positions[yCoordinateIndex]);
+				bodies.positions[zCoordinateIndex] = periodicBox.wrapCoordinate(bodies.positions[zCoordinateIndex]);
+			}
+		}
+		if constexpr (CalcDiagnostics) {
+			// @formatter:off
+			#pragma omp critical
+			// @formatter:on
+			accumulator.add(threadAccumulator);
+		}
+	}
+	if constexpr (CalcDiagnostics) {
+		accumulator.store(*pDiagnostics);
 	}
-}
\ No newline at end of file
+}
+
+void OpenMpEulerPositionVelocityCalculationImpl::updatePositionAndVelocity(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *accelerations,
+		const float timeStep
+) {
+	update<false>(bodies, numBodies, accelerations, timeStep, nullptr);
+}
+
+void OpenMpEulerPositionVelocityCalculationImpl::updatePositionAndVelocityWithDiagnostics(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *accelerations,
+		const float timeStep,
+		Diagnostics &diagnostics
+) {
+	update<true>(bodies, numBodies, accelerations, timeStep, &diagnostics);
+}
@@ -2,6 +2,7 @@
 #define PHYSICS_ENGINE_OPENMP_EULER_POSITION_VELOCITY_CALCULATION_H
 
 #include "physics/position_velocity_calculation.h"
+#include "physics/periodic_box.h"
 
 /**
  * @brief Namespace for physics-related functions and classes.
@@ -10,10 +11,51 @@ namespace physics {
 
 	/**
 	 * @brief Implements the method for updating the positions and velocities of N bodies using the <em>Euler method</em>.
-	 * @details The Euler method is known for its simplicity, but also for its lack of accuracy.
+	 * @details The Euler method is known for its simplicity, but also for its lack of accuracy. In a periodic box
+	 * the positions are wrapped into the box after each update.
 	 */
 	class [[maybe_unused]] OpenMpEulerPositionVelocityCalculationImpl : public IPositionVelocityCalculation {
+		private:
+			/**
+			 * Whether the positions are wrapped into the periodic box.
+			 */
+			bool isPeriodic_;
+
+			/**
+			 * The periodic box, only used if the boundaries are periodic.
+			 */
+			PeriodicBox periodicBox_;
+
+			/**
+			 * @brief Updates the positions and velocities of the given bodies using the <em>Euler method</em>.
+			 * @tparam CalcDiagnostics <code>true</code> to calculate the diagnostics in the same loop.
+			 * @param bodies the bodies whose positions and velocities are to be updated.
+			 * @param numBodies the number of bodies.
+			 * @param accelerations the current accelerations of the bodies.
+			 * @param timeStep the time step.
+			 * @param[out] pDiagnostics the pointer to the diagnostics, only used if <code>CalcDiagnostics</code>.
+			 */
+			template<bool CalcDiagnostics>
+			void update(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *accelerations,
+					float timeStep,
+					Diagnostics *pDiagnostics
+			);
+
 		public:
+			/**
+			 * @brief The default constructor. Creates a new instance of this class with open boundaries.
+			 */
+			OpenMpEulerPositionVelocityCalculationImpl();
+
+			/**
+			 * @brief The parameterized constructor. Creates a new instance of this class with periodic boundaries.
+			 * @param periodicBox the periodic box, into which the positions are wrapped.
+			 */
+			explicit OpenMpEulerPositionVelocityCalculationImpl(const PeriodicBox &periodicBox);
+
 			/**
 			 * @brief Updates the positions and velocities of the given bodies using the <em>Euler method</em>.
 			 * @param bodies the bodies whose positions and velocities are to be updated.
@@ -28,6 +70,24 @@ namespace physics {
 					const float *accelerations,
 					float timeStep
 			) override;
+
+			/**
+			 * @brief Updates the positions and velocities of the given bodies using the <em>Euler method</em> and
+			 * calculates the kinetic energy and the momenta before the update by a reduction fused into the update loop.
+			 * @param bodies the bodies whose positions and velocities are to be updated.
+			 * @param numBodies the number of bodies.
+			 * @param accelerations the current accelerations of the bodies. The number of elements in
+			 * 						<code>accelerations</code> parameter must be <code>numBodies * vector dimension</code>.
+			 * @param timeStep the time step.
+			 * @param[out] diagnostics the diagnostics, whose kinetic energy and momenta are to be set.
+			 */
+			void updatePositionAndVelocityWithDiagnostics(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *accelerations,
+					float timeStep,
+					Diagnostics &diagnostics
+			) override;
 	};
 }
 
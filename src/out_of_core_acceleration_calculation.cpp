@@ -0,0 +1,166 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PHYSICS_ENGINE_HAS_POSIX_MADVISE
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "out_of_core_acceleration_calculation.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Advises the operating system that the passed range of memory will be needed soon, so the pages of
+	 * memory-mapped bodies are read ahead asynchronously. The advice is a harmless hint for other memory.
+	 */
+	void adviseWillNeed(const void *const pMemory, const size_t numBytes) {
+#ifdef PHYSICS_ENGINE_HAS_POSIX_MADVISE
+		static const auto pageSize = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+		const auto address = reinterpret_cast<std::uintptr_t>(pMemory);
+		const std::uintptr_t pageAddress = address - (address % pageSize);
+		// the return value is ignored, since the advice is only a hint
+		(void) posix_madvise(reinterpret_cast<void *>(pageAddress), numBytes + (address - pageAddress),
+							 POSIX_MADV_WILLNEED);
+#else
+		(void) pMemory;
+		(void) numBytes;
+#endif
+	}
+
+	/**
+	 * @brief Advises the operating system to read ahead the masses and positions of the passed tile of bodies.
+	 */
+	void adviseWillNeedTile(const Bodies<float, float, float> &bodies, const size_t begin, const size_t end) {
+		adviseWillNeed(bodies.masses + begin, (end - begin) * sizeof(float));
+		adviseWillNeed(bodies.positions + (begin * 3), (end - begin) * 3 * sizeof(float));
+	}
+}
+
+template<typename TForceLaw>
+BasicOutOfCoreAccelerationCalculationImpl<TForceLaw>::BasicOutOfCoreAccelerationCalculationImpl(
+		const TForceLaw &forceLaw,
+		const size_t tileSize
+) : forceLaw_(forceLaw),
+	tileSize_(tileSize) {
+	if (0 == tileSize) {
+		// let it crash
+		throw std::invalid_argument("The tile size must be positive.");
+	}
+}
+
+template<typename TForceLaw>
+template<bool CalcPotentials>
+void BasicOutOfCoreAccelerationCalculationImpl<TForceLaw>::sweep(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	// data members cannot be listed in the data-sharing clauses, hence the local copies
+	const TForceLaw forceLaw = forceLaw_;
+	const size_t tileSize = std::min(tileSize_, numBodies);
+	tileAccelerations_.resize(tileSize * 3);
+	float *const tileAccelerations = tileAccelerations_.data();
+	float *tilePotentials = nullptr;
+	if constexpr (CalcPotentials) {
+		tilePotentials_.resize(tileSize);
+		tilePotentials = tilePotentials_.data();
+	}
+
+	for (size_t targetBegin = 0; targetBegin < numBodies; targetBegin += tileSize) {
+		const size_t targetEnd = std::min(numBodies, targetBegin + tileSize);
+		std::fill(tileAccelerations, tileAccelerations + ((targetEnd - targetBegin) * 3), 0.0f);
+		if constexpr (CalcPotentials) {
+			std::fill(tilePotentials, tilePotentials + (targetEnd - targetBegin), 0.0f);
+		}
+
+		// 1. stream the source tiles through the target tile
+		for (size_t sourceBegin = 0; sourceBegin < numBodies; sourceBegin += tileSize) {
+			const size_t sourceEnd = std::min(numBodies, sourceBegin + tileSize);
+			// the next source tile, which is the first tile again for the next target tile
+			const size_t nextSourceBegin = (sourceEnd < numBodies) ? sourceEnd : 0;
+			adviseWillNeedTile(bodies, nextSourceBegin, std::min(numBodies, nextSourceBegin + tileSize));
+			// @formatter:off
+			#pragma omp parallel for default(none) shared(bodies, targetBegin, targetEnd, sourceBegin, sourceEnd, tileAccelerations, tilePotentials, squaredSofteningFactor, forceLaw)
+			// @formatter:on
+			// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+			for (long long i = static_cast<long long>(targetBegin); i < static_cast<long long>(targetEnd); ++i) {
+				const size_t xCoordinateIndexBody1 = i * 3;
+				const float targetMass = bodies.masses[i];
+				float forceVector[3] = {0.0f, 0.0f, 0.0f};
+				float potential = 0.0f;
+				for (size_t j = sourceBegin; j < sourceEnd; ++j) {
+					if (static_cast<size_t>(i) != j) {
+						const size_t xCoordinateIndexBody2 = j * 3;
+						// the distance vector points from body 1 to body 2
+						const float distanceVector[3] = {
+								bodies.positions[xCoordinateIndexBody2] - bodies.positions[xCoordinateIndexBody1],
+								bodies.positions[xCoordinateIndexBody2 + 1] - bodies.positions[xCoordinateIndexBody1 + 1],
+								bodies.positions[xCoordinateIndexBody2 + 2] - bodies.positions[xCoordinateIndexBody1 + 2]
+						};
+						const float distanceSquared = (distanceVector[0] * distanceVector[0]) +
+													  (distanceVector[1] * distanceVector[1]) +
+													  (distanceVector[2] * distanceVector[2]);
+						const float receivedForce = forceLaw(distanceSquared, squaredSofteningFactor, targetMass,
+															 bodies.masses[j]);
+						forceVector[0] += receivedForce * distanceVector[0];
+						forceVector[1] += receivedForce * distanceVector[1];
+						forceVector[2] += receivedForce * distanceVector[2];
+						if constexpr (CalcPotentials) {
+							potential += forceLaw.calcPotentialEnergy(distanceSquared, squaredSofteningFactor,
+																	  targetMass, bodies.masses[j]);
+						}
+					}
+				}
+				const size_t tileIndex = i - targetBegin;
+				tileAccelerations[tileIndex * 3] += forceVector[0];
+				tileAccelerations[(tileIndex * 3) + 1] += forceVector[1];
+				tileAccelerations[(tileIndex * 3) + 2] += forceVector[2];
+				if constexpr (CalcPotentials) {
+					tilePotentials[tileIndex] += potential;
+				}
+			}
+		}
+
+		// 2. write back the results of the target tile
+		std::copy(tileAccelerations, tileAccelerations + ((targetEnd - targetBegin) * 3),
+				  accelerations + (targetBegin * 3));
+		if constexpr (CalcPotentials) {
+			std::copy(tilePotentials, tilePotentials + (targetEnd - targetBegin), potentials + targetBegin);
+		}
+	}
+}
+
+template<typename TForceLaw>
+void BasicOutOfCoreAccelerationCalculationImpl<TForceLaw>::calcAccelerations(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		const float squaredSofteningFactor
+) {
+	sweep<false>(bodies, numBodies, accelerations, nullptr, squaredSofteningFactor);
+}
+
+template<typename TForceLaw>
+bool BasicOutOfCoreAccelerationCalculationImpl<TForceLaw>::isPotentialCalculationSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicOutOfCoreAccelerationCalculationImpl<TForceLaw>::calcAccelerationsAndPotentials(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	sweep<true>(bodies, numBodies, accelerations, potentials, squaredSofteningFactor);
+}
+
+PHYSICS_INSTANTIATE_FOR_ALL_FORCE_LAWS(physics::BasicOutOfCoreAccelerationCalculationImpl)
@@ -0,0 +1,139 @@
+#ifndef PHYSICS_ENGINE_OUT_OF_CORE_ACCELERATION_CALCULATION_H
+#define PHYSICS_ENGINE_OUT_OF_CORE_ACCELERATION_CALCULATION_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <vector>
+
+#include "physics/acceleration_calculation.h"
+#include "physics/force_laws.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief An <strong>out-of-core</strong>, OpenMP-accelerated implementation of the calculation of accelerations
+	 * of N bodies, e.g. of memory-mapped bodies exceeding the RAM.
+	 * @details The bodies are processed in tiles. The accelerations of a tile of target bodies are accumulated from
+	 * the tiles of source bodies, which are streamed one after another, while the operating system is advised to read
+	 * ahead the next source tile. The accelerations are written back tile by tile. Hence only about three tiles of
+	 * bodies are touched at a time, i.e. the working set is bounded by the tile size, and all other pages may be
+	 * evicted. The template is explicitly instantiated for each force law in its translation unit.
+	 * @tparam TForceLaw the force law between two bodies, which is inlined into the inner loop.
+	 */
+	template<typename TForceLaw>
+	class BasicOutOfCoreAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		private:
+			/**
+			 * The force law between two bodies.
+			 */
+			TForceLaw forceLaw_;
+
+			/**
+			 * The number of bodies of a tile.
+			 */
+			size_t tileSize_;
+
+			/**
+			 * The accelerations of the current tile of target bodies.
+			 */
+			std::vector<float> tileAccelerations_;
+
+			/**
+			 * The potential energies of the current tile of target bodies.
+			 */
+			std::vector<float> tilePotentials_;
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potentials of the given bodies tile by tile.
+			 * @tparam CalcPotentials <code>true</code> to calculate the potentials in the same sweep.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[out] accelerations the accelerations of the passed bodies.
+			 * @param[out] potentials the potential energies of the passed bodies, only used if
+			 * 					<code>CalcPotentials</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			template<bool CalcPotentials>
+			void sweep(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			);
+
+		public:
+			/**
+			 * The default number of bodies of a tile, i.e. about 1.8 MiB of masses, positions and accelerations.
+			 */
+			static constexpr size_t DEFAULT_TILE_SIZE = 65'536;
+
+			/**
+			 * @brief The parameterized constructor.
+			 * @param forceLaw the force law between two bodies.
+			 * @param tileSize the number of bodies of a tile, which bounds the working set.
+			 * @throws std::invalid_argument if the tile size is 0.
+			 */
+			explicit BasicOutOfCoreAccelerationCalculationImpl(const TForceLaw &forceLaw = TForceLaw(),
+															   size_t tileSize = DEFAULT_TILE_SIZE);
+
+			/**
+			 * @brief Returns the number of bodies of a tile.
+			 * @return the number of bodies of a tile.
+			 */
+			[[nodiscard]] inline size_t getTileSize() const {
+				return tileSize_;
+			}
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[out] accelerations the accelerations of the passed bodies. The <code>accelerations</code>
+			 * 					parameter must be a pointer to an allocated storage which is large enough to store
+			 * 					<code>numBodies * vector dimension</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerations(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the potentials are calculated by the force law.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isPotentialCalculationSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations and the potential energies of the given bodies in the same sweep
+			 * over all pairs.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[out] accelerations the accelerations of the passed bodies, as by <code>calcAccelerations</code>.
+			 * @param[out] potentials the potential energy of each body with all other bodies. The number of elements
+			 * 					must be <code>numBodies</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerationsAndPotentials(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			) override;
+	};
+
+	/**
+	 * @brief The out-of-core implementation of the calculation of gravitational accelerations of N bodies.
+	 */
+	using OutOfCoreAccelerationCalculationImpl = BasicOutOfCoreAccelerationCalculationImpl<NewtonianForceLaw>;
+}
+
+#endif //PHYSICS_ENGINE_OUT_OF_CORE_ACCELERATION_CALCULATION_H
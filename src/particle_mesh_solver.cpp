@@ -0,0 +1,303 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+#include "particle_mesh_solver.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Checks that the passed mesh size is a power of two of at least 16.
+	 * @param meshSize the mesh size to be checked.
+	 * @return the passed mesh size.
+	 * @throws std::invalid_argument if the mesh size is not a power of two of at least 16.
+	 */
+	size_t requireValidMeshSize(const size_t meshSize) {
+		if ((meshSize < 16) || (0 != (meshSize & (meshSize - 1)))) {
+			// let it crash
+			throw std::invalid_argument("The mesh size of the particle-mesh solver must be a power of two >= 16.");
+		}
+		return meshSize;
+	}
+}
+
+ParticleMeshSolver::ParticleMeshSolver(const size_t meshSize, const float splitScaleInCells) :
+		meshSize_(requireValidMeshSize(meshSize)),
+		splitScaleInCells_(splitScaleInCells),
+		fastFourierTransform_(2 * meshSize),
+		transformedGreensFunction_(8 * meshSize * meshSize * meshSize),
+		paddedMesh_(8 * meshSize * meshSize * meshSize),
+		fieldMesh_{
+				std::vector<double>(meshSize * meshSize * meshSize),
+				std::vector<double>(meshSize * meshSize * meshSize),
+				std::vector<double>(meshSize * meshSize * meshSize)
+		},
+		meshOrigin_{0.0, 0.0, 0.0},
+		cellSize_(1.0),
+		currentSplitScaleInCells_(splitScaleInCells) {
+	transformGreensFunction(splitScaleInCells_);
+}
+
+void ParticleMeshSolver::transformGreensFunction(const double splitScaleInCells) {
+	// The Green's function only depends on the distance in cells, so it is transformed once per split scale in cells.
+	// Offsets beyond half of the padded mesh are negative offsets.
+	const size_t paddedMeshSize = 2 * meshSize_;
+	const auto toOffset = [paddedMeshSize](const size_t index) {
+		return static_cast<double>(index <= (paddedMeshSize / 2) ? static_cast<long long>(index)
+																 : static_cast<long long>(index) -
+																   static_cast<long long>(paddedMeshSize));
+	};
+	currentSplitScaleInCells_ = splitScaleInCells;
+	const double inverseTwoSplitScale = 1.0 / (2.0 * splitScaleInCells);
+	for (size_t x = 0; x < paddedMeshSize; ++x) {
+		for (size_t y = 0; y < paddedMeshSize; ++y) {
+			for (size_t z = 0; z < paddedMeshSize; ++z) {
+				const double distance = std::sqrt(
+						(toOffset(x) * toOffset(x)) + (toOffset(y) * toOffset(y)) + (toOffset(z) * toOffset(z))
+				);
+				// the limit of -erf(r / (2 * r_s)) / r for r -> 0
+				const double greensFunction = (0.0 < distance)
+											  ? -std::erf(distance * inverseTwoSplitScale) / distance
+											  : -2.0 * inverseTwoSplitScale / std::sqrt(std::numbers::pi);
+				transformedGreensFunction_[(((x * paddedMeshSize) + y) * paddedMeshSize) + z] = greensFunction;
+			}
+		}
+	}
+	fastFourierTransform_.forward(transformedGreensFunction_.data());
+
+	// Deconvolve the smoothing of the mass assignment and the interpolation, each of them multiplies the spectrum
+	// by the cloud-in-cell window sinc^2(pi * k / n) per axis.
+	const auto calcSquaredWindow = [paddedMeshSize](const size_t index) {
+		const size_t frequency = (index <= (paddedMeshSize / 2)) ? index : (paddedMeshSize - index);
+		if (0 == frequency) {
+			return 1.0;
+		}
+		const double argument = std::numbers::pi * static_cast<double>(frequency) /
+								static_cast<double>(paddedMeshSize);
+		const double sinc = std::sin(argument) / argument;
+		return sinc * sinc * sinc * sinc;
+	};
+	for (size_t x = 0; x < paddedMeshSize; ++x) {
+		for (size_t y = 0; y < paddedMeshSize; ++y) {
+			for (size_t z = 0; z < paddedMeshSize; ++z) {
+				transformedGreensFunction_[(((x * paddedMeshSize) + y) * paddedMeshSize) + z] /=
+						calcSquaredWindow(x) * calcSquaredWindow(y) * calcSquaredWindow(z);
+			}
+		}
+	}
+
+	// The self-field of a body only depends on the offsets between the mesh points of its mass assignment and its
+	// interpolation, which are in {-1, 0, 1}^3. It is the finite difference of the real space potential kernel.
+	std::copy(transformedGreensFunction_.begin(), transformedGreensFunction_.end(), paddedMesh_.begin());
+	fastFourierTransform_.inverse(paddedMesh_.data());
+	const auto potentialKernel = [this, paddedMeshSize](const long long x, const long long y, const long long z) {
+		const auto wrap = [paddedMeshSize](const long long offset) {
+			return static_cast<size_t>((offset + static_cast<long long>(paddedMeshSize)) %
+									   static_cast<long long>(paddedMeshSize));
+		};
+		return paddedMesh_[(((wrap(x) * paddedMeshSize) + wrap(y)) * paddedMeshSize) + wrap(z)].real();
+	};
+	for (long long dx = -1; dx <= 1; ++dx) {
+		for (long long dy = -1; dy <= 1; ++dy) {
+			for (long long dz = -1; dz <= 1; ++dz) {
+				double *const selfField = selfFieldKernel_[((dx + 1) * 9) + ((dy + 1) * 3) + (dz + 1)];
+				selfField[0] =
+						((8.0 * (potentialKernel(dx + 1, dy, dz) - potentialKernel(dx - 1, dy, dz))) -
+						 (potentialKernel(dx + 2, dy, dz) - potentialKernel(dx - 2, dy, dz))) / 12.0;
+				selfField[1] =
+						((8.0 * (potentialKernel(dx, dy + 1, dz) - potentialKernel(dx, dy - 1, dz))) -
+						 (potentialKernel(dx, dy + 2, dz) - potentialKernel(dx, dy - 2, dz))) / 12.0;
+				selfField[2] =
+						((8.0 * (potentialKernel(dx, dy, dz + 1) - potentialKernel(dx, dy, dz - 1))) -
+						 (potentialKernel(dx, dy, dz + 2) - potentialKernel(dx, dy, dz - 2))) / 12.0;
+			}
+		}
+	}
+}
+
+void ParticleMeshSolver::placeMesh(const Bodies<float, float, float> &bodies, const size_t numBodies) {
+	float min[3] = {
+			std::numeric_limits<float>::max(),
+			std::numeric_limits<float>::max(),
+			std::numeric_limits<float>::max()
+	};
+	float max[3] = {
+			std::numeric_limits<float>::lowest(),
+			std::numeric_limits<float>::lowest(),
+			std::numeric_limits<float>::lowest()
+	};
+	for (size_t i = 0; i < numBodies; ++i) {
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			min[dimension] = std::min(min[dimension], bodies.positions[(i * 3) + dimension]);
+			max[dimension] = std::max(max[dimension], bodies.positions[(i * 3) + dimension]);
+		}
+	}
+	double extent = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+	if (!(0.0 < extent)) {
+		extent = 1.0; // all bodies at the same position, any mesh does it
+	}
+
+	// the bodies occupy the mesh coordinates [MESH_MARGIN, meshSize - MESH_MARGIN - 1]
+	cellSize_ = extent / static_cast<double>(meshSize_ - (2 * MESH_MARGIN) - 1);
+	for (size_t dimension = 0; dimension < 3; ++dimension) {
+		meshOrigin_[dimension] = min[dimension] - (static_cast<double>(MESH_MARGIN) * cellSize_);
+	}
+}
+
+void ParticleMeshSolver::calcLongRangeField(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const field,
+		const float minSplitScale
+) {
+	placeMesh(bodies, numBodies);
+	// the Green's function is transformed again only if the required split scale leaves a band around the current one,
+	// since the extent of the bodies and thus the cell size change slightly by each step
+	const double requiredSplitScaleInCells = std::max(static_cast<double>(splitScaleInCells_),
+													  static_cast<double>(minSplitScale) / cellSize_);
+	if ((currentSplitScaleInCells_ < requiredSplitScaleInCells) ||
+		((requiredSplitScaleInCells * SPLIT_SCALE_HEADROOM * SPLIT_SCALE_HEADROOM) < currentSplitScaleInCells_)) {
+		transformGreensFunction((splitScaleInCells_ < requiredSplitScaleInCells)
+								? (requiredSplitScaleInCells * SPLIT_SCALE_HEADROOM)
+								: static_cast<double>(splitScaleInCells_));
+	}
+
+	const size_t n = meshSize_;
+	const size_t paddedMeshSize = 2 * n;
+	const size_t numPaddedElements = paddedMeshSize * paddedMeshSize * paddedMeshSize;
+	const double inverseCellSize = 1.0 / cellSize_;
+	std::complex<double> *const paddedMesh = paddedMesh_.data();
+	const double *const meshOrigin = meshOrigin_;
+	std::fill(paddedMesh_.begin(), paddedMesh_.end(), std::complex<double>(0.0f, 0.0f));
+
+	// 1. assign the masses to the mesh (cloud-in-cell)
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, paddedMesh, paddedMeshSize, meshOrigin, inverseCellSize)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+		size_t cell[3];
+		double weights[3][2];
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const double meshCoordinate =
+					(static_cast<double>(bodies.positions[(i * 3) + dimension]) - meshOrigin[dimension]) * inverseCellSize;
+			const double cellCoordinate = std::floor(meshCoordinate);
+			cell[dimension] = static_cast<size_t>(cellCoordinate);
+			weights[dimension][1] = meshCoordinate - cellCoordinate;
+			weights[dimension][0] = 1.0 - weights[dimension][1];
+		}
+		for (size_t dx = 0; dx < 2; ++dx) {
+			for (size_t dy = 0; dy < 2; ++dy) {
+				for (size_t dz = 0; dz < 2; ++dz) {
+					const size_t index =
+							((((cell[0] + dx) * paddedMeshSize) + (cell[1] + dy)) * paddedMeshSize) + (cell[2] + dz);
+					const double mass = bodies.masses[i] * weights[0][dx] * weights[1][dy] * weights[2][dz];
+					// std::complex has no atomic update, but its storage is an array of two doubles by the standard
+					double &realPart = reinterpret_cast<double *>(paddedMesh)[2 * index];
+					// @formatter:off
+					#pragma omp atomic
+					// @formatter:on
+					realPart += mass;
+				}
+			}
+		}
+	}
+
+	// 2. convolve with the long-range Green's function
+	fastFourierTransform_.forward(paddedMesh);
+	const std::complex<double> *const transformedGreensFunction = transformedGreensFunction_.data();
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(paddedMesh, transformedGreensFunction, numPaddedElements)
+	// @formatter:on
+	for (long long i = 0; i < static_cast<long long>(numPaddedElements); ++i) {
+		paddedMesh[i] *= transformedGreensFunction[i];
+	}
+	fastFourierTransform_.inverse(paddedMesh);
+
+	// 3. the field is the gradient of the potential by four-point finite differences; the potential of the Green's
+	// function for a cell size of one is scaled by 1 / h and the derivative by another 1 / h
+	const double scale = inverseCellSize * inverseCellSize / 12.0;
+	const auto potential = [paddedMesh, paddedMeshSize](const size_t x, const size_t y, const size_t z) {
+		return paddedMesh[(((x * paddedMeshSize) + y) * paddedMeshSize) + z].real();
+	};
+	double *const fieldMeshX = fieldMesh_[0].data();
+	double *const fieldMeshY = fieldMesh_[1].data();
+	double *const fieldMeshZ = fieldMesh_[2].data();
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(n, scale, potential, fieldMeshX, fieldMeshY, fieldMeshZ)
+	// @formatter:on
+	for (long long x = 2; x < static_cast<long long>(n - 2); ++x) {
+		for (size_t y = 2; y < (n - 2); ++y) {
+			for (size_t z = 2; z < (n - 2); ++z) {
+				const size_t index = (((x * n) + y) * n) + z;
+				fieldMeshX[index] = scale * ((8.0 * (potential(x + 1, y, z) - potential(x - 1, y, z))) -
+											 (potential(x + 2, y, z) - potential(x - 2, y, z)));
+				fieldMeshY[index] = scale * ((8.0 * (potential(x, y + 1, z) - potential(x, y - 1, z))) -
+											 (potential(x, y + 2, z) - potential(x, y - 2, z)));
+				fieldMeshZ[index] = scale * ((8.0 * (potential(x, y, z + 1) - potential(x, y, z - 1))) -
+											 (potential(x, y, z + 2) - potential(x, y, z - 2)));
+			}
+		}
+	}
+
+	// 4. interpolate the field back to the bodies (cloud-in-cell) and remove the self-field of each body
+	const double selfFieldScale = inverseCellSize * inverseCellSize;
+	const double (*const selfFieldKernel)[3] = selfFieldKernel_;
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, field, n, meshOrigin, inverseCellSize, fieldMeshX, fieldMeshY, fieldMeshZ, selfFieldScale, selfFieldKernel)
+	// @formatter:on
+	for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+		size_t cell[3];
+		double weights[3][2];
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const double meshCoordinate =
+					(static_cast<double>(bodies.positions[(i * 3) + dimension]) - meshOrigin[dimension]) * inverseCellSize;
+			const double cellCoordinate = std::floor(meshCoordinate);
+			cell[dimension] = static_cast<size_t>(cellCoordinate);
+			weights[dimension][1] = meshCoordinate - cellCoordinate;
+			weights[dimension][0] = 1.0 - weights[dimension][1];
+		}
+		double fieldVector[3] = {0.0, 0.0, 0.0};
+		for (size_t dx = 0; dx < 2; ++dx) {
+			for (size_t dy = 0; dy < 2; ++dy) {
+				for (size_t dz = 0; dz < 2; ++dz) {
+					const size_t index = ((((cell[0] + dx) * n) + (cell[1] + dy)) * n) + (cell[2] + dz);
+					const double weight = weights[0][dx] * weights[1][dy] * weights[2][dz];
+					fieldVector[0] += weight * fieldMeshX[index];
+					fieldVector[1] += weight * fieldMeshY[index];
+					fieldVector[2] += weight * fieldMeshZ[index];
+				}
+			}
+		}
+		// the weight of the offset d between interpolation and assignment point per axis: w0 * w1 for d = +-1 and
+		// w0^2 + w1^2 for d = 0
+		double offsetWeights[3][3];
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			offsetWeights[dimension][0] = weights[dimension][0] * weights[dimension][1];
+			offsetWeights[dimension][1] = (weights[dimension][0] * weights[dimension][0]) +
+										  (weights[dimension][1] * weights[dimension][1]);
+			offsetWeights[dimension][2] = offsetWeights[dimension][0];
+		}
+		double selfFieldVector[3] = {0.0, 0.0, 0.0};
+		for (size_t dx = 0; dx < 3; ++dx) {
+			for (size_t dy = 0; dy < 3; ++dy) {
+				for (size_t dz = 0; dz < 3; ++dz) {
+					const double weight = offsetWeights[0][dx] * offsetWeights[1][dy] * offsetWeights[2][dz];
+					const double *const selfField = selfFieldKernel[(dx * 9) + (dy * 3) + dz];
+					selfFieldVector[0] += weight * selfField[0];
+					selfFieldVector[1] += weight * selfField[1];
+					selfFieldVector[2] += weight * selfField[2];
+				}
+			}
+		}
+		// the field is the negative gradient of the potential
+		const double selfFieldFactor = bodies.masses[i] * selfFieldScale;
+		field[(i * 3)] = static_cast<float>((selfFieldFactor * selfFieldVector[0]) - fieldVector[0]);
+		field[(i * 3) + 1] = static_cast<float>((selfFieldFactor * selfFieldVector[1]) - fieldVector[1]);
+		field[(i * 3) + 2] = static_cast<float>((selfFieldFactor * selfFieldVector[2]) - fieldVector[2]);
+	}
+}
@@ -0,0 +1,141 @@
+#ifndef PHYSICS_ENGINE_PARTICLE_MESH_SOLVER_H
+#define PHYSICS_ENGINE_PARTICLE_MESH_SOLVER_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "physics/bodies.h"
+#include "fast_fourier_transform.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A particle-mesh (PM) solver for the long-range part of the gravitational field of N bodies.
+	 * @details The field is split with a Gaussian of the split scale <code>r_s</code>: the long-range potential of a
+	 * point mass is <code>-m * erf(r / (2 * r_s)) / r</code>. The masses are assigned to a cubic mesh enclosing all
+	 * bodies by cloud-in-cell (CIC) interpolation and convolved with the long-range Green's function by a fast Fourier
+	 * transform on a mesh with twice the size (zero padding), so the boundary conditions are isolated, not periodic.
+	 * The field is obtained by four-point finite differences and interpolated back to the bodies with CIC. The window of
+	 * the CIC interpolation is deconvolved and the self-force of each body is subtracted.
+	 * The split scale is given in mesh cells, so it shrinks and grows with the extent of the bodies. It can be bounded
+	 * below in units of length, e.g. by the softening, which the long-range Green's function does not apply.
+	 */
+	class ParticleMeshSolver {
+
+		private:
+			/**
+			 * The number of mesh cells per axis.
+			 */
+			size_t meshSize_;
+
+			/**
+			 * The minimum split scale in mesh cells.
+			 */
+			float splitScaleInCells_;
+
+			/**
+			 * The fast Fourier transform of the zero padded mesh.
+			 */
+			FastFourierTransform3d fastFourierTransform_;
+
+			/**
+			 * The transformed long-range Green's function for a cell size of one.
+			 */
+			std::vector<std::complex<double>> transformedGreensFunction_;
+
+			/**
+			 * The zero padded mesh of the masses, which is overwritten by the potential.
+			 */
+			std::vector<std::complex<double>> paddedMesh_;
+
+			/**
+			 * The x, y and z components of the field on the mesh.
+			 */
+			std::vector<double> fieldMesh_[3];
+
+			/**
+			 * The field on the mesh points at the offsets <code>{-1, 0, 1}^3</code> from a unit mass for a cell size of
+			 * one. It is used to remove the self-force of a body, which the mass assignment and the interpolation
+			 * introduce for bodies between mesh points.
+			 */
+			double selfFieldKernel_[27][3];
+
+			/**
+			 * The minimum corner of the mesh of the last calculation.
+			 */
+			double meshOrigin_[3];
+
+			/**
+			 * The edge length of a mesh cell of the last calculation.
+			 */
+			double cellSize_;
+
+			/**
+			 * The split scale in mesh cells of the transformed Green's function.
+			 */
+			double currentSplitScaleInCells_;
+
+			/**
+			 * @brief Transforms the long-range Green's function of the passed split scale and derives the self-field
+			 * kernel from it.
+			 * @param splitScaleInCells the split scale in mesh cells.
+			 */
+			void transformGreensFunction(double splitScaleInCells);
+
+			/**
+			 * @brief Places the mesh so that all bodies including the interpolation margins are enclosed.
+			 * @param bodies the bodies.
+			 * @param numBodies the number of bodies.
+			 */
+			void placeMesh(const Bodies<float, float, float> &bodies, size_t numBodies);
+
+		public:
+			/**
+			 * The number of mesh cells between a body and the border of the mesh, which are required by the
+			 * cloud-in-cell interpolation and the finite differences.
+			 */
+			static constexpr size_t MESH_MARGIN = 3;
+
+			/**
+			 * The factor by which a split scale above the minimum exceeds the required split scale, so the Green's
+			 * function is not transformed again by each slight change of the cell size.
+			 */
+			static constexpr double SPLIT_SCALE_HEADROOM = 1.25;
+
+			/**
+			 * @brief The parameterized constructor. Creates a new instance of this class by the parameters.
+			 * @param meshSize the number of mesh cells per axis, must be a power of two of at least 16.
+			 * @param splitScaleInCells the minimum split scale in mesh cells.
+			 * @throws std::invalid_argument if the mesh size is not a power of two of at least 16.
+			 */
+			ParticleMeshSolver(size_t meshSize, float splitScaleInCells);
+
+			/**
+			 * @brief Calculates the long-range field of the given bodies at the positions of the bodies.
+			 * @param bodies the bodies whose field is to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[out] field the long-range field of the passed bodies without the gravitational constant, i.e. the
+			 * 					negative gradient of the potential, which points towards the masses. It must be large
+			 * 					enough to store <code>numBodies * vector dimension</code>.
+			 * @param minSplitScale the minimum split scale in units of length, which enlarges the split scale in mesh
+			 * 						cells if the cells are too small.
+			 */
+			void calcLongRangeField(const Bodies<float, float, float> &bodies, size_t numBodies, float *field,
+									float minSplitScale);
+
+			/**
+			 * @brief Returns the split scale of the last calculation in units of length.
+			 * @return the split scale of the last calculation in units of length.
+			 */
+			[[nodiscard]] inline float getSplitScale() const {
+				return static_cast<float>(currentSplitScaleInCells_ * cellSize_);
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_PARTICLE_MESH_SOLVER_H
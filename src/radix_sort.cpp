@@ -0,0 +1,84 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <omp.h>
+
+#include "radix_sort.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The number of key bits sorted by one pass.
+	 */
+	constexpr unsigned int BITS_PER_PASS = 8;
+
+	/**
+	 * The number of buckets of one pass.
+	 */
+	constexpr size_t NUM_BUCKETS = size_t{1} << BITS_PER_PASS;
+}
+
+void physics::radixSortByKeys(
+		std::pair<std::uint64_t, size_t> *pairs,
+		std::pair<std::uint64_t, size_t> *buffer,
+		const size_t numPairs,
+		const unsigned int numKeyBits,
+		std::vector<size_t> &histograms
+) {
+	const auto maxNumThreads = static_cast<size_t>(omp_get_max_threads());
+	histograms.resize(maxNumThreads * NUM_BUCKETS);
+	std::pair<std::uint64_t, size_t> *source = pairs;
+	std::pair<std::uint64_t, size_t> *destination = buffer;
+	for (unsigned int shift = 0; shift < numKeyBits; shift += BITS_PER_PASS) {
+		bool isSorted = false;
+		// @formatter:off
+		#pragma omp parallel default(none) shared(source, destination, numPairs, shift, histograms, isSorted)
+		// @formatter:on
+		{
+			const auto numThreads = static_cast<size_t>(omp_get_num_threads());
+			const auto thread = static_cast<size_t>(omp_get_thread_num());
+			const size_t chunkSize = (numPairs + numThreads - 1) / numThreads;
+			const size_t begin = std::min(numPairs, thread * chunkSize);
+			const size_t end = std::min(numPairs, begin + chunkSize);
+			size_t *const histogram = histograms.data() + (thread * NUM_BUCKETS);
+
+			// 1. count the digits of the own chunk
+			std::fill(histogram, histogram + NUM_BUCKETS, 0);
+			for (size_t i = begin; i < end; ++i) {
+				++histogram[(source[i].first >> shift) & (NUM_BUCKETS - 1)];
+			}
+			// @formatter:off
+			#pragma omp barrier
+			// @formatter:on
+
+			// 2. the exclusive prefix sums, ordered by digit and then by thread, which keeps the sort stable
+			// @formatter:off
+			#pragma omp single
+			// @formatter:on
+			{
+				size_t offset = 0;
+				for (size_t digit = 0; digit < NUM_BUCKETS; ++digit) {
+					for (size_t t = 0; t < numThreads; ++t) {
+						const size_t count = histograms[(t * NUM_BUCKETS) + digit];
+						isSorted = isSorted || (count == numPairs);
+						histograms[(t * NUM_BUCKETS) + digit] = offset;
+						offset += count;
+					}
+				}
+			}
+
+			// 3. scatter the own chunk, unless all pairs have the same digit
+			if (!isSorted) {
+				for (size_t i = begin; i < end; ++i) {
+					destination[histogram[(source[i].first >> shift) & (NUM_BUCKETS - 1)]++] = source[i];
+				}
+			}
+		}
+		if (!isSorted) {
+			std::swap(source, destination);
+		}
+	}
+	if (source != pairs) {
+		std::copy(source, source + numPairs, pairs);
+	}
+}
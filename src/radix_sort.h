@@ -0,0 +1,35 @@
+#ifndef PHYSICS_ENGINE_RADIX_SORT_H
+#define PHYSICS_ENGINE_RADIX_SORT_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief Sorts the passed key and index pairs by their keys with a stable, parallel LSD radix sort.
+	 * @details Each pass sorts by 8 bits of the keys. Each thread counts and scatters a contiguous chunk of the pairs,
+	 * so the sort is stable. Passes in which all keys have the same digit are skipped, so the sort of keys with few
+	 * significant bits is cheap.
+	 * @param pairs the key and index pairs to be sorted.
+	 * @param buffer the workspace with the same number of elements as the pairs.
+	 * @param numPairs the number of pairs.
+	 * @param numKeyBits the number of significant bits of the keys.
+	 * @param histograms the workspace of the digit counts, which is resized to the number of threads times 256.
+	 */
+	void radixSortByKeys(
+			std::pair<std::uint64_t, size_t> *pairs,
+			std::pair<std::uint64_t, size_t> *buffer,
+			size_t numPairs,
+			unsigned int numKeyBits,
+			std::vector<size_t> &histograms
+	);
+}
+
+#endif //PHYSICS_ENGINE_RADIX_SORT_H
@@ -0,0 +1,192 @@
+#ifndef PHYSICS_ENGINE_REPRODUCIBLE_SUM_H
+#define PHYSICS_ENGINE_REPRODUCIBLE_SUM_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "physics/bodies.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief An exact sum of floats in a fixed-point accumulator, whose result does not depend on the order of the
+	 * summands.
+	 * @details Each float is a 24-bit integer times a power of two between <code>2^-149</code> and <code>2^104</code>,
+	 * so it is added exactly to an accumulator of signed 64-bit limbs, each of which holds 32 bits of the fixed-point
+	 * number plus the carries of up to <code>2^31</code> additions. The carries are propagated before they can
+	 * overflow and by <code>getValue</code>, which rounds the exact sum once. Infinities and NaNs are summed up as
+	 * floats, so they propagate as usual.
+	 */
+	class ReproducibleSum {
+
+		public:
+			/**
+			 * The number of limbs, which cover the 277 bits of the floats plus the carries of the highest limb.
+			 */
+			static constexpr size_t NUM_LIMBS = 9;
+
+		private:
+			/**
+			 * The number of additions, after which the carries are propagated.
+			 */
+			static constexpr uint32_t MAX_NUM_PENDING_ADDITIONS = uint32_t(1) << 31;
+
+			/**
+			 * The limbs of the fixed-point number, the limb <code>k</code> has the weight <code>2^(32 * k - 149)</code>.
+			 */
+			int64_t limbs_[NUM_LIMBS] = {};
+
+			/**
+			 * The number of additions since the carries were propagated.
+			 */
+			uint32_t numPendingAdditions_ = 0;
+
+			/**
+			 * The sum of the infinite and NaN summands.
+			 */
+			float nonFiniteSum_ = 0.0f;
+
+			/**
+			 * @brief Propagates the carries, so all limbs except the highest one are in <code>[0, 2^32)</code>.
+			 */
+			inline void propagateCarries() {
+				for (size_t limb = 0; limb < (NUM_LIMBS - 1); ++limb) {
+					// the arithmetic shift rounds towards negative infinity, so the remainder is not negative
+					const int64_t carry = limbs_[limb] >> 32;
+					limbs_[limb] -= carry * (int64_t(1) << 32);
+					limbs_[limb + 1] += carry;
+				}
+				numPendingAdditions_ = 0;
+			}
+
+		public:
+			/**
+			 * @brief Adds the passed value exactly to this sum.
+			 * @param value the value to be added.
+			 */
+			inline void add(const float value) {
+				const auto bits = std::bit_cast<uint32_t>(value);
+				const uint32_t biasedExponent = (bits >> 23) & 0xFF;
+				if (0xFF == biasedExponent) {
+					nonFiniteSum_ += value;
+					return;
+				}
+				// the value is significand * 2^(shift - 149), subnormals have the same shift as the smallest normals
+				const uint64_t significand = (bits & 0x7FFFFF) | ((0 == biasedExponent) ? 0 : 0x800000);
+				const uint32_t shift = (0 == biasedExponent) ? 0 : (biasedExponent - 1);
+				const uint64_t shiftedSignificand = significand << (shift % 32);
+				const size_t limb = shift / 32;
+				const auto lowPart = static_cast<int64_t>(shiftedSignificand & 0xFFFFFFFF);
+				const auto highPart = static_cast<int64_t>(shiftedSignificand >> 32);
+				if (0 != (bits >> 31)) {
+					limbs_[limb] -= lowPart;
+					limbs_[limb + 1] -= highPart;
+				} else {
+					limbs_[limb] += lowPart;
+					limbs_[limb + 1] += highPart;
+				}
+				if (MAX_NUM_PENDING_ADDITIONS == ++numPendingAdditions_) {
+					propagateCarries();
+				}
+			}
+
+			/**
+			 * @brief Returns the exact sum rounded to a float.
+			 * @details The three highest non-zero limbs are converted into a double, which is rounded to a float, so
+			 * the result is within one unit in the last place of the exact sum. It is a function of the exact sum only,
+			 * so the summation order does not matter.
+			 * @return the rounded sum.
+			 */
+			[[nodiscard]] inline float getValue() const {
+				if (0.0f != nonFiniteSum_) {
+					return nonFiniteSum_;
+				}
+				ReproducibleSum magnitude = *this;
+				magnitude.propagateCarries();
+				const bool isNegative = magnitude.limbs_[NUM_LIMBS - 1] < 0;
+				if (isNegative) {
+					for (int64_t &limb: magnitude.limbs_) {
+						limb = -limb;
+					}
+					magnitude.propagateCarries();
+				}
+
+				double value = 0.0;
+				size_t numConvertedLimbs = 0;
+				for (size_t limb = NUM_LIMBS; (0 < limb) && (numConvertedLimbs < 3); --limb) {
+					if ((0 != magnitude.limbs_[limb - 1]) || (0 < numConvertedLimbs)) {
+						value += std::ldexp(static_cast<double>(magnitude.limbs_[limb - 1]),
+											(32 * static_cast<int>(limb - 1)) - 149);
+						++numConvertedLimbs;
+					}
+				}
+				return static_cast<float>(isNegative ? -value : value);
+			}
+	};
+
+	/**
+	 * @brief Calculates the acceleration and optionally the potential of one target body caused by all other bodies
+	 * with reproducible sums.
+	 * @details All implementations share this function in their deterministic mode, so the contribution of each
+	 * pair is the same expression and the results are bit-identical.
+	 * @tparam CalcPotentials <code>true</code> to calculate the potential as well.
+	 * @tparam TForceLaw the force law between two bodies.
+	 * @param forceLaw the force law between two bodies.
+	 * @param bodies the bodies.
+	 * @param numBodies the number of bodies.
+	 * @param target the index of the target body.
+	 * @param[out] accelerations the accelerations, of which only the elements of the target body are written.
+	 * @param[out] potentials the potentials, of which only the element of the target body is written if
+	 * 					<code>CalcPotentials</code>.
+	 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+	 */
+	template<bool CalcPotentials, typename TForceLaw>
+	inline void calcAccelerationOfTargetReproducibly(const TForceLaw &forceLaw,
+													 const Bodies<float, float, float> &bodies,
+													 const size_t numBodies, const size_t target,
+													 float *const accelerations, float *const potentials,
+													 const float squaredSofteningFactor) {
+		const float targetPosition[3] = {
+				bodies.positions[target * 3], bodies.positions[(target * 3) + 1], bodies.positions[(target * 3) + 2]
+		};
+		const float targetMass = bodies.masses[target];
+		ReproducibleSum forceSums[3];
+		ReproducibleSum potentialSum;
+		for (size_t j = 0; j < numBodies; ++j) {
+			if (target != j) {
+				// the distance vector points from the target to the source body
+				const float distanceVector[3] = {
+						bodies.positions[j * 3] - targetPosition[0],
+						bodies.positions[(j * 3) + 1] - targetPosition[1],
+						bodies.positions[(j * 3) + 2] - targetPosition[2]
+				};
+				const float distanceSquared = (distanceVector[0] * distanceVector[0]) +
+											  (distanceVector[1] * distanceVector[1]) +
+											  (distanceVector[2] * distanceVector[2]);
+				const float receivedForce = forceLaw(distanceSquared, squaredSofteningFactor, targetMass,
+													 bodies.masses[j]);
+				forceSums[0].add(receivedForce * distanceVector[0]);
+				forceSums[1].add(receivedForce * distanceVector[1]);
+				forceSums[2].add(receivedForce * distanceVector[2]);
+				if constexpr (CalcPotentials) {
+					potentialSum.add(forceLaw.calcPotentialEnergy(distanceSquared, squaredSofteningFactor, targetMass,
+																  bodies.masses[j]));
+				}
+			}
+		}
+		accelerations[target * 3] = forceSums[0].getValue();
+		accelerations[(target * 3) + 1] = forceSums[1].getValue();
+		accelerations[(target * 3) + 2] = forceSums[2].getValue();
+		if constexpr (CalcPotentials) {
+			potentials[target] = potentialSum.getValue();
+		}
+	}
+}
+
+#endif //PHYSICS_ENGINE_REPRODUCIBLE_SUM_H
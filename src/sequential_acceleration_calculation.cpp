@@ -1,17 +1,33 @@
 // Reminder: Always include standard library and system headers before including your own headers.
-#include <cmath>
+#include <algorithm>
 
 #include "sequential_acceleration_calculation.h"
-#include "physics/astronomical_algorithms.h"
+#include "reproducible_sum.h"
 
 using namespace physics;
 
-void SequentialAccelerationCalculationImpl::calcAccelerations(
+template<typename TForceLaw>
+BasicSequentialAccelerationCalculationImpl<TForceLaw>::BasicSequentialAccelerationCalculationImpl(
+		const TForceLaw &forceLaw
+) :
+		forceLaw_(forceLaw),
+		isDeterministicModeEnabled_(false) {
+}
+
+template<typename TForceLaw>
+template<bool CalcPotentials>
+void BasicSequentialAccelerationCalculationImpl<TForceLaw>::sweep(
 		const Bodies<float, float, float> &bodies,
 		const size_t numBodies,
 		float *const accelerations,
+		float *const potentials,
 		const float squaredSofteningFactor
 ) {
+	// the pairs are accumulated, so previous contents of the accelerations must not leak into the result
+	std::fill(accelerations, accelerations + (numBodies * 3), 0.0f);
+	if constexpr (CalcPotentials) {
+		std::fill(potentials, potentials + numBodies, 0.0f);
+	}
 	for (size_t i = 0; i < numBodies; ++i) {
 		const size_t xCoordinateIndexBody1 = i * 3;
 		const size_t yCoordinateIndexBody1 = xCoordinateIndexBody1 + 1;
@@ -21,37 +37,150 @@ void SequentialAccelerationCalculationImpl::calcAccelerations(
 			const size_t yCoordinateIndexBody2 = xCoordinateIndexBody2 + 1;
 			const size_t zCoordinateIndexBody2 = xCoordinateIndexBody2 + 2;
 
+			// the distance vector points from body 1 to body 2
 			const float distanceVectorXCoordinate =
-					bodies.positions[xCoordinateIndexBody1] - bodies.positions[xCoordinateIndexBody2];
+					bodies.positions[xCoordinateIndexBody2] - bodies.positions[xCoordinateIndexBody1];
 			const float distanceVectorYCoordinate =
-					bodies.positions[yCoordinateIndexBody1] - bodies.positions[yCoordinateIndexBody2];
+					bodies.positions[yCoordinateIndexBody2] - bodies.positions[yCoordinateIndexBody1];
 			const float distanceVectorZCoordinate =
-					bodies.positions[zCoordinateIndexBody1] - bodies.positions[zCoordinateIndexBody2];
-			const float distance = std::sqrt(
+					bodies.positions[zCoordinateIndexBody2] - bodies.positions[zCoordinateIndexBody1];
+			const float distanceSquared =
 					(distanceVectorXCoordinate * distanceVectorXCoordinate) +
 					(distanceVectorYCoordinate * distanceVectorYCoordinate) +
-					(distanceVectorZCoordinate * distanceVectorZCoordinate)
-			) + squaredSofteningFactor; // to avoid zero in the following divisions
-			const float normalizedDistanceVectorXCoordinate = distanceVectorXCoordinate / distance;
-			const float normalizedDistanceVectorYCoordinate = distanceVectorYCoordinate / distance;
-			const float normalizedDistanceVectorZCoordinate = distanceVectorZCoordinate / distance;
-			const float distanceSquared = distance * distance;
-			const float tmp = bodies.masses[j] / distanceSquared;
-			accelerations[xCoordinateIndexBody1] += (tmp * normalizedDistanceVectorXCoordinate);
-			accelerations[yCoordinateIndexBody1] += (tmp * normalizedDistanceVectorYCoordinate);
-			accelerations[zCoordinateIndexBody1] += (tmp * normalizedDistanceVectorZCoordinate);
+					(distanceVectorZCoordinate * distanceVectorZCoordinate);
+			// the distance factor is symmetric, so it is calculated only once per pair
+			const float distanceFactor = forceLaw_.calcDistanceFactor(distanceSquared, squaredSofteningFactor);
+
+			const float tmp = distanceFactor * forceLaw_.calcStrengthFactor(bodies.masses[i], bodies.masses[j]);
+			accelerations[xCoordinateIndexBody1] += (tmp * distanceVectorXCoordinate);
+			accelerations[yCoordinateIndexBody1] += (tmp * distanceVectorYCoordinate);
+			accelerations[zCoordinateIndexBody1] += (tmp * distanceVectorZCoordinate);
 
 			// Newton's third law
-			const float tmp2 = bodies.masses[i] / distanceSquared;
-			accelerations[xCoordinateIndexBody2] -= (tmp2 * normalizedDistanceVectorXCoordinate);
-			accelerations[yCoordinateIndexBody2] -= (tmp2 * normalizedDistanceVectorYCoordinate);
-			accelerations[zCoordinateIndexBody2] -= (tmp2 * normalizedDistanceVectorZCoordinate);
+			const float tmp2 = distanceFactor * forceLaw_.calcStrengthFactor(bodies.masses[j], bodies.masses[i]);
+			accelerations[xCoordinateIndexBody2] -= (tmp2 * distanceVectorXCoordinate);
+			accelerations[yCoordinateIndexBody2] -= (tmp2 * distanceVectorYCoordinate);
+			accelerations[zCoordinateIndexBody2] -= (tmp2 * distanceVectorZCoordinate);
+
+			if constexpr (CalcPotentials) {
+				// the potential energy of a pair is symmetric as well
+				const float potentialEnergy = forceLaw_.calcPotentialEnergy(distanceSquared, squaredSofteningFactor,
+																			bodies.masses[i], bodies.masses[j]);
+				potentials[i] += potentialEnergy;
+				potentials[j] += potentialEnergy;
+			}
+		}
+	}
+}
+
+template<typename TForceLaw>
+template<bool CalcPotentials>
+void BasicSequentialAccelerationCalculationImpl<TForceLaw>::sweepReproducibly(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	for (size_t i = 0; i < numBodies; ++i) {
+		calcAccelerationOfTargetReproducibly<CalcPotentials>(forceLaw_, bodies, numBodies, i, accelerations, potentials,
+															 squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+void BasicSequentialAccelerationCalculationImpl<TForceLaw>::calcAccelerations(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		const float squaredSofteningFactor
+) {
+	if (isDeterministicModeEnabled_) {
+		sweepReproducibly<false>(bodies, numBodies, accelerations, nullptr, squaredSofteningFactor);
+	} else {
+		sweep<false>(bodies, numBodies, accelerations, nullptr, squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+bool BasicSequentialAccelerationCalculationImpl<TForceLaw>::isPotentialCalculationSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicSequentialAccelerationCalculationImpl<TForceLaw>::calcAccelerationsAndPotentials(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	if (isDeterministicModeEnabled_) {
+		sweepReproducibly<true>(bodies, numBodies, accelerations, potentials, squaredSofteningFactor);
+	} else {
+		sweep<true>(bodies, numBodies, accelerations, potentials, squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+bool BasicSequentialAccelerationCalculationImpl<TForceLaw>::isProbeEvaluationSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicSequentialAccelerationCalculationImpl<TForceLaw>::calcFieldAtProbes(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *const probeMasses,
+		const float *const probePositions,
+		const size_t numProbes,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	for (size_t i = 0; i < numProbes; ++i) {
+		const float *const probePosition = &probePositions[i * 3];
+		float forceVector[3] = {0.0f, 0.0f, 0.0f};
+		float potential = 0.0f;
+		for (size_t j = 0; j < numBodies; ++j) {
+			// the distance vector points from the probe to the body
+			const float distanceVectorXCoordinate = bodies.positions[j * 3] - probePosition[0];
+			const float distanceVectorYCoordinate = bodies.positions[(j * 3) + 1] - probePosition[1];
+			const float distanceVectorZCoordinate = bodies.positions[(j * 3) + 2] - probePosition[2];
+			const float distanceSquared =
+					(distanceVectorXCoordinate * distanceVectorXCoordinate) +
+					(distanceVectorYCoordinate * distanceVectorYCoordinate) +
+					(distanceVectorZCoordinate * distanceVectorZCoordinate);
+			// a body at the position of the probe is the probe itself
+			if (0.0f < distanceSquared) {
+				const float receivedForce = forceLaw_(distanceSquared, squaredSofteningFactor, probeMasses[i],
+													  bodies.masses[j]);
+				forceVector[0] += (receivedForce * distanceVectorXCoordinate);
+				forceVector[1] += (receivedForce * distanceVectorYCoordinate);
+				forceVector[2] += (receivedForce * distanceVectorZCoordinate);
+				if (nullptr != potentials) {
+					potential += forceLaw_.calcPotentialEnergy(distanceSquared, squaredSofteningFactor, probeMasses[i],
+															   bodies.masses[j]);
+				}
+			}
+		}
+		accelerations[i * 3] = forceVector[0];
+		accelerations[(i * 3) + 1] = forceVector[1];
+		accelerations[(i * 3) + 2] = forceVector[2];
+		if (nullptr != potentials) {
+			potentials[i] = potential;
 		}
-		accelerations[xCoordinateIndexBody1] =
-				static_cast<float>(accelerations[xCoordinateIndexBody1] * GRAVITATIONAL_CONSTANT);
-		accelerations[yCoordinateIndexBody1] =
-				static_cast<float>(accelerations[yCoordinateIndexBody1] * GRAVITATIONAL_CONSTANT);
-		accelerations[zCoordinateIndexBody1] =
-				static_cast<float>(accelerations[zCoordinateIndexBody1] * GRAVITATIONAL_CONSTANT);
 	}
-}
\ No newline at end of file
+}
+
+template<typename TForceLaw>
+bool BasicSequentialAccelerationCalculationImpl<TForceLaw>::isDeterministicModeSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicSequentialAccelerationCalculationImpl<TForceLaw>::setDeterministicModeEnabled(const bool enabled) {
+	isDeterministicModeEnabled_ = enabled;
+}
+
+PHYSICS_INSTANTIATE_FOR_ALL_FORCE_LAWS(physics::BasicSequentialAccelerationCalculationImpl)
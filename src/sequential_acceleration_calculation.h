@@ -2,6 +2,7 @@
 #define PHYSICS_ENGINE_SEQUENTIAL_ACCELERATION_CALCULATION_H
 
 #include "physics/acceleration_calculation.h"
+#include "physics/force_laws.h"
 
 /**
  * @brief Namespace for physics-related functions and classes.
@@ -9,11 +10,70 @@
 namespace physics {
 
 	/**
-	 * @brief An <strong>sequential</strong> implementation of the calculation of gravitational accelerations of N bodies.
+	 * @brief An <strong>sequential</strong> implementation of the calculation of accelerations of N bodies.
+	 * @details The template is explicitly instantiated for each force law in its translation unit.
+	 * @tparam TForceLaw the force law between two bodies, which is inlined into the inner loop.
 	 */
-	class SequentialAccelerationCalculationImpl : public IAccelerationCalculation {
+	template<typename TForceLaw>
+	class BasicSequentialAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		private:
+			/**
+			 * The force law between two bodies.
+			 */
+			TForceLaw forceLaw_;
+
+			/**
+			 * Whether the contributions of the pairs are summed up reproducibly.
+			 */
+			bool isDeterministicModeEnabled_;
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potentials of the given bodies in one sweep.
+			 * @tparam CalcPotentials <code>true</code> to calculate the potentials in the same sweep.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[out] accelerations the accelerations of the passed bodies, which are reset before the sweep.
+			 * @param[out] potentials the potential energies of the passed bodies, only used if
+			 * 					<code>CalcPotentials</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			template<bool CalcPotentials>
+			void sweep(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			);
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potentials of the given bodies target by target
+			 * with reproducible sums, without Newton's third law.
+			 * @tparam CalcPotentials <code>true</code> to calculate the potentials in the same sweep.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[out] accelerations the accelerations of the passed bodies.
+			 * @param[out] potentials the potential energies of the passed bodies, only used if
+			 * 					<code>CalcPotentials</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			template<bool CalcPotentials>
+			void sweepReproducibly(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			);
 
 		public:
+			/**
+			 * @brief The parameterized constructor.
+			 * @param forceLaw the force law between two bodies.
+			 */
+			explicit BasicSequentialAccelerationCalculationImpl(const TForceLaw &forceLaw = TForceLaw());
+
 			/**
 			 * @brief Calculates the accelerations of the given bodies.
 			 * @param bodies the bodies whose accelerations are to be calculated.
@@ -29,7 +89,79 @@ namespace physics {
 					float *accelerations,
 					float squaredSofteningFactor
 			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the potentials are calculated by the force law.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isPotentialCalculationSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations and the potential energies of the given bodies in the same sweep
+			 * over all pairs.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies, as by <code>calcAccelerations</code>.
+			 * @param[out] potentials the potential energy of each body with all other bodies. The number of elements
+			 * 					must be <code>numBodies</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerationsAndPotentials(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the field can be evaluated at probes.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isProbeEvaluationSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potential energies of probes caused by the passed
+			 * bodies by direct summation.
+			 * @param bodies the source bodies.
+			 * @param numBodies the number of bodies.
+			 * @param probeMasses the masses (resp. charges) of the probes.
+			 * @param probePositions the positions of the probes, <code>numProbes * vector dimension</code> coordinates.
+			 * @param numProbes the number of probes.
+			 * @param[out] accelerations the accelerations of the probes, <code>numProbes * vector dimension</code>
+			 * 					elements.
+			 * @param[out] potentials the potential energies of the probes with all bodies, <code>numProbes</code>
+			 * 					elements, or <code>nullptr</code> if they are not needed.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcFieldAtProbes(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *probeMasses,
+					const float *probePositions,
+					size_t numProbes,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the pairs can be summed up reproducibly.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isDeterministicModeSupported() const override;
+
+			/**
+			 * @brief Enables or disables the deterministic mode, in which the pairs are visited target by target.
+			 * @param enabled <code>true</code> if the calculation should be deterministic.
+			 */
+			void setDeterministicModeEnabled(bool enabled) override;
 	};
+
+	/**
+	 * @brief The sequential implementation of the calculation of gravitational accelerations of N bodies.
+	 */
+	using SequentialAccelerationCalculationImpl = BasicSequentialAccelerationCalculationImpl<NewtonianForceLaw>;
 }
 
 #endif //PHYSICS_ENGINE_SEQUENTIAL_ACCELERATION_CALCULATION_H
@@ -0,0 +1,241 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "small_n_acceleration_calculation.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief The bodies of a kernel in arrays of a fixed size, which are kept in the registers if the kernel is
+	 * fully unrolled.
+	 * @tparam NumBodies the number of bodies.
+	 */
+	template<size_t NumBodies>
+	struct SmallNBodies {
+		std::array<float, NumBodies> xCoordinates;
+		std::array<float, NumBodies> yCoordinates;
+		std::array<float, NumBodies> zCoordinates;
+		std::array<float, NumBodies> masses;
+		std::array<float, NumBodies> xAccelerations;
+		std::array<float, NumBodies> yAccelerations;
+		std::array<float, NumBodies> zAccelerations;
+		std::array<float, NumBodies> potentials;
+	};
+
+	/**
+	 * @brief Creates the pairs <code>(i, j)</code> with <code>i < j</code> of a fixed number of bodies in the order
+	 * of the nested loops.
+	 */
+	template<size_t NumBodies>
+	constexpr auto createPairs() {
+		std::array<std::pair<size_t, size_t>, (NumBodies < 2) ? 0 : ((NumBodies * (NumBodies - 1)) / 2)> pairs{};
+		size_t pair = 0;
+		for (size_t i = 0; i < NumBodies; ++i) {
+			for (size_t j = i + 1; j < NumBodies; ++j) {
+				pairs[pair++] = {i, j};
+			}
+		}
+		return pairs;
+	}
+
+	/**
+	 * The pairs of a fixed number of bodies, whose indices are constants of the fully unrolled kernels.
+	 */
+	template<size_t NumBodies>
+	constexpr auto PAIRS = createPairs<NumBodies>();
+
+	/**
+	 * @brief Accumulates the accelerations and optionally the potentials of a pair of bodies by Newton's third law.
+	 */
+	template<bool CalcPotentials, typename TForceLaw, size_t NumBodies>
+	inline void accumulatePair(const TForceLaw &forceLaw, SmallNBodies<NumBodies> &bodies, const size_t i,
+							   const size_t j, const float squaredSofteningFactor) {
+		// the distance vector points from body i to body j
+		const float distanceVectorXCoordinate = bodies.xCoordinates[j] - bodies.xCoordinates[i];
+		const float distanceVectorYCoordinate = bodies.yCoordinates[j] - bodies.yCoordinates[i];
+		const float distanceVectorZCoordinate = bodies.zCoordinates[j] - bodies.zCoordinates[i];
+		const float distanceSquared = (distanceVectorXCoordinate * distanceVectorXCoordinate) +
+									  (distanceVectorYCoordinate * distanceVectorYCoordinate) +
+									  (distanceVectorZCoordinate * distanceVectorZCoordinate);
+		// the distance factor is symmetric, so it is calculated only once per pair
+		const float distanceFactor = forceLaw.calcDistanceFactor(distanceSquared, squaredSofteningFactor);
+
+		const float tmp = distanceFactor * forceLaw.calcStrengthFactor(bodies.masses[i], bodies.masses[j]);
+		bodies.xAccelerations[i] += (tmp * distanceVectorXCoordinate);
+		bodies.yAccelerations[i] += (tmp * distanceVectorYCoordinate);
+		bodies.zAccelerations[i] += (tmp * distanceVectorZCoordinate);
+
+		// Newton's third law
+		const float tmp2 = distanceFactor * forceLaw.calcStrengthFactor(bodies.masses[j], bodies.masses[i]);
+		bodies.xAccelerations[j] -= (tmp2 * distanceVectorXCoordinate);
+		bodies.yAccelerations[j] -= (tmp2 * distanceVectorYCoordinate);
+		bodies.zAccelerations[j] -= (tmp2 * distanceVectorZCoordinate);
+
+		if constexpr (CalcPotentials) {
+			// the potential energy of a pair is symmetric as well
+			const float potentialEnergy = forceLaw.calcPotentialEnergy(distanceSquared, squaredSofteningFactor,
+																	   bodies.masses[i], bodies.masses[j]);
+			bodies.potentials[i] += potentialEnergy;
+			bodies.potentials[j] += potentialEnergy;
+		}
+	}
+
+	/**
+	 * @brief Calculates the accelerations and optionally the potentials of a fixed number of bodies.
+	 * @details The pairs are visited in the same order as by the sequential implementation. The kernels of up to
+	 * <code>FULLY_UNROLLED_MAX_NUM_BODIES</code> bodies expand one call per pair with constant indices, the
+	 * larger kernels loop over the pairs with constant bounds.
+	 */
+	template<bool CalcPotentials, typename TForceLaw, size_t NumBodies>
+	void calcAccelerationsOfSmallN(const TForceLaw &forceLaw, const Bodies<float, float, float> &bodies,
+								   float *const accelerations, float *const potentials,
+								   const float squaredSofteningFactor) {
+		SmallNBodies<NumBodies> smallNBodies{};
+		for (size_t i = 0; i < NumBodies; ++i) {
+			smallNBodies.xCoordinates[i] = bodies.positions[i * 3];
+			smallNBodies.yCoordinates[i] = bodies.positions[(i * 3) + 1];
+			smallNBodies.zCoordinates[i] = bodies.positions[(i * 3) + 2];
+			smallNBodies.masses[i] = bodies.masses[i];
+		}
+
+		if constexpr (NumBodies <= BasicSmallNAccelerationCalculationImpl<TForceLaw>::FULLY_UNROLLED_MAX_NUM_BODIES) {
+			[&]<size_t... Pair>(std::index_sequence<Pair...>) {
+				(accumulatePair<CalcPotentials>(forceLaw, smallNBodies, PAIRS<NumBodies>[Pair].first,
+												PAIRS<NumBodies>[Pair].second, squaredSofteningFactor), ...);
+			}(std::make_index_sequence<PAIRS<NumBodies>.size()>());
+		} else {
+			for (size_t i = 0; i < NumBodies; ++i) {
+				for (size_t j = i + 1; j < NumBodies; ++j) {
+					accumulatePair<CalcPotentials>(forceLaw, smallNBodies, i, j, squaredSofteningFactor);
+				}
+			}
+		}
+
+		for (size_t i = 0; i < NumBodies; ++i) {
+			accelerations[i * 3] = smallNBodies.xAccelerations[i];
+			accelerations[(i * 3) + 1] = smallNBodies.yAccelerations[i];
+			accelerations[(i * 3) + 2] = smallNBodies.zAccelerations[i];
+			if constexpr (CalcPotentials) {
+				potentials[i] = smallNBodies.potentials[i];
+			}
+		}
+	}
+}
+
+template<typename TForceLaw>
+BasicSmallNAccelerationCalculationImpl<TForceLaw>::BasicSmallNAccelerationCalculationImpl(const TForceLaw &forceLaw) :
+		forceLaw_(forceLaw),
+		fallbackCalculation_(forceLaw),
+		isDeterministicModeEnabled_(false) {
+}
+
+template<typename TForceLaw>
+template<bool CalcPotentials>
+typename BasicSmallNAccelerationCalculationImpl<TForceLaw>::Kernel
+BasicSmallNAccelerationCalculationImpl<TForceLaw>::selectKernel(const size_t numBodies) {
+	// the table of the kernels of 0 to MAX_NUM_BODIES bodies is created at compile time
+	static constexpr std::array<Kernel, MAX_NUM_BODIES + 1> kernels =
+			[]<size_t... NumBodies>(std::index_sequence<NumBodies...>) {
+				return std::array<Kernel, MAX_NUM_BODIES + 1>{
+						&calcAccelerationsOfSmallN<CalcPotentials, TForceLaw, NumBodies>...
+				};
+			}(std::make_index_sequence<MAX_NUM_BODIES + 1>());
+	return kernels[numBodies];
+}
+
+template<typename TForceLaw>
+void BasicSmallNAccelerationCalculationImpl<TForceLaw>::calcAccelerations(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		const float squaredSofteningFactor
+) {
+	if (isDeterministicModeEnabled_ || (MAX_NUM_BODIES < numBodies)) {
+		fallbackCalculation_.calcAccelerations(bodies, numBodies, accelerations, squaredSofteningFactor);
+	} else {
+		selectKernel<false>(numBodies)(forceLaw_, bodies, accelerations, nullptr, squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+bool BasicSmallNAccelerationCalculationImpl<TForceLaw>::isPotentialCalculationSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicSmallNAccelerationCalculationImpl<TForceLaw>::calcAccelerationsAndPotentials(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	if (isDeterministicModeEnabled_ || (MAX_NUM_BODIES < numBodies)) {
+		fallbackCalculation_.calcAccelerationsAndPotentials(bodies, numBodies, accelerations, potentials,
+															squaredSofteningFactor);
+	} else {
+		selectKernel<true>(numBodies)(forceLaw_, bodies, accelerations, potentials, squaredSofteningFactor);
+	}
+}
+
+template<typename TForceLaw>
+bool BasicSmallNAccelerationCalculationImpl<TForceLaw>::isTargetRangeSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicSmallNAccelerationCalculationImpl<TForceLaw>::calcAccelerationsOfTargetRange(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const size_t targetBegin,
+		const size_t targetEnd,
+		float *const accelerations,
+		const float squaredSofteningFactor
+) {
+	if (isDeterministicModeEnabled_ || (MAX_NUM_BODIES < numBodies)) {
+		fallbackCalculation_.calcAccelerationsOfTargetRange(bodies, numBodies, targetBegin, targetEnd, accelerations,
+															 squaredSofteningFactor);
+	} else if (targetBegin < targetEnd) {
+		float allAccelerations[MAX_NUM_BODIES * 3];
+		selectKernel<false>(numBodies)(forceLaw_, bodies, allAccelerations, nullptr, squaredSofteningFactor);
+		std::copy(allAccelerations + (targetBegin * 3), allAccelerations + (targetEnd * 3),
+				  accelerations + (targetBegin * 3));
+	}
+}
+
+template<typename TForceLaw>
+bool BasicSmallNAccelerationCalculationImpl<TForceLaw>::isProbeEvaluationSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicSmallNAccelerationCalculationImpl<TForceLaw>::calcFieldAtProbes(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *const probeMasses,
+		const float *const probePositions,
+		const size_t numProbes,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	// the probes are no sources, so the kernels of the pairs do not apply
+	fallbackCalculation_.calcFieldAtProbes(bodies, numBodies, probeMasses, probePositions, numProbes, accelerations,
+										   potentials, squaredSofteningFactor);
+}
+
+template<typename TForceLaw>
+bool BasicSmallNAccelerationCalculationImpl<TForceLaw>::isDeterministicModeSupported() const {
+	return true;
+}
+
+template<typename TForceLaw>
+void BasicSmallNAccelerationCalculationImpl<TForceLaw>::setDeterministicModeEnabled(const bool enabled) {
+	fallbackCalculation_.setDeterministicModeEnabled(enabled);
+	isDeterministicModeEnabled_ = enabled;
+}
+
+PHYSICS_INSTANTIATE_FOR_ALL_FORCE_LAWS(physics::BasicSmallNAccelerationCalculationImpl)
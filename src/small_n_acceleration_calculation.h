@@ -0,0 +1,201 @@
+#ifndef PHYSICS_ENGINE_SMALL_N_ACCELERATION_CALCULATION_H
+#define PHYSICS_ENGINE_SMALL_N_ACCELERATION_CALCULATION_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+
+#include "physics/acceleration_calculation.h"
+#include "physics/force_laws.h"
+#include "openmp_acceleration_calculation.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A <strong>sequential</strong> implementation of the calculation of accelerations of few bodies, e.g.
+	 * planetary systems or triple stars, by kernels which are specialized at compile time for each number of bodies.
+	 * @details For few bodies the generic implementations are dominated by the overhead of each call, i.e. the start
+	 * of the OpenMP region and the branch <code>i != j</code> of the inner loop. Instead each kernel loads the
+	 * bodies into arrays of a fixed size on the stack and visits each pair exactly once by Newton's third law, so
+	 * there is no branch and all loop bounds are known to the compiler. The kernels of up to
+	 * <code>FULLY_UNROLLED_MAX_NUM_BODIES</code> bodies are fully unrolled, so the bodies stay in the registers. A
+	 * kernel is selected by a table lookup per call, larger numbers of bodies fall back to the OpenMP
+	 * implementation. The template is explicitly instantiated for each force law in its translation unit.
+	 * @tparam TForceLaw the force law between two bodies, which is inlined into the kernels.
+	 */
+	template<typename TForceLaw>
+	class BasicSmallNAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		public:
+			/**
+			 * The maximum number of bodies, which are calculated by a specialized kernel.
+			 */
+			static constexpr size_t MAX_NUM_BODIES = 64;
+
+			/**
+			 * The maximum number of bodies, whose kernel is fully unrolled.
+			 */
+			static constexpr size_t FULLY_UNROLLED_MAX_NUM_BODIES = 16;
+
+		private:
+			/**
+			 * The signature of the specialized kernels, which write the accelerations of all bodies and optionally
+			 * their potentials.
+			 */
+			using Kernel = void (*)(const TForceLaw &forceLaw, const Bodies<float, float, float> &bodies,
+									float *accelerations, float *potentials, float squaredSofteningFactor);
+
+			/**
+			 * The force law between two bodies.
+			 */
+			TForceLaw forceLaw_;
+
+			/**
+			 * The calculation of more than <code>MAX_NUM_BODIES</code> bodies.
+			 */
+			BasicOpenMpAccelerationCalculationImpl<TForceLaw> fallbackCalculation_;
+
+			/**
+			 * Whether the calculation is deterministic, in which case the fallback calculation is used for any number
+			 * of bodies.
+			 */
+			bool isDeterministicModeEnabled_;
+
+			/**
+			 * @brief Returns the kernel of the passed number of bodies.
+			 * @tparam CalcPotentials <code>true</code> to select the kernels which calculate the potentials as well.
+			 * @param numBodies the number of bodies, at most <code>MAX_NUM_BODIES</code>.
+			 * @return the specialized kernel.
+			 */
+			template<bool CalcPotentials>
+			static Kernel selectKernel(size_t numBodies);
+
+		public:
+			/**
+			 * @brief The parameterized constructor.
+			 * @param forceLaw the force law between two bodies.
+			 */
+			explicit BasicSmallNAccelerationCalculationImpl(const TForceLaw &forceLaw = TForceLaw());
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies. The <code>accelerations</code>
+			 * 					parameter must be a pointer to an allocated storage which is large enough to store
+			 * 					<code>numBodies * vector dimension</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerations(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the potentials are calculated by the force law.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isPotentialCalculationSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations and the potential energies of the given bodies in the same sweep
+			 * over all pairs.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies, as by <code>calcAccelerations</code>.
+			 * @param[out] potentials the potential energy of each body with all other bodies. The number of elements
+			 * 					must be <code>numBodies</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerationsAndPotentials(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the accelerations of a range of target bodies can be calculated.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isTargetRangeSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations of the target bodies of the passed range caused by all bodies.
+			 * @details The specialized kernels calculate all bodies at once, which is cheaper for few bodies than
+			 * skipping the pairs outside the range, so only the copy into the output is restricted to the range.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param targetBegin the index of the first target body.
+			 * @param targetEnd the index after the last target body, at most <code>numBodies</code>.
+			 * @param[in, out] accelerations the accelerations of all passed bodies, of which only the elements of the
+			 * 					target bodies are written.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerationsOfTargetRange(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					size_t targetBegin,
+					size_t targetEnd,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the field can be evaluated at probes.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isProbeEvaluationSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potential energies of probes caused by the passed
+			 * bodies by direct summation of the OpenMP implementation.
+			 * @param bodies the source bodies.
+			 * @param numBodies the number of bodies.
+			 * @param probeMasses the masses (resp. charges) of the probes.
+			 * @param probePositions the positions of the probes, <code>numProbes * vector dimension</code> coordinates.
+			 * @param numProbes the number of probes.
+			 * @param[out] accelerations the accelerations of the probes, <code>numProbes * vector dimension</code>
+			 * 					elements.
+			 * @param[out] potentials the potential energies of the probes with all bodies, <code>numProbes</code>
+			 * 					elements, or <code>nullptr</code> if they are not needed.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcFieldAtProbes(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *probeMasses,
+					const float *probePositions,
+					size_t numProbes,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the fallback calculation can sum up the pairs reproducibly.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isDeterministicModeSupported() const override;
+
+			/**
+			 * @brief Enables or disables the deterministic mode of the fallback calculation, which then replaces the
+			 * unrolled kernels, so the results are bit-identical to the other deterministic implementations.
+			 * @param enabled <code>true</code> if the calculation should be deterministic.
+			 */
+			void setDeterministicModeEnabled(bool enabled) override;
+	};
+
+	/**
+	 * @brief The implementation of the calculation of gravitational accelerations of few bodies by specialized
+	 * kernels.
+	 */
+	using SmallNAccelerationCalculationImpl = BasicSmallNAccelerationCalculationImpl<NewtonianForceLaw>;
+}
+
+#endif //PHYSICS_ENGINE_SMALL_N_ACCELERATION_CALCULATION_H
@@ -0,0 +1,100 @@
+#ifndef PHYSICS_ENGINE_SPACE_FILLING_CURVES_H
+#define PHYSICS_ENGINE_SPACE_FILLING_CURVES_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstdint>
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * The number of bits per coordinate axis of a 3D Morton key. Three axes with 21 bits each fit into 63 bits.
+	 */
+	constexpr unsigned int MORTON_KEY_BITS_PER_AXIS = 21;
+
+	/**
+	 * @brief Spreads the lower 21 bits of the passed value so that two zero bits are between each pair of bits.
+	 * @param value the value whose bits are to be spread.
+	 * @return the spread bits.
+	 */
+	inline std::uint64_t spreadBitsBy2(std::uint64_t value) {
+		value &= 0x1fffff;
+		value = (value | (value << 32)) & 0x1f00000000ffff;
+		value = (value | (value << 16)) & 0x1f0000ff0000ff;
+		value = (value | (value << 8)) & 0x100f00f00f00f00f;
+		value = (value | (value << 4)) & 0x10c30c30c30c30c3;
+		value = (value | (value << 2)) & 0x1249249249249249;
+		return value;
+	}
+
+	/**
+	 * @brief Calculates the 3D Morton key (Z-order) of the passed grid coordinates.
+	 * @param x the x grid coordinate, only the lower 21 bits are used.
+	 * @param y the y grid coordinate, only the lower 21 bits are used.
+	 * @param z the z grid coordinate, only the lower 21 bits are used.
+	 * @return the 63-bit Morton key.
+	 */
+	inline std::uint64_t calcMortonKey(const std::uint32_t x, const std::uint32_t y, const std::uint32_t z) {
+		return (spreadBitsBy2(x) << 2) | (spreadBitsBy2(y) << 1) | spreadBitsBy2(z);
+	}
+
+	/**
+	 * @brief Calculates the 3D Hilbert key of the passed grid coordinates.
+	 * @details The coordinates are transformed into the transposed Hilbert index by Skilling's algorithm, whose bits
+	 * are interleaved like a Morton key. Unlike the Morton curve, consecutive cells along the Hilbert curve are always
+	 * face neighbours, so the bodies sorted by their Hilbert keys have a better locality.
+	 * @param x the x grid coordinate, only the lower 21 bits are used.
+	 * @param y the y grid coordinate, only the lower 21 bits are used.
+	 * @param z the z grid coordinate, only the lower 21 bits are used.
+	 * @return the 63-bit Hilbert key.
+	 */
+	inline std::uint64_t calcHilbertKey(const std::uint32_t x, const std::uint32_t y, const std::uint32_t z) {
+		constexpr std::uint32_t mask = (1u << MORTON_KEY_BITS_PER_AXIS) - 1;
+		constexpr std::uint32_t highestBit = 1u << (MORTON_KEY_BITS_PER_AXIS - 1);
+		std::uint32_t transposed[3] = {x & mask, y & mask, z & mask};
+		// inverse undo of the excess work
+		for (std::uint32_t bit = highestBit; 1 < bit; bit >>= 1) {
+			const std::uint32_t lowerBits = bit - 1;
+			for (std::uint32_t &coordinate: transposed) {
+				if (0 != (coordinate & bit)) {
+					transposed[0] ^= lowerBits;
+				} else {
+					const std::uint32_t swappedBits = (transposed[0] ^ coordinate) & lowerBits;
+					transposed[0] ^= swappedBits;
+					coordinate ^= swappedBits;
+				}
+			}
+		}
+		// Gray encoding
+		transposed[1] ^= transposed[0];
+		transposed[2] ^= transposed[1];
+		std::uint32_t flippedBits = 0;
+		for (std::uint32_t bit = highestBit; 1 < bit; bit >>= 1) {
+			if (0 != (transposed[2] & bit)) {
+				flippedBits ^= bit - 1;
+			}
+		}
+		return calcMortonKey(transposed[0] ^ flippedBits, transposed[1] ^ flippedBits, transposed[2] ^ flippedBits);
+	}
+
+	/**
+	 * @brief Maps a coordinate to the grid coordinate used to calculate a space-filling curve key.
+	 * @param coordinate the coordinate to be mapped.
+	 * @param min the minimum coordinate of the bounding cube.
+	 * @param inverseCubeSize the inverse edge length of the bounding cube.
+	 * @return the grid coordinate clamped to the valid range of 21 bits.
+	 */
+	inline std::uint32_t calcGridCoordinate(const float coordinate, const float min, const float inverseCubeSize) {
+		constexpr std::uint32_t maxGridCoordinate = (1u << MORTON_KEY_BITS_PER_AXIS) - 1;
+		const float normalized = (coordinate - min) * inverseCubeSize;
+		if (!(0.0f < normalized)) { // also catches NaN
+			return 0;
+		}
+		const auto gridCoordinate = static_cast<std::uint64_t>(normalized * static_cast<float>(maxGridCoordinate));
+		return static_cast<std::uint32_t>(gridCoordinate < maxGridCoordinate ? gridCoordinate : maxGridCoordinate);
+	}
+}
+
+#endif //PHYSICS_ENGINE_SPACE_FILLING_CURVES_H
@@ -0,0 +1,413 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <omp.h>
+
+#include "sweep_and_prune_collision_handling.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Calculates the earliest time of impact of two spheres, which move linearly within the time step.
+	 * @param previousDistanceVector the distance vector from the first to the second sphere at the beginning.
+	 * @param distanceVector the distance vector from the first to the second sphere at the end.
+	 * @param sumOfRadii the sum of the radii of the spheres.
+	 * @param[out] timeOfImpact the time of impact as fraction of the time step.
+	 * @return <code>true</code> if the spheres touch within the time step, otherwise <code>false</code>.
+	 */
+	bool calcTimeOfImpact(const float *previousDistanceVector, const float *distanceVector, const float sumOfRadii,
+						  float &timeOfImpact) {
+		// solve |d0 + s * (d1 - d0)|^2 = R^2 for the smallest s in [0, 1]
+		float a = 0.0f, b = 0.0f, c = -(sumOfRadii * sumOfRadii);
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const float relativeMotion = distanceVector[dimension] - previousDistanceVector[dimension];
+			a += relativeMotion * relativeMotion;
+			b += 2.0f * previousDistanceVector[dimension] * relativeMotion;
+			c += previousDistanceVector[dimension] * previousDistanceVector[dimension];
+		}
+		if (c <= 0.0f) {
+			// already touching at the beginning of the time step
+			timeOfImpact = 0.0f;
+			return true;
+		}
+		if ((0.0f == a) || (0.0f <= b)) {
+			return false; // no relative motion or separating
+		}
+		const float discriminant = (b * b) - (4.0f * a * c);
+		if (discriminant < 0.0f) {
+			return false;
+		}
+		timeOfImpact = (-b - std::sqrt(discriminant)) / (2.0f * a);
+		return timeOfImpact <= 1.0f;
+	}
+}
+
+SweepAndPruneCollisionHandlingImpl::SweepAndPruneCollisionHandlingImpl(
+		const CollisionResolution resolution,
+		const float bodyDensity,
+		const float coefficientOfRestitution
+) : resolution_(resolution),
+	bodyDensity_(bodyDensity),
+	coefficientOfRestitution_(coefficientOfRestitution),
+	sceneMin_{0.0f, 0.0f, 0.0f},
+	sceneMax_{0.0f, 0.0f, 0.0f},
+	maxBoxSize_{0.0f, 0.0f, 0.0f} {
+	if (!(0.0f < bodyDensity)) {
+		// let it crash
+		throw std::invalid_argument("The density of the bodies must be positive.");
+	}
+	if (!((0.0f <= coefficientOfRestitution) && (coefficientOfRestitution <= 1.0f))) {
+		// let it crash
+		throw std::invalid_argument("The coefficient of restitution must be in [0, 1].");
+	}
+}
+
+size_t SweepAndPruneCollisionHandlingImpl::calcSweptBoxes(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *const previousPositions
+) {
+	radii_.resize(numBodies);
+	sweptBoxesMin_.resize(numBodies * 3);
+	sweptBoxesMax_.resize(numBodies * 3);
+	float *const radii = radii_.data();
+	float *const sweptBoxesMin = sweptBoxesMin_.data();
+	float *const sweptBoxesMax = sweptBoxesMax_.data();
+	const float radiusFactor = static_cast<float>(3.0 / (4.0 * std::numbers::pi * bodyDensity_));
+
+	float minX = std::numeric_limits<float>::max(), minY = minX, minZ = minX;
+	float maxX = std::numeric_limits<float>::lowest(), maxY = maxX, maxZ = maxX;
+	float maxSizeX = 0.0f, maxSizeY = 0.0f, maxSizeZ = 0.0f;
+	// @formatter:off
+	#pragma omp parallel for default(none) shared(bodies, numBodies, previousPositions, radii, sweptBoxesMin, sweptBoxesMax, radiusFactor) reduction(min:minX, minY, minZ) reduction(max:maxX, maxY, maxZ, maxSizeX, maxSizeY, maxSizeZ)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long i = 0; i < static_cast<long long>(numBodies); ++i) {
+		radii[i] = std::cbrt(radiusFactor * bodies.masses[i]);
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const size_t index = (i * 3) + dimension;
+			sweptBoxesMin[index] = std::min(previousPositions[index], bodies.positions[index]) - radii[i];
+			sweptBoxesMax[index] = std::max(previousPositions[index], bodies.positions[index]) + radii[i];
+		}
+		minX = std::min(minX, sweptBoxesMin[(i * 3)]);
+		minY = std::min(minY, sweptBoxesMin[(i * 3) + 1]);
+		minZ = std::min(minZ, sweptBoxesMin[(i * 3) + 2]);
+		maxX = std::max(maxX, sweptBoxesMax[(i * 3)]);
+		maxY = std::max(maxY, sweptBoxesMax[(i * 3) + 1]);
+		maxZ = std::max(maxZ, sweptBoxesMax[(i * 3) + 2]);
+		maxSizeX = std::max(maxSizeX, sweptBoxesMax[(i * 3)] - sweptBoxesMin[(i * 3)]);
+		maxSizeY = std::max(maxSizeY, sweptBoxesMax[(i * 3) + 1] - sweptBoxesMin[(i * 3) + 1]);
+		maxSizeZ = std::max(maxSizeZ, sweptBoxesMax[(i * 3) + 2] - sweptBoxesMin[(i * 3) + 2]);
+	}
+	sceneMin_[0] = minX;
+	sceneMin_[1] = minY;
+	sceneMin_[2] = minZ;
+	sceneMax_[0] = maxX;
+	sceneMax_[1] = maxY;
+	sceneMax_[2] = maxZ;
+	maxBoxSize_[0] = maxSizeX;
+	maxBoxSize_[1] = maxSizeY;
+	maxBoxSize_[2] = maxSizeZ;
+
+	// sweeping along the axis of the largest extent yields the fewest overlapping intervals
+	const float extents[3] = {maxX - minX, maxY - minY, maxZ - minZ};
+	return static_cast<size_t>(std::max_element(extents, extents + 3) - extents);
+}
+
+void SweepAndPruneCollisionHandlingImpl::findContacts(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *const previousPositions,
+		const size_t sweepAxis
+) {
+	// 1. the columns of the grid over the two axes orthogonal to the sweep axis, at most about N columns
+	const size_t gridAxes[2] = {(sweepAxis + 1) % 3, (sweepAxis + 2) % 3};
+	const auto maxNumColumnsPerAxis = static_cast<size_t>(std::sqrt(static_cast<double>(numBodies))) + 1;
+	float columnOrigin[2], inverseColumnSize[2];
+	size_t numColumns[2];
+	for (size_t k = 0; k < 2; ++k) {
+		const size_t axis = gridAxes[k];
+		const float extent = sceneMax_[axis] - sceneMin_[axis];
+		const float columnSize = std::max(maxBoxSize_[axis], extent / static_cast<float>(maxNumColumnsPerAxis));
+		columnOrigin[k] = sceneMin_[axis];
+		inverseColumnSize[k] = (0.0f < columnSize) ? (1.0f / columnSize) : 0.0f;
+		numColumns[k] = std::min(maxNumColumnsPerAxis, static_cast<size_t>(extent * inverseColumnSize[k]) + 1);
+	}
+	const auto calcColumnCoordinate = [&](const size_t k, const float coordinate) {
+		const auto columnCoordinate = static_cast<size_t>((coordinate - columnOrigin[k]) * inverseColumnSize[k]);
+		return std::min(columnCoordinate, numColumns[k] - 1);
+	};
+
+	// 2. assign the swept boxes to the overlapped columns by counting sort
+	columnOffsets_.assign((numColumns[0] * numColumns[1]) + 1, 0);
+	const auto forEachColumnOfBox = [&](const size_t i, const auto &function) {
+		const size_t firstColumn[2] = {
+				calcColumnCoordinate(0, sweptBoxesMin_[(i * 3) + gridAxes[0]]),
+				calcColumnCoordinate(1, sweptBoxesMin_[(i * 3) + gridAxes[1]])
+		};
+		const size_t lastColumn[2] = {
+				calcColumnCoordinate(0, sweptBoxesMax_[(i * 3) + gridAxes[0]]),
+				calcColumnCoordinate(1, sweptBoxesMax_[(i * 3) + gridAxes[1]])
+		};
+		for (size_t u = firstColumn[0]; u <= lastColumn[0]; ++u) {
+			for (size_t v = firstColumn[1]; v <= lastColumn[1]; ++v) {
+				function((u * numColumns[1]) + v);
+			}
+		}
+	};
+	for (size_t i = 0; i < numBodies; ++i) {
+		forEachColumnOfBox(i, [&](const size_t column) {
+			++columnOffsets_[column + 1];
+		});
+	}
+	for (size_t column = 1; column < columnOffsets_.size(); ++column) {
+		columnOffsets_[column] += columnOffsets_[column - 1];
+	}
+	columnEntries_.resize(columnOffsets_.back());
+	columnFillLevels_.assign(columnOffsets_.begin(), columnOffsets_.end() - 1);
+	for (size_t i = 0; i < numBodies; ++i) {
+		forEachColumnOfBox(i, [&](const size_t column) {
+			columnEntries_[columnFillLevels_[column]++] = {sweptBoxesMin_[(i * 3) + sweepAxis], i};
+		});
+	}
+
+	// 3. sort and sweep each column; the narrow phase of the candidate pairs
+	contacts_.clear();
+	const size_t totalNumColumns = numColumns[0] * numColumns[1];
+	const size_t *const columnOffsets = columnOffsets_.data();
+	std::pair<float, size_t> *const columnEntries = columnEntries_.data();
+	const float *const radii = radii_.data();
+	const float *const sweptBoxesMin = sweptBoxesMin_.data();
+	const float *const sweptBoxesMax = sweptBoxesMax_.data();
+	std::vector<Contact> &contacts = contacts_;
+	// the contacts of each thread keep their capacity, so a steady state of contacts does not allocate
+	if (threadContacts_.size() < static_cast<size_t>(omp_get_max_threads())) {
+		threadContacts_.resize(omp_get_max_threads());
+	}
+	std::vector<std::vector<Contact>> &allThreadContacts = threadContacts_;
+	// @formatter:off
+	#pragma omp parallel default(none) shared(bodies, previousPositions, sweepAxis, gridAxes, numColumns, calcColumnCoordinate, totalNumColumns, columnOffsets, columnEntries, radii, sweptBoxesMin, sweptBoxesMax, contacts, allThreadContacts)
+	// @formatter:on
+	{
+		std::vector<Contact> &threadContacts = allThreadContacts[omp_get_thread_num()];
+		threadContacts.clear();
+		// @formatter:off
+		#pragma omp for schedule(dynamic, 64) nowait
+		// @formatter:on
+		// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+		for (long long column = 0; column < static_cast<long long>(totalNumColumns); ++column) {
+			std::pair<float, size_t> *const first = columnEntries + columnOffsets[column];
+			std::pair<float, size_t> *const last = columnEntries + columnOffsets[column + 1];
+			std::sort(first, last);
+			for (const std::pair<float, size_t> *entry = first; entry < last; ++entry) {
+				const size_t i = entry->second;
+				const float sweepEnd = sweptBoxesMax[(i * 3) + sweepAxis];
+				for (const std::pair<float, size_t> *other = entry + 1;
+					 (other < last) && (other->first <= sweepEnd); ++other) {
+					const size_t j = other->second;
+					bool isOverlapping = true;
+					for (size_t dimension = 0; dimension < 3; ++dimension) {
+						isOverlapping = isOverlapping &&
+										(sweptBoxesMin[(i * 3) + dimension] <= sweptBoxesMax[(j * 3) + dimension]) &&
+										(sweptBoxesMin[(j * 3) + dimension] <= sweptBoxesMax[(i * 3) + dimension]);
+					}
+					if (!isOverlapping) {
+						continue;
+					}
+					// only the column of the lower corner of the intersection reports the pair
+					const size_t ownerColumn =
+							(calcColumnCoordinate(0, std::max(sweptBoxesMin[(i * 3) + gridAxes[0]],
+															  sweptBoxesMin[(j * 3) + gridAxes[0]])) * numColumns[1]) +
+							calcColumnCoordinate(1, std::max(sweptBoxesMin[(i * 3) + gridAxes[1]],
+															 sweptBoxesMin[(j * 3) + gridAxes[1]]));
+					if (ownerColumn != static_cast<size_t>(column)) {
+						continue;
+					}
+					float previousDistanceVector[3], distanceVector[3];
+					for (size_t dimension = 0; dimension < 3; ++dimension) {
+						previousDistanceVector[dimension] =
+								previousPositions[(j * 3) + dimension] - previousPositions[(i * 3) + dimension];
+						distanceVector[dimension] =
+								bodies.positions[(j * 3) + dimension] - bodies.positions[(i * 3) + dimension];
+					}
+					float timeOfImpact;
+					if (calcTimeOfImpact(previousDistanceVector, distanceVector, radii[i] + radii[j],
+										 timeOfImpact)) {
+						threadContacts.push_back({std::min(i, j), std::max(i, j), timeOfImpact});
+					}
+				}
+			}
+		}
+		// @formatter:off
+		#pragma omp critical
+		// @formatter:on
+		contacts.insert(contacts.end(), threadContacts.begin(), threadContacts.end());
+	}
+
+	// the order of the threads is arbitrary, so sort by all members for reproducible resolutions
+	std::sort(contacts_.begin(), contacts_.end(), [](const Contact &left, const Contact &right) {
+		if (left.timeOfImpact != right.timeOfImpact) {
+			return left.timeOfImpact < right.timeOfImpact;
+		}
+		return (left.firstBody < right.firstBody) ||
+			   ((left.firstBody == right.firstBody) && (left.secondBody < right.secondBody));
+	});
+}
+
+void SweepAndPruneCollisionHandlingImpl::bounce(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *const previousPositions,
+		const float timeStep
+) {
+	std::vector<bool> &hasBounced = hasBounced_;
+	hasBounced.assign(numBodies, false);
+	for (const Contact &contact: contacts_) {
+		const size_t i = contact.firstBody;
+		const size_t j = contact.secondBody;
+		if (hasBounced[i] || hasBounced[j]) {
+			continue;
+		}
+		// the positions at the time of impact and the contact normal from the first to the second body
+		const float s = contact.timeOfImpact;
+		float contactPositions[2][3], normal[3];
+		float squaredNormalLength = 0.0f;
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const size_t indexI = (i * 3) + dimension, indexJ = (j * 3) + dimension;
+			contactPositions[0][dimension] = previousPositions[indexI] +
+											 (s * (bodies.positions[indexI] - previousPositions[indexI]));
+			contactPositions[1][dimension] = previousPositions[indexJ] +
+											 (s * (bodies.positions[indexJ] - previousPositions[indexJ]));
+			normal[dimension] = contactPositions[1][dimension] - contactPositions[0][dimension];
+			squaredNormalLength += normal[dimension] * normal[dimension];
+		}
+		if (0.0f == squaredNormalLength) {
+			continue; // concentric bodies have no contact normal
+		}
+		const float inverseNormalLength = 1.0f / std::sqrt(squaredNormalLength);
+		float normalVelocity = 0.0f;
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			normal[dimension] *= inverseNormalLength;
+			normalVelocity += (bodies.velocities[(j * 3) + dimension] - bodies.velocities[(i * 3) + dimension]) *
+							  normal[dimension];
+		}
+		if (0.0f <= normalVelocity) {
+			continue; // the bodies are separating
+		}
+		const float impulse = -(1.0f + coefficientOfRestitution_) * normalVelocity /
+							  ((1.0f / bodies.masses[i]) + (1.0f / bodies.masses[j]));
+		const float remainingTime = (1.0f - s) * timeStep;
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const size_t indexI = (i * 3) + dimension, indexJ = (j * 3) + dimension;
+			bodies.velocities[indexI] -= impulse * normal[dimension] / bodies.masses[i];
+			bodies.velocities[indexJ] += impulse * normal[dimension] / bodies.masses[j];
+			// move on from the contact with the new velocities for the rest of the time step
+			bodies.positions[indexI] = contactPositions[0][dimension] + (bodies.velocities[indexI] * remainingTime);
+			bodies.positions[indexJ] = contactPositions[1][dimension] + (bodies.velocities[indexJ] * remainingTime);
+		}
+		hasBounced[i] = true;
+		hasBounced[j] = true;
+	}
+}
+
+size_t SweepAndPruneCollisionHandlingImpl::findMergeTarget(size_t body) {
+	while (mergeTargets_[body] != body) {
+		// path halving
+		mergeTargets_[body] = mergeTargets_[mergeTargets_[body]];
+		body = mergeTargets_[body];
+	}
+	return body;
+}
+
+size_t SweepAndPruneCollisionHandlingImpl::merge(const Bodies<float, float, float> &bodies, const size_t numBodies) {
+	mergeTargets_.resize(numBodies);
+	for (size_t i = 0; i < numBodies; ++i) {
+		mergeTargets_[i] = i;
+	}
+	for (const Contact &contact: contacts_) {
+		const size_t first = findMergeTarget(contact.firstBody);
+		const size_t second = findMergeTarget(contact.secondBody);
+		if (first == second) {
+			continue;
+		}
+		// the heavier body absorbs the lighter body
+		const bool isFirstHeavier = bodies.masses[second] <= bodies.masses[first];
+		const size_t survivor = isFirstHeavier ? first : second;
+		const size_t absorbed = isFirstHeavier ? second : first;
+		const float survivorMass = bodies.masses[survivor];
+		const float absorbedMass = bodies.masses[absorbed];
+		const float mass = survivorMass + absorbedMass;
+		// the center of mass and the momentum are conserved
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const size_t survivorIndex = (survivor * 3) + dimension, absorbedIndex = (absorbed * 3) + dimension;
+			bodies.positions[survivorIndex] = ((survivorMass * bodies.positions[survivorIndex]) +
+											   (absorbedMass * bodies.positions[absorbedIndex])) / mass;
+			bodies.velocities[survivorIndex] = ((survivorMass * bodies.velocities[survivorIndex]) +
+												(absorbedMass * bodies.velocities[absorbedIndex])) / mass;
+		}
+		bodies.masses[survivor] = mass;
+		mergeTargets_[absorbed] = survivor;
+	}
+
+	// remove the absorbed bodies and keep the order of the remaining bodies
+	remainingBodyIndices_.resize(numBodies);
+	size_t numRemainingBodies = 0;
+	for (size_t i = 0; i < numBodies; ++i) {
+		if (mergeTargets_[i] != i) {
+			continue;
+		}
+		remainingBodyIndices_[numRemainingBodies] = i;
+		if (numRemainingBodies != i) {
+			bodies.masses[numRemainingBodies] = bodies.masses[i];
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				bodies.positions[(numRemainingBodies * 3) + dimension] = bodies.positions[(i * 3) + dimension];
+				bodies.velocities[(numRemainingBodies * 3) + dimension] = bodies.velocities[(i * 3) + dimension];
+			}
+		}
+		++numRemainingBodies;
+	}
+	return numRemainingBodies;
+}
+
+size_t SweepAndPruneCollisionHandlingImpl::handleCollisions(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *const previousPositions,
+		const float timeStep
+) {
+	contacts_.clear();
+	if (numBodies < 2) {
+		return numBodies;
+	}
+
+	// 1. broad phase and narrow phase
+	const size_t sweepAxis = calcSweptBoxes(bodies, numBodies, previousPositions);
+	findContacts(bodies, numBodies, previousPositions, sweepAxis);
+	if (contacts_.empty()) {
+		return numBodies;
+	}
+
+	// 2. resolution
+	switch (resolution_) {
+		case CollisionResolution::MERGE:
+			return merge(bodies, numBodies);
+		case CollisionResolution::BOUNCE:
+			bounce(bodies, numBodies, previousPositions, timeStep);
+			return numBodies;
+		default:
+			// let it crash
+			throw std::runtime_error("Unknown resolution of collisions.");
+	}
+}
+
+ICollisionHandling *physics::createCollisionHandling(
+		const CollisionResolution &resolution,
+		const float bodyDensity,
+		const float coefficientOfRestitution
+) {
+	return new SweepAndPruneCollisionHandlingImpl(resolution, bodyDensity, coefficientOfRestitution);
+}
@@ -0,0 +1,237 @@
+#ifndef PHYSICS_ENGINE_SWEEP_AND_PRUNE_COLLISION_HANDLING_H
+#define PHYSICS_ENGINE_SWEEP_AND_PRUNE_COLLISION_HANDLING_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "physics/collision_handling.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A contact of two bodies within a time step.
+	 */
+	struct Contact {
+
+		/**
+		 * The index of the first body, which is less than the index of the second body.
+		 */
+		size_t firstBody;
+
+		/**
+		 * The index of the second body.
+		 */
+		size_t secondBody;
+
+		/**
+		 * The time of impact as fraction of the time step in <code>[0, 1]</code>.
+		 */
+		float timeOfImpact;
+	};
+
+	/**
+	 * @brief A collision handling of spherical bodies with a <strong>sweep-and-prune</strong> broad phase and a
+	 * continuous narrow phase.
+	 * @details The broad phase assigns the bounding boxes of the swept spheres, i.e. of their motion within the time
+	 * step, to the columns of a uniform grid over the two axes orthogonal to the axis of the largest extent. The
+	 * columns are at least as wide as the largest box, so a box overlaps at most four columns. The boxes of each
+	 * column are sorted along the sweep axis and swept in parallel by OpenMP; a pair is only reported by the column
+	 * containing the lower corner of the intersection of both boxes. This keeps the number of overlapping intervals
+	 * of a sweep small, even for millions of bodies, unlike a sweep over all boxes along a single axis. The narrow
+	 * phase calculates the earliest time of impact of the candidate pairs under linear motion, so fast bodies do not
+	 * tunnel through each other. The contacts are resolved sequentially in the order of their times of impact; a
+	 * body bounces at most once per time step, whereas merged bodies may absorb further bodies.
+	 */
+	class SweepAndPruneCollisionHandlingImpl : public ICollisionHandling {
+
+		private:
+			/**
+			 * The resolution of colliding bodies.
+			 */
+			CollisionResolution resolution_;
+
+			/**
+			 * The density of the bodies, which determines their radii.
+			 */
+			float bodyDensity_;
+
+			/**
+			 * The coefficient of restitution of bouncing bodies.
+			 */
+			float coefficientOfRestitution_;
+
+			/**
+			 * The radii of the bodies.
+			 */
+			std::vector<float> radii_;
+
+			/**
+			 * The minimum corners of the bounding boxes of the swept spheres.
+			 */
+			std::vector<float> sweptBoxesMin_;
+
+			/**
+			 * The maximum corners of the bounding boxes of the swept spheres.
+			 */
+			std::vector<float> sweptBoxesMax_;
+
+			/**
+			 * The minimum corner of the bounding box of all swept boxes.
+			 */
+			float sceneMin_[3];
+
+			/**
+			 * The maximum corner of the bounding box of all swept boxes.
+			 */
+			float sceneMax_[3];
+
+			/**
+			 * The largest size of the swept boxes per axis.
+			 */
+			float maxBoxSize_[3];
+
+			/**
+			 * The offsets of the columns of the grid into the column entries; the entries of column <code>c</code>
+			 * are <code>[columnOffsets_[c], columnOffsets_[c + 1])</code>.
+			 */
+			std::vector<size_t> columnOffsets_;
+
+			/**
+			 * The minimum coordinate of each swept box along the sweep axis and the index of its body, per column
+			 * sorted ascending.
+			 */
+			std::vector<std::pair<float, size_t>> columnEntries_;
+
+			/**
+			 * The next free entry of each column while the swept boxes are assigned to the columns.
+			 */
+			std::vector<size_t> columnFillLevels_;
+
+			/**
+			 * The contacts found by each thread, which are kept between the time steps to avoid allocations.
+			 */
+			std::vector<std::vector<Contact>> threadContacts_;
+
+			/**
+			 * The flags of the bodies which already bounced in the current time step.
+			 */
+			std::vector<bool> hasBounced_;
+
+			/**
+			 * The contacts of the last time step, sorted by their times of impact.
+			 */
+			std::vector<Contact> contacts_;
+
+			/**
+			 * The index of the body which absorbed a body, or the index of the body itself.
+			 */
+			std::vector<size_t> mergeTargets_;
+
+			/**
+			 * The indices before the last merge of the remaining bodies.
+			 */
+			std::vector<size_t> remainingBodyIndices_;
+
+			/**
+			 * @brief Calculates the radii and the swept boxes of the bodies and their bounds.
+			 * @param bodies the bodies.
+			 * @param numBodies the number of bodies.
+			 * @param previousPositions the positions of the bodies at the beginning of the time step.
+			 * @return the index of the axis of the largest extent of the swept boxes.
+			 */
+			size_t calcSweptBoxes(const Bodies<float, float, float> &bodies, size_t numBodies,
+								  const float *previousPositions);
+
+			/**
+			 * @brief Finds the contacts of the bodies by the sweeps over the columns of the grid and the narrow phase.
+			 * @param bodies the bodies.
+			 * @param numBodies the number of bodies.
+			 * @param previousPositions the positions of the bodies at the beginning of the time step.
+			 * @param sweepAxis the index of the axis of the sweep.
+			 */
+			void findContacts(const Bodies<float, float, float> &bodies, size_t numBodies,
+							  const float *previousPositions, size_t sweepAxis);
+
+			/**
+			 * @brief Lets the bodies of each contact bounce off each other at their times of impact.
+			 * @param bodies the bodies.
+			 * @param numBodies the number of bodies.
+			 * @param previousPositions the positions of the bodies at the beginning of the time step.
+			 * @param timeStep the time step.
+			 */
+			void bounce(const Bodies<float, float, float> &bodies, size_t numBodies, const float *previousPositions,
+						float timeStep);
+
+			/**
+			 * @brief Merges the bodies of each contact and removes the absorbed bodies.
+			 * @param bodies the bodies.
+			 * @param numBodies the number of bodies.
+			 * @return the number of remaining bodies.
+			 */
+			size_t merge(const Bodies<float, float, float> &bodies, size_t numBodies);
+
+			/**
+			 * @brief Returns the body which absorbed the passed body, directly or indirectly.
+			 * @param body the index of the body.
+			 * @return the index of the absorbing body, or the passed index if the body was not absorbed.
+			 */
+			size_t findMergeTarget(size_t body);
+
+		public:
+			/**
+			 * @brief The parameterized constructor. Creates a new instance of this class by the parameters.
+			 * @param resolution the resolution of colliding bodies.
+			 * @param bodyDensity the density of the bodies, which determines their radii.
+			 * @param coefficientOfRestitution the coefficient of restitution in <code>[0, 1]</code> of bouncing bodies.
+			 * @throws std::invalid_argument if the density is not positive or the coefficient of restitution is out
+			 * of range.
+			 */
+			SweepAndPruneCollisionHandlingImpl(
+					CollisionResolution resolution,
+					float bodyDensity,
+					float coefficientOfRestitution
+			);
+
+			/**
+			 * @brief Returns the number of contacts found in the last time step.
+			 * @return the number of contacts found in the last time step.
+			 */
+			[[nodiscard]] inline size_t getNumContacts() const {
+				return contacts_.size();
+			}
+
+			/**
+			 * @brief Detects and resolves the collisions of the given bodies, which moved along straight lines from the
+			 * previous positions to their current positions within the time step.
+			 * @param bodies the bodies whose collisions are to be handled.
+			 * @param numBodies the number of bodies.
+			 * @param previousPositions the positions of the bodies at the beginning of the time step. The number of
+			 * 							elements must be <code>numBodies * vector dimension</code>.
+			 * @param timeStep the time step.
+			 * @return the number of bodies after the resolution of the collisions.
+			 */
+			size_t handleCollisions(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *previousPositions,
+					float timeStep
+			) override;
+
+			/**
+			 * @brief Returns the indices which the remaining bodies had before the last call of
+			 * <code>handleCollisions</code>.
+			 * @details Only valid if the last call merged bodies.
+			 * @return the previous indices of the remaining bodies in ascending order.
+			 */
+			[[nodiscard]] inline const size_t *getRemainingBodyIndices() const override {
+				return remainingBodyIndices_.data();
+			}
+	};
+}
+
+#endif //PHYSICS_ENGINE_SWEEP_AND_PRUNE_COLLISION_HANDLING_H
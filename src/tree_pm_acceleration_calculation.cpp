@@ -0,0 +1,294 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "tree_pm_acceleration_calculation.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The maximum number of pending nodes of an octree walk: at most seven siblings per level are pending.
+	 */
+	constexpr size_t MAX_WALK_STACK_SIZE = 8 * 22;
+
+	/**
+	 * @brief Calculates the squared distance between a point and an axis-aligned box.
+	 * @param point the point.
+	 * @param boxMin the minimum corner of the box.
+	 * @param boxMax the maximum corner of the box.
+	 * @return the squared distance, zero if the point is inside the box.
+	 */
+	inline float calcSquaredDistanceToBox(const float *point, const float *boxMin, const float *boxMax) {
+		float squaredDistance = 0.0f;
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const float below = boxMin[dimension] - point[dimension];
+			const float above = point[dimension] - boxMax[dimension];
+			const float distance = std::max({below, above, 0.0f});
+			squaredDistance += distance * distance;
+		}
+		return squaredDistance;
+	}
+}
+
+TreePmAccelerationCalculationImpl::TreePmAccelerationCalculationImpl(
+		const NewtonianForceLaw &forceLaw,
+		const size_t meshSize,
+		const float splitScaleInCells,
+		const float cutoffInSplitScales,
+		const float openingAngle,
+		const size_t leafCapacity
+) : forceLaw_(forceLaw),
+	particleMeshSolver_(meshSize, splitScaleInCells),
+	octree_(leafCapacity),
+	cutoffInSplitScales_(cutoffInSplitScales),
+	squaredOpeningAngle_(openingAngle * openingAngle),
+	shortRangeFactorTable_(SHORT_RANGE_FACTOR_TABLE_SIZE + 2) {
+	for (size_t k = 0; k < shortRangeFactorTable_.size(); ++k) {
+		const double u = cutoffInSplitScales_ * static_cast<double>(k) / SHORT_RANGE_FACTOR_TABLE_SIZE;
+		shortRangeFactorTable_[k] = static_cast<float>(
+				std::erfc(0.5 * u) + ((u / std::sqrt(std::numbers::pi)) * std::exp(-0.25 * u * u))
+		);
+	}
+}
+
+void TreePmAccelerationCalculationImpl::calcAccelerations(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		const float squaredSofteningFactor
+) {
+	calcAccelerationsWithScratch(bodies, numBodies, accelerations, squaredSofteningFactor, nullptr);
+}
+
+void TreePmAccelerationCalculationImpl::calcAccelerationsInContext(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		const float squaredSofteningFactor,
+		UpdateContext &context
+) {
+	// the octree is built outside of parallel regions, so the arena of the first thread is free
+	calcAccelerationsWithScratch(bodies, numBodies, accelerations, squaredSofteningFactor, &context.getArena(0));
+}
+
+void TreePmAccelerationCalculationImpl::calcAccelerationsWithScratch(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		float *const accelerations,
+		const float squaredSofteningFactor,
+		Arena *const pScratchArena
+) {
+	if (numBodies < 2) {
+		std::fill(accelerations, accelerations + (numBodies * 3), 0.0f);
+		return;
+	}
+
+	// 1. long-range part
+	const float minSplitScale = MIN_SPLIT_SCALE_IN_SOFTENING_FACTORS * std::sqrt(squaredSofteningFactor);
+	particleMeshSolver_.calcLongRangeField(bodies, numBodies, accelerations, minSplitScale);
+
+	// 2. short-range part
+	// the bodies move only slightly per step, so the octree of the previous step is refitted if possible
+	octree_.update(bodies, numBodies, pScratchArena);
+	const std::vector<OctreeNode> &nodes = octree_.getNodes();
+	const size_t *const bodyIndices = octree_.getBodyIndices().data();
+	const float splitScale = particleMeshSolver_.getSplitScale();
+	const float cutoffRadius = cutoffInSplitScales_ * splitScale;
+	const float squaredCutoffRadius = cutoffRadius * cutoffRadius;
+	const float squaredOpeningAngle = squaredOpeningAngle_;
+	const float tableScale = static_cast<float>(SHORT_RANGE_FACTOR_TABLE_SIZE) / cutoffRadius;
+	const float *const shortRangeFactorTable = shortRangeFactorTable_.data();
+	const NewtonianForceLaw forceLaw = forceLaw_;
+	const float gravitationalConstant = forceLaw_.gravitationalConstant;
+
+	// the received short-range force of a mass at the passed distance vector, which points towards the mass
+	const auto calcShortRangeForce = [=](const float *distanceVector, const float squaredDistance,
+										 const float mass, float *forceVector) {
+		const float distance = std::sqrt(squaredDistance);
+		const float tablePosition = distance * tableScale;
+		const auto tableIndex = static_cast<size_t>(tablePosition);
+		const float fraction = tablePosition - static_cast<float>(tableIndex);
+		const float shortRangeFactor = ((1.0f - fraction) * shortRangeFactorTable[tableIndex]) +
+									   (fraction * shortRangeFactorTable[tableIndex + 1]);
+		const float receivedForce = shortRangeFactor *
+									forceLaw.calcDistanceFactor(squaredDistance, squaredSofteningFactor) *
+									forceLaw.calcStrengthFactor(0.0f, mass);
+		forceVector[0] += receivedForce * distanceVector[0];
+		forceVector[1] += receivedForce * distanceVector[1];
+		forceVector[2] += receivedForce * distanceVector[2];
+	};
+
+	// @formatter:off
+	#pragma omp parallel for schedule(dynamic, 64) default(none) shared(bodies, numBodies, accelerations, nodes, bodyIndices, squaredCutoffRadius, squaredOpeningAngle, gravitationalConstant, calcShortRangeForce)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long k = 0; k < static_cast<long long>(numBodies); ++k) {
+		// walk in Morton order, so consecutive iterations of a thread visit similar nodes
+		const size_t i = bodyIndices[k];
+		const float *const position = &bodies.positions[i * 3];
+		float forceVector[3] = {0.0f, 0.0f, 0.0f};
+
+		size_t stack[MAX_WALK_STACK_SIZE];
+		size_t stackSize = 0;
+		stack[stackSize++] = 0;
+		while (0 < stackSize) {
+			const OctreeNode &node = nodes[stack[--stackSize]];
+			if (squaredCutoffRadius < calcSquaredDistanceToBox(position, node.boundingBoxMin, node.boundingBoxMax)) {
+				continue; // the whole node is out of the short range
+			}
+			if (0 == node.numChildren) {
+				for (size_t b = node.firstBody; b < (node.firstBody + node.numBodies); ++b) {
+					const size_t j = bodyIndices[b];
+					if (i != j) {
+						const float distanceVector[3] = {
+								bodies.positions[(j * 3)] - position[0],
+								bodies.positions[(j * 3) + 1] - position[1],
+								bodies.positions[(j * 3) + 2] - position[2]
+						};
+						const float squaredDistance = (distanceVector[0] * distanceVector[0]) +
+													  (distanceVector[1] * distanceVector[1]) +
+													  (distanceVector[2] * distanceVector[2]);
+						if (squaredDistance < squaredCutoffRadius) {
+							calcShortRangeForce(distanceVector, squaredDistance, bodies.masses[j], forceVector);
+						}
+					}
+				}
+				continue;
+			}
+			const float distanceVector[3] = {
+					node.centerOfMass[0] - position[0],
+					node.centerOfMass[1] - position[1],
+					node.centerOfMass[2] - position[2]
+			};
+			const float squaredDistance = (distanceVector[0] * distanceVector[0]) +
+										  (distanceVector[1] * distanceVector[1]) +
+										  (distanceVector[2] * distanceVector[2]);
+			const float nodeSize = std::max({
+					node.boundingBoxMax[0] - node.boundingBoxMin[0],
+					node.boundingBoxMax[1] - node.boundingBoxMin[1],
+					node.boundingBoxMax[2] - node.boundingBoxMin[2]
+			});
+			const bool isInsideNode = (0.0f == calcSquaredDistanceToBox(position, node.boundingBoxMin,
+																		 node.boundingBoxMax));
+			if (!isInsideNode && ((nodeSize * nodeSize) < (squaredOpeningAngle * squaredDistance))) {
+				if (squaredDistance < squaredCutoffRadius) {
+					calcShortRangeForce(distanceVector, squaredDistance, node.mass, forceVector);
+				}
+			} else {
+				for (size_t child = node.firstChild; child < (node.firstChild + node.numChildren); ++child) {
+					stack[stackSize++] = child;
+				}
+			}
+		}
+
+		// false sharing is ok here
+		accelerations[(i * 3)] = (gravitationalConstant * accelerations[(i * 3)]) + forceVector[0];
+		accelerations[(i * 3) + 1] = (gravitationalConstant * accelerations[(i * 3) + 1]) + forceVector[1];
+		accelerations[(i * 3) + 2] = (gravitationalConstant * accelerations[(i * 3) + 2]) + forceVector[2];
+	}
+}
+
+bool TreePmAccelerationCalculationImpl::isProbeEvaluationSupported() const {
+	return true;
+}
+
+void TreePmAccelerationCalculationImpl::calcFieldAtProbes(
+		const Bodies<float, float, float> &bodies,
+		const size_t numBodies,
+		const float *const probeMasses,
+		const float *const probePositions,
+		const size_t numProbes,
+		float *const accelerations,
+		float *const potentials,
+		const float squaredSofteningFactor
+) {
+	if (0 == numBodies) {
+		std::fill(accelerations, accelerations + (numProbes * 3), 0.0f);
+		if (nullptr != potentials) {
+			std::fill(potentials, potentials + numProbes, 0.0f);
+		}
+		return;
+	}
+
+	octree_.update(bodies, numBodies);
+	const std::vector<OctreeNode> &nodes = octree_.getNodes();
+	const size_t *const bodyIndices = octree_.getBodyIndices().data();
+	const float squaredOpeningAngle = squaredOpeningAngle_;
+	const NewtonianForceLaw forceLaw = forceLaw_;
+
+	// @formatter:off
+	#pragma omp parallel for schedule(dynamic, 16) default(none) shared(bodies, probeMasses, probePositions, numProbes, accelerations, potentials, squaredSofteningFactor, nodes, bodyIndices, squaredOpeningAngle, forceLaw)
+	// @formatter:on
+	// using signed (!) int for the loop counter variable is mandatory if you compile with visual c++ compiler !!!
+	for (long long i = 0; i < static_cast<long long>(numProbes); ++i) {
+		const float *const position = &probePositions[i * 3];
+		const float probeMass = probeMasses[i];
+		float forceVector[3] = {0.0f, 0.0f, 0.0f};
+		float potential = 0.0f;
+		// the received force and potential of a mass at the passed distance vector, which points towards the mass
+		const auto addMass = [&](const float *distanceVector, const float squaredDistance, const float mass) {
+			const float receivedForce = forceLaw(squaredDistance, squaredSofteningFactor, probeMass, mass);
+			forceVector[0] += receivedForce * distanceVector[0];
+			forceVector[1] += receivedForce * distanceVector[1];
+			forceVector[2] += receivedForce * distanceVector[2];
+			potential += forceLaw.calcPotentialEnergy(squaredDistance, squaredSofteningFactor, probeMass, mass);
+		};
+
+		size_t stack[MAX_WALK_STACK_SIZE];
+		size_t stackSize = 0;
+		stack[stackSize++] = 0;
+		while (0 < stackSize) {
+			const OctreeNode &node = nodes[stack[--stackSize]];
+			if (0 == node.numChildren) {
+				for (size_t b = node.firstBody; b < (node.firstBody + node.numBodies); ++b) {
+					const size_t j = bodyIndices[b];
+					const float distanceVector[3] = {
+							bodies.positions[(j * 3)] - position[0],
+							bodies.positions[(j * 3) + 1] - position[1],
+							bodies.positions[(j * 3) + 2] - position[2]
+					};
+					const float squaredDistance = (distanceVector[0] * distanceVector[0]) +
+												  (distanceVector[1] * distanceVector[1]) +
+												  (distanceVector[2] * distanceVector[2]);
+					// a body at the position of the probe is the probe itself
+					if (0.0f < squaredDistance) {
+						addMass(distanceVector, squaredDistance, bodies.masses[j]);
+					}
+				}
+				continue;
+			}
+			const float distanceVector[3] = {
+					node.centerOfMass[0] - position[0],
+					node.centerOfMass[1] - position[1],
+					node.centerOfMass[2] - position[2]
+			};
+			const float squaredDistance = (distanceVector[0] * distanceVector[0]) +
+										  (distanceVector[1] * distanceVector[1]) +
+										  (distanceVector[2] * distanceVector[2]);
+			const float nodeSize = std::max({
+					node.boundingBoxMax[0] - node.boundingBoxMin[0],
+					node.boundingBoxMax[1] - node.boundingBoxMin[1],
+					node.boundingBoxMax[2] - node.boundingBoxMin[2]
+			});
+			const bool isInsideNode = (0.0f == calcSquaredDistanceToBox(position, node.boundingBoxMin,
+																		 node.boundingBoxMax));
+			if (!isInsideNode && ((nodeSize * nodeSize) < (squaredOpeningAngle * squaredDistance))) {
+				addMass(distanceVector, squaredDistance, node.mass);
+			} else {
+				for (size_t child = node.firstChild; child < (node.firstChild + node.numChildren); ++child) {
+					stack[stackSize++] = child;
+				}
+			}
+		}
+
+		// false sharing is ok here
+		accelerations[(i * 3)] = forceVector[0];
+		accelerations[(i * 3) + 1] = forceVector[1];
+		accelerations[(i * 3) + 2] = forceVector[2];
+		if (nullptr != potentials) {
+			potentials[i] = potential;
+		}
+	}
+}
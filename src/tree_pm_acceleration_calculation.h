@@ -0,0 +1,179 @@
+#ifndef PHYSICS_ENGINE_TREE_PM_ACCELERATION_CALCULATION_H
+#define PHYSICS_ENGINE_TREE_PM_ACCELERATION_CALCULATION_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <vector>
+
+#include "physics/acceleration_calculation.h"
+#include "physics/force_laws.h"
+#include "particle_mesh_solver.h"
+#include "octree.h"
+
+/**
+ * @brief Namespace for physics-related functions and classes.
+ */
+namespace physics {
+
+	/**
+	 * @brief A <strong>TreePM</strong> implementation of the calculation of gravitational accelerations of N bodies.
+	 * @details The gravitational field is split by a Gaussian of the split scale <code>r_s</code> into a long-range
+	 * part, which is calculated by a particle-mesh solver, and a short-range part, which is calculated by an
+	 * OpenMP-parallel octree walk. The short-range walk only visits nodes within the cutoff radius, i.e. a few mesh
+	 * cells, so the costs scale nearly linearly with the number of bodies, while the accuracy on small scales is
+	 * retained. The softening is applied by the short-range part only, so the split scale is at least a few softening
+	 * factors, which widens the short range of a strongly softened system.
+	 */
+	class TreePmAccelerationCalculationImpl : public IAccelerationCalculation {
+
+		private:
+			/**
+			 * The Newtonian force law of the short-range part, whose distance factor is multiplied by the
+			 * short-range factor.
+			 */
+			NewtonianForceLaw forceLaw_;
+
+			/**
+			 * The particle-mesh solver of the long-range part.
+			 */
+			ParticleMeshSolver particleMeshSolver_;
+
+			/**
+			 * The octree of the short-range part, which is refitted between the time steps.
+			 */
+			Octree octree_;
+
+			/**
+			 * The cutoff radius of the short-range part in split scales.
+			 */
+			float cutoffInSplitScales_;
+
+			/**
+			 * The squared opening angle of the octree walk.
+			 */
+			float squaredOpeningAngle_;
+
+			/**
+			 * The tabulated short-range factor <code>erfc(u / 2) + (u / sqrt(pi)) * exp(-u^2 / 4)</code> for
+			 * <code>u = r / r_s</code> in <code>[0, cutoffInSplitScales]</code>.
+			 */
+			std::vector<float> shortRangeFactorTable_;
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 * @param pScratchArena the optional arena for the workspace of the octree build, <code>nullptr</code> to
+			 * 					use the workspace of the octree.
+			 */
+			void calcAccelerationsWithScratch(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor,
+					Arena *pScratchArena
+			);
+
+		public:
+			/**
+			 * The number of intervals of the tabulated short-range factor.
+			 */
+			static constexpr size_t SHORT_RANGE_FACTOR_TABLE_SIZE = 1024;
+
+			/**
+			 * The minimum split scale in softening factors. The long-range part is not softened, so the split scale
+			 * is enlarged until the short-range part covers the distances on which the softening matters.
+			 */
+			static constexpr float MIN_SPLIT_SCALE_IN_SOFTENING_FACTORS = 4.0f;
+
+			/**
+			 * @brief The parameterized constructor. Creates a new instance of this class by the parameters.
+			 * @param forceLaw the Newtonian force law, which provides the gravitational constant and the softening.
+			 * @param meshSize the number of mesh cells per axis of the particle-mesh solver, a power of two of at
+			 * 					least 16.
+			 * @param splitScaleInCells the split scale <code>r_s</code> in mesh cells.
+			 * @param cutoffInSplitScales the cutoff radius of the short-range part in split scales.
+			 * @param openingAngle the opening angle of the octree walk; smaller values are more accurate.
+			 * @param leafCapacity the maximum number of bodies per octree leaf.
+			 */
+			explicit TreePmAccelerationCalculationImpl(
+					const NewtonianForceLaw &forceLaw = NewtonianForceLaw(),
+					size_t meshSize = 64,
+					float splitScaleInCells = 1.25f,
+					float cutoffInSplitScales = 4.5f,
+					float openingAngle = 0.3f,
+					size_t leafCapacity = 8
+			);
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies. The <code>accelerations</code>
+			 * 					parameter must be a pointer to an allocated storage which is large enough to store
+			 * 					<code>numBodies * vector dimension</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcAccelerations(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor
+			) override;
+
+			/**
+			 * @brief Calculates the accelerations of the given bodies. The workspace of the octree build is taken from
+			 * the scratch arena of the first thread of the passed context.
+			 * @param bodies the bodies whose accelerations are to be calculated.
+			 * @param numBodies the number of bodies.
+			 * @param[in, out] accelerations the accelerations of the passed bodies, as by <code>calcAccelerations</code>.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 * @param context the context of the update.
+			 */
+			void calcAccelerationsInContext(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					float *accelerations,
+					float squaredSofteningFactor,
+					UpdateContext &context
+			) override;
+
+			/**
+			 * @brief Returns <code>true</code>, since the field can be evaluated at probes.
+			 * @return <code>true</code>.
+			 */
+			[[nodiscard]] bool isProbeEvaluationSupported() const override;
+
+			/**
+			 * @brief Calculates the accelerations and optionally the potential energies of probes caused by the passed
+			 * bodies by a Barnes-Hut walk of the octree, whose costs are proportional to <code>log(N)</code> per
+			 * probe.
+			 * @details The probes may be anywhere, whereas the mesh of the long-range part only covers the bodies, so the
+			 * whole field is calculated by the octree with the opening angle of the short-range part and monopole
+			 * moments.
+			 * @param bodies the source bodies.
+			 * @param numBodies the number of bodies.
+			 * @param probeMasses the masses (resp. charges) of the probes.
+			 * @param probePositions the positions of the probes, <code>numProbes * vector dimension</code> coordinates.
+			 * @param numProbes the number of probes.
+			 * @param[out] accelerations the accelerations of the probes, <code>numProbes * vector dimension</code>
+			 * 					elements.
+			 * @param[out] potentials the potential energies of the probes with all bodies, <code>numProbes</code>
+			 * 					elements, or <code>nullptr</code> if they are not needed.
+			 * @param squaredSofteningFactor the squared softening factor, in order to avoid division by zero.
+			 */
+			void calcFieldAtProbes(
+					const Bodies<float, float, float> &bodies,
+					size_t numBodies,
+					const float *probeMasses,
+					const float *probePositions,
+					size_t numProbes,
+					float *accelerations,
+					float *potentials,
+					float squaredSofteningFactor
+			) override;
+	};
+}
+
+#endif //PHYSICS_ENGINE_TREE_PM_ACCELERATION_CALCULATION_H
@@ -0,0 +1,27 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+
+#include "physics/update_context.h"
+
+using namespace physics;
+
+UpdateContext::UpdateContext(const size_t numThreads, const size_t capacityPerThread, const bool useHugePages) {
+	arenas_.reserve(std::max<size_t>(1, numThreads));
+	for (size_t i = 0; i < std::max<size_t>(1, numThreads); ++i) {
+		arenas_.emplace_back(capacityPerThread, useHugePages);
+	}
+}
+
+void UpdateContext::reset() {
+	for (Arena &arena: arenas_) {
+		arena.reset();
+	}
+}
+
+size_t UpdateContext::getPeakUsage() const {
+	size_t peakUsage = 0;
+	for (const Arena &arena: arenas_) {
+		peakUsage += arena.getPeakUsage();
+	}
+	return peakUsage;
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "performance_tests_framework.h"
+
+using namespace physics;
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, SequentialPlummerSphereN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::SEQUENTIAL,
+												  Scenario::PLUMMER_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, SequentialHierarchicalClustersN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::SEQUENTIAL,
+												  Scenario::HIERARCHICAL_CLUSTERS, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, SequentialUniformSquareN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::SEQUENTIAL,
+												  Scenario::UNIFORM_SQUARE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OpenMpPlummerSphereN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::PLUMMER_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OpenMpHierarchicalClustersN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::HIERARCHICAL_CLUSTERS, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OpenMpUniformSquareN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::UNIFORM_SQUARE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OpenMpCompressedPlummerSphereN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::PLUMMER_SPHERE, 10'000, true);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OpenMpCompressedHierarchicalClustersN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::HIERARCHICAL_CLUSTERS, 10'000, true);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OpenMpCompressedUniformSquareN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::UNIFORM_SQUARE, 10'000, true);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OpenClPlummerSphereN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OPEN_CL,
+												  Scenario::PLUMMER_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OpenClHierarchicalClustersN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OPEN_CL,
+												  Scenario::HIERARCHICAL_CLUSTERS, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OpenClUniformSquareN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OPEN_CL,
+												  Scenario::UNIFORM_SQUARE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, SmallNPlummerSphereN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::SMALL_N,
+												  Scenario::PLUMMER_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, SmallNHierarchicalClustersN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::SMALL_N,
+												  Scenario::HIERARCHICAL_CLUSTERS, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, SmallNUniformSquareN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::SMALL_N,
+												  Scenario::UNIFORM_SQUARE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, TreePmPlummerSphereN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::PLUMMER_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, TreePmHierarchicalClustersN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::HIERARCHICAL_CLUSTERS, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, TreePmUniformSquareN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::UNIFORM_SQUARE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OutOfCorePlummerSphereN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OUT_OF_CORE,
+												  Scenario::PLUMMER_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OutOfCoreHierarchicalClustersN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OUT_OF_CORE,
+												  Scenario::HIERARCHICAL_CLUSTERS, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, OutOfCoreUniformSquareN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::OUT_OF_CORE,
+												  Scenario::UNIFORM_SQUARE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, HeterogeneousPlummerSphereN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::HETEROGENEOUS,
+												  Scenario::PLUMMER_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, HeterogeneousHierarchicalClustersN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::HETEROGENEOUS,
+												  Scenario::HIERARCHICAL_CLUSTERS, 10'000);
+}
+
+TEST(PerformanceTestAccelerationCalculationAccuracy, HeterogeneousUniformSquareN10_000) {
+	PerformanceTestFramework::performAccuracyTest(AccelerationCalculationImplementation::HETEROGENEOUS,
+												  Scenario::UNIFORM_SQUARE, 10'000);
+}
@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+
+#include "performance_tests_framework.h"
+
+using namespace physics;
+
+TEST(PerformanceTestDeterministicAccelerationCalculation, SequentialN1_000) {
+	PerformanceTestFramework::performDeterministicTest(AccelerationCalculationImplementation::SEQUENTIAL, 1'000);
+}
+
+TEST(PerformanceTestDeterministicAccelerationCalculation, SequentialN10_000) {
+	PerformanceTestFramework::performDeterministicTest(AccelerationCalculationImplementation::SEQUENTIAL, 10'000);
+}
+
+TEST(PerformanceTestDeterministicAccelerationCalculation, OpenMpN1_000) {
+	PerformanceTestFramework::performDeterministicTest(AccelerationCalculationImplementation::OPEN_MP, 1'000);
+}
+
+TEST(PerformanceTestDeterministicAccelerationCalculation, OpenMpN10_000) {
+	PerformanceTestFramework::performDeterministicTest(AccelerationCalculationImplementation::OPEN_MP, 10'000);
+}
+
+TEST(PerformanceTestDeterministicAccelerationCalculation, OpenMpN100_000) {
+	PerformanceTestFramework::performDeterministicTest(AccelerationCalculationImplementation::OPEN_MP, 100'000);
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#include <gtest/gtest.h>
+
+#include "performance_tests_framework.h"
+
+using namespace physics;
+
+TEST(PerformanceTestHeterogeneousAccelerationCalculation, N10_000) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::HETEROGENEOUS, 10'000);
+}
+
+TEST(PerformanceTestHeterogeneousAccelerationCalculation, N100_000) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::HETEROGENEOUS, 100'000);
+}
@@ -23,3 +23,11 @@ TEST(PerformanceTestOpenCLAccelerationCalculation, N100_000) {
 TEST(PerformanceTestOpenCLAccelerationCalculation, N1_000_000) {
 	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::OPEN_CL, 1'000'000);
 }
+
+TEST(PerformanceTestOpenCLAccelerationCalculation, N100_000MultiDevice) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::OPEN_CL_MULTI_DEVICE, 100'000);
+}
+
+TEST(PerformanceTestOpenCLAccelerationCalculation, N1_000_000MultiDevice) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::OPEN_CL_MULTI_DEVICE, 1'000'000);
+}
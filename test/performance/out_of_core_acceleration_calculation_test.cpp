@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+
+#include "performance_tests_framework.h"
+
+using namespace physics;
+
+TEST(PerformanceTestOutOfCoreAccelerationCalculation, N10_000) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::OUT_OF_CORE, 10'000);
+}
+
+TEST(PerformanceTestOutOfCoreAccelerationCalculation, N100_000) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::OUT_OF_CORE, 100'000);
+}
+
+TEST(PerformanceTestOutOfCoreAccelerationCalculation, N10_000Mapped) {
+	PerformanceTestFramework::performMappedTest(AccelerationCalculationImplementation::OUT_OF_CORE, 10'000);
+}
+
+TEST(PerformanceTestOutOfCoreAccelerationCalculation, N100_000Mapped) {
+	PerformanceTestFramework::performMappedTest(AccelerationCalculationImplementation::OUT_OF_CORE, 100'000);
+}
+
+TEST(PerformanceTestOutOfCoreAccelerationCalculation, N1_000_000Mapped) {
+	PerformanceTestFramework::performMappedTest(AccelerationCalculationImplementation::OUT_OF_CORE, 1'000'000);
+}
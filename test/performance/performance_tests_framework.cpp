@@ -1,12 +1,61 @@
 // Reminder: Always include standard library and system headers before including your own headers.
 #include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <memory>
 #include <random>
+#include <vector>
 
 #include "performance_tests_framework.h"
+#include "physics/arena.h"
+#include "physics/initial_conditions.h"
+#include "physics/mapped_bodies.h"
+#include "../../src/acceleration_accuracy.h"
 
 using namespace physics;
 
+namespace {
+	void measureAccelerationCalculation(const AccelerationCalculationImplementation &implementation,
+										const Bodies<float, float, float> &bodies, const size_t n,
+										float *const accelerations) {
+		IAccelerationCalculation *pAccelerationCalculation = createAccelerationCalculation(implementation);
+		const float softeningFactorSquared = 0.01;
+
+		auto tmp = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+		std::cout << "Test started at " << std::ctime(&tmp) << std::endl;
+		if (n == 1'000'000) {
+			tmp = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now() + std::chrono::seconds(11702));
+			std::cout << "Estimated time of arrival (ETA): " << std::ctime(&tmp) << std::endl;
+		}
+		auto startTimeInNanoSeconds = std::chrono::high_resolution_clock::now();
+		{
+			pAccelerationCalculation->calcAccelerations(bodies, n, accelerations, softeningFactorSquared);
+		}
+		auto endTimeInNanoSeconds = std::chrono::high_resolution_clock::now();
+		std::cout.precision(17);
+		std::cout << "Processing took: "
+				  << static_cast<long double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+						  endTimeInNanoSeconds - startTimeInNanoSeconds).count()) / 1e+9
+				  << " seconds for N = "
+				  << n
+				  << std::endl;
+
+		delete pAccelerationCalculation;
+	}
+
+	double measureSeconds(IAccelerationCalculation &accelerationCalculation, const Bodies<float, float, float> &bodies,
+						  const size_t n, float *const accelerations) {
+		const float softeningFactorSquared = 0.01;
+		auto startTimeInNanoSeconds = std::chrono::high_resolution_clock::now();
+		{
+			accelerationCalculation.calcAccelerations(bodies, n, accelerations, softeningFactorSquared);
+		}
+		auto endTimeInNanoSeconds = std::chrono::high_resolution_clock::now();
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				endTimeInNanoSeconds - startTimeInNanoSeconds).count()) / 1e+9;
+	}
+}
+
 float PerformanceTestFramework::generateRandomFloat(float inclusiveMin, float exclusiveMax) {
 	if (exclusiveMax < inclusiveMin) {
 		const float tmp = exclusiveMax;
@@ -14,67 +63,110 @@ float PerformanceTestFramework::generateRandomFloat(float inclusiveMin, float ex
 		inclusiveMin = tmp;
 	}
 
-	static std::random_device rd;
-	static std::default_random_engine engine(rd());
-	static std::uniform_real_distribution<> distribution(inclusiveMin, exclusiveMax);
-	return static_cast<float>(distribution(engine));
+	// each thread has its own engine, since the function may be called by parallel loops
+	thread_local std::default_random_engine engine(std::random_device{}());
+	std::uniform_real_distribution<float> distribution(inclusiveMin, exclusiveMax);
+	return distribution(engine);
 }
 
 void PerformanceTestFramework::generateNRandomBodies(const size_t n, const Bodies<float, float, float> &bodies) {
-	// @formatter:off
-#pragma omp parallel for default(none) shared(n, bodies)
-	// @formatter:on
-	for (int i = 0; i < n; ++i) {
-		const size_t xCoordinateIndex = i * 3;
-		const size_t yCoordinateIndex = xCoordinateIndex + 1;
-		const size_t zCoordinateIndex = xCoordinateIndex + 2;
-
-		bodies.masses[i] = 1.0f;
-		bodies.positions[xCoordinateIndex] = generateRandomFloat(-0.25f, 0.251f);
-		bodies.positions[yCoordinateIndex] = generateRandomFloat(-0.25f, 0.251f);
-		bodies.positions[zCoordinateIndex] = 0.0f;
-		bodies.velocities[xCoordinateIndex] = 0.0f;
-		bodies.velocities[yCoordinateIndex] = 0.0f;
-		bodies.velocities[zCoordinateIndex] = 0.0f;
-	}
+	// bodies of unit mass at rest in a flat square, which is the distribution of the original benchmarks
+	ScenarioParameters parameters;
+	parameters.totalMass = static_cast<float>(n);
+	parameters.scaleRadius = 0.25f;
+	generateScenario(Scenario::UNIFORM_SQUARE, bodies, n, parameters);
 }
 
 void
 PerformanceTestFramework::performTest(const AccelerationCalculationImplementation &implementation, const size_t n) {
 	const size_t numCoordinates = n * 3;
-	Bodies<float, float, float> bodies{new float[n], new float[numCoordinates], new float[numCoordinates]};
+	// one block for the bodies and the accelerations, backed by huge pages to avoid the page faults of large arrays
+	Arena arena((sizeof(float) * (n + (3 * numCoordinates))) + (4 * Arena::ALIGNMENT), true);
+	Bodies<float, float, float> bodies{arena.allocate<float>(n), arena.allocate<float>(numCoordinates),
+									   arena.allocate<float>(numCoordinates)};
 
 	generateNRandomBodies(n, bodies);
+	float *const accelerations = arena.allocate<float>(numCoordinates);
+	measureAccelerationCalculation(implementation, bodies, n, accelerations);
+}
 
-	IAccelerationCalculation *pAccelerationCalculation = createAccelerationCalculation(implementation);
-	const float softeningFactorSquared = 0.01;
-	auto *accelerations = new float[numCoordinates];
-
-	auto tmp = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-	std::cout << "Test started at " << std::ctime(&tmp) << std::endl;
-	if (n == 1'000'000) {
-		tmp = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now() + std::chrono::seconds(11702));
-		std::cout << "Estimated time of arrival (ETA): " << std::ctime(&tmp) << std::endl;
-	}
-	auto startTimeInNanoSeconds = std::chrono::high_resolution_clock::now();
+void
+PerformanceTestFramework::performMappedTest(const AccelerationCalculationImplementation &implementation,
+											const size_t n) {
+	// the bodies and the accelerations are paged in and out by the operating system
+	const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "physics_engine_bodies.bin";
 	{
-		pAccelerationCalculation->calcAccelerations(bodies, n, accelerations, softeningFactorSquared);
+		MappedBodies mappedBodies(filePath.string(), n);
+		generateNRandomBodies(n, mappedBodies.getBodies());
+		measureAccelerationCalculation(implementation, mappedBodies.getBodies(), n, mappedBodies.getAccelerations());
 	}
-	auto endTimeInNanoSeconds = std::chrono::high_resolution_clock::now();
+	std::filesystem::remove(filePath);
+}
+
+void
+PerformanceTestFramework::performDeterministicTest(const AccelerationCalculationImplementation &implementation,
+												   const size_t n) {
+	const size_t numCoordinates = n * 3;
+	Arena arena((sizeof(float) * (n + (3 * numCoordinates))) + (4 * Arena::ALIGNMENT), true);
+	Bodies<float, float, float> bodies{arena.allocate<float>(n), arena.allocate<float>(numCoordinates),
+									   arena.allocate<float>(numCoordinates)};
+
+	generateNRandomBodies(n, bodies);
+	float *const accelerations = arena.allocate<float>(numCoordinates);
+	const std::unique_ptr<IAccelerationCalculation> pAccelerationCalculation(
+			createAccelerationCalculation(implementation));
+	// the cost of the deterministic mode is the ratio of the two runs on the same bodies
+	const double defaultSeconds = measureSeconds(*pAccelerationCalculation, bodies, n, accelerations);
+	pAccelerationCalculation->setDeterministicModeEnabled(true);
+	const double deterministicSeconds = measureSeconds(*pAccelerationCalculation, bodies, n, accelerations);
 	std::cout.precision(17);
-	std::cout << "Processing took: "
-			  << static_cast<long double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
-					  endTimeInNanoSeconds - startTimeInNanoSeconds).count()) / 1e+9
-			  << " seconds for N = "
-			  << n
-			  << std::endl;
-
-	delete pAccelerationCalculation;
-	delete[] accelerations;
-	delete[] bodies.masses;
-	bodies.masses = nullptr;
-	delete[] bodies.positions;
-	bodies.positions = nullptr;
-	delete[] bodies.velocities;
-	bodies.velocities = nullptr;
-}
\ No newline at end of file
+	std::cout << "Processing took: " << defaultSeconds << " seconds (default), " << deterministicSeconds
+			  << " seconds (deterministic), overhead factor " << (deterministicSeconds / defaultSeconds)
+			  << " for N = " << n << std::endl;
+}
+
+void PerformanceTestFramework::performScenarioTest(const AccelerationCalculationImplementation &implementation,
+												   const Scenario scenario, const size_t n) {
+	const size_t numCoordinates = n * 3;
+	Arena arena((sizeof(float) * (n + (3 * numCoordinates))) + (4 * Arena::ALIGNMENT), true);
+	Bodies<float, float, float> bodies{arena.allocate<float>(n), arena.allocate<float>(numCoordinates),
+									   arena.allocate<float>(numCoordinates)};
+
+	// the same seed measures all implementations on the same bodies
+	ScenarioParameters parameters;
+	parameters.seed = 49;
+	generateScenario(scenario, bodies, n, parameters);
+	float *const accelerations = arena.allocate<float>(numCoordinates);
+	measureAccelerationCalculation(implementation, bodies, n, accelerations);
+}
+
+void PerformanceTestFramework::performAccuracyTest(const AccelerationCalculationImplementation &implementation,
+												   const Scenario scenario, const size_t n,
+												   const bool isPositionCompressionEnabled) {
+	const size_t numCoordinates = n * 3;
+	Arena arena((sizeof(float) * (n + (3 * numCoordinates))) + (4 * Arena::ALIGNMENT), true);
+	Bodies<float, float, float> bodies{arena.allocate<float>(n), arena.allocate<float>(numCoordinates),
+									   arena.allocate<float>(numCoordinates)};
+
+	ScenarioParameters parameters;
+	parameters.seed = 50;
+	generateScenario(scenario, bodies, n, parameters);
+	float *const accelerations = arena.allocate<float>(numCoordinates);
+	const float softeningFactorSquared = 0.01;
+	// the oracle is a direct sum in double precision, so each speed optimization is measured with its accuracy
+	std::vector<double> referenceAccelerations(numCoordinates);
+	calcReferenceAccelerations(bodies, n, softeningFactorSquared, referenceAccelerations.data());
+	const std::unique_ptr<IAccelerationCalculation> pAccelerationCalculation(
+			createAccelerationCalculation(implementation));
+	if (isPositionCompressionEnabled) {
+		pAccelerationCalculation->setPositionCompressionEnabled(true);
+	}
+	const AccelerationAccuracy accuracy = measureAccelerationAccuracy(
+			*pAccelerationCalculation, bodies, n, softeningFactorSquared, referenceAccelerations.data(),
+			accelerations);
+	std::cout.precision(6);
+	std::cout << "Relative error p50 " << accuracy.medianRelativeError << ", p90 " << accuracy.p90RelativeError
+			  << ", p99 " << accuracy.p99RelativeError << ", max " << accuracy.maxRelativeError << " at "
+			  << accuracy.interactionsPerSecond << " interactions per second (" << accuracy.seconds
+			  << " seconds) for N = " << n << std::endl;
+}
@@ -2,6 +2,7 @@
 #define PHYSICS_ENGINE_PERFORMANCE_TESTS_FRAMEWORK_H
 
 #include "physics/acceleration_calculation_factory.h"
+#include "physics/initial_conditions.h"
 
 namespace PerformanceTestFramework {
 	float generateRandomFloat(float inclusiveMin, float exclusiveMax);
@@ -9,6 +10,16 @@ namespace PerformanceTestFramework {
 	void generateNRandomBodies(size_t n, const physics::Bodies<float, float, float> &bodies);
 
 	void performTest(const physics::AccelerationCalculationImplementation &implementation, size_t n);
+
+	void performMappedTest(const physics::AccelerationCalculationImplementation &implementation, size_t n);
+
+	void performDeterministicTest(const physics::AccelerationCalculationImplementation &implementation, size_t n);
+
+	void performScenarioTest(const physics::AccelerationCalculationImplementation &implementation,
+							 physics::Scenario scenario, size_t n);
+
+	void performAccuracyTest(const physics::AccelerationCalculationImplementation &implementation,
+							 physics::Scenario scenario, size_t n, bool isPositionCompressionEnabled = false);
 }
 
 #endif //PHYSICS_ENGINE_PERFORMANCE_TESTS_FRAMEWORK_H
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include "performance_tests_framework.h"
+
+using namespace physics;
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmPlummerSphereN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::PLUMMER_SPHERE, 100'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmPlummerSphereN1_000_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::PLUMMER_SPHERE, 1'000'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmHernquistSphereN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::HERNQUIST_SPHERE, 100'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmHernquistSphereN1_000_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::HERNQUIST_SPHERE, 1'000'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmKingSphereN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::KING_SPHERE, 100'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmKingSphereN1_000_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::KING_SPHERE, 1'000'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmExponentialDiskN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::EXPONENTIAL_DISK, 100'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmExponentialDiskN1_000_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::EXPONENTIAL_DISK, 1'000'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmHierarchicalClustersN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::HIERARCHICAL_CLUSTERS, 100'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, TreePmHierarchicalClustersN1_000_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::TREE_PM,
+												  Scenario::HIERARCHICAL_CLUSTERS, 1'000'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpPlummerSphereN10_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::PLUMMER_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpPlummerSphereN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::PLUMMER_SPHERE, 100'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpHernquistSphereN10_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::HERNQUIST_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpHernquistSphereN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::HERNQUIST_SPHERE, 100'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpKingSphereN10_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::KING_SPHERE, 10'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpKingSphereN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::KING_SPHERE, 100'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpExponentialDiskN10_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::EXPONENTIAL_DISK, 10'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpExponentialDiskN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::EXPONENTIAL_DISK, 100'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpHierarchicalClustersN10_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::HIERARCHICAL_CLUSTERS, 10'000);
+}
+
+TEST(PerformanceTestScenarioAccelerationCalculation, OpenMpHierarchicalClustersN100_000) {
+	PerformanceTestFramework::performScenarioTest(AccelerationCalculationImplementation::OPEN_MP,
+												  Scenario::HIERARCHICAL_CLUSTERS, 100'000);
+}
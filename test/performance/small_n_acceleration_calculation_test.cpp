@@ -0,0 +1,17 @@
+#include <gtest/gtest.h>
+
+#include "performance_tests_framework.h"
+
+using namespace physics;
+
+TEST(PerformanceTestSmallNAccelerationCalculation, N3) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::SMALL_N, 3);
+}
+
+TEST(PerformanceTestSmallNAccelerationCalculation, N16) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::SMALL_N, 16);
+}
+
+TEST(PerformanceTestSmallNAccelerationCalculation, N64) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::SMALL_N, 64);
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+
+#include "performance_tests_framework.h"
+
+using namespace physics;
+
+TEST(PerformanceTestTreePmAccelerationCalculation, N100) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::TREE_PM, 100);
+}
+
+TEST(PerformanceTestTreePmAccelerationCalculation, N1_000) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::TREE_PM, 1'000);
+}
+
+TEST(PerformanceTestTreePmAccelerationCalculation, N10_000) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::TREE_PM, 10'000);
+}
+
+TEST(PerformanceTestTreePmAccelerationCalculation, N100_000) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::TREE_PM, 100'000);
+}
+
+TEST(PerformanceTestTreePmAccelerationCalculation, N1_000_000) {
+	PerformanceTestFramework::performTest(AccelerationCalculationImplementation::TREE_PM, 1'000'000);
+}
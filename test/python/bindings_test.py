@@ -0,0 +1,131 @@
+import array
+import threading
+import unittest
+
+import physics_engine
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+
+def create_two_bodies():
+    bodies = physics_engine.Bodies(2)
+    masses = memoryview(bodies.masses)
+    positions = memoryview(bodies.positions)
+    # the gravitational constant is small, so the masses are large enough to move the bodies
+    masses[0] = 1e10
+    masses[1] = 1e10
+    positions[0, 0] = -1.0
+    positions[1, 0] = 1.0
+    return bodies
+
+
+class BindingsTest(unittest.TestCase):
+
+    def test_arrays_should_be_shared_without_copies(self):
+        bodies = physics_engine.Bodies(3)
+        positions = memoryview(bodies.positions)
+        self.assertEqual((3, 3), positions.shape)
+        self.assertEqual('f', positions.format)
+        self.assertFalse(positions.readonly)
+        self.assertTrue(positions.c_contiguous)
+        self.assertEqual((3,), memoryview(bodies.masses).shape)
+
+        positions[2, 1] = 5.0
+
+        # a second view addresses the same memory
+        self.assertEqual(5.0, memoryview(bodies.positions)[2, 1])
+
+    def test_views_should_keep_bodies_alive(self):
+        velocities = memoryview(physics_engine.Bodies(4).velocities)
+        velocities[3, 2] = 1.5
+        self.assertEqual(1.5, velocities[3, 2])
+
+    def test_update_should_move_bodies_in_place(self):
+        bodies = create_two_bodies()
+        system = physics_engine.BodiesSystem(bodies, physics_engine.SEQUENTIAL, 0.1)
+        positions = memoryview(bodies.positions)
+
+        system.update(0.1, 10)
+
+        # the bodies attract each other symmetrically
+        self.assertLess(positions[0, 0], 0.0)
+        self.assertGreater(positions[0, 0], -1.0)
+        self.assertAlmostEqual(-positions[0, 0], positions[1, 0], places=5)
+        self.assertIs(bodies, system.bodies)
+        self.assertEqual(2, system.num_bodies)
+
+    def test_update_should_release_gil(self):
+        bodies = physics_engine.Bodies(2_000)
+        masses = memoryview(bodies.masses)
+        positions = memoryview(bodies.positions)
+        for i in range(bodies.num_bodies):
+            masses[i] = 1.0
+            positions[i, 0] = float(i)
+        system = physics_engine.BodiesSystem(bodies, physics_engine.OPEN_MP)
+        num_ticks = 0
+        worker = threading.Thread(target=system.update, args=(0.01, 20))
+
+        worker.start()
+        while worker.is_alive():
+            num_ticks += 1
+        worker.join()
+
+        # the main thread kept running during the update
+        self.assertGreater(num_ticks, 1)
+
+    def test_acceleration_calculation_should_write_into_buffer(self):
+        bodies = create_two_bodies()
+        calculation = physics_engine.AccelerationCalculation(physics_engine.SEQUENTIAL)
+        accelerations = array.array('f', [0.0] * (2 * 3))
+
+        calculation.calc_accelerations(bodies, accelerations, 0.0)
+
+        self.assertAlmostEqual(6.674e-11 * 1e10 / 4.0, accelerations[0], places=4)
+        self.assertAlmostEqual(-accelerations[0], accelerations[3], places=6)
+
+    def test_invalid_arguments_should_raise(self):
+        bodies = create_two_bodies()
+        calculation = physics_engine.AccelerationCalculation()
+        with self.assertRaises(ValueError):
+            physics_engine.Bodies(-1)
+        with self.assertRaises(ValueError):
+            physics_engine.AccelerationCalculation(100)
+        with self.assertRaises(ValueError):
+            physics_engine.AccelerationCalculation(physics_engine.EWALD)
+        with self.assertRaises(ValueError):
+            calculation.calc_accelerations(bodies, array.array('f', [0.0]))
+        # buffers of other types are not reinterpreted as float32, even if they are large enough
+        with self.assertRaises(ValueError):
+            calculation.calc_accelerations(bodies, array.array('d', [0.0] * (2 * 3)))
+        with self.assertRaises(ValueError):
+            calculation.calc_accelerations(bodies, bytearray(2 * 3 * 4))
+        with self.assertRaises(TypeError):
+            calculation.calc_accelerations(bytearray(4), array.array('f', [0.0] * 6))
+        with self.assertRaises(TypeError):
+            physics_engine.BodiesSystem(None)
+        # re-initialising would delete the calculation while another thread may still use it without the GIL
+        with self.assertRaises(RuntimeError):
+            calculation.__init__(physics_engine.SEQUENTIAL)
+
+    @unittest.skipUnless(numpy, 'NumPy is not installed')
+    def test_numpy_arrays_should_be_views(self):
+        bodies = physics_engine.Bodies(2)
+        positions = numpy.asarray(bodies.positions)
+        masses = numpy.asarray(bodies.masses)
+        self.assertEqual((2, 3), positions.shape)
+        self.assertEqual(numpy.float32, positions.dtype)
+
+        masses[:] = 1e10
+        positions[:, 0] = [-1.0, 1.0]
+        physics_engine.BodiesSystem(bodies, physics_engine.SEQUENTIAL).update(0.1)
+
+        self.assertTrue(numpy.all(numpy.asarray(bodies.positions) == positions))
+        self.assertLess(positions[0, 0], 0.0)
+        self.assertGreater(positions[0, 0], -1.0)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,127 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/initial_conditions.h"
+#include "../../src/acceleration_accuracy.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * Generated bodies with their reference accelerations.
+	 */
+	struct ReferenceBodies : TestBodies {
+		std::vector<double> referenceAccelerations;
+
+		ReferenceBodies(const Scenario scenario, const size_t numBodies) :
+				TestBodies(createScenario(scenario, numBodies, createParameters())),
+				referenceAccelerations(numBodies * 3) {
+			calcReferenceAccelerations(asBodies(), numBodies, 0.01f, referenceAccelerations.data());
+		}
+
+		AccelerationAccuracy measure(IAccelerationCalculation &accelerationCalculation) {
+			std::vector<float> accelerations(masses.size() * 3);
+			return measureAccelerationAccuracy(accelerationCalculation, asBodies(), masses.size(), 0.01f,
+											   referenceAccelerations.data(), accelerations.data());
+		}
+
+		static ScenarioParameters createParameters() {
+			ScenarioParameters parameters;
+			parameters.seed = 50;
+			return parameters;
+		}
+	};
+}
+
+TEST(AccelerationAccuracyTest, ReferenceShouldMatchTwoBodies) {
+	// Preparation
+	std::vector<float> masses{2.0f, 3.0f};
+	std::vector<float> positions{0.0f, 0.0f, 0.0f, 0.0f, 2.0f, 0.0f};
+	std::vector<float> velocities(6, 0.0f);
+	std::vector<double> accelerations(6);
+
+	// Stimulation
+	calcReferenceAccelerations({masses.data(), positions.data(), velocities.data()}, 2, 0.25f, accelerations.data(),
+							   1.0);
+
+	// Tests: a = G m / (d^2 + eps^2)^1.5 * d
+	const double distanceFactor = 2.0 / std::pow(4.25, 1.5);
+	ASSERT_DOUBLE_EQ(3.0 * distanceFactor, accelerations[1]);
+	ASSERT_DOUBLE_EQ(-2.0 * distanceFactor, accelerations[4]);
+	ASSERT_EQ(0.0, accelerations[0]);
+	ASSERT_EQ(0.0, accelerations[5]);
+}
+
+TEST(AccelerationAccuracyTest, PercentilesShouldRankRelativeErrors) {
+	// Preparation: the relative errors of the bodies are 0, 0.01, ..., 0.99
+	const size_t numBodies = 100;
+	std::vector<double> referenceAccelerations(numBodies * 3, 0.0);
+	std::vector<float> accelerations(numBodies * 3, 0.0f);
+	for (size_t i = 0; i < numBodies; ++i) {
+		referenceAccelerations[(i * 3) + 1] = -4.0;
+		accelerations[(i * 3) + 1] = static_cast<float>(-4.0 * (1.0 + (0.01 * static_cast<double>(i))));
+	}
+
+	// Stimulation
+	const AccelerationAccuracy accuracy = compareAccelerations(accelerations.data(), referenceAccelerations.data(),
+															   numBodies);
+
+	// Tests
+	ASSERT_NEAR(0.49, accuracy.medianRelativeError, 1e-6);
+	ASSERT_NEAR(0.89, accuracy.p90RelativeError, 1e-6);
+	ASSERT_NEAR(0.98, accuracy.p99RelativeError, 1e-6);
+	ASSERT_NEAR(0.99, accuracy.maxRelativeError, 1e-6);
+}
+
+TEST(AccelerationAccuracyTest, DirectSumsShouldBeAccurateToSinglePrecision) {
+	const AccelerationCalculationImplementation implementations[] = {
+			AccelerationCalculationImplementation::SEQUENTIAL, AccelerationCalculationImplementation::OPEN_MP,
+			AccelerationCalculationImplementation::SMALL_N, AccelerationCalculationImplementation::OUT_OF_CORE};
+	for (const Scenario scenario: {Scenario::PLUMMER_SPHERE, Scenario::HIERARCHICAL_CLUSTERS}) {
+		ReferenceBodies referenceBodies(scenario, 2'000);
+		for (const AccelerationCalculationImplementation implementation: implementations) {
+			// Stimulation
+			const std::unique_ptr<IAccelerationCalculation> pCalculation(
+					createAccelerationCalculation(implementation));
+			const AccelerationAccuracy accuracy = referenceBodies.measure(*pCalculation);
+
+			// Tests
+			ASSERT_LT(accuracy.p99RelativeError, 1e-5);
+			ASSERT_LT(accuracy.maxRelativeError, 1e-4);
+			ASSERT_GT(accuracy.interactionsPerSecond, 0.0);
+		}
+	}
+}
+
+TEST(AccelerationAccuracyTest, ApproximationsShouldStayWithinTheirErrorBudgets) {
+	// Preparation
+	ReferenceBodies plummerSphere(Scenario::PLUMMER_SPHERE, 2'000);
+	ReferenceBodies hierarchicalClusters(Scenario::HIERARCHICAL_CLUSTERS, 2'000);
+	ReferenceBodies uniformSquare(Scenario::UNIFORM_SQUARE, 2'000);
+	const std::unique_ptr<IAccelerationCalculation> pTreePm(
+			createAccelerationCalculation(AccelerationCalculationImplementation::TREE_PM));
+	const std::unique_ptr<IAccelerationCalculation> pCompressed(
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP));
+	pCompressed->setPositionCompressionEnabled(true);
+
+	// Stimulation
+	const AccelerationAccuracy treePmPlummer = plummerSphere.measure(*pTreePm);
+	const AccelerationAccuracy treePmClusters = hierarchicalClusters.measure(*pTreePm);
+	const AccelerationAccuracy treePmSquare = uniformSquare.measure(*pTreePm);
+	const AccelerationAccuracy compressedPlummer = plummerSphere.measure(*pCompressed);
+	const AccelerationAccuracy compressedClusters = hierarchicalClusters.measure(*pCompressed);
+
+	// Tests: the budgets are about twice the errors measured when they were introduced. On the clusters and the square
+	// the softening factor of 0.1 exceeds the split scale of the mesh, so they gate that TreePM softens all pairs.
+	ASSERT_LT(treePmPlummer.p99RelativeError, 0.025);
+	ASSERT_LT(treePmClusters.p99RelativeError, 0.015);
+	ASSERT_LT(treePmSquare.medianRelativeError, 0.005);
+	ASSERT_LT(treePmSquare.p99RelativeError, 0.025);
+	ASSERT_LT(compressedPlummer.p99RelativeError, 0.01);
+	ASSERT_LT(compressedClusters.p99RelativeError, 0.015);
+}
@@ -6,6 +6,11 @@
 #include "../../src/sequential_acceleration_calculation.h"
 #include "../../src/openmp_acceleration_calculation.h"
 #include "../../src/opencl_acceleration_calculation.h"
+#include "../../src/tree_pm_acceleration_calculation.h"
+#include "../../src/out_of_core_acceleration_calculation.h"
+#include "../../src/heterogeneous_acceleration_calculation.h"
+#include "../../src/multi_device_opencl_acceleration_calculation.h"
+#include "../../src/small_n_acceleration_calculation.h"
 #include "../../cuda-module/include/cudamodule/cuda_acceleration_calculation.h"
 
 using namespace physics;
@@ -65,4 +70,79 @@ TEST(AccelerationCalculationFactoryTest, ShouldCreateCUDAAcclerationImplementati
 
 	// Clean up
 	delete pAccelerationCalculation;
-}
\ No newline at end of file
+}
+
+TEST(AccelerationCalculationFactoryTest, ShouldCreateTreePmAcclerationImplementation) {
+	// Stimulation
+	const IAccelerationCalculation *const pAccelerationCalculation =
+			createAccelerationCalculation(AccelerationCalculationImplementation::TREE_PM);
+
+	// Test
+	assertReturnedTypeOfImplementationIs<TreePmAccelerationCalculationImpl>(pAccelerationCalculation);
+
+	// Clean up
+	delete pAccelerationCalculation;
+}
+TEST(AccelerationCalculationFactoryTest, ShouldCreateOutOfCoreAcclerationImplementation) {
+	// Stimulation
+	const IAccelerationCalculation *const pAccelerationCalculation =
+			createAccelerationCalculation(AccelerationCalculationImplementation::OUT_OF_CORE);
+
+	// Test
+	assertReturnedTypeOfImplementationIs<OutOfCoreAccelerationCalculationImpl>(pAccelerationCalculation);
+
+	// Clean up
+	delete pAccelerationCalculation;
+}
+
+TEST(AccelerationCalculationFactoryTest, ShouldCreateHeterogeneousAcclerationImplementation) {
+	// Stimulation
+	const IAccelerationCalculation *const pAccelerationCalculation =
+			createAccelerationCalculation(AccelerationCalculationImplementation::HETEROGENEOUS);
+
+	// Test
+	assertReturnedTypeOfImplementationIs<HeterogeneousAccelerationCalculationImpl>(pAccelerationCalculation);
+
+	// Clean up
+	delete pAccelerationCalculation;
+}
+
+TEST(AccelerationCalculationFactoryTest, ShouldCreateMultiDeviceOpenCLAcclerationImplementation) {
+	// Stimulation
+	const IAccelerationCalculation *const pAccelerationCalculation =
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_CL_MULTI_DEVICE);
+
+	// Test
+	assertReturnedTypeOfImplementationIs<MultiDeviceOpenClAccelerationCalculationImpl>(pAccelerationCalculation);
+
+	// Clean up
+	delete pAccelerationCalculation;
+}
+
+TEST(AccelerationCalculationFactoryTest, ShouldCreateSmallNAcclerationImplementation) {
+	// Stimulation
+	const IAccelerationCalculation *const pAccelerationCalculation =
+			createAccelerationCalculation(AccelerationCalculationImplementation::SMALL_N);
+
+	// Test
+	assertReturnedTypeOfImplementationIs<SmallNAccelerationCalculationImpl>(pAccelerationCalculation);
+
+	// Clean up
+	delete pAccelerationCalculation;
+}
+
+TEST(AccelerationCalculationFactoryTest, ShouldSelectSmallNImplementationForFewBodies) {
+	// Stimulation
+	const IAccelerationCalculation *const pFewBodiesCalculation =
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP, NewtonianForceLaw(), 3);
+	const IAccelerationCalculation *const pManyBodiesCalculation =
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP, NewtonianForceLaw(), 1'000);
+
+	// Test
+	assertReturnedTypeOfImplementationIs<SmallNAccelerationCalculationImpl>(pFewBodiesCalculation);
+	assertReturnedTypeOfImplementationIs<OpenMpAccelerationCalculationImpl>(pManyBodiesCalculation);
+
+	// Clean up
+	delete pFewBodiesCalculation;
+	delete pManyBodiesCalculation;
+}
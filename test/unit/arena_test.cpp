@@ -0,0 +1,138 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/arena.h"
+#include "physics/update_context.h"
+#include "../../src/tree_pm_acceleration_calculation.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+TEST(ArenaTest, AllocationsShouldBeAlignedAndReusedAfterReset) {
+	// Preparation
+	Arena arena(1024);
+
+	// Stimulation
+	auto *const pFirst = arena.allocate<float>(3);
+	auto *const pSecond = arena.allocate<double>(5);
+	arena.reset();
+	auto *const pThird = arena.allocate<float>(3);
+
+	// Tests
+	ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(pFirst) % Arena::ALIGNMENT);
+	ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(pSecond) % Arena::ALIGNMENT);
+	ASSERT_EQ(Arena::ALIGNMENT, reinterpret_cast<std::byte *>(pSecond) - reinterpret_cast<std::byte *>(pFirst));
+	ASSERT_EQ(pFirst, pThird);
+	ASSERT_EQ(Arena::ALIGNMENT, arena.getUsage());
+	ASSERT_EQ(2 * Arena::ALIGNMENT, arena.getPeakUsage());
+}
+
+TEST(ArenaTest, OverflowShouldGrowTheBlockToThePeakUsage) {
+	// Preparation
+	Arena arena(256);
+	arena.allocate<float>(32);
+
+	// Stimulation: the second allocation does not fit anymore
+	float *const pOverflow = arena.allocate<float>(1000);
+	pOverflow[999] = 1.0f;
+	arena.reset();
+
+	// Tests: after the reset both allocations fit into the block
+	ASSERT_EQ(128 + 4032, arena.getPeakUsage());
+	ASSERT_LE(arena.getPeakUsage(), arena.getCapacity());
+	const size_t capacity = arena.getCapacity();
+	arena.allocate<float>(32);
+	arena.allocate<float>(1000);
+	arena.reset();
+	ASSERT_EQ(capacity, arena.getCapacity());
+}
+
+TEST(ArenaTest, HugePageBackedBlockShouldBeUsable) {
+	// Preparation
+	const size_t count = 1'000'000;
+	Arena arena(count * sizeof(float), true);
+
+	// Stimulation
+	float *const values = arena.allocate<float>(count);
+	for (size_t i = 0; i < count; ++i) {
+		values[i] = static_cast<float>(i);
+	}
+
+	// Tests: the block is rounded up to whole huge pages, the backing itself is only a hint to the kernel
+	ASSERT_LE(count * sizeof(float), arena.getCapacity());
+	ASSERT_FLOAT_EQ(static_cast<float>(count - 1), values[count - 1]);
+}
+
+TEST(ArenaTest, DeletedBlockOfHugePageCapacityShouldBeReleased) {
+	// Preparation: the block is below one huge page, so it is allocated normally, but aligned up to a huge page
+	const size_t hugePageSize = 2 * 1024 * 1024;
+	auto pArena = std::make_unique<Arena>(hugePageSize - 1, true);
+	ASSERT_EQ(hugePageSize, pArena->getCapacity());
+	ASSERT_FALSE(pArena->isHugePageBacked());
+
+	// Stimulation: the block is deleted, not unmapped, also after it was grown by an overflow
+	pArena->allocate<std::byte>(hugePageSize);
+	pArena->allocate<std::byte>(1);
+	pArena->reset();
+	pArena.reset();
+	Arena arena(hugePageSize - 1, true);
+
+	// Tests: the released memory is reusable
+	auto *const pBytes = arena.allocate<std::byte>(hugePageSize);
+	pBytes[hugePageSize - 1] = std::byte{1};
+	ASSERT_EQ(std::byte{1}, pBytes[hugePageSize - 1]);
+}
+
+TEST(ArenaTest, MovedArenaShouldOwnTheBlock) {
+	Arena arena(1024);
+	float *const pValue = arena.allocate<float>(1);
+	Arena movedArena(std::move(arena));
+	ASSERT_EQ(0, arena.getCapacity());
+	ASSERT_EQ(1024, movedArena.getCapacity());
+	ASSERT_EQ(pValue + (Arena::ALIGNMENT / sizeof(float)), movedArena.allocate<float>(1));
+}
+
+TEST(ArenaTest, UpdateContextShouldResetAllArenas) {
+	// Preparation
+	UpdateContext context(4, 1024);
+	for (size_t thread = 0; thread < context.getNumThreads(); ++thread) {
+		context.getArena(thread).allocate<float>(100);
+	}
+
+	// Stimulation
+	context.reset();
+
+	// Tests
+	ASSERT_EQ(4, context.getNumThreads());
+	ASSERT_EQ(4 * 448, context.getPeakUsage());
+	for (size_t thread = 0; thread < context.getNumThreads(); ++thread) {
+		ASSERT_EQ(0, context.getArena(thread).getUsage());
+	}
+}
+
+TEST(ArenaTest, TreePmInContextShouldMatchTreePmWithoutContext) {
+	// Preparation
+	const size_t numBodies = 3'000;
+	RandomBodiesParameters parameters;
+	parameters.seed = 17;
+	parameters.minMass = 1.0f;
+	parameters.maxMass = 1.0f;
+	TestBodies randomBodies = TestBodies::createRandom(numBodies, parameters);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	std::vector<float> expected(numBodies * 3), actual(numBodies * 3);
+	// two calculations, since a calculation refits the octree of its previous call instead of building it
+	TreePmAccelerationCalculationImpl accelerationCalculation, contextAccelerationCalculation;
+	UpdateContext context(1);
+
+	// Stimulation
+	accelerationCalculation.calcAccelerations(bodies, numBodies, expected.data(), 0.01f);
+	contextAccelerationCalculation.calcAccelerationsInContext(bodies, numBodies, actual.data(), 0.01f, context);
+
+	// Tests: the sorting workspace of the octree was taken from the arena
+	ASSERT_EQ(expected, actual);
+	ASSERT_LE(numBodies * sizeof(std::pair<std::uint64_t, size_t>), context.getPeakUsage());
+}
@@ -0,0 +1,439 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/bodies_system.h"
+#include "physics/collision_handling.h"
+#include "../../src/openmp_euler_position_velocity_calculation.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The number of heap allocations of the unit tests, counted by the replaced global operator new.
+	 */
+	std::atomic<size_t> numAllocations{0};
+
+	/**
+	 * @brief Creates random bodies far away from each other in a large cube, so they neither collide nor move
+	 * noticeably.
+	 */
+	TestBodies createScatteredBodies(const size_t numBodies) {
+		RandomBodiesParameters parameters;
+		parameters.seed = 13;
+		parameters.minMass = 1.0f;
+		parameters.maxMass = 1.0f;
+		parameters.halfExtent = 1e4f;
+		return TestBodies::createRandom(numBodies, parameters);
+	}
+
+	/**
+	 * A fake calculation which blocks until it is released, so the state during an asynchronous update can be tested.
+	 */
+	class GatedAccelerationCalculation : public IAccelerationCalculation {
+
+		private:
+			std::atomic<bool> &isReleased_;
+
+		public:
+			explicit GatedAccelerationCalculation(std::atomic<bool> &isReleased) :
+					isReleased_(isReleased) {
+			}
+
+			void calcAccelerations(const Bodies<float, float, float> &, const size_t numBodies,
+								   float *const accelerations, float) override {
+				while (!isReleased_) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+				std::fill(accelerations, accelerations + (numBodies * 3), 1.0f);
+			}
+	};
+
+	/**
+	 * A fake calculation which always fails.
+	 */
+	class FailingAccelerationCalculation : public IAccelerationCalculation {
+
+		public:
+			void calcAccelerations(const Bodies<float, float, float> &, size_t, float *, float) override {
+				throw std::runtime_error("The calculation failed.");
+			}
+	};
+
+	/**
+	 * A coroutine which is started immediately and destroys itself at its end.
+	 */
+	struct DetachedCoroutine {
+		struct promise_type {
+			DetachedCoroutine get_return_object() {
+				return {};
+			}
+
+			std::suspend_never initial_suspend() noexcept {
+				return {};
+			}
+
+			std::suspend_never final_suspend() noexcept {
+				return {};
+			}
+
+			void return_void() {
+			}
+
+			void unhandled_exception() {
+				std::terminate();
+			}
+		};
+	};
+
+	/**
+	 * @brief Awaits the passed number of asynchronous updates and reports the number of finished updates.
+	 */
+	DetachedCoroutine awaitUpdates(BodiesSystem &bodiesSystem, const int numUpdates, std::promise<int> &finished) {
+		int numFinishedUpdates = 0;
+		for (int i = 0; i < numUpdates; ++i) {
+			co_await bodiesSystem.updateAsync();
+			++numFinishedUpdates;
+		}
+		finished.set_value(numFinishedUpdates);
+	}
+
+	/**
+	 * @brief Awaits one asynchronous update and sets the passed flag some time after it is resumed.
+	 */
+	DetachedCoroutine awaitUpdateSlowly(BodiesSystem &bodiesSystem, std::atomic<bool> &isContinuationFinished) {
+		co_await bodiesSystem.updateAsync();
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		isContinuationFinished = true;
+	}
+
+	/**
+	 * @brief Creates a system with an OpenMP (resp. the passed) acceleration calculation, the Euler integration and a
+	 * collision handling.
+	 */
+	BodiesSystem createSystem(const Bodies<float, float, float> &bodies, const size_t numBodies,
+							  const AccelerationCalculationImplementation implementation =
+							  AccelerationCalculationImplementation::OPEN_MP) {
+		return {bodies, numBodies,
+				std::unique_ptr<IAccelerationCalculation>(createAccelerationCalculation(implementation)),
+				std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(), 0.01f,
+				std::unique_ptr<ICollisionHandling>(createCollisionHandling(CollisionResolution::BOUNCE, 1.0f))};
+	}
+}
+
+// the replaced operators forward to the aligned operators, which are not replaced
+void *operator new(const std::size_t size) {
+	++numAllocations;
+	return ::operator new(size, std::align_val_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__});
+}
+
+void operator delete(void *const pMemory) noexcept {
+	::operator delete(pMemory, std::align_val_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__});
+}
+
+void operator delete(void *const pMemory, const std::size_t) noexcept {
+	::operator delete(pMemory, std::align_val_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__});
+}
+
+TEST(BodiesSystemTest, ShouldBeMovableButNotCopyable) {
+	ASSERT_FALSE(std::is_copy_constructible_v<BodiesSystem>);
+	ASSERT_FALSE(std::is_copy_assignable_v<BodiesSystem>);
+	ASSERT_TRUE(std::is_nothrow_move_constructible_v<BodiesSystem>);
+	ASSERT_TRUE(std::is_nothrow_move_assignable_v<BodiesSystem>);
+}
+
+TEST(BodiesSystemTest, MovedSystemShouldKeepUpdating) {
+	// Preparation
+	const size_t numBodies = 100;
+	TestBodies scatteredBodies = createScatteredBodies(numBodies);
+	BodiesSystem bodiesSystem = createSystem(scatteredBodies.asBodies(), numBodies);
+	bodiesSystem.update();
+
+	// Stimulation
+	BodiesSystem movedBodiesSystem(std::move(bodiesSystem));
+	movedBodiesSystem.update();
+
+	// Tests
+	ASSERT_EQ(numBodies, movedBodiesSystem.getNumBodies());
+	ASSERT_EQ(scatteredBodies.masses.data(), movedBodiesSystem.getBodies().masses);
+}
+
+TEST(BodiesSystemTest, MissingCalculationShouldThrow) {
+	TestBodies scatteredBodies = createScatteredBodies(1);
+	ASSERT_THROW(BodiesSystem(scatteredBodies.asBodies(), 1, nullptr,
+							  std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(), 0.01f),
+				 std::invalid_argument);
+}
+
+TEST(BodiesSystemTest, WarmedUpUpdateShouldNotAllocate) {
+	// Preparation: the first updates size the workspaces of the calculations
+	const size_t numBodies = 2'000;
+	TestBodies scatteredBodies = createScatteredBodies(numBodies);
+	BodiesSystem bodiesSystem = createSystem(scatteredBodies.asBodies(), numBodies);
+	bodiesSystem.setDiagnosticsEnabled(true);
+	for (int i = 0; i < 3; ++i) {
+		bodiesSystem.update();
+	}
+	const size_t numAllocationsBefore = numAllocations;
+
+	// Stimulation
+	for (int i = 0; i < 10; ++i) {
+		bodiesSystem.update();
+	}
+
+	// Tests
+	ASSERT_EQ(numAllocationsBefore, numAllocations);
+}
+
+TEST(BodiesSystemTest, WarmedUpTreePmUpdateShouldNotAllocate) {
+	// Preparation: the first updates size the workspaces of the calculations, including those of the mesh
+	const size_t numBodies = 2'000;
+	TestBodies scatteredBodies = createScatteredBodies(numBodies);
+	BodiesSystem bodiesSystem = createSystem(scatteredBodies.asBodies(), numBodies,
+											 AccelerationCalculationImplementation::TREE_PM);
+	for (int i = 0; i < 3; ++i) {
+		bodiesSystem.update();
+	}
+	const size_t numAllocationsBefore = numAllocations;
+
+	// Stimulation
+	for (int i = 0; i < 3; ++i) {
+		bodiesSystem.update();
+	}
+
+	// Tests
+	ASSERT_EQ(numAllocationsBefore, numAllocations);
+}
+
+TEST(BodiesSystemTest, SequentialAccelerationsShouldNotAccumulateOverUpdates) {
+	// Preparation
+	const size_t numBodies = 50;
+	TestBodies scatteredBodies = createScatteredBodies(numBodies);
+	const Bodies<float, float, float> bodies = scatteredBodies.asBodies();
+	std::vector<float> first(numBodies * 3, 0.0f), second(numBodies * 3, 0.0f);
+	const std::unique_ptr<IAccelerationCalculation> pAccelerationCalculation(
+			createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL));
+	pAccelerationCalculation->calcAccelerations(bodies, numBodies, first.data(), 0.01f);
+	second = first;
+
+	// Stimulation: the output still contains the previous accelerations
+	pAccelerationCalculation->calcAccelerations(bodies, numBodies, second.data(), 0.01f);
+
+	// Tests
+	ASSERT_EQ(first, second);
+}
+
+TEST(BodiesSystemTest, ReorderedBodiesShouldBeFoundByOriginalIds) {
+	// Preparation: the mass of each body encodes its original ID
+	const size_t numBodies = 500;
+	TestBodies scatteredBodies = createScatteredBodies(numBodies);
+	for (size_t i = 0; i < numBodies; ++i) {
+		scatteredBodies.masses[i] = 1.0f + static_cast<float>(i);
+	}
+	BodiesSystem bodiesSystem = createSystem(scatteredBodies.asBodies(), numBodies);
+	ASSERT_THROW(bodiesSystem.setReorderingEnabled(true, SpaceFillingCurve::HILBERT, 0), std::invalid_argument);
+	bodiesSystem.setReorderingEnabled(true, SpaceFillingCurve::HILBERT, 2);
+
+	// Stimulation
+	for (int i = 0; i < 3; ++i) {
+		bodiesSystem.update();
+	}
+
+	// Tests
+	for (size_t originalId = 0; originalId < numBodies; ++originalId) {
+		const std::optional<size_t> index = bodiesSystem.getBodyReordering().findBody(originalId);
+		ASSERT_TRUE(index.has_value());
+		ASSERT_EQ(1.0f + static_cast<float>(originalId), scatteredBodies.masses[*index]);
+	}
+}
+
+TEST(BodiesSystemTest, AsyncUpdatesShouldMatchSynchronousUpdates) {
+	// Preparation
+	const size_t numBodies = 200;
+	TestBodies expectedBodies = createScatteredBodies(numBodies), actualBodies = createScatteredBodies(numBodies);
+	BodiesSystem expectedSystem = createSystem(expectedBodies.asBodies(), numBodies);
+	BodiesSystem actualSystem = createSystem(actualBodies.asBodies(), numBodies);
+
+	// Stimulation
+	for (int i = 0; i < 3; ++i) {
+		expectedSystem.update();
+		actualSystem.updateAsync().get();
+	}
+
+	// Tests
+	ASSERT_EQ(expectedBodies.positions, actualBodies.positions);
+	ASSERT_EQ(expectedBodies.velocities, actualBodies.velocities);
+}
+
+TEST(BodiesSystemTest, SnapshotShouldHoldStateBeforePendingUpdate) {
+	// Preparation
+	const size_t numBodies = 10;
+	TestBodies scatteredBodies = createScatteredBodies(numBodies);
+	const std::vector<float> initialPositions = scatteredBodies.positions;
+	std::atomic<bool> isReleased{false};
+	BodiesSystem bodiesSystem(scatteredBodies.asBodies(), numBodies,
+							  std::make_unique<GatedAccelerationCalculation>(isReleased),
+							  std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(), 0.01f);
+	ASSERT_EQ(nullptr, bodiesSystem.getSnapshot());
+
+	// Stimulation
+	const AsyncUpdate pendingUpdate = bodiesSystem.updateAsync(1.0f);
+	const std::shared_ptr<const BodiesSnapshot> pSnapshot = bodiesSystem.getSnapshot();
+
+	// Tests: the update is blocked, while the snapshot is readable
+	ASSERT_FALSE(pendingUpdate.isReady());
+	ASSERT_NE(nullptr, pSnapshot);
+	ASSERT_EQ(numBodies, pSnapshot->getNumBodies());
+	ASSERT_EQ(initialPositions, std::vector<float>(pSnapshot->getPositions(),
+												   pSnapshot->getPositions() + (numBodies * 3)));
+	ASSERT_EQ(numBodies - 1, pSnapshot->getOriginalId(numBodies - 1));
+	isReleased = true;
+	pendingUpdate.get();
+	ASSERT_NE(initialPositions, scatteredBodies.positions);
+	ASSERT_EQ(initialPositions, std::vector<float>(pSnapshot->getPositions(),
+												   pSnapshot->getPositions() + (numBodies * 3)));
+
+	// Tests: the held snapshot is not overwritten by the next update
+	bodiesSystem.updateAsync(1.0f).get();
+	ASSERT_NE(pSnapshot, bodiesSystem.getSnapshot());
+	ASSERT_EQ(initialPositions, std::vector<float>(pSnapshot->getPositions(),
+												   pSnapshot->getPositions() + (numBodies * 3)));
+}
+
+TEST(BodiesSystemTest, MoveShouldWaitForPendingAsyncUpdates) {
+	// Preparation
+	const size_t numBodies = 10;
+	TestBodies movedBodies = createScatteredBodies(numBodies), replacedBodies = createScatteredBodies(numBodies);
+	const std::vector<float> initialPositions = movedBodies.positions;
+	const std::vector<float> initialReplacedPositions = replacedBodies.positions;
+	std::atomic<bool> isMovedReleased{false}, isReplacedReleased{false};
+	BodiesSystem movedSystem(movedBodies.asBodies(), numBodies,
+							 std::make_unique<GatedAccelerationCalculation>(isMovedReleased),
+							 std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(), 0.01f);
+	BodiesSystem replacedSystem(replacedBodies.asBodies(), numBodies,
+								std::make_unique<GatedAccelerationCalculation>(isReplacedReleased),
+								std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(), 0.01f);
+	const AsyncUpdate movedUpdate = movedSystem.updateAsync(1.0f);
+	replacedSystem.updateAsync(1.0f);
+	std::thread releasingThread([&isMovedReleased, &isReplacedReleased]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		isMovedReleased = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		isReplacedReleased = true;
+	});
+
+	// Stimulation: both moves block until the pending updates are finished
+	BodiesSystem movedConstructedSystem(std::move(movedSystem));
+	const bool isMovedUpdateReadyAfterConstruction = movedUpdate.isReady();
+	// the handle of the replaced update must not be used anymore, since its thread is destroyed by the assignment
+	replacedSystem = std::move(movedConstructedSystem);
+	const std::vector<float> replacedPositionsAfterAssignment = replacedBodies.positions;
+	releasingThread.join();
+
+	// Tests: the moved system keeps updating its own bodies
+	ASSERT_TRUE(isMovedUpdateReadyAfterConstruction);
+	ASSERT_NE(initialReplacedPositions, replacedPositionsAfterAssignment);
+	const std::vector<float> positionsAfterFirstUpdate = movedBodies.positions;
+	ASSERT_NE(initialPositions, positionsAfterFirstUpdate);
+	replacedSystem.updateAsync(1.0f).get();
+	ASSERT_NE(positionsAfterFirstUpdate, movedBodies.positions);
+	ASSERT_EQ(movedBodies.masses.data(), replacedSystem.getBodies().masses);
+}
+
+TEST(BodiesSystemTest, PublishedFramesShouldNotBlockOrAllocate) {
+	// Preparation
+	const size_t numBodies = 1'000;
+	TestBodies scatteredBodies = createScatteredBodies(numBodies);
+	BodiesSystem bodiesSystem = createSystem(scatteredBodies.asBodies(), numBodies);
+	ASSERT_EQ(nullptr, bodiesSystem.getFrameRing());
+	bodiesSystem.setFramePublishingEnabled(true, 3);
+	const std::shared_ptr<FrameRing> pFrameRing = bodiesSystem.getFrameRing();
+	ASSERT_NE(nullptr, pFrameRing);
+	bodiesSystem.update();
+	// an observer holds the first frame through all further updates
+	const FrameRing::Frame heldFrame = pFrameRing->acquireLatest();
+	const std::vector<float> heldPositions = scatteredBodies.positions;
+	for (int i = 0; i < 3; ++i) {
+		bodiesSystem.update();
+	}
+	const size_t numAllocationsBefore = numAllocations;
+
+	// Stimulation
+	for (int i = 0; i < 10; ++i) {
+		bodiesSystem.update();
+	}
+	const FrameRing::Frame latestFrame = pFrameRing->acquireLatest();
+
+	// Tests
+	ASSERT_EQ(numAllocationsBefore, numAllocations);
+	ASSERT_EQ(1u, heldFrame.getSequenceNumber());
+	ASSERT_EQ(heldPositions, std::vector<float>(heldFrame.getSnapshot().getPositions(),
+												heldFrame.getSnapshot().getPositions() + (numBodies * 3)));
+	ASSERT_EQ(14u, latestFrame.getSequenceNumber());
+	ASSERT_EQ(scatteredBodies.positions,
+			  std::vector<float>(latestFrame.getSnapshot().getPositions(),
+								 latestFrame.getSnapshot().getPositions() + (numBodies * 3)));
+	ASSERT_EQ(0u, pFrameRing->getNumDroppedFrames());
+}
+
+TEST(BodiesSystemTest, CoroutineShouldAwaitAsyncUpdates) {
+	// Preparation
+	const size_t numBodies = 100;
+	TestBodies expectedBodies = createScatteredBodies(numBodies), actualBodies = createScatteredBodies(numBodies);
+	BodiesSystem expectedSystem = createSystem(expectedBodies.asBodies(), numBodies);
+	BodiesSystem actualSystem = createSystem(actualBodies.asBodies(), numBodies);
+	for (int i = 0; i < 4; ++i) {
+		expectedSystem.update();
+	}
+	std::promise<int> finished;
+
+	// Stimulation: the coroutine is resumed by the thread of the updates
+	awaitUpdates(actualSystem, 4, finished);
+
+	// Tests
+	ASSERT_EQ(4, finished.get_future().get());
+	actualSystem.waitForAsyncUpdate();
+	ASSERT_EQ(expectedBodies.positions, actualBodies.positions);
+}
+
+TEST(BodiesSystemTest, WaitingShouldIncludeTheResumedCoroutine) {
+	// Preparation
+	const size_t numBodies = 100;
+	TestBodies scatteredBodies = createScatteredBodies(numBodies);
+	BodiesSystem bodiesSystem = createSystem(scatteredBodies.asBodies(), numBodies);
+	std::atomic<bool> isContinuationFinished{false};
+
+	// Stimulation: the update is finished before the coroutine, which is resumed by the thread of the updates
+	awaitUpdateSlowly(bodiesSystem, isContinuationFinished);
+	bodiesSystem.waitForAsyncUpdate();
+
+	// Tests
+	ASSERT_TRUE(isContinuationFinished);
+}
+
+TEST(BodiesSystemTest, FailedAsyncUpdateShouldRethrow) {
+	// Preparation
+	TestBodies scatteredBodies = createScatteredBodies(2);
+	BodiesSystem bodiesSystem(scatteredBodies.asBodies(), 2, std::make_unique<FailingAccelerationCalculation>(),
+							  std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(), 0.01f);
+
+	// Stimulation & Test
+	const AsyncUpdate failedUpdate = bodiesSystem.updateAsync();
+	ASSERT_THROW(failedUpdate.get(), std::runtime_error);
+	bodiesSystem.waitForAsyncUpdate();
+}
@@ -0,0 +1,140 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/body_reordering.h"
+#include "../../src/radix_sort.h"
+#include "../../src/space_filling_curves.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Calculates the mean distance between the bodies which are consecutive in memory.
+	 */
+	double calcMeanNeighbourDistance(const std::vector<float> &positions) {
+		const size_t numBodies = positions.size() / 3;
+		double distanceSum = 0.0;
+		for (size_t i = 1; i < numBodies; ++i) {
+			double squaredDistance = 0.0;
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				const double difference = positions[(i * 3) + dimension] - positions[((i - 1) * 3) + dimension];
+				squaredDistance += difference * difference;
+			}
+			distanceSum += std::sqrt(squaredDistance);
+		}
+		return distanceSum / static_cast<double>(numBodies - 1);
+	}
+}
+
+TEST(BodyReorderingTest, HilbertCurveShouldVisitNeighbouringCells) {
+	// Preparation: the Hilbert curve visits the first octant of each level completely before leaving it
+	const std::uint32_t gridSize = 8;
+	std::vector<std::pair<std::uint64_t, std::uint32_t>> keysAndCells;
+	for (std::uint32_t x = 0; x < gridSize; ++x) {
+		for (std::uint32_t y = 0; y < gridSize; ++y) {
+			for (std::uint32_t z = 0; z < gridSize; ++z) {
+				keysAndCells.emplace_back(calcHilbertKey(x, y, z), (((x * gridSize) + y) * gridSize) + z);
+			}
+		}
+	}
+
+	// Stimulation
+	std::sort(keysAndCells.begin(), keysAndCells.end());
+
+	// Tests: the keys are dense and consecutive cells share a face
+	for (size_t i = 0; i < keysAndCells.size(); ++i) {
+		ASSERT_EQ(i, keysAndCells[i].first);
+		if (0 < i) {
+			const auto cell = static_cast<int>(keysAndCells[i].second);
+			const auto previousCell = static_cast<int>(keysAndCells[i - 1].second);
+			const int size = static_cast<int>(gridSize);
+			ASSERT_EQ(1, std::abs((cell / (size * size)) - (previousCell / (size * size)))
+						 + std::abs(((cell / size) % size) - ((previousCell / size) % size))
+						 + std::abs((cell % size) - (previousCell % size)));
+		}
+	}
+}
+
+TEST(BodyReorderingTest, RadixSortShouldBeStable) {
+	// Preparation: few distinct keys, so the order of equal keys matters
+	const size_t numPairs = 100'000;
+	std::vector<std::pair<std::uint64_t, size_t>> pairs(numPairs), buffer(numPairs);
+	std::mt19937_64 engine(3);
+	std::uniform_int_distribution<std::uint64_t> keyDistribution(0, 1'000);
+	for (size_t i = 0; i < numPairs; ++i) {
+		pairs[i] = {keyDistribution(engine) << 30, i};
+	}
+	std::vector<std::pair<std::uint64_t, size_t>> expected = pairs;
+	std::stable_sort(expected.begin(), expected.end(), [](const auto &first, const auto &second) {
+		return first.first < second.first;
+	});
+	std::vector<size_t> histograms;
+
+	// Stimulation
+	radixSortByKeys(pairs.data(), buffer.data(), numPairs, 63, histograms);
+
+	// Tests
+	ASSERT_EQ(expected, pairs);
+}
+
+TEST(BodyReorderingTest, ReorderShouldPermuteBodiesAndKeepOriginalIds) {
+	for (const SpaceFillingCurve curve: {SpaceFillingCurve::MORTON, SpaceFillingCurve::HILBERT}) {
+		// Preparation: the mass and the velocity of each body encode its original ID
+		const size_t numBodies = 10'000;
+		std::vector<float> masses(numBodies), positions(numBodies * 3), velocities(numBodies * 3);
+		std::mt19937 engine(11);
+		std::uniform_real_distribution<float> positionDistribution(-1.0f, 1.0f);
+		for (size_t i = 0; i < numBodies; ++i) {
+			masses[i] = static_cast<float>(i);
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				positions[(i * 3) + dimension] = positionDistribution(engine);
+				velocities[(i * 3) + dimension] = static_cast<float>(i) + static_cast<float>(dimension);
+			}
+		}
+		const std::vector<float> originalPositions = positions;
+		const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+		BodyReordering bodyReordering(numBodies, curve);
+
+		// Stimulation
+		bodyReordering.reorder(bodies, numBodies);
+
+		// Tests: each body is complete and can be found by its original ID
+		for (size_t i = 0; i < numBodies; ++i) {
+			const size_t originalId = bodyReordering.getOriginalId(i);
+			ASSERT_EQ(static_cast<float>(originalId), masses[i]);
+			ASSERT_EQ(i, bodyReordering.findBody(originalId));
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				ASSERT_EQ(originalPositions[(originalId * 3) + dimension], positions[(i * 3) + dimension]);
+				ASSERT_EQ(static_cast<float>(originalId) + static_cast<float>(dimension),
+						  velocities[(i * 3) + dimension]);
+			}
+		}
+		// bodies which are consecutive in memory are much closer in space
+		ASSERT_LT(10.0 * calcMeanNeighbourDistance(positions), calcMeanNeighbourDistance(originalPositions));
+	}
+}
+
+TEST(BodyReorderingTest, RemovedBodiesShouldNotBeFound) {
+	// Preparation
+	BodyReordering bodyReordering(5);
+	const size_t remainingBodyIndices[] = {0, 2, 4};
+
+	// Stimulation
+	bodyReordering.removeBodies(remainingBodyIndices, 3);
+
+	// Tests
+	ASSERT_EQ(0, bodyReordering.findBody(0));
+	ASSERT_FALSE(bodyReordering.findBody(1).has_value());
+	ASSERT_EQ(1, bodyReordering.findBody(2));
+	ASSERT_FALSE(bodyReordering.findBody(3).has_value());
+	ASSERT_EQ(2, bodyReordering.findBody(4));
+	ASSERT_FALSE(bodyReordering.findBody(5).has_value());
+	ASSERT_EQ(4, bodyReordering.getOriginalId(2));
+}
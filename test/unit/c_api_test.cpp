@@ -0,0 +1,92 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/c_api.h"
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/bodies_system.h"
+#include "../../src/openmp_euler_position_velocity_calculation.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+TEST(CApiTest, SystemShouldMatchCppSystem) {
+	// Preparation
+	TestBodies cBodies = TestBodies::createThreeBodies();
+	TestBodies cppBodies = TestBodies::createThreeBodies();
+	physics_engine_system *pSystem = nullptr;
+	ASSERT_EQ(PHYSICS_ENGINE_OK, physics_engine_system_create(
+			cBodies.masses.data(), cBodies.positions.data(), cBodies.velocities.data(), 3, PHYSICS_ENGINE_SEQUENTIAL,
+			0.1f, &pSystem));
+	BodiesSystem bodiesSystem(cppBodies.asBodies(), 3,
+							  std::unique_ptr<IAccelerationCalculation>(
+									  createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL)),
+							  std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(), 0.1f);
+	std::vector<float> masses(3), positions(9), velocities(9);
+
+	// Stimulation
+	ASSERT_EQ(PHYSICS_ENGINE_OK, physics_engine_system_step(pSystem, 0.1f, 10));
+	for (int i = 0; i < 10; ++i) {
+		bodiesSystem.update(0.1f);
+	}
+	ASSERT_EQ(PHYSICS_ENGINE_OK, physics_engine_system_read(pSystem, masses.data(), positions.data(),
+															velocities.data()));
+
+	// Tests: the system owns a copy, so the bodies of the caller are unchanged
+	ASSERT_EQ(3u, physics_engine_system_get_num_bodies(pSystem));
+	ASSERT_EQ(TestBodies::createThreeBodies().positions, cBodies.positions);
+	ASSERT_EQ(cppBodies.masses, masses);
+	ASSERT_EQ(cppBodies.positions, positions);
+	ASSERT_EQ(cppBodies.velocities, velocities);
+	ASSERT_EQ(PHYSICS_ENGINE_OK, physics_engine_system_read(pSystem, nullptr, positions.data(), nullptr));
+
+	// Clean up
+	physics_engine_system_destroy(pSystem);
+}
+
+TEST(CApiTest, AccelerationsShouldBeWrittenIntoBufferOfCaller) {
+	// Preparation
+	TestBodies threeBodies = TestBodies::createThreeBodies();
+	physics_engine_acceleration_calculation *pCalculation = nullptr;
+	ASSERT_EQ(PHYSICS_ENGINE_OK, physics_engine_acceleration_calculation_create(PHYSICS_ENGINE_OPEN_MP,
+																				&pCalculation));
+	const std::unique_ptr<IAccelerationCalculation> pExpectedCalculation(
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP));
+	std::vector<float> accelerations(9), expectedAccelerations(9);
+
+	// Stimulation
+	ASSERT_EQ(PHYSICS_ENGINE_OK, physics_engine_calc_accelerations(
+			pCalculation, threeBodies.masses.data(), threeBodies.positions.data(), 3, 0.01f, accelerations.data()));
+	pExpectedCalculation->calcAccelerations(threeBodies.asBodies(), 3, expectedAccelerations.data(), 0.01f);
+
+	// Tests
+	ASSERT_EQ(expectedAccelerations, accelerations);
+
+	// Clean up
+	physics_engine_acceleration_calculation_destroy(pCalculation);
+}
+
+TEST(CApiTest, ErrorsShouldBeReturnedAsStatus) {
+	TestBodies threeBodies = TestBodies::createThreeBodies();
+	physics_engine_system *pSystem = nullptr;
+	physics_engine_acceleration_calculation *pCalculation = nullptr;
+	ASSERT_EQ(static_cast<uint32_t>(PHYSICS_ENGINE_ABI_VERSION), physics_engine_get_abi_version());
+	ASSERT_EQ(PHYSICS_ENGINE_INVALID_ARGUMENT, physics_engine_system_create(
+			nullptr, threeBodies.positions.data(), threeBodies.velocities.data(), 3, PHYSICS_ENGINE_SEQUENTIAL, 0.1f,
+			&pSystem));
+	ASSERT_EQ(PHYSICS_ENGINE_INVALID_ARGUMENT, physics_engine_system_create(
+			threeBodies.masses.data(), threeBodies.positions.data(), threeBodies.velocities.data(), 3, 42, 0.1f,
+			&pSystem));
+	ASSERT_EQ(std::string("Unknown implementation of the acceleration calculation."),
+			  physics_engine_get_last_error_message());
+	ASSERT_EQ(nullptr, pSystem);
+	ASSERT_EQ(PHYSICS_ENGINE_INVALID_ARGUMENT, physics_engine_system_step(nullptr, 0.1f, 1));
+	ASSERT_EQ(PHYSICS_ENGINE_INVALID_ARGUMENT, physics_engine_acceleration_calculation_create(-1, &pCalculation));
+	ASSERT_EQ(PHYSICS_ENGINE_INVALID_ARGUMENT, physics_engine_calc_accelerations(
+			nullptr, threeBodies.masses.data(), threeBodies.positions.data(), 3, 0.01f, nullptr));
+	ASSERT_EQ(0u, physics_engine_system_get_num_bodies(nullptr));
+	physics_engine_system_destroy(nullptr);
+	physics_engine_acceleration_calculation_destroy(nullptr);
+}
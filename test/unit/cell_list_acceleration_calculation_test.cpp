@@ -0,0 +1,113 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cmath>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/cell_list_acceleration_calculation.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * A linear spring repulsion between overlapping spheres of equal diameter, as used by granular simulations.
+	 */
+	struct HarmonicRepulsionPairForce {
+		float stiffness;
+		float diameter;
+
+		float operator()(const float distanceSquared, const float, const float targetMass, const float) const {
+			const float distance = std::sqrt(distanceSquared);
+			return -stiffness * (diameter - distance) / (distance * targetMass);
+		}
+	};
+
+	void calcAccelerationsByBruteForce(const Bodies<float, float, float> &bodies, const size_t numBodies,
+									   const HarmonicRepulsionPairForce &pairForce, const float cutoffRadius,
+									   float *accelerations) {
+		for (size_t i = 0; i < numBodies; ++i) {
+			double accelerationVector[3] = {0.0, 0.0, 0.0};
+			for (size_t j = 0; j < numBodies; ++j) {
+				if (i != j) {
+					float distanceVector[3];
+					float squaredDistance = 0.0f;
+					for (size_t dimension = 0; dimension < 3; ++dimension) {
+						distanceVector[dimension] =
+								bodies.positions[(j * 3) + dimension] - bodies.positions[(i * 3) + dimension];
+						squaredDistance += distanceVector[dimension] * distanceVector[dimension];
+					}
+					if (squaredDistance < (cutoffRadius * cutoffRadius)) {
+						const float factor = pairForce(squaredDistance, 0.0f, bodies.masses[i], bodies.masses[j]);
+						for (size_t dimension = 0; dimension < 3; ++dimension) {
+							accelerationVector[dimension] += factor * distanceVector[dimension];
+						}
+					}
+				}
+			}
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				accelerations[(i * 3) + dimension] = static_cast<float>(accelerationVector[dimension]);
+			}
+		}
+	}
+
+	void assertAccelerationsNear(const std::vector<float> &expected, const std::vector<float> &actual) {
+		ASSERT_EQ(expected.size(), actual.size());
+		for (size_t i = 0; i < expected.size(); ++i) {
+			ASSERT_NEAR(expected[i], actual[i], 1e-3f * (1.0f + std::abs(expected[i])));
+		}
+	}
+}
+
+TEST(AccelerationCalculationTest, CellListAccelerationCalculationTest) {
+	// Preparation
+	const size_t numBodies = 2'000;
+	const float diameter = 1.0f;
+	const HarmonicRepulsionPairForce pairForce{100.0f, diameter};
+	RandomBodiesParameters parameters;
+	parameters.seed = 7;
+	parameters.halfExtent = 6.0f;
+	TestBodies randomBodies = TestBodies::createRandom(numBodies, parameters);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	CellListAccelerationCalculationImpl<HarmonicRepulsionPairForce> accelerationCalculation(pairForce, diameter, 0.3f);
+	std::vector<float> expected(numBodies * 3), actual(numBodies * 3);
+
+	// Test case 1: the first call builds the neighbour list
+	{
+		// Stimulation
+		accelerationCalculation.calcAccelerations(bodies, numBodies, actual.data(), 0.0f);
+		calcAccelerationsByBruteForce(bodies, numBodies, pairForce, diameter, expected.data());
+
+		// Tests
+		ASSERT_EQ(1, accelerationCalculation.getNumNeighbourListBuilds());
+		assertAccelerationsNear(expected, actual);
+	}
+
+	// Test case 2: displacements below half of the skin distance reuse the neighbour list
+	{
+		for (float &coordinate: randomBodies.positions) {
+			coordinate += 0.05f;
+		}
+		randomBodies.positions[0] += 0.08f;
+
+		// Stimulation
+		accelerationCalculation.calcAccelerations(bodies, numBodies, actual.data(), 0.0f);
+		calcAccelerationsByBruteForce(bodies, numBodies, pairForce, diameter, expected.data());
+
+		// Tests
+		ASSERT_EQ(1, accelerationCalculation.getNumNeighbourListBuilds());
+		assertAccelerationsNear(expected, actual);
+	}
+
+	// Test case 3: a displacement beyond half of the skin distance rebuilds the neighbour list
+	{
+		randomBodies.positions[3] += 0.2f;
+
+		// Stimulation
+		accelerationCalculation.calcAccelerations(bodies, numBodies, actual.data(), 0.0f);
+		calcAccelerationsByBruteForce(bodies, numBodies, pairForce, diameter, expected.data());
+
+		// Tests
+		ASSERT_EQ(2, accelerationCalculation.getNumNeighbourListBuilds());
+		assertAccelerationsNear(expected, actual);
+	}
+}
@@ -0,0 +1,162 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/collision_handling.h"
+#include "physics/bodies_system.h"
+#include "../../src/sweep_and_prune_collision_handling.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The density of a body of unit mass and unit radius.
+	 */
+	const float UNIT_DENSITY = static_cast<float>(3.0 / (4.0 * std::numbers::pi));
+
+	/**
+	 * A position and velocity calculation without acceleration, i.e. linear motion.
+	 */
+	class LinearMotion : public IPositionVelocityCalculation {
+		public:
+			void updatePositionAndVelocity(const Bodies<float, float, float> &bodies, const size_t numBodies,
+										   const float *, const float timeStep) override {
+				for (size_t i = 0; i < (numBodies * 3); ++i) {
+					bodies.positions[i] += bodies.velocities[i] * timeStep;
+				}
+			}
+	};
+
+	/**
+	 * An acceleration calculation without forces.
+	 */
+	class NoAcceleration : public IAccelerationCalculation {
+		public:
+			void calcAccelerations(const Bodies<float, float, float> &, const size_t numBodies,
+								   float *const accelerations, const float) override {
+				std::fill(accelerations, accelerations + (numBodies * 3), 0.0f);
+			}
+	};
+}
+
+TEST(CollisionHandlingTest, FastBodiesShouldMergeInsteadOfTunneling) {
+	// Preparation: two unit spheres pass through each other within one step
+	const size_t numBodies = 2;
+	std::vector<float> masses{1.0f, 3.0f};
+	std::vector<float> previousPositions{-10.0f, 0.0f, 0.0f, 10.0f, 0.5f, 0.0f};
+	std::vector<float> positions{10.0f, 0.0f, 0.0f, -10.0f, 0.5f, 0.0f};
+	std::vector<float> velocities{20.0f, 0.0f, 0.0f, -20.0f, 0.0f, 0.0f};
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	ICollisionHandling *const pCollisionHandling = createCollisionHandling(CollisionResolution::MERGE, UNIT_DENSITY);
+
+	// Stimulation
+	const size_t numRemainingBodies =
+			pCollisionHandling->handleCollisions(bodies, numBodies, previousPositions.data(), 1.0f);
+
+	// Tests: mass, momentum and center of mass are conserved
+	ASSERT_EQ(1, numRemainingBodies);
+	ASSERT_FLOAT_EQ(4.0f, masses[0]);
+	ASSERT_FLOAT_EQ((20.0f - 60.0f) / 4.0f, velocities[0]);
+	ASSERT_FLOAT_EQ((10.0f - 30.0f) / 4.0f, positions[0]);
+	ASSERT_FLOAT_EQ(1.5f / 4.0f, positions[1]);
+
+	// Clean up
+	delete pCollisionHandling;
+}
+
+TEST(CollisionHandlingTest, ElasticHeadOnCollisionShouldExchangeVelocities) {
+	// Preparation: two unit spheres touch after a quarter of the step
+	const size_t numBodies = 2;
+	std::vector<float> masses{1.0f, 1.0f};
+	std::vector<float> previousPositions{-2.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f};
+	std::vector<float> positions{2.0f, 0.0f, 0.0f, -2.0f, 0.0f, 0.0f};
+	std::vector<float> velocities{4.0f, 0.0f, 0.0f, -4.0f, 0.0f, 0.0f};
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	ICollisionHandling *const pCollisionHandling =
+			createCollisionHandling(CollisionResolution::BOUNCE, UNIT_DENSITY, 1.0f);
+
+	// Stimulation
+	const size_t numRemainingBodies =
+			pCollisionHandling->handleCollisions(bodies, numBodies, previousPositions.data(), 1.0f);
+
+	// Tests: the bodies turn at the contact and move back for the rest of the step
+	ASSERT_EQ(2, numRemainingBodies);
+	ASSERT_FLOAT_EQ(-4.0f, velocities[0]);
+	ASSERT_FLOAT_EQ(4.0f, velocities[3]);
+	ASSERT_FLOAT_EQ(-1.0f - 3.0f, positions[0]);
+	ASSERT_FLOAT_EQ(1.0f + 3.0f, positions[3]);
+
+	// Clean up
+	delete pCollisionHandling;
+}
+
+TEST(CollisionHandlingTest, BroadPhaseShouldFindAllOverlappingPairs) {
+	// Preparation: resting bodies, so the contacts are the overlapping pairs
+	const size_t numBodies = 5'000;
+	std::vector<float> masses(numBodies), positions(numBodies * 3), velocities(numBodies * 3, 0.0f);
+	std::mt19937 engine(3);
+	std::uniform_real_distribution<float> massDistribution(0.001f, 0.01f);
+	std::uniform_real_distribution<float> positionDistribution(0.0f, 20.0f);
+	for (size_t i = 0; i < numBodies; ++i) {
+		masses[i] = massDistribution(engine);
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			positions[(i * 3) + dimension] = positionDistribution(engine);
+		}
+	}
+	const std::vector<float> previousPositions = positions;
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	SweepAndPruneCollisionHandlingImpl collisionHandling(CollisionResolution::BOUNCE, UNIT_DENSITY, 0.5f);
+
+	size_t expectedNumContacts = 0;
+	for (size_t i = 0; i < numBodies; ++i) {
+		for (size_t j = i + 1; j < numBodies; ++j) {
+			float squaredDistance = 0.0f;
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				const float difference = positions[(j * 3) + dimension] - positions[(i * 3) + dimension];
+				squaredDistance += difference * difference;
+			}
+			const float sumOfRadii = std::cbrt(masses[i]) + std::cbrt(masses[j]);
+			if (squaredDistance <= (sumOfRadii * sumOfRadii)) {
+				++expectedNumContacts;
+			}
+		}
+	}
+
+	// Stimulation
+	collisionHandling.handleCollisions(bodies, numBodies, previousPositions.data(), 1.0f);
+
+	// Tests
+	ASSERT_LT(0, expectedNumContacts);
+	ASSERT_EQ(expectedNumContacts, collisionHandling.getNumContacts());
+}
+
+TEST(CollisionHandlingTest, BodiesSystemShouldRemoveMergedBodies) {
+	// Preparation
+	const size_t numBodies = 3;
+	std::vector<float> masses{1.0f, 1.0f, 1.0f};
+	std::vector<float> positions{-3.0f, 0.0f, 0.0f, 3.0f, 0.0f, 0.0f, 0.0f, 50.0f, 0.0f};
+	std::vector<float> velocities{10.0f, 0.0f, 0.0f, -10.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	BodiesSystem bodiesSystem(bodies, numBodies, std::make_unique<NoAcceleration>(), std::make_unique<LinearMotion>(),
+							  0.0f, std::unique_ptr<ICollisionHandling>(
+									  createCollisionHandling(CollisionResolution::MERGE, UNIT_DENSITY)));
+
+	// Stimulation
+	bodiesSystem.update(1.0f);
+
+	// Tests: the merged body is at rest and the untouched body keeps its place
+	ASSERT_EQ(2, bodiesSystem.getNumBodies());
+	ASSERT_FLOAT_EQ(2.0f, masses[0]);
+	ASSERT_FLOAT_EQ(0.0f, velocities[0]);
+	ASSERT_FLOAT_EQ(1.0f, masses[1]);
+	ASSERT_FLOAT_EQ(50.0f, positions[4]);
+	ASSERT_EQ(0, bodiesSystem.getBodyReordering().findBody(0));
+	ASSERT_FALSE(bodiesSystem.getBodyReordering().findBody(1).has_value());
+	ASSERT_EQ(1, bodiesSystem.getBodyReordering().findBody(2));
+	ASSERT_EQ(2, bodiesSystem.getBodyReordering().getOriginalId(1));
+}
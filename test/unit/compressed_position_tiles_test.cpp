@@ -0,0 +1,227 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/body_reordering.h"
+#include "../../src/compressed_position_tiles.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Creates half of the bodies in a dense cluster, half scattered in a cube, with random masses.
+	 */
+	TestBodies createClusteredBodies(const size_t numBodies) {
+		RandomBodiesParameters parameters;
+		parameters.seed = 42;
+		parameters.maxMass = 1.5f;
+		parameters.clusterStandardDeviation = 0.1f;
+		return TestBodies::createRandom(numBodies, parameters);
+	}
+
+	/**
+	 * @brief Calculates the sorted relative errors of the magnitudes of the acceleration differences.
+	 */
+	std::vector<double> calcSortedRelativeErrors(const std::vector<float> &expected, const std::vector<float> &actual) {
+		std::vector<double> relativeErrors(expected.size() / 3);
+		for (size_t i = 0; i < relativeErrors.size(); ++i) {
+			double squaredDifference = 0.0, squaredExpected = 0.0;
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				const double difference = expected[(i * 3) + dimension] - actual[(i * 3) + dimension];
+				squaredDifference += difference * difference;
+				squaredExpected += static_cast<double>(expected[(i * 3) + dimension]) * expected[(i * 3) + dimension];
+			}
+			relativeErrors[i] = std::sqrt(squaredDifference / squaredExpected);
+		}
+		std::sort(relativeErrors.begin(), relativeErrors.end());
+		return relativeErrors;
+	}
+}
+
+TEST(CompressedPositionTilesTest, HalvesShouldRoundTripAndRoundToNearest) {
+	// all finite halves survive the conversion to float and back
+	for (std::uint32_t half = 0; half <= 0xffff; ++half) {
+		if (0x7c00 != (half & 0x7c00)) {
+			ASSERT_EQ(half, convertFloatToHalf(convertHalfToFloat(static_cast<std::uint16_t>(half)))) << half;
+		}
+	}
+	// the relative error of normal halves is at most half of their precision of 11 bits
+	std::mt19937 engine(1);
+	std::uniform_real_distribution<float> exponentDistribution(-14.0f, 15.0f);
+	for (int i = 0; i < 100'000; ++i) {
+		const float value = std::exp2(exponentDistribution(engine));
+		ASSERT_LE(std::abs(convertHalfToFloat(convertFloatToHalf(value)) - value), value * std::exp2(-11.0f));
+		ASSERT_EQ(-convertHalfToFloat(convertFloatToHalf(value)), convertHalfToFloat(convertFloatToHalf(-value)));
+	}
+}
+
+TEST(CompressedPositionTilesTest, DecompressedBodiesShouldBeWithinTheQuantizationBounds) {
+	// Preparation
+	const size_t numBodies = 1'000;
+	TestBodies clusteredBodies = createClusteredBodies(numBodies);
+	CompressedPositionTiles tiles;
+	std::vector<float> decompressed(CompressedPositionTiles::TILE_SIZE * 4);
+
+	// Stimulation
+	tiles.compress(clusteredBodies.asBodies(), numBodies);
+
+	// Tests: an error of half a unit in the last place of a half in [-1, 1], scaled by the tile, plus float rounding
+	ASSERT_EQ(4, tiles.getNumTiles());
+	size_t numDecompressedBodies = 0;
+	for (size_t tile = 0; tile < tiles.getNumTiles(); ++tile) {
+		const float *const header = tiles.getTileHeaders() + (tile * CompressedPositionTiles::NUM_HEADER_FLOATS);
+		const size_t numTileBodies = tiles.decompressTile(tile, decompressed.data());
+		for (size_t k = 0; k < numTileBodies; ++k) {
+			const size_t i = numDecompressedBodies + k;
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				ASSERT_NEAR(clusteredBodies.positions[(i * 3) + dimension], decompressed[(k * 4) + dimension],
+							(header[3] * std::exp2(-11.0f)) + 1e-6f);
+			}
+			ASSERT_NEAR(clusteredBodies.masses[i], decompressed[(k * 4) + 3],
+						clusteredBodies.masses[i] * std::exp2(-11.0f));
+		}
+		numDecompressedBodies += numTileBodies;
+	}
+	ASSERT_EQ(numBodies, numDecompressedBodies);
+}
+
+TEST(CompressedPositionTilesTest, MassesOfWideRangeShouldKeepTheirPrecision) {
+	// Preparation: the sun, the planets and Pluto in one tile, followed by masses down to 2^-29 of the largest one
+	std::vector<float> masses = {1.989e30f, 3.301e23f, 4.867e24f, 5.972e24f, 6.417e23f, 1.898e27f, 5.683e26f,
+								 8.681e25f, 1.024e26f, 1.303e22f};
+	std::mt19937 engine(36);
+	std::uniform_real_distribution<float> exponentDistribution(-29.0f, 0.0f);
+	while (masses.size() < CompressedPositionTiles::TILE_SIZE) {
+		masses.push_back(masses[0] * std::exp2(exponentDistribution(engine)));
+	}
+	const size_t numBodies = masses.size();
+	std::vector<float> positions(numBodies * 3, 1.0f), velocities(numBodies * 3, 0.0f);
+	CompressedPositionTiles tiles;
+	std::vector<float> decompressed(CompressedPositionTiles::TILE_SIZE * 4);
+
+	// Stimulation
+	tiles.compress({masses.data(), positions.data(), velocities.data()}, numBodies);
+	tiles.decompressTile(0, decompressed.data());
+
+	// Tests: the largest mass is exact, the relative error of each mass is at most half of the precision of a half
+	ASSERT_EQ(masses[0], decompressed[3]);
+	for (size_t i = 0; i < numBodies; ++i) {
+		ASSERT_NEAR(masses[i], decompressed[(i * 4) + 3], masses[i] * std::exp2(-11.0f)) << i;
+	}
+}
+
+TEST(CompressedPositionTilesTest, CompressedOpenMpShouldStayWithinErrorBoundsOfSequential) {
+	for (const bool reorder: {false, true}) {
+		// Preparation: the tiles are much smaller if the bodies are ordered along a space-filling curve
+		const size_t numBodies = 2'000;
+		TestBodies clusteredBodies = createClusteredBodies(numBodies);
+		const Bodies<float, float, float> bodies = clusteredBodies.asBodies();
+		if (reorder) {
+			BodyReordering(numBodies).reorder(bodies, numBodies);
+		}
+		std::vector<float> expected(numBodies * 3), actual(numBodies * 3);
+		IAccelerationCalculation *const pSequential =
+				createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL);
+		IAccelerationCalculation *const pOpenMp =
+				createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP);
+		ASSERT_TRUE(pOpenMp->isPositionCompressionSupported());
+		pOpenMp->setPositionCompressionEnabled(true);
+
+		// Stimulation
+		pSequential->calcAccelerations(bodies, numBodies, expected.data(), 0.01f);
+		pOpenMp->calcAccelerations(bodies, numBodies, actual.data(), 0.01f);
+
+		// Tests
+		const std::vector<double> relativeErrors = calcSortedRelativeErrors(expected, actual);
+		ASSERT_LT(relativeErrors[numBodies / 2], 1e-4);
+		ASSERT_LT(relativeErrors[(numBodies * 99) / 100], 5e-4);
+		ASSERT_LT(relativeErrors.back(), 5e-3);
+
+		// Clean up
+		delete pSequential;
+		delete pOpenMp;
+	}
+}
+
+TEST(CompressedPositionTilesTest, CompressedPotentialsShouldBeCalculatedFromExactPositions) {
+	// Preparation
+	const size_t numBodies = 1'000;
+	TestBodies clusteredBodies = createClusteredBodies(numBodies);
+	const Bodies<float, float, float> bodies = clusteredBodies.asBodies();
+	std::vector<float> expectedAccelerations(numBodies * 3), expectedPotentials(numBodies);
+	std::vector<float> actualAccelerations(numBodies * 3), actualPotentials(numBodies);
+	IAccelerationCalculation *const pExact =
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP);
+	IAccelerationCalculation *const pCompressed =
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP);
+	pCompressed->setPositionCompressionEnabled(true);
+
+	// Stimulation
+	pExact->calcAccelerationsAndPotentials(bodies, numBodies, expectedAccelerations.data(),
+										   expectedPotentials.data(), 0.01f);
+	pCompressed->calcAccelerationsAndPotentials(bodies, numBodies, actualAccelerations.data(),
+												actualPotentials.data(), 0.01f);
+
+	// Tests: the accelerations are compressed, while the potentials only differ by the order of the summation
+	const std::vector<double> relativeErrors = calcSortedRelativeErrors(expectedAccelerations, actualAccelerations);
+	ASSERT_GT(relativeErrors.back(), 0.0);
+	ASSERT_LT(relativeErrors[numBodies / 2], 1e-3);
+	for (size_t i = 0; i < numBodies; ++i) {
+		ASSERT_NEAR(expectedPotentials[i], actualPotentials[i], std::abs(expectedPotentials[i]) * 1e-5f) << i;
+	}
+
+	// Clean up
+	delete pExact;
+	delete pCompressed;
+}
+
+TEST(CompressedPositionTilesTest, CompressedTargetRangesShouldMatchTheWholeCalculation) {
+	// Preparation: the ranges do not start at the blocks of targets
+	const size_t numBodies = 1'000;
+	TestBodies clusteredBodies = createClusteredBodies(numBodies);
+	const Bodies<float, float, float> bodies = clusteredBodies.asBodies();
+	std::vector<float> expected(numBodies * 3), actual(numBodies * 3);
+	IAccelerationCalculation *const pCompressed =
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP);
+	pCompressed->setPositionCompressionEnabled(true);
+
+	// Stimulation
+	pCompressed->calcAccelerations(bodies, numBodies, expected.data(), 0.01f);
+	const size_t rangeEnds[] = {1, 70, 333, numBodies};
+	size_t rangeBegin = 0;
+	for (const size_t rangeEnd: rangeEnds) {
+		pCompressed->calcAccelerationsOfTargetRange(bodies, numBodies, rangeBegin, rangeEnd, actual.data(), 0.01f);
+		rangeBegin = rangeEnd;
+	}
+
+	// Tests: each target sums up the same tiles in the same order
+	ASSERT_EQ(expected, actual);
+
+	// Clean up
+	delete pCompressed;
+}
+
+TEST(CompressedPositionTilesTest, CompressionShouldNotBeCombinedWithTheDeterministicMode) {
+	IAccelerationCalculation *const pOpenMp =
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP);
+	pOpenMp->setPositionCompressionEnabled(true);
+	ASSERT_THROW(pOpenMp->setDeterministicModeEnabled(true), std::logic_error);
+	ASSERT_NO_THROW(pOpenMp->setDeterministicModeEnabled(false));
+	delete pOpenMp;
+}
+
+TEST(CompressedPositionTilesTest, UnsupportedCompressionShouldThrow) {
+	IAccelerationCalculation *const pSequential =
+			createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL);
+	ASSERT_FALSE(pSequential->isPositionCompressionSupported());
+	ASSERT_NO_THROW(pSequential->setPositionCompressionEnabled(false));
+	ASSERT_THROW(pSequential->setPositionCompressionEnabled(true), std::logic_error);
+	delete pSequential;
+}
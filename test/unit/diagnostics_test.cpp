@@ -0,0 +1,173 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/bodies_system.h"
+#include "physics/diagnostics.h"
+#include "physics/force_laws.h"
+#include "../../src/openmp_euler_position_velocity_calculation.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * Asserts that the force of the passed law is the negative gradient of its potential energy, i.e. that the
+	 * force towards the source body equals <code>dU/dr</code>. The target body has unit mass, so the result of the
+	 * force law is the force for all laws.
+	 */
+	template<typename TForceLaw>
+	void assertForceIsGradientOfPotential(const TForceLaw &forceLaw, const float squaredSofteningFactor) {
+		const float sourceMass = 1.7f;
+		const float step = 1e-3f;
+		for (float distance = 0.6f; distance < 3.0f; distance += 0.2f) {
+			const float potentialBefore = forceLaw.calcPotentialEnergy((distance - step) * (distance - step),
+																	   squaredSofteningFactor, 1.0f, sourceMass);
+			const float potentialAfter = forceLaw.calcPotentialEnergy((distance + step) * (distance + step),
+																	  squaredSofteningFactor, 1.0f, sourceMass);
+			const float derivative = (potentialAfter - potentialBefore) / (2.0f * step);
+			const float force = forceLaw(distance * distance, squaredSofteningFactor, 1.0f, sourceMass) * distance;
+			ASSERT_NEAR(derivative, force, 1e-2f * (1e-2f + std::abs(force))) << "distance: " << distance;
+		}
+	}
+}
+
+TEST(DiagnosticsTest, PotentialEnergyOfTwoBodiesShouldMatchNewton) {
+	// Preparation
+	const size_t numBodies = 2;
+	std::vector<float> masses{2.0f, 3.0f};
+	std::vector<float> positions{0.0f, 0.0f, 0.0f, 0.0f, 2.0f, 0.0f};
+	std::vector<float> velocities(numBodies * 3, 0.0f);
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	std::vector<float> accelerations(numBodies * 3, 0.0f), potentials(numBodies);
+
+	for (const AccelerationCalculationImplementation impl: {AccelerationCalculationImplementation::SEQUENTIAL,
+															AccelerationCalculationImplementation::OPEN_MP}) {
+		IAccelerationCalculation *const pAccelerationCalculation =
+				createAccelerationCalculation(impl, NewtonianForceLaw{1.0f});
+		std::fill(accelerations.begin(), accelerations.end(), 0.0f);
+
+		// Stimulation
+		ASSERT_TRUE(pAccelerationCalculation->isPotentialCalculationSupported());
+		pAccelerationCalculation->calcAccelerationsAndPotentials(bodies, numBodies, accelerations.data(),
+																 potentials.data(), 0.0f);
+
+		// Tests: U = -G * m1 * m2 / r and the accelerations are unchanged
+		ASSERT_FLOAT_EQ(-3.0f, potentials[0]);
+		ASSERT_FLOAT_EQ(-3.0f, potentials[1]);
+		ASSERT_DOUBLE_EQ(-3.0, calcTotalPotentialEnergy(potentials.data(), numBodies));
+		ASSERT_FLOAT_EQ(3.0f / 4.0f, accelerations[1]);
+		ASSERT_FLOAT_EQ(-2.0f / 4.0f, accelerations[4]);
+
+		// Clean up
+		delete pAccelerationCalculation;
+	}
+}
+
+TEST(DiagnosticsTest, MotionDiagnosticsShouldMatchDirectSums) {
+	// Preparation
+	const size_t numBodies = 10'000;
+	RandomBodiesParameters parameters;
+	parameters.seed = 5;
+	parameters.maxSpeed = 1.0f;
+	TestBodies randomBodies = TestBodies::createRandom(numBodies, parameters);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+
+	double kineticEnergy = 0.0, linearMomentum[3] = {0.0, 0.0, 0.0}, angularMomentum[3] = {0.0, 0.0, 0.0};
+	for (size_t i = 0; i < numBodies; ++i) {
+		const double m = bodies.masses[i];
+		const double r[3] = {bodies.positions[i * 3], bodies.positions[(i * 3) + 1], bodies.positions[(i * 3) + 2]};
+		const double v[3] = {bodies.velocities[i * 3], bodies.velocities[(i * 3) + 1],
+							 bodies.velocities[(i * 3) + 2]};
+		kineticEnergy += 0.5 * m * ((v[0] * v[0]) + (v[1] * v[1]) + (v[2] * v[2]));
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			linearMomentum[dimension] += m * v[dimension];
+		}
+		angularMomentum[0] += m * ((r[1] * v[2]) - (r[2] * v[1]));
+		angularMomentum[1] += m * ((r[2] * v[0]) - (r[0] * v[2]));
+		angularMomentum[2] += m * ((r[0] * v[1]) - (r[1] * v[0]));
+	}
+	Diagnostics diagnostics;
+
+	// Stimulation
+	calcMotionDiagnostics(bodies, numBodies, diagnostics);
+
+	// Tests
+	ASSERT_NEAR(kineticEnergy, diagnostics.kineticEnergy, 1e-9 * kineticEnergy);
+	for (size_t dimension = 0; dimension < 3; ++dimension) {
+		ASSERT_NEAR(linearMomentum[dimension], diagnostics.linearMomentum[dimension], 1e-9);
+		ASSERT_NEAR(angularMomentum[dimension], diagnostics.angularMomentum[dimension], 1e-9);
+	}
+}
+
+TEST(DiagnosticsTest, BodiesSystemShouldConserveEnergyAndMomentaOfCircularOrbit) {
+	// Preparation: two equal bodies on a circular orbit around their common center of mass
+	const size_t numBodies = 2;
+	std::vector<float> masses{1.0f, 1.0f};
+	std::vector<float> positions{-0.5f, 0.0f, 0.0f, 0.5f, 0.0f, 0.0f};
+	const float orbitalVelocity = std::sqrt(0.5f);
+	std::vector<float> velocities{0.0f, -orbitalVelocity, 0.0f, 0.0f, orbitalVelocity, 0.0f};
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	BodiesSystem bodiesSystem(bodies, numBodies, std::unique_ptr<IAccelerationCalculation>(
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP, NewtonianForceLaw{1.0f})),
+							  std::make_unique<OpenMpEulerPositionVelocityCalculationImpl>(), 0.0f);
+	bodiesSystem.setDiagnosticsEnabled(true);
+
+	// Stimulation
+	bodiesSystem.update(1e-3f);
+	const Diagnostics initial = bodiesSystem.getDiagnostics();
+	for (int step = 0; step < 5'000; ++step) {
+		bodiesSystem.update(1e-3f);
+	}
+	const Diagnostics &final = bodiesSystem.getDiagnostics();
+
+	// Tests: E = 2 * (m * v^2 / 2) - G * m * m / r = -0.5, L_z = 2 * m * r * v
+	ASSERT_NEAR(-0.5, initial.totalEnergy, 1e-6);
+	ASSERT_NEAR(2.0 * 0.5 * orbitalVelocity, initial.angularMomentum[2], 1e-6);
+	ASSERT_NEAR(initial.totalEnergy, final.totalEnergy, 1e-3);
+	ASSERT_NEAR(initial.angularMomentum[2], final.angularMomentum[2], 1e-4);
+	for (size_t dimension = 0; dimension < 3; ++dimension) {
+		ASSERT_NEAR(0.0, final.linearMomentum[dimension], 1e-5);
+	}
+}
+
+TEST(DiagnosticsTest, ForcesShouldBeNegativeGradientsOfPotentials) {
+	assertForceIsGradientOfPotential(NewtonianForceLaw{1.0f}, 0.01f);
+	assertForceIsGradientOfPotential(SplineSoftenedNewtonianForceLaw{1.0f}, 0.25f);
+	assertForceIsGradientOfPotential(CoulombForceLaw{1.0f}, 0.01f);
+	assertForceIsGradientOfPotential(CoulombForceLaw{1.0f, SofteningKernel::CUBIC_SPLINE}, 0.25f);
+	assertForceIsGradientOfPotential(YukawaForceLaw{1.0f, 2.0f}, 0.01f);
+	assertForceIsGradientOfPotential(LennardJonesForceLaw{0.1f, 0.5f}, 0.0f);
+}
+
+TEST(DiagnosticsTest, SequentialAndOpenMpPotentialsShouldAgree) {
+	// Preparation
+	const size_t numBodies = 300;
+	RandomBodiesParameters parameters;
+	parameters.seed = 7;
+	parameters.halfExtent = 4.0f;
+	TestBodies randomBodies = TestBodies::createRandom(numBodies, parameters);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	std::vector<float> accelerations(numBodies * 3, 0.0f), sequential(numBodies), openMp(numBodies);
+	IAccelerationCalculation *const pSequential =
+			createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL, YukawaForceLaw{1.0f, 2.0f});
+	IAccelerationCalculation *const pOpenMp =
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP, YukawaForceLaw{1.0f, 2.0f});
+
+	// Stimulation
+	pSequential->calcAccelerationsAndPotentials(bodies, numBodies, accelerations.data(), sequential.data(), 0.01f);
+	pOpenMp->calcAccelerationsAndPotentials(bodies, numBodies, accelerations.data(), openMp.data(), 0.01f);
+
+	// Tests
+	for (size_t i = 0; i < numBodies; ++i) {
+		ASSERT_NEAR(sequential[i], openMp[i], 1e-4f * (1.0f + std::abs(sequential[i])));
+	}
+
+	// Clean up
+	delete pSequential;
+	delete pOpenMp;
+}
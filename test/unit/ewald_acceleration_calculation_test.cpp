@@ -0,0 +1,208 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/periodic_box.h"
+#include "../../src/openmp_euler_position_velocity_calculation.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The Madelung constant of a simple cubic lattice of unit masses in a uniform neutralizing background, i.e. the
+	 * potential of a unit mass with its own images in a unit box.
+	 */
+	constexpr double WIGNER_LATTICE_CONSTANT = -2.837297479;
+
+	/**
+	 * Calculates the Coulomb accelerations of the passed charges by a summation over the images in spherical shells up
+	 * to the passed radius in box lengths, which converges to the Ewald sum for a neutral set of charges without a
+	 * dipole moment.
+	 */
+	std::vector<double> sumOverImages(const Bodies<float, float, float> &bodies, const size_t numBodies,
+									  const double edgeLength, const int maxImage) {
+		const int squaredMaxImage = maxImage * maxImage;
+		std::vector<double> accelerations(numBodies * 3, 0.0);
+		for (size_t i = 0; i < numBodies; ++i) {
+			for (size_t j = 0; j < numBodies; ++j) {
+				for (int nx = -maxImage; nx <= maxImage; ++nx) {
+					for (int ny = -maxImage; ny <= maxImage; ++ny) {
+						for (int nz = -maxImage; nz <= maxImage; ++nz) {
+							const double distanceVector[3] = {
+									bodies.positions[j * 3] + (nx * edgeLength) - bodies.positions[i * 3],
+									bodies.positions[(j * 3) + 1] + (ny * edgeLength) - bodies.positions[(i * 3) + 1],
+									bodies.positions[(j * 3) + 2] + (nz * edgeLength) - bodies.positions[(i * 3) + 2]
+							};
+							const double distanceSquared = (distanceVector[0] * distanceVector[0]) +
+														   (distanceVector[1] * distanceVector[1]) +
+														   (distanceVector[2] * distanceVector[2]);
+							const bool isInSphere = ((nx * nx) + (ny * ny) + (nz * nz)) <= squaredMaxImage;
+							if (isInSphere && (0.0 < distanceSquared)) {
+								// like charges repel each other
+								const double factor = -static_cast<double>(bodies.masses[i]) * bodies.masses[j] /
+													  (distanceSquared * std::sqrt(distanceSquared));
+								for (size_t dimension = 0; dimension < 3; ++dimension) {
+									accelerations[(i * 3) + dimension] += factor * distanceVector[dimension];
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+		return accelerations;
+	}
+}
+
+TEST(AccelerationCalculationTest, EwaldAccelerationCalculationShouldMatchSumOverImages) {
+	// Preparation
+	// Each charge has a partner of the same sign at the point reflection about the center of the box and each such
+	// pair has a partner pair of the opposite sign, so the charges are neutral and have no dipole moment.
+	const size_t numBodies = 16;
+	const float edgeLength = 2.0f;
+	std::vector<float> masses(numBodies);
+	std::vector<float> positions(numBodies * 3);
+	std::vector<float> velocities(numBodies * 3, 0.0f);
+	std::mt19937 generator(43);
+	std::uniform_real_distribution<float> distribution(-0.45f * edgeLength, 0.45f * edgeLength);
+	for (size_t i = 0; i < numBodies; i += 2) {
+		masses[i] = masses[i + 1] = ((i / 2) % 2 == 0) ? 1.0f : -1.0f;
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const float offset = distribution(generator);
+			positions[(i * 3) + dimension] = (0.5f * edgeLength) + offset;
+			positions[((i + 1) * 3) + dimension] = (0.5f * edgeLength) - offset;
+		}
+	}
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	CoulombForceLaw forceLaw;
+	forceLaw.coulombConstant = 1.0f;
+	const std::unique_ptr<IAccelerationCalculation> pEwald(createAccelerationCalculation(
+			AccelerationCalculationImplementation::EWALD, forceLaw, PeriodicBox{edgeLength}));
+	std::vector<float> accelerations(numBodies * 3);
+
+	// Stimulation
+	pEwald->calcAccelerations(bodies, numBodies, accelerations.data(), 0.0f);
+	const std::vector<double> expected = sumOverImages(bodies, numBodies, edgeLength, 12);
+
+	// Tests
+	// The tolerance is the accuracy of the correction table, relative to the typical acceleration.
+	const double typicalAcceleration = 1.0 / (edgeLength * edgeLength);
+	for (size_t i = 0; i < numBodies * 3; ++i) {
+		ASSERT_NEAR(expected[i], accelerations[i], 2e-3 * typicalAcceleration) << "at " << i;
+	}
+}
+
+TEST(AccelerationCalculationTest, EwaldSelfPotentialShouldMatchMadelungConstant) {
+	// Preparation
+	const float edgeLength = 4.0f;
+	float mass = 3.0f;
+	float position[3] = {1.0f, 2.0f, 3.0f};
+	float velocity[3] = {0.0f, 0.0f, 0.0f};
+	const Bodies<float, float, float> bodies{&mass, position, velocity};
+	NewtonianForceLaw forceLaw;
+	forceLaw.gravitationalConstant = 1.0f;
+	const std::unique_ptr<IAccelerationCalculation> pEwald(createAccelerationCalculation(
+			AccelerationCalculationImplementation::EWALD, forceLaw, PeriodicBox{edgeLength}));
+	float acceleration[3];
+	float potential;
+
+	// Stimulation
+	pEwald->calcAccelerationsAndPotentials(bodies, 1, acceleration, &potential, 0.0f);
+
+	// Tests
+	// A single body is at rest in the lattice of its images and its potential is the one of a Wigner crystal.
+	ASSERT_FLOAT_EQ(0.0f, acceleration[0]);
+	ASSERT_FLOAT_EQ(0.0f, acceleration[1]);
+	ASSERT_FLOAT_EQ(0.0f, acceleration[2]);
+	ASSERT_NEAR(-mass * mass * WIGNER_LATTICE_CONSTANT / edgeLength, potential, 1e-4);
+}
+
+TEST(AccelerationCalculationTest, EwaldAccelerationCalculationShouldBePeriodic) {
+	// Preparation
+	const size_t numBodies = 200;
+	const PeriodicBox periodicBox{10.0f};
+	std::vector<float> masses(numBodies);
+	std::vector<float> positions(numBodies * 3);
+	std::vector<float> shiftedPositions(numBodies * 3);
+	std::vector<float> velocities(numBodies * 3, 0.0f);
+	std::mt19937 generator(7);
+	std::uniform_real_distribution<float> massDistribution(0.5f, 2.0f);
+	std::uniform_real_distribution<float> positionDistribution(0.0f, periodicBox.edgeLength);
+	for (size_t i = 0; i < numBodies; ++i) {
+		masses[i] = massDistribution(generator);
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			positions[(i * 3) + dimension] = positionDistribution(generator);
+			// a translation by a whole box length to other images
+			shiftedPositions[(i * 3) + dimension] = positions[(i * 3) + dimension] +
+													(static_cast<float>((i + dimension) % 3) - 1.0f) *
+													periodicBox.edgeLength;
+		}
+	}
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	const Bodies<float, float, float> shiftedBodies{masses.data(), shiftedPositions.data(), velocities.data()};
+	NewtonianForceLaw forceLaw;
+	forceLaw.gravitationalConstant = 1.0f;
+	const std::unique_ptr<IAccelerationCalculation> pEwald(
+			createAccelerationCalculation(AccelerationCalculationImplementation::EWALD, forceLaw, periodicBox));
+	std::vector<float> accelerations(numBodies * 3);
+	std::vector<float> shiftedAccelerations(numBodies * 3);
+
+	// Stimulation
+	pEwald->calcAccelerations(bodies, numBodies, accelerations.data(), 0.01f);
+	pEwald->calcAccelerations(shiftedBodies, numBodies, shiftedAccelerations.data(), 0.01f);
+
+	// Tests
+	// The images are equivalent and the total momentum is conserved, since the correction is antisymmetric.
+	double totalForce[3] = {0.0, 0.0, 0.0};
+	double totalForceMagnitude = 0.0;
+	for (size_t i = 0; i < numBodies; ++i) {
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const float acceleration = accelerations[(i * 3) + dimension];
+			ASSERT_NEAR(acceleration, shiftedAccelerations[(i * 3) + dimension],
+						1e-4f * (1.0f + std::abs(acceleration)));
+			totalForce[dimension] += masses[i] * static_cast<double>(acceleration);
+			totalForceMagnitude += masses[i] * std::abs(static_cast<double>(acceleration));
+		}
+	}
+	for (const double force: totalForce) {
+		ASSERT_NEAR(0.0, force, 1e-5 * totalForceMagnitude);
+	}
+}
+
+TEST(AccelerationCalculationTest, EwaldAccelerationCalculationShouldNeedPeriodicBoxAndLongRangeForceLaw) {
+	ASSERT_THROW(createAccelerationCalculation(AccelerationCalculationImplementation::EWALD), std::invalid_argument);
+	ASSERT_THROW(createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP, NewtonianForceLaw(),
+											   PeriodicBox{1.0f}), std::invalid_argument);
+	ASSERT_THROW(createAccelerationCalculation(AccelerationCalculationImplementation::EWALD, LennardJonesForceLaw(),
+											   PeriodicBox{1.0f}), std::invalid_argument);
+	ASSERT_THROW(createAccelerationCalculation(AccelerationCalculationImplementation::EWALD, NewtonianForceLaw(),
+											   PeriodicBox{0.0f}), std::invalid_argument);
+}
+
+TEST(PositionVelocityCalculationTest, PeriodicEulerShouldWrapPositionsIntoBox) {
+	// Preparation
+	const PeriodicBox periodicBox{2.0f};
+	float masses[2] = {1.0f, 1.0f};
+	float positions[6] = {1.95f, 1.0f, 0.05f, 0.5f, 0.5f, 0.5f};
+	float velocities[6] = {1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f};
+	const Bodies<float, float, float> bodies{masses, positions, velocities};
+	const float accelerations[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+	OpenMpEulerPositionVelocityCalculationImpl positionVelocityCalculation(periodicBox);
+
+	// Stimulation
+	positionVelocityCalculation.updatePositionAndVelocity(bodies, 2, accelerations, 0.1f);
+
+	// Tests
+	// The first body leaves the box through two faces and enters it through the opposite ones.
+	ASSERT_NEAR(0.05f, positions[0], 1e-6f);
+	ASSERT_NEAR(1.0f, positions[1], 1e-6f);
+	ASSERT_NEAR(1.95f, positions[2], 1e-6f);
+	ASSERT_FLOAT_EQ(0.5f, positions[3]);
+	ASSERT_FLOAT_EQ(1.0f, velocities[0]);
+	ASSERT_FLOAT_EQ(-1.0f, velocities[2]);
+}
@@ -0,0 +1,184 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/force_laws.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	template<typename TForceLaw>
+	void assertSequentialAndOpenMpAgree(const TForceLaw &forceLaw) {
+		const size_t numBodies = 200;
+		const float squaredSofteningFactor = 0.01f;
+		// random bodies with positive masses (resp. charges), which are reused for all force laws
+		RandomBodiesParameters parameters;
+		parameters.seed = 11;
+		parameters.halfExtent = 4.0f;
+		TestBodies randomBodies = TestBodies::createRandom(numBodies, parameters);
+		const Bodies<float, float, float> bodies = randomBodies.asBodies();
+		std::vector<float> sequential(numBodies * 3, 0.0f), openMp(numBodies * 3, 0.0f);
+
+		IAccelerationCalculation *const pSequential =
+				createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL, forceLaw);
+		IAccelerationCalculation *const pOpenMp =
+				createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP, forceLaw);
+		pSequential->calcAccelerations(bodies, numBodies, sequential.data(), squaredSofteningFactor);
+		pOpenMp->calcAccelerations(bodies, numBodies, openMp.data(), squaredSofteningFactor);
+
+		for (size_t i = 0; i < (numBodies * 3); ++i) {
+			ASSERT_NEAR(sequential[i], openMp[i], 1e-4f * (1.0f + std::abs(sequential[i])));
+		}
+
+		delete pSequential;
+		delete pOpenMp;
+	}
+}
+
+TEST(ForceLawsTest, NewtonianForceLawShouldAttract) {
+	// Preparation
+	const size_t numBodies = 2;
+	std::vector<float> masses{2.0f, 3.0f}, positions{0.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f}, velocities(6, 0.0f);
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	std::vector<float> accelerations(numBodies * 3, 0.0f);
+	const NewtonianForceLaw forceLaw{1.0f};
+	IAccelerationCalculation *const pAccelerationCalculation =
+			createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL, forceLaw);
+
+	// Stimulation
+	pAccelerationCalculation->calcAccelerations(bodies, numBodies, accelerations.data(), 0.0f);
+
+	// Tests: a = G * m / r^2 towards the other body
+	ASSERT_FLOAT_EQ(3.0f / 4.0f, accelerations[0]);
+	ASSERT_FLOAT_EQ(-2.0f / 4.0f, accelerations[3]);
+	ASSERT_FLOAT_EQ(0.0f, accelerations[1]);
+	ASSERT_FLOAT_EQ(0.0f, accelerations[4]);
+
+	// Clean up
+	delete pAccelerationCalculation;
+}
+
+TEST(ForceLawsTest, SplineSoftenedNewtonianForceLawShouldBeNewtonianBeyondSplineLength) {
+	// Preparation
+	const SplineSoftenedNewtonianForceLaw splineSoftened{1.0f};
+	const float squaredSofteningFactor = 0.25f;
+	const float splineLength = 2.8f * 0.5f;
+
+	// Tests: exactly Newtonian beyond the spline length, continuous at the ends of the polynomials and finite at zero
+	ASSERT_FLOAT_EQ(1.0f / (8.0f * 8.0f * 8.0f), splineSoftened.calcDistanceFactor(64.0f, squaredSofteningFactor));
+	const float inverseSplineLength = 1.0f / splineLength;
+	ASSERT_NEAR(inverseSplineLength * inverseSplineLength * inverseSplineLength,
+				splineSoftened.calcDistanceFactor(splineLength * splineLength * 0.9999f, squaredSofteningFactor),
+				1e-3f);
+	const float halfSplineLength = 0.5f * splineLength;
+	ASSERT_NEAR(splineSoftened.calcDistanceFactor(halfSplineLength * halfSplineLength * 0.9999f,
+												  squaredSofteningFactor),
+				splineSoftened.calcDistanceFactor(halfSplineLength * halfSplineLength * 1.0001f,
+												  squaredSofteningFactor),
+				1e-3f);
+	ASSERT_TRUE(std::isfinite(splineSoftened.calcDistanceFactor(0.0f, squaredSofteningFactor)));
+}
+
+TEST(ForceLawsTest, SofteningKernelsShouldMatchPublishedFormulations) {
+	// Preparation
+	const NewtonianForceLaw unsoftened{1.0f, SofteningKernel::NONE};
+	const NewtonianForceLaw plummerSoftened{1.0f, SofteningKernel::PLUMMER};
+	const NewtonianForceLaw splineSoftened{1.0f, SofteningKernel::CUBIC_SPLINE};
+	const float squaredSofteningFactor = 0.25f;
+
+	// Tests
+	// no softening ignores the softening factor
+	ASSERT_FLOAT_EQ(1.0f / 8.0f, unsoftened.calcDistanceFactor(4.0f, squaredSofteningFactor));
+	ASSERT_FLOAT_EQ(-0.5f, unsoftened.calcPotentialEnergy(4.0f, squaredSofteningFactor, 1.0f, 1.0f));
+	// the Plummer softening is the default, (r^2 + eps^2)^(-3/2) and -(r^2 + eps^2)^(-1/2)
+	ASSERT_FLOAT_EQ(1.0f / std::pow(4.25f, 1.5f), plummerSoftened.calcDistanceFactor(4.0f, squaredSofteningFactor));
+	ASSERT_FLOAT_EQ(-1.0f / std::sqrt(4.25f),
+					plummerSoftened.calcPotentialEnergy(4.0f, squaredSofteningFactor, 1.0f, 1.0f));
+	ASSERT_FLOAT_EQ(NewtonianForceLaw{1.0f}.calcDistanceFactor(4.0f, squaredSofteningFactor),
+					plummerSoftened.calcDistanceFactor(4.0f, squaredSofteningFactor));
+	// the spline softening is the one of the spline softened force law and has the same potential minimum -1 / eps
+	for (const float distanceSquared: {0.0f, 0.1f, 0.5f, 1.0f, 4.0f}) {
+		ASSERT_EQ(SplineSoftenedNewtonianForceLaw{1.0f}.calcDistanceFactor(distanceSquared, squaredSofteningFactor),
+				  splineSoftened.calcDistanceFactor(distanceSquared, squaredSofteningFactor));
+	}
+	ASSERT_NEAR(-2.0f, splineSoftened.calcPotentialEnergy(0.0f, squaredSofteningFactor, 1.0f, 1.0f), 1e-5f);
+	ASSERT_NEAR(-2.0f, plummerSoftened.calcPotentialEnergy(0.0f, squaredSofteningFactor, 1.0f, 1.0f), 1e-5f);
+}
+
+TEST(ForceLawsTest, CoulombForceLawShouldRepelLikeCharges) {
+	// Preparation
+	const CoulombForceLaw forceLaw{1.0f};
+
+	// Tests
+	ASSERT_FLOAT_EQ(-2.0f / 8.0f, forceLaw(4.0f, 0.0f, 1.0f, 2.0f));
+	ASSERT_FLOAT_EQ(2.0f / 8.0f, forceLaw(4.0f, 0.0f, -1.0f, 2.0f));
+}
+
+TEST(ForceLawsTest, YukawaForceLawShouldApproachCoulombForLargeScreeningLength) {
+	// Preparation
+	const CoulombForceLaw coulomb{1.0f};
+	const YukawaForceLaw weaklyScreened{1.0f, 1e6f};
+	const YukawaForceLaw stronglyScreened{1.0f, 0.5f};
+
+	// Tests
+	ASSERT_NEAR(coulomb(4.0f, 0.0f, 1.0f, 1.0f), weaklyScreened(4.0f, 0.0f, 1.0f, 1.0f), 1e-5f);
+	// exp(-4) * (1 + 4) of the Coulomb force at r = 2 and lambda = 0.5
+	ASSERT_NEAR(coulomb(4.0f, 0.0f, 1.0f, 1.0f) * std::exp(-4.0f) * 5.0f, stronglyScreened(4.0f, 0.0f, 1.0f, 1.0f),
+				1e-6f);
+}
+
+TEST(ForceLawsTest, LennardJonesForceLawShouldVanishAtPotentialMinimum) {
+	// Preparation
+	const LennardJonesForceLaw forceLaw{1.0f, 1.0f};
+	const float minimumDistance = std::pow(2.0f, 1.0f / 6.0f);
+
+	// Tests: repulsive inside, attractive outside of the minimum of the potential
+	ASSERT_NEAR(0.0f, forceLaw(minimumDistance * minimumDistance, 0.0f, 1.0f, 1.0f), 1e-5f);
+	ASSERT_GT(0.0f, forceLaw(0.9f * 0.9f, 0.0f, 1.0f, 1.0f));
+	ASSERT_LT(0.0f, forceLaw(1.5f * 1.5f, 0.0f, 1.0f, 1.0f));
+	// the force is divided by the target mass
+	ASSERT_FLOAT_EQ(0.5f * forceLaw(2.0f, 0.0f, 1.0f, 1.0f), forceLaw(2.0f, 0.0f, 2.0f, 7.0f));
+}
+
+TEST(ForceLawsTest, SequentialAndOpenMpShouldAgreeForAllForceLaws) {
+	assertSequentialAndOpenMpAgree(NewtonianForceLaw{1.0f});
+	assertSequentialAndOpenMpAgree(SplineSoftenedNewtonianForceLaw{1.0f});
+	assertSequentialAndOpenMpAgree(NewtonianForceLaw{1.0f, SofteningKernel::CUBIC_SPLINE});
+	assertSequentialAndOpenMpAgree(CoulombForceLaw{1.0f});
+	assertSequentialAndOpenMpAgree(YukawaForceLaw{1.0f, 2.0f});
+	assertSequentialAndOpenMpAgree(LennardJonesForceLaw{0.1f, 0.5f});
+}
+
+TEST(ForceLawsTest, OpenClSourceShouldDefineForceLawMacros) {
+	// Stimulation
+	const std::string source = YukawaForceLaw{2.0f, 0.5f}.createOpenClSource();
+
+	// Tests: the definition is shared with C++ and the parameters are baked into the macros
+	ASSERT_NE(std::string::npos, source.find("float calcYukawaDistanceFactor("));
+	ASSERT_NE(std::string::npos, source.find("#define FORCE_LAW_DISTANCE_FACTOR(distanceSquared, squaredSofteningFactor)"));
+	ASSERT_NE(std::string::npos, source.find("#define FORCE_LAW_STRENGTH_FACTOR(targetMass, sourceMass)"));
+	ASSERT_NE(std::string::npos, source.find(forcelaws::toOpenClFloatLiteral(2.0f)));
+	ASSERT_EQ(std::string::npos, source.find("PHYSICS_"));
+}
+
+TEST(ForceLawsTest, OpenClSourceShouldSelectSofteningKernel) {
+	// Stimulation
+	const std::string source = CoulombForceLaw{1.0f, SofteningKernel::CUBIC_SPLINE}.createOpenClSource();
+
+	// Tests: the softening kernels are shared and the selected one is baked into the macro of the distance factor
+	ASSERT_NE(std::string::npos, source.find("float calcSoftenedInverseCubedDistance("));
+	ASSERT_NE(std::string::npos, source.find("calcCoulombDistanceFactor((distanceSquared), (squaredSofteningFactor), 2)"));
+	ASSERT_EQ(std::string::npos, source.find("PHYSICS_"));
+}
+
+TEST(ForceLawsTest, TreePmShouldRejectNonNewtonianForceLaws) {
+	ASSERT_THROW(
+			createAccelerationCalculation(AccelerationCalculationImplementation::TREE_PM, CoulombForceLaw()),
+			std::invalid_argument
+	);
+}
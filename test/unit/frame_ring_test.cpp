@@ -0,0 +1,143 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/frame_ring.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Sets all coordinates of the passed bodies to the same value, so a frame which mixes two states is
+	 * detected.
+	 */
+	void setAllCoordinates(TestBodies &testBodies, const float value) {
+		std::fill(testBodies.positions.begin(), testBodies.positions.end(), value);
+		std::fill(testBodies.velocities.begin(), testBodies.velocities.end(), value);
+	}
+}
+
+TEST(FrameRingTest, LatestFrameShouldHoldPublishedState) {
+	// Preparation
+	const size_t numBodies = 4;
+	TestBodies uniformBodies(numBodies);
+	const BodyReordering bodyReordering(numBodies);
+	FrameRing frameRing(4);
+	ASSERT_FALSE(frameRing.acquireLatest().isValid());
+
+	// Stimulation
+	setAllCoordinates(uniformBodies, 1.0f);
+	ASSERT_TRUE(frameRing.publish(uniformBodies.asBodies(), numBodies, bodyReordering));
+	setAllCoordinates(uniformBodies, 2.0f);
+	ASSERT_TRUE(frameRing.publish(uniformBodies.asBodies(), numBodies, bodyReordering));
+	const FrameRing::Frame frame = frameRing.acquireLatest();
+
+	// Tests
+	ASSERT_TRUE(frame.isValid());
+	ASSERT_EQ(2u, frame.getSequenceNumber());
+	ASSERT_EQ(numBodies, frame.getSnapshot().getNumBodies());
+	ASSERT_EQ(uniformBodies.positions, std::vector<float>(frame.getSnapshot().getPositions(),
+														  frame.getSnapshot().getPositions() + (numBodies * 3)));
+	ASSERT_EQ(numBodies - 1, frame.getSnapshot().getOriginalId(numBodies - 1));
+}
+
+TEST(FrameRingTest, HeldFramesShouldBeSkippedInsteadOfOverwritten) {
+	// Preparation
+	const size_t numBodies = 2;
+	TestBodies uniformBodies(numBodies);
+	const BodyReordering bodyReordering(numBodies);
+	FrameRing frameRing(3);
+	std::vector<FrameRing::Frame> heldFrames;
+
+	// Stimulation: the observers hold the first three frames
+	for (int i = 1; i <= 3; ++i) {
+		setAllCoordinates(uniformBodies, static_cast<float>(i));
+		ASSERT_TRUE(frameRing.publish(uniformBodies.asBodies(), numBodies, bodyReordering));
+		heldFrames.push_back(frameRing.acquireLatest());
+	}
+	setAllCoordinates(uniformBodies, 4.0f);
+	const bool isFourthFramePublished = frameRing.publish(uniformBodies.asBodies(), numBodies, bodyReordering);
+
+	// Tests: the fourth frame is skipped and the held frames are intact
+	ASSERT_FALSE(isFourthFramePublished);
+	ASSERT_EQ(1u, frameRing.getNumDroppedFrames());
+	for (size_t i = 0; i < heldFrames.size(); ++i) {
+		ASSERT_EQ(i + 1, heldFrames[i].getSequenceNumber());
+		ASSERT_EQ(static_cast<float>(i + 1), heldFrames[i].getSnapshot().getPositions()[0]);
+	}
+	ASSERT_EQ(3u, frameRing.acquireLatest().getSequenceNumber());
+
+	// Tests: a released frame is reused, the skipped frame leaves a gap in the sequence numbers
+	heldFrames.erase(heldFrames.begin());
+	setAllCoordinates(uniformBodies, 5.0f);
+	ASSERT_TRUE(frameRing.publish(uniformBodies.asBodies(), numBodies, bodyReordering));
+	const FrameRing::Frame frame = frameRing.acquireLatest();
+	ASSERT_EQ(5u, frame.getSequenceNumber());
+	ASSERT_EQ(5.0f, frame.getSnapshot().getVelocities()[0]);
+	ASSERT_EQ(2.0f, heldFrames[0].getSnapshot().getPositions()[0]);
+}
+
+TEST(FrameRingTest, ConcurrentObserversShouldReadConsistentFrames) {
+	// Preparation
+	const size_t numBodies = 256;
+	const int numFrames = 2'000;
+	const int numObservers = 3;
+	TestBodies uniformBodies(numBodies);
+	const BodyReordering bodyReordering(numBodies);
+	FrameRing frameRing(numObservers + 2);
+	std::atomic<bool> isFinished{false};
+	std::atomic<int> numInconsistentFrames{0};
+	std::atomic<int> numOutOfOrderFrames{0};
+
+	// Stimulation: the observers read the latest frames, while the producer publishes
+	std::vector<std::thread> observers;
+	for (int observer = 0; observer < numObservers; ++observer) {
+		observers.emplace_back([&frameRing, &isFinished, &numInconsistentFrames, &numOutOfOrderFrames]() {
+			uint64_t lastSequenceNumber = 0;
+			while (!isFinished) {
+				const FrameRing::Frame frame = frameRing.acquireLatest();
+				if (!frame.isValid()) {
+					continue;
+				}
+				if (frame.getSequenceNumber() < lastSequenceNumber) {
+					++numOutOfOrderFrames;
+				}
+				lastSequenceNumber = frame.getSequenceNumber();
+				// each frame has the value of its sequence number in all coordinates
+				const BodiesSnapshot &snapshot = frame.getSnapshot();
+				const auto expectedValue = static_cast<float>(frame.getSequenceNumber());
+				for (size_t i = 0; i < (snapshot.getNumBodies() * 3); ++i) {
+					if ((expectedValue != snapshot.getPositions()[i]) ||
+						(expectedValue != snapshot.getVelocities()[i])) {
+						++numInconsistentFrames;
+						break;
+					}
+				}
+			}
+		});
+	}
+	for (int i = 1; i <= numFrames; ++i) {
+		setAllCoordinates(uniformBodies, static_cast<float>(i));
+		frameRing.publish(uniformBodies.asBodies(), numBodies, bodyReordering);
+	}
+	isFinished = true;
+	for (std::thread &observer: observers) {
+		observer.join();
+	}
+
+	// Tests: each observer holds at most one frame, so the producer never skips a frame
+	ASSERT_EQ(0, numInconsistentFrames);
+	ASSERT_EQ(0, numOutOfOrderFrames);
+	ASSERT_EQ(0u, frameRing.getNumDroppedFrames());
+	ASSERT_EQ(static_cast<uint64_t>(numFrames), frameRing.acquireLatest().getSequenceNumber());
+}
+
+TEST(FrameRingTest, RingShouldNeedTwoSlots) {
+	ASSERT_THROW(FrameRing(1), std::invalid_argument);
+}
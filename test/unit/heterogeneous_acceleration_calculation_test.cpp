@@ -0,0 +1,102 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "../../src/heterogeneous_acceleration_calculation.h"
+#include "../../src/openmp_acceleration_calculation.h"
+#include "../../src/sequential_acceleration_calculation.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * A fake calculation whose duration is proportional to the number of target bodies, so the split of the
+	 * heterogeneous calculation can be tested independently of the hardware.
+	 */
+	class SleepingAccelerationCalculation : public IAccelerationCalculation {
+
+		private:
+			std::chrono::microseconds durationPerTarget_;
+
+		public:
+			explicit SleepingAccelerationCalculation(const std::chrono::microseconds durationPerTarget) :
+					durationPerTarget_(durationPerTarget) {
+			}
+
+			void calcAccelerations(const Bodies<float, float, float> &bodies, const size_t numBodies,
+								   float *const accelerations, const float squaredSofteningFactor) override {
+				calcAccelerationsOfTargetRange(bodies, numBodies, 0, numBodies, accelerations, squaredSofteningFactor);
+			}
+
+			[[nodiscard]] bool isTargetRangeSupported() const override {
+				return true;
+			}
+
+			void calcAccelerationsOfTargetRange(const Bodies<float, float, float> &, size_t, const size_t targetBegin,
+												const size_t targetEnd, float *const accelerations,
+												float) override {
+				std::fill(accelerations + (targetBegin * 3), accelerations + (targetEnd * 3), 0.0f);
+				std::this_thread::sleep_for(durationPerTarget_ * static_cast<long>(targetEnd - targetBegin));
+			}
+	};
+}
+
+TEST(AccelerationCalculationTest, HeterogeneousAccelerationCalculationShouldMatchOpenMp) {
+	// Preparation
+	const size_t numBodies = 1'001;
+	RandomBodiesParameters parameters;
+	parameters.seed = 23;
+	TestBodies randomBodies = TestBodies::createRandom(numBodies, parameters);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	std::vector<float> expected(numBodies * 3), actual(numBodies * 3, 1.0f);
+	OpenMpAccelerationCalculationImpl openMp;
+	HeterogeneousAccelerationCalculationImpl heterogeneous(std::make_unique<OpenMpAccelerationCalculationImpl>(),
+														   std::make_unique<OpenMpAccelerationCalculationImpl>(),
+														   0.3f);
+
+	// Stimulation
+	openMp.calcAccelerations(bodies, numBodies, expected.data(), 0.01f);
+	heterogeneous.calcAccelerations(bodies, numBodies, actual.data(), 0.01f);
+
+	// Tests: each target body is calculated by the same loop as before
+	ASSERT_EQ(expected, actual);
+	ASSERT_LT(0.0, heterogeneous.getLastHostDuration());
+	ASSERT_LT(0.0, heterogeneous.getLastDeviceDuration());
+}
+
+TEST(AccelerationCalculationTest, HeterogeneousSplitShouldAdaptToTheRates) {
+	// Preparation: the device is three times slower than the host, so it should get a quarter of the bodies
+	const size_t numBodies = 4'000;
+	std::vector<float> masses(numBodies, 1.0f), positions(numBodies * 3, 0.0f), velocities(numBodies * 3, 0.0f);
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	std::vector<float> accelerations(numBodies * 3);
+	HeterogeneousAccelerationCalculationImpl heterogeneous(
+			std::make_unique<SleepingAccelerationCalculation>(std::chrono::microseconds(1)),
+			std::make_unique<SleepingAccelerationCalculation>(std::chrono::microseconds(3)));
+
+	// Stimulation
+	for (int step = 0; step < 15; ++step) {
+		heterogeneous.calcAccelerations(bodies, numBodies, accelerations.data(), 0.01f);
+	}
+
+	// Tests: the overhead of sleeping blurs the rates a little
+	ASSERT_NEAR(0.25f, heterogeneous.getDeviceShare(), 0.07f);
+}
+
+TEST(AccelerationCalculationTest, HeterogeneousCalculationShouldRejectInvalidWorkers) {
+	ASSERT_THROW(HeterogeneousAccelerationCalculationImpl(std::make_unique<OpenMpAccelerationCalculationImpl>(),
+														  nullptr), std::invalid_argument);
+	ASSERT_THROW(HeterogeneousAccelerationCalculationImpl(std::make_unique<OpenMpAccelerationCalculationImpl>(),
+														  std::make_unique<SequentialAccelerationCalculationImpl>()),
+				 std::invalid_argument);
+	ASSERT_THROW(HeterogeneousAccelerationCalculationImpl(std::make_unique<OpenMpAccelerationCalculationImpl>(),
+														  std::make_unique<OpenMpAccelerationCalculationImpl>(), 1.5f),
+				 std::invalid_argument);
+}
@@ -0,0 +1,210 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <omp.h>
+#include <gtest/gtest.h>
+
+#include "physics/initial_conditions.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * The storage of generated bodies.
+	 */
+	struct GeneratedBodies : TestBodies {
+		GeneratedBodies(const Scenario scenario, const size_t numBodies, const ScenarioParameters &parameters) :
+				TestBodies(createScenario(scenario, numBodies, parameters)) {
+		}
+
+		[[nodiscard]] double calcRadius(const size_t i) const {
+			return std::sqrt((static_cast<double>(positions[i * 3]) * positions[i * 3]) +
+							 (static_cast<double>(positions[(i * 3) + 1]) * positions[(i * 3) + 1]) +
+							 (static_cast<double>(positions[(i * 3) + 2]) * positions[(i * 3) + 2]));
+		}
+
+		/**
+		 * @brief Returns the virial ratio <code>2T / |W|</code> by a direct sum with <code>G = 1</code>, which is 1
+		 * in equilibrium.
+		 */
+		[[nodiscard]] double calcVirialRatio() const {
+			double kineticEnergy = 0.0;
+			double potentialEnergy = 0.0;
+			for (size_t i = 0; i < masses.size(); ++i) {
+				for (size_t dimension = 0; dimension < 3; ++dimension) {
+					const double velocity = velocities[(i * 3) + dimension];
+					kineticEnergy += 0.5 * masses[i] * velocity * velocity;
+				}
+				for (size_t j = i + 1; j < masses.size(); ++j) {
+					double squaredDistance = 0.0;
+					for (size_t dimension = 0; dimension < 3; ++dimension) {
+						const double difference = static_cast<double>(positions[(i * 3) + dimension]) -
+												  positions[(j * 3) + dimension];
+						squaredDistance += difference * difference;
+					}
+					potentialEnergy -= static_cast<double>(masses[i]) * masses[j] / std::sqrt(squaredDistance);
+				}
+			}
+			return 2.0 * kineticEnergy / -potentialEnergy;
+		}
+	};
+
+	/**
+	 * @brief Returns parameters with <code>G = 1</code>, so the velocities are of the order of 1.
+	 */
+	ScenarioParameters createParameters(const uint64_t seed) {
+		ScenarioParameters parameters;
+		parameters.seed = seed;
+		parameters.gravitationalConstant = 1.0f;
+		return parameters;
+	}
+
+	bool areBitIdentical(const std::vector<float> &expected, const std::vector<float> &actual) {
+		return (expected.size() == actual.size()) &&
+			   (0 == std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(float)));
+	}
+
+	const Scenario ALL_SCENARIOS[] = {Scenario::UNIFORM_SQUARE, Scenario::COLD_COLLAPSE, Scenario::PLUMMER_SPHERE,
+									  Scenario::HERNQUIST_SPHERE, Scenario::KING_SPHERE, Scenario::EXPONENTIAL_DISK,
+									  Scenario::HIERARCHICAL_CLUSTERS};
+}
+
+TEST(InitialConditionsTest, SameSeedShouldGenerateSameBodiesForAnyNumberOfThreads) {
+	const int numThreads = omp_get_max_threads();
+	for (const Scenario scenario: ALL_SCENARIOS) {
+		// Stimulation
+		omp_set_num_threads(1);
+		const GeneratedBodies sequentialBodies(scenario, 1'000, createParameters(7));
+		omp_set_num_threads(std::max(4, numThreads));
+		const GeneratedBodies parallelBodies(scenario, 1'000, createParameters(7));
+		const GeneratedBodies otherBodies(scenario, 1'000, createParameters(8));
+
+		// Tests
+		ASSERT_TRUE(areBitIdentical(sequentialBodies.masses, parallelBodies.masses));
+		ASSERT_TRUE(areBitIdentical(sequentialBodies.positions, parallelBodies.positions));
+		ASSERT_TRUE(areBitIdentical(sequentialBodies.velocities, parallelBodies.velocities));
+		ASSERT_FALSE(areBitIdentical(sequentialBodies.positions, otherBodies.positions));
+	}
+	omp_set_num_threads(numThreads);
+}
+
+TEST(InitialConditionsTest, SpheresShouldBeInEquilibrium) {
+	// Preparation
+	const size_t numBodies = 4'000;
+	const ScenarioParameters parameters = createParameters(49);
+
+	// Stimulation
+	const GeneratedBodies plummerSphere(Scenario::PLUMMER_SPHERE, numBodies, parameters);
+	const GeneratedBodies hernquistSphere(Scenario::HERNQUIST_SPHERE, numBodies, parameters);
+	const GeneratedBodies kingSphere(Scenario::KING_SPHERE, numBodies, parameters);
+	const GeneratedBodies coldCollapse(Scenario::COLD_COLLAPSE, numBodies, parameters);
+
+	// Tests: the Hernquist sphere is only approximately in equilibrium
+	ASSERT_NEAR(1.0, plummerSphere.calcVirialRatio(), 0.1);
+	ASSERT_NEAR(1.0, hernquistSphere.calcVirialRatio(), 0.2);
+	ASSERT_NEAR(1.0, kingSphere.calcVirialRatio(), 0.1);
+	ASSERT_EQ(0.0, coldCollapse.calcVirialRatio());
+}
+
+TEST(InitialConditionsTest, SpheresShouldHaveTheirProfiles) {
+	// Preparation
+	const size_t numBodies = 10'000;
+	const ScenarioParameters parameters = createParameters(50);
+	const GeneratedBodies plummerSphere(Scenario::PLUMMER_SPHERE, numBodies, parameters);
+	const GeneratedBodies hernquistSphere(Scenario::HERNQUIST_SPHERE, numBodies, parameters);
+	const GeneratedBodies kingSphere(Scenario::KING_SPHERE, numBodies, parameters);
+	const GeneratedBodies coldCollapse(Scenario::COLD_COLLAPSE, numBodies, parameters);
+	std::vector<double> plummerRadii, hernquistRadii, kingRadii, coldCollapseRadii;
+
+	// Stimulation
+	for (size_t i = 0; i < numBodies; ++i) {
+		plummerRadii.push_back(plummerSphere.calcRadius(i));
+		hernquistRadii.push_back(hernquistSphere.calcRadius(i));
+		kingRadii.push_back(kingSphere.calcRadius(i));
+		coldCollapseRadii.push_back(coldCollapse.calcRadius(i));
+	}
+	for (std::vector<double> *pRadii: {&plummerRadii, &hernquistRadii, &kingRadii, &coldCollapseRadii}) {
+		std::sort(pRadii->begin(), pRadii->end());
+	}
+
+	// Tests: the half-mass radii of the truncated profiles, and the tidal radius of the King sphere with W0 = 6
+	ASSERT_NEAR(1.0 / std::sqrt(std::pow(0.4995, -2.0 / 3.0) - 1.0), plummerRadii[numBodies / 2], 0.05);
+	ASSERT_NEAR(std::sqrt(0.475) / (1.0 - std::sqrt(0.475)), hernquistRadii[numBodies / 2], 0.1);
+	ASSERT_NEAR(std::cbrt(0.5), coldCollapseRadii[numBodies / 2], 0.02);
+	// the sphere is moved into its center-of-mass frame, which is slightly off the origin
+	ASSERT_LE(coldCollapseRadii.back(), 1.05);
+	ASSERT_LT(kingRadii.back(), 20.0);
+	ASSERT_GT(kingRadii.back(), 10.0);
+}
+
+TEST(InitialConditionsTest, DiskShouldRotateAroundCentralBody) {
+	// Preparation
+	const size_t numBodies = 1'000;
+	ScenarioParameters parameters = createParameters(51);
+	parameters.centralMass = 100.0f;
+
+	// Stimulation
+	const GeneratedBodies disk(Scenario::EXPONENTIAL_DISK, numBodies, parameters);
+
+	// Tests: the central body is the first one, the others move counterclockwise on nearly Keplerian orbits
+	ASSERT_EQ(100.0f, disk.masses[0]);
+	ASSERT_FLOAT_EQ(1.0f / (numBodies - 1), disk.masses[1]);
+	for (size_t i = 1; i < numBodies; ++i) {
+		const double x = disk.positions[i * 3] - disk.positions[0];
+		const double y = disk.positions[(i * 3) + 1] - disk.positions[1];
+		const double vx = disk.velocities[i * 3] - disk.velocities[0];
+		const double vy = disk.velocities[(i * 3) + 1] - disk.velocities[1];
+		const double radius = std::hypot(x, y);
+		ASSERT_GT((x * vy) - (y * vx), 0.0);
+		ASSERT_NEAR(0.0, ((x * vx) + (y * vy)) / radius, 1e-3);
+		ASSERT_NEAR(std::sqrt(100.0 / radius), std::hypot(vx, vy), 0.05 * std::sqrt(101.0 / radius));
+		ASSERT_LT(std::abs(disk.positions[(i * 3) + 2]), 10.0 * parameters.diskScaleHeightRatio);
+	}
+}
+
+TEST(InitialConditionsTest, BodiesShouldBeInCenterOfMassFrame) {
+	for (const Scenario scenario: ALL_SCENARIOS) {
+		// Stimulation
+		ScenarioParameters parameters = createParameters(52);
+		parameters.totalMass = 10.0f;
+		parameters.numClusters = 5;
+		const GeneratedBodies bodies(scenario, 999, parameters);
+
+		// Tests
+		double totalMass = 0.0;
+		double centerOfMass[3] = {0.0, 0.0, 0.0};
+		double linearMomentum[3] = {0.0, 0.0, 0.0};
+		for (size_t i = 0; i < bodies.masses.size(); ++i) {
+			totalMass += bodies.masses[i];
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				centerOfMass[dimension] += bodies.masses[i] * bodies.positions[(i * 3) + dimension];
+				linearMomentum[dimension] += bodies.masses[i] * bodies.velocities[(i * 3) + dimension];
+			}
+		}
+		ASSERT_NEAR(10.0, totalMass, 1e-3);
+		if (Scenario::UNIFORM_SQUARE != scenario) {
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				ASSERT_NEAR(0.0, centerOfMass[dimension] / totalMass, 1e-5);
+				ASSERT_NEAR(0.0, linearMomentum[dimension] / totalMass, 1e-5);
+			}
+		}
+	}
+}
+
+TEST(InitialConditionsTest, InvalidParametersShouldThrow) {
+	std::vector<float> masses(2), positions(6), velocities(6);
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	ScenarioParameters negativeMass;
+	negativeMass.totalMass = -1.0f;
+	ScenarioParameters flatKing;
+	flatKing.kingCentralPotential = 0.0f;
+	ScenarioParameters noClusters;
+	noClusters.numClusters = 0;
+	ASSERT_THROW(generateScenario(Scenario::PLUMMER_SPHERE, bodies, 2, negativeMass), std::invalid_argument);
+	ASSERT_THROW(generateScenario(Scenario::KING_SPHERE, bodies, 2, flatKing), std::invalid_argument);
+	ASSERT_THROW(generateScenario(Scenario::HIERARCHICAL_CLUSTERS, bodies, 2, noClusters), std::invalid_argument);
+}
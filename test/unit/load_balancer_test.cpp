@@ -0,0 +1,67 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../../src/load_balancer.h"
+
+using namespace physics;
+
+TEST(LoadBalancerTest, PartitionShouldCoverAllItemsInOrder) {
+	// Preparation
+	const LoadBalancer loadBalancer(std::vector<float>{1.0f, 2.0f, 1.0f});
+	std::vector<size_t> boundaries;
+
+	// Stimulation
+	loadBalancer.partition(1'001, boundaries);
+
+	// Tests
+	ASSERT_EQ((std::vector<size_t>{0, 250, 751, 1'001}), boundaries);
+	ASSERT_FLOAT_EQ(0.5f, loadBalancer.getShare(1));
+}
+
+TEST(LoadBalancerTest, SharesShouldConvergeToTheRatesOfTheWorkers) {
+	// Preparation: the workers process 1, 2 and 5 items per millisecond
+	const double rates[] = {1'000.0, 2'000.0, 5'000.0};
+	LoadBalancer loadBalancer(3);
+	std::vector<size_t> boundaries;
+	std::vector<double> durations(3);
+
+	// Stimulation
+	for (int step = 0; step < 20; ++step) {
+		loadBalancer.partition(80'000, boundaries);
+		for (size_t worker = 0; worker < 3; ++worker) {
+			durations[worker] = static_cast<double>(boundaries[worker + 1] - boundaries[worker]) / rates[worker];
+		}
+		loadBalancer.update(boundaries, durations);
+	}
+
+	// Tests: all workers finish at the same time
+	ASSERT_NEAR(1.0f / 8.0f, loadBalancer.getShare(0), 1e-4f);
+	ASSERT_NEAR(2.0f / 8.0f, loadBalancer.getShare(1), 1e-4f);
+	ASSERT_NEAR(5.0f / 8.0f, loadBalancer.getShare(2), 1e-4f);
+	ASSERT_DOUBLE_EQ(5'000.0, loadBalancer.getRate(2));
+}
+
+TEST(LoadBalancerTest, SlowWorkerShouldKeepTheMinimumShare) {
+	// Preparation
+	LoadBalancer loadBalancer(2);
+	std::vector<size_t> boundaries;
+
+	// Stimulation: the second worker is a million times slower
+	for (int step = 0; step < 30; ++step) {
+		loadBalancer.partition(10'000, boundaries);
+		loadBalancer.update(boundaries, {static_cast<double>(boundaries[1]),
+										 1e6 * static_cast<double>(boundaries[2] - boundaries[1])});
+	}
+
+	// Tests
+	ASSERT_NEAR(LoadBalancer::MIN_SHARE, loadBalancer.getShare(1), 1e-4f);
+}
+
+TEST(LoadBalancerTest, InvalidSharesShouldThrow) {
+	ASSERT_THROW(LoadBalancer(0), std::invalid_argument);
+	ASSERT_THROW(LoadBalancer(std::vector<float>{}), std::invalid_argument);
+	ASSERT_THROW(LoadBalancer(std::vector<float>{0.5f, -0.1f}), std::invalid_argument);
+	ASSERT_THROW(LoadBalancer(std::vector<float>{0.0f, 0.0f}), std::invalid_argument);
+}
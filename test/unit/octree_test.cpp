@@ -0,0 +1,98 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../../src/octree.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Creates random bodies in a unit cube with random masses and velocities.
+	 */
+	TestBodies createMovingBodies(const size_t numBodies) {
+		RandomBodiesParameters parameters;
+		parameters.seed = 23;
+		parameters.maxSpeed = 1.0f;
+		return TestBodies::createRandom(numBodies, parameters);
+	}
+
+	/**
+	 * @brief Moves the passed bodies along their velocities.
+	 */
+	void move(TestBodies &testBodies, const float timeStep) {
+		for (size_t i = 0; i < testBodies.positions.size(); ++i) {
+			testBodies.positions[i] += testBodies.velocities[i] * timeStep;
+		}
+	}
+
+	/**
+	 * Asserts that the bounding box and the monopole moment of each node match its bodies.
+	 */
+	void assertNodesMatchBodies(const Octree &octree, const Bodies<float, float, float> &bodies) {
+		for (const OctreeNode &node: octree.getNodes()) {
+			double mass = 0.0, weightedPositionSum[3] = {0.0, 0.0, 0.0};
+			float boxMin[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+							   std::numeric_limits<float>::max()};
+			float boxMax[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+							   std::numeric_limits<float>::lowest()};
+			for (size_t k = node.firstBody; k < (node.firstBody + node.numBodies); ++k) {
+				const size_t i = octree.getBodyIndices()[k];
+				mass += bodies.masses[i];
+				for (size_t dimension = 0; dimension < 3; ++dimension) {
+					const float coordinate = bodies.positions[(i * 3) + dimension];
+					weightedPositionSum[dimension] += bodies.masses[i] * static_cast<double>(coordinate);
+					boxMin[dimension] = std::min(boxMin[dimension], coordinate);
+					boxMax[dimension] = std::max(boxMax[dimension], coordinate);
+				}
+			}
+			ASSERT_NEAR(mass, node.mass, 1e-4 * mass);
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				ASSERT_FLOAT_EQ(boxMin[dimension], node.boundingBoxMin[dimension]);
+				ASSERT_FLOAT_EQ(boxMax[dimension], node.boundingBoxMax[dimension]);
+				ASSERT_NEAR(weightedPositionSum[dimension] / mass, node.centerOfMass[dimension], 1e-5);
+			}
+		}
+	}
+}
+
+TEST(OctreeTest, RefitShouldMatchTheMovedBodies) {
+	// Preparation
+	const size_t numBodies = 20'000;
+	TestBodies randomBodies = createMovingBodies(numBodies);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	Octree octree;
+	octree.build(bodies, numBodies);
+	const size_t numNodes = octree.getNodes().size();
+
+	// Stimulation
+	move(randomBodies, 1e-3f);
+	randomBodies.masses[7] *= 2.0f;
+	const bool isRebuilt = octree.update(bodies, numBodies);
+
+	// Tests: the structure is kept, the boxes and moments follow the bodies
+	ASSERT_FALSE(isRebuilt);
+	ASSERT_EQ(numNodes, octree.getNodes().size());
+	assertNodesMatchBodies(octree, bodies);
+}
+
+TEST(OctreeTest, DegradedOrChangedOctreeShouldBeRebuilt) {
+	// Preparation
+	const size_t numBodies = 20'000;
+	TestBodies randomBodies = createMovingBodies(numBodies);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	Octree octree(8, 0.5f);
+	ASSERT_TRUE(octree.update(bodies, numBodies));
+
+	// Stimulation and tests: the bodies cross many leaves, so the leaves grow too much
+	move(randomBodies, 0.1f);
+	ASSERT_TRUE(octree.update(bodies, numBodies));
+	assertNodesMatchBodies(octree, bodies);
+
+	// Stimulation and tests: fewer bodies, e.g. after a merge
+	ASSERT_TRUE(octree.update(bodies, numBodies - 1));
+	ASSERT_EQ(numBodies - 1, octree.getNodes()[0].numBodies);
+}
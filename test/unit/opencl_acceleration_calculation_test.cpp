@@ -1,9 +1,15 @@
 // Reminder: Always include standard library and system headers before including your own headers.
 #include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "physics/acceleration_calculation_factory.h"
 #include "commons/math.h"
+#include "../../src/multi_device_opencl_acceleration_calculation.h"
+#include "../../src/openmp_acceleration_calculation.h"
+#include "test_bodies.h"
 
 namespace {
 	float calc3dVectorLength(const float *vector3d) {
@@ -183,4 +189,65 @@ TEST(AccelerationCalculationTest, OpenCLAccelerationCalculationTest) {
 		delete[] accelerations;
 		delete pAccelerationCalculation;
 	}
-}
\ No newline at end of file
+}
+
+TEST(AccelerationCalculationTest, MultiDeviceOpenCLAccelerationCalculationShouldMatchOpenMp) {
+	// Preparation: one CPU device of PoCL is split into sub-devices of one compute unit each
+	const size_t numBodies = 20'000;
+	RandomBodiesParameters parameters;
+	parameters.seed = 29;
+	TestBodies randomBodies = TestBodies::createRandom(numBodies, parameters);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	std::vector<float> expected(numBodies * 3), actual(numBodies * 3, 1.0f);
+	OpenMpAccelerationCalculationImpl openMp;
+	MultiDeviceOpenClAccelerationCalculationImpl multiDevice(NewtonianForceLaw(), 1);
+	ASSERT_LE(1, multiDevice.getNumDevices());
+
+	// Stimulation: the shares are balanced between the calculations
+	openMp.calcAccelerations(bodies, numBodies, expected.data(), 0.01f);
+	for (int step = 0; step < 3; ++step) {
+		multiDevice.calcAccelerations(bodies, numBodies, actual.data(), 0.01f);
+	}
+
+	// Tests: the summation order differs only by the batches of the sources
+	for (size_t i = 0; i < (numBodies * 3); ++i) {
+		ASSERT_NEAR(expected[i], actual[i], 1e-3f * (1.0f + std::abs(expected[i])));
+	}
+	float sumOfShares = 0.0f;
+	for (size_t device = 0; device < multiDevice.getNumDevices(); ++device) {
+		sumOfShares += multiDevice.getDeviceShare(device);
+	}
+	ASSERT_NEAR(1.0f, sumOfShares, 1e-5f);
+}
+
+TEST(AccelerationCalculationTest, CompressedOpenCLShouldFollowChangingNumbersOfBodiesAndSoftenings) {
+	// Preparation: the number of bodies grows and shrinks, so the buffers are reallocated and partly used
+	const size_t maxNumBodies = 3'000;
+	RandomBodiesParameters parameters;
+	parameters.seed = 36;
+	parameters.clusterStandardDeviation = 0.1f;
+	TestBodies randomBodies = TestBodies::createRandom(maxNumBodies, parameters);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	const std::unique_ptr<IAccelerationCalculation> pOpenMp(
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP));
+	const std::unique_ptr<IAccelerationCalculation> pOpenCl(
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_CL));
+	ASSERT_TRUE(pOpenCl->isPositionCompressionSupported());
+	pOpenMp->setPositionCompressionEnabled(true);
+	pOpenCl->setPositionCompressionEnabled(true);
+
+	for (const auto &[numBodies, squaredSofteningFactor]: {std::pair<size_t, float>(1'000, 0.01f),
+														   std::pair<size_t, float>(maxNumBodies, 0.1f),
+														   std::pair<size_t, float>(500, 1.0f)}) {
+		std::vector<float> expected(numBodies * 3), actual(numBodies * 3, 1.0f);
+
+		// Stimulation
+		pOpenMp->calcAccelerations(bodies, numBodies, expected.data(), squaredSofteningFactor);
+		pOpenCl->calcAccelerations(bodies, numBodies, actual.data(), squaredSofteningFactor);
+
+		// Tests: both decompress the same tiles, so they differ only by the order of the summation
+		for (size_t i = 0; i < (numBodies * 3); ++i) {
+			ASSERT_NEAR(expected[i], actual[i], 1e-3f * (1.0f + std::abs(expected[i]))) << numBodies << ", " << i;
+		}
+	}
+}
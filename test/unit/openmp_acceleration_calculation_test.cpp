@@ -1,9 +1,12 @@
 // Reminder: Always include standard library and system headers before including your own headers.
 #include <cmath>
+#include <memory>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "physics/acceleration_calculation_factory.h"
 #include "commons/math.h"
+#include "test_bodies.h"
 
 namespace {
 	float calc3dVectorLength(const float *vector3d) {
@@ -179,3 +182,47 @@ TEST(AccelerationCalculationTest, OpenMpAccelerationCalculationTest) {
 	// Clean up
 	delete pAccelerationCalculation;
 }
+
+TEST(AccelerationCalculationTest, OpenMpProbesShouldMatchAccelerationsOfSubset) {
+	// Preparation
+	const size_t numBodies = 500;
+	RandomBodiesParameters parameters;
+	parameters.seed = 5;
+	TestBodies randomBodies = TestBodies::createRandom(numBodies, parameters);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	// the probes are the bodies 7 and 300 and a point without a body
+	const float probeMasses[3] = {bodies.masses[7], bodies.masses[300], 1.0f};
+	const float probePositions[9] = {
+			bodies.positions[21], bodies.positions[22], bodies.positions[23],
+			bodies.positions[900], bodies.positions[901], bodies.positions[902],
+			0.5f, 0.5f, 0.5f
+	};
+	const std::unique_ptr<IAccelerationCalculation> pOpenMp(
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP));
+	const std::unique_ptr<IAccelerationCalculation> pSequential(
+			createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL));
+	std::vector<float> allAccelerations(numBodies * 3), allPotentials(numBodies);
+	float expectedAccelerations[9], expectedPotentials[3], actualAccelerations[9], actualPotentials[3];
+
+	// Stimulation
+	pOpenMp->calcAccelerationsAndPotentials(bodies, numBodies, allAccelerations.data(), allPotentials.data(), 0.01f);
+	pSequential->calcFieldAtProbes(bodies, numBodies, probeMasses, probePositions, 3, expectedAccelerations,
+								   expectedPotentials, 0.01f);
+	pOpenMp->calcFieldAtProbes(bodies, numBodies, probeMasses, probePositions, 3, actualAccelerations,
+							   actualPotentials, 0.01f);
+
+	// Tests: a probe at a body excludes the body itself, as in the calculation of all bodies
+	ASSERT_TRUE(pOpenMp->isProbeEvaluationSupported());
+	for (size_t dimension = 0; dimension < 3; ++dimension) {
+		ASSERT_EQ(allAccelerations[21 + dimension], actualAccelerations[dimension]);
+		ASSERT_EQ(allAccelerations[900 + dimension], actualAccelerations[3 + dimension]);
+	}
+	ASSERT_EQ(allPotentials[7], actualPotentials[0]);
+	ASSERT_EQ(allPotentials[300], actualPotentials[1]);
+	for (size_t i = 0; i < 9; ++i) {
+		ASSERT_NEAR(expectedAccelerations[i], actualAccelerations[i], 1e-5f * std::abs(expectedAccelerations[i]));
+	}
+	for (size_t i = 0; i < 3; ++i) {
+		ASSERT_NEAR(expectedPotentials[i], actualPotentials[i], 1e-5f * std::abs(expectedPotentials[i]));
+	}
+}
@@ -0,0 +1,96 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "physics/mapped_bodies.h"
+#include "../../src/out_of_core_acceleration_calculation.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Generates random bodies in a cube.
+	 */
+	void generateRandomBodies(const Bodies<float, float, float> &bodies, const size_t numBodies) {
+		RandomBodiesParameters parameters;
+		parameters.seed = 19;
+		TestBodies::generateRandom(bodies, numBodies, parameters);
+	}
+
+	/**
+	 * @brief Returns the path of a temporary file of the passed name.
+	 */
+	std::string getTemporaryFilePath(const std::string &fileName) {
+		return (std::filesystem::temp_directory_path() / fileName).string();
+	}
+}
+
+TEST(AccelerationCalculationTest, OutOfCoreAccelerationCalculationShouldMatchOpenMp) {
+	// Preparation: the number of bodies is no multiple of the tile size
+	const size_t numBodies = 1'000;
+	std::vector<float> masses(numBodies), positions(numBodies * 3), velocities(numBodies * 3);
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	generateRandomBodies(bodies, numBodies);
+	std::vector<float> expected(numBodies * 3), actual(numBodies * 3, 1.0f);
+	std::vector<float> expectedPotentials(numBodies), actualPotentials(numBodies, 1.0f);
+	IAccelerationCalculation *const pOpenMp = createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP);
+	OutOfCoreAccelerationCalculationImpl outOfCore(NewtonianForceLaw(), 128);
+
+	// Stimulation
+	pOpenMp->calcAccelerationsAndPotentials(bodies, numBodies, expected.data(), expectedPotentials.data(), 0.01f);
+	outOfCore.calcAccelerationsAndPotentials(bodies, numBodies, actual.data(), actualPotentials.data(), 0.01f);
+
+	// Tests: the summation order differs only by the tiles
+	for (size_t i = 0; i < (numBodies * 3); ++i) {
+		ASSERT_NEAR(expected[i], actual[i], 1e-4f * (1.0f + std::abs(expected[i])));
+	}
+	for (size_t i = 0; i < numBodies; ++i) {
+		ASSERT_NEAR(expectedPotentials[i], actualPotentials[i], 1e-4f * (1.0f + std::abs(expectedPotentials[i])));
+	}
+
+	// Clean up
+	delete pOpenMp;
+}
+
+TEST(AccelerationCalculationTest, OutOfCoreAccelerationCalculationShouldRejectEmptyTiles) {
+	ASSERT_THROW(OutOfCoreAccelerationCalculationImpl(NewtonianForceLaw(), 0), std::invalid_argument);
+}
+
+TEST(MappedBodiesTest, MappedBodiesShouldPersistInTheirFile) {
+	// Preparation
+	const size_t numBodies = 3'000;
+	const std::string filePath = getTemporaryFilePath("physics_engine_mapped_bodies_test.bin");
+	std::filesystem::remove(filePath);
+	std::vector<float> expected(numBodies * 3);
+	{
+		MappedBodies mappedBodies(filePath, numBodies);
+		generateRandomBodies(mappedBodies.getBodies(), numBodies);
+		OutOfCoreAccelerationCalculationImpl outOfCore(NewtonianForceLaw(), 1'024);
+
+		// Stimulation: the accelerations are written into the mapping
+		outOfCore.calcAccelerations(mappedBodies.getBodies(), numBodies, mappedBodies.getAccelerations(), 0.01f);
+		std::copy(mappedBodies.getAccelerations(), mappedBodies.getAccelerations() + (numBodies * 3),
+				  expected.begin());
+		mappedBodies.flush();
+	}
+	{
+		const MappedBodies reopenedBodies(filePath, numBodies);
+
+		// Tests
+		ASSERT_EQ(numBodies, reopenedBodies.getNumBodies());
+		for (size_t i = 0; i < (numBodies * 3); ++i) {
+			ASSERT_EQ(expected[i], reopenedBodies.getAccelerations()[i]);
+		}
+	}
+
+	// Clean up
+	std::filesystem::remove(filePath);
+}
@@ -0,0 +1,227 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "../../src/reproducible_sum.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Creates bodies with random masses in a cube, whose accelerations are sums of very different magnitudes.
+	 */
+	TestBodies createRandomBodies(const size_t numBodies) {
+		RandomBodiesParameters parameters;
+		parameters.seed = 44;
+		parameters.maxMass = 1.5f;
+		return TestBodies::createRandom(numBodies, parameters);
+	}
+
+	/**
+	 * @brief Calculates the accelerations and the potentials of the passed bodies in the deterministic mode.
+	 */
+	void calcDeterministically(const AccelerationCalculationImplementation implementation,
+							   const Bodies<float, float, float> &bodies, const size_t numBodies,
+							   std::vector<float> &accelerations, std::vector<float> &potentials) {
+		const std::unique_ptr<IAccelerationCalculation> pCalculation(createAccelerationCalculation(implementation));
+		pCalculation->setDeterministicModeEnabled(true);
+		accelerations.assign(numBodies * 3, 0.0f);
+		potentials.assign(numBodies, 0.0f);
+		pCalculation->calcAccelerationsAndPotentials(bodies, numBodies, accelerations.data(), potentials.data(),
+													 0.01f);
+	}
+
+	/**
+	 * @brief Returns whether the passed floats have the same bits.
+	 */
+	bool areBitIdentical(const std::vector<float> &expected, const std::vector<float> &actual) {
+		return (expected.size() == actual.size()) &&
+			   (0 == std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(float)));
+	}
+}
+
+TEST(ReproducibleSumTest, SumShouldNotDependOnOrder) {
+	// Preparation
+	std::mt19937 engine(45);
+	std::uniform_real_distribution<float> exponentDistribution(-30.0f, 30.0f);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	std::vector<float> summands(10'000);
+	for (float &summand: summands) {
+		summand = distribution(engine) * std::exp2(exponentDistribution(engine));
+	}
+	ReproducibleSum sum;
+
+	// Stimulation
+	for (const float summand: summands) {
+		sum.add(summand);
+	}
+
+	// Tests
+	for (int permutation = 0; permutation < 5; ++permutation) {
+		std::shuffle(summands.begin(), summands.end(), engine);
+		ReproducibleSum shuffledSum;
+		for (const float summand: summands) {
+			shuffledSum.add(summand);
+		}
+		const float expected = sum.getValue();
+		const float actual = shuffledSum.getValue();
+		ASSERT_EQ(0, std::memcmp(&expected, &actual, sizeof(float)));
+	}
+}
+
+TEST(ReproducibleSumTest, SumShouldBeExact) {
+	// Preparation
+	ReproducibleSum sum;
+	ReproducibleSum subnormalSum;
+	ReproducibleSum negativeSum;
+
+	// Stimulation
+	sum.add(1e30f);
+	sum.add(1.0f);
+	sum.add(-1e30f);
+	subnormalSum.add(std::numeric_limits<float>::denorm_min());
+	subnormalSum.add(std::numeric_limits<float>::max());
+	subnormalSum.add(-std::numeric_limits<float>::max());
+	negativeSum.add(-0.1f);
+	negativeSum.add(-0.2f);
+
+	// Tests
+	// a float sum would cancel the small summands, which the exact sum keeps
+	ASSERT_EQ(1.0f, sum.getValue());
+	ASSERT_EQ(std::numeric_limits<float>::denorm_min(), subnormalSum.getValue());
+	ASSERT_EQ(static_cast<float>(-(static_cast<double>(0.1f) + static_cast<double>(0.2f))), negativeSum.getValue());
+	ASSERT_EQ(0.0f, ReproducibleSum().getValue());
+}
+
+TEST(ReproducibleSumTest, SumShouldPropagateInfinitiesAndNaNs) {
+	// Preparation
+	ReproducibleSum infiniteSum;
+	ReproducibleSum nanSum;
+
+	// Stimulation
+	infiniteSum.add(1.0f);
+	infiniteSum.add(std::numeric_limits<float>::infinity());
+	nanSum.add(std::numeric_limits<float>::infinity());
+	nanSum.add(-std::numeric_limits<float>::infinity());
+
+	// Tests
+	ASSERT_EQ(std::numeric_limits<float>::infinity(), infiniteSum.getValue());
+	ASSERT_TRUE(std::isnan(nanSum.getValue()));
+}
+
+TEST(ReproducibleSumTest, DeterministicModeShouldBeBitIdenticalAcrossImplementations) {
+	// Preparation
+	const size_t numBodies = 500;
+	const size_t numSmallBodies = 7;
+	TestBodies randomBodies = createRandomBodies(numBodies);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	std::vector<float> sequentialAccelerations, sequentialPotentials;
+	std::vector<float> openMpAccelerations, openMpPotentials;
+	std::vector<float> smallSequentialAccelerations, smallSequentialPotentials;
+	std::vector<float> smallNAccelerations, smallNPotentials;
+
+	// Stimulation
+	calcDeterministically(AccelerationCalculationImplementation::SEQUENTIAL, bodies, numBodies,
+						  sequentialAccelerations, sequentialPotentials);
+	calcDeterministically(AccelerationCalculationImplementation::OPEN_MP, bodies, numBodies, openMpAccelerations,
+						  openMpPotentials);
+	calcDeterministically(AccelerationCalculationImplementation::SEQUENTIAL, bodies, numSmallBodies,
+						  smallSequentialAccelerations, smallSequentialPotentials);
+	calcDeterministically(AccelerationCalculationImplementation::SMALL_N, bodies, numSmallBodies,
+						  smallNAccelerations, smallNPotentials);
+
+	// Tests
+	ASSERT_TRUE(areBitIdentical(sequentialAccelerations, openMpAccelerations));
+	ASSERT_TRUE(areBitIdentical(sequentialPotentials, openMpPotentials));
+	ASSERT_TRUE(areBitIdentical(smallSequentialAccelerations, smallNAccelerations));
+	ASSERT_TRUE(areBitIdentical(smallSequentialPotentials, smallNPotentials));
+}
+
+TEST(ReproducibleSumTest, DeterministicModeShouldNotDependOnThreadsOrOrder) {
+	// Preparation
+	const size_t numBodies = 1000;
+	TestBodies randomBodies = createRandomBodies(numBodies);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	// the same bodies in reverse order, so the pairs of each target are visited in another order
+	TestBodies reversedBodies(numBodies);
+	std::vector<size_t> permutation(numBodies);
+	std::iota(permutation.rbegin(), permutation.rend(), 0);
+	for (size_t i = 0; i < numBodies; ++i) {
+		reversedBodies.masses[i] = randomBodies.masses[permutation[i]];
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			reversedBodies.positions[(i * 3) + dimension] = randomBodies.positions[(permutation[i] * 3) + dimension];
+		}
+	}
+	const std::unique_ptr<IAccelerationCalculation> pCalculation(
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP));
+	pCalculation->setDeterministicModeEnabled(true);
+	// the compression would change the sums, so it must not be combined with the deterministic mode
+	ASSERT_THROW(pCalculation->setPositionCompressionEnabled(true), std::logic_error);
+	std::vector<float> accelerations(numBodies * 3);
+	std::vector<float> rangeAccelerations(numBodies * 3);
+	std::vector<float> reversedAccelerations(numBodies * 3);
+
+	// Stimulation
+	pCalculation->calcAccelerations(bodies, numBodies, accelerations.data(), 0.01f);
+	// the number of threads depends on the number of targets, so a few ranges run with fewer threads
+	const size_t rangeEnds[] = {1, 3, 10, 100, numBodies};
+	size_t rangeBegin = 0;
+	for (const size_t rangeEnd: rangeEnds) {
+		pCalculation->calcAccelerationsOfTargetRange(bodies, numBodies, rangeBegin, rangeEnd,
+													 rangeAccelerations.data(), 0.01f);
+		rangeBegin = rangeEnd;
+	}
+	pCalculation->calcAccelerations(reversedBodies.asBodies(), numBodies, reversedAccelerations.data(), 0.01f);
+
+	// Tests
+	ASSERT_TRUE(areBitIdentical(accelerations, rangeAccelerations));
+	for (size_t i = 0; i < numBodies; ++i) {
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			const float expected = accelerations[(permutation[i] * 3) + dimension];
+			const float actual = reversedAccelerations[(i * 3) + dimension];
+			ASSERT_EQ(0, std::memcmp(&expected, &actual, sizeof(float))) << "at " << i;
+		}
+	}
+}
+
+TEST(ReproducibleSumTest, DeterministicModeShouldBeCloseToDefaultMode) {
+	// Preparation
+	const size_t numBodies = 300;
+	TestBodies randomBodies = createRandomBodies(numBodies);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+	const std::unique_ptr<IAccelerationCalculation> pCalculation(
+			createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL));
+	std::vector<float> accelerations(numBodies * 3);
+	std::vector<float> deterministicAccelerations(numBodies * 3);
+
+	// Stimulation
+	pCalculation->calcAccelerations(bodies, numBodies, accelerations.data(), 0.01f);
+	pCalculation->setDeterministicModeEnabled(true);
+	pCalculation->calcAccelerations(bodies, numBodies, deterministicAccelerations.data(), 0.01f);
+
+	// Tests
+	for (size_t i = 0; i < numBodies * 3; ++i) {
+		ASSERT_NEAR(accelerations[i], deterministicAccelerations[i], 1e-3f * (1.0f + std::abs(accelerations[i])));
+	}
+}
+
+TEST(ReproducibleSumTest, DeterministicModeShouldOnlyBeEnabledIfSupported) {
+	const std::unique_ptr<IAccelerationCalculation> pOpenMp(
+			createAccelerationCalculation(AccelerationCalculationImplementation::OPEN_MP));
+	const std::unique_ptr<IAccelerationCalculation> pTreePm(
+			createAccelerationCalculation(AccelerationCalculationImplementation::TREE_PM));
+	ASSERT_TRUE(pOpenMp->isDeterministicModeSupported());
+	ASSERT_FALSE(pTreePm->isDeterministicModeSupported());
+	ASSERT_NO_THROW(pTreePm->setDeterministicModeEnabled(false));
+	ASSERT_THROW(pTreePm->setDeterministicModeEnabled(true), std::logic_error);
+}
@@ -0,0 +1,91 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "../../src/small_n_acceleration_calculation.h"
+#include "../../src/sequential_acceleration_calculation.h"
+#include "test_bodies.h"
+
+using namespace physics;
+
+namespace {
+	/**
+	 * @brief Creates random bodies in a cube, which depend on the passed seed only.
+	 */
+	TestBodies createRandomBodies(const size_t numBodies, const uint64_t seed) {
+		RandomBodiesParameters parameters;
+		parameters.seed = seed;
+		return TestBodies::createRandom(numBodies, parameters);
+	}
+
+	void assertNear(const std::vector<float> &expected, const std::vector<float> &actual) {
+		ASSERT_EQ(expected.size(), actual.size());
+		for (size_t i = 0; i < expected.size(); ++i) {
+			ASSERT_NEAR(expected[i], actual[i], 1e-5f * std::max(1.0f, std::abs(expected[i]))) << "at index " << i;
+		}
+	}
+}
+
+TEST(AccelerationCalculationTest, SmallNAccelerationCalculationShouldMatchSequentialForEachNumberOfBodies) {
+	SequentialAccelerationCalculationImpl sequential;
+	SmallNAccelerationCalculationImpl smallN;
+	// the numbers of bodies include the fully unrolled kernels, the looping kernels and the fallback
+	for (size_t numBodies = 0; numBodies <= (SmallNAccelerationCalculationImpl::MAX_NUM_BODIES + 3); ++numBodies) {
+		// Preparation
+		TestBodies randomBodies = createRandomBodies(numBodies, numBodies);
+		std::vector<float> expected(numBodies * 3), actual(numBodies * 3, 1.0f);
+
+		// Stimulation
+		sequential.calcAccelerations(randomBodies.asBodies(), numBodies, expected.data(), 0.01f);
+		smallN.calcAccelerations(randomBodies.asBodies(), numBodies, actual.data(), 0.01f);
+
+		// Test
+		assertNear(expected, actual);
+	}
+}
+
+TEST(AccelerationCalculationTest, SmallNAccelerationCalculationShouldMatchSequentialPotentials) {
+	for (const size_t numBodies: {3, 16, 17, 64}) {
+		// Preparation
+		TestBodies randomBodies = createRandomBodies(numBodies, 42);
+		std::vector<float> expectedAccelerations(numBodies * 3), actualAccelerations(numBodies * 3);
+		std::vector<float> expectedPotentials(numBodies), actualPotentials(numBodies, 1.0f);
+		BasicSequentialAccelerationCalculationImpl<YukawaForceLaw> sequential;
+		BasicSmallNAccelerationCalculationImpl<YukawaForceLaw> smallN;
+
+		// Stimulation
+		sequential.calcAccelerationsAndPotentials(randomBodies.asBodies(), numBodies, expectedAccelerations.data(),
+												  expectedPotentials.data(), 0.01f);
+		smallN.calcAccelerationsAndPotentials(randomBodies.asBodies(), numBodies, actualAccelerations.data(),
+											  actualPotentials.data(), 0.01f);
+
+		// Test
+		assertNear(expectedAccelerations, actualAccelerations);
+		assertNear(expectedPotentials, actualPotentials);
+	}
+}
+
+TEST(AccelerationCalculationTest, SmallNAccelerationCalculationShouldWriteOnlyTheTargetRange) {
+	// Preparation
+	const size_t numBodies = 12;
+	TestBodies randomBodies = createRandomBodies(numBodies, 7);
+	std::vector<float> expected(numBodies * 3), actual(numBodies * 3, -1.0f);
+	SmallNAccelerationCalculationImpl smallN;
+	smallN.calcAccelerations(randomBodies.asBodies(), numBodies, expected.data(), 0.01f);
+
+	// Stimulation
+	smallN.calcAccelerationsOfTargetRange(randomBodies.asBodies(), numBodies, 4, 9, actual.data(), 0.01f);
+
+	// Tests
+	ASSERT_TRUE(smallN.isTargetRangeSupported());
+	for (size_t i = 0; i < (numBodies * 3); ++i) {
+		if ((i < (4 * 3)) || ((9 * 3) <= i)) {
+			ASSERT_EQ(-1.0f, actual[i]) << "at index " << i;
+		} else {
+			ASSERT_EQ(expected[i], actual[i]) << "at index " << i;
+		}
+	}
+}
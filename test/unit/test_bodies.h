@@ -0,0 +1,132 @@
+#ifndef PHYSICS_ENGINE_TEST_BODIES_H
+#define PHYSICS_ENGINE_TEST_BODIES_H
+
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "physics/bodies.h"
+#include "physics/initial_conditions.h"
+
+/**
+ * @brief The parameters of the random bodies of the unit tests.
+ */
+struct RandomBodiesParameters {
+
+	/**
+	 * The seed of the random numbers.
+	 */
+	uint64_t seed = 0;
+
+	/**
+	 * The inclusive minimum of the uniformly distributed masses.
+	 */
+	float minMass = 0.5f;
+
+	/**
+	 * The exclusive maximum of the uniformly distributed masses, equal to <code>minMass</code> for equal masses.
+	 */
+	float maxMass = 2.0f;
+
+	/**
+	 * The half of the edge length of the cube around the origin, in which the positions are uniformly distributed.
+	 */
+	float halfExtent = 1.0f;
+
+	/**
+	 * The maximum of each component of the uniformly distributed velocities, 0 for bodies at rest.
+	 */
+	float maxSpeed = 0.0f;
+
+	/**
+	 * The standard deviation of the normally distributed positions of every second body around the origin, 0 to
+	 * distribute all positions in the cube.
+	 */
+	float clusterStandardDeviation = 0.0f;
+};
+
+/**
+ * @brief The bodies of the unit tests, whose masses, positions and velocities are kept alive by vectors.
+ */
+struct TestBodies {
+	std::vector<float> masses, positions, velocities;
+
+	/**
+	 * @brief Creates bodies of unit masses at rest in the origin.
+	 * @param numBodies the number of bodies.
+	 */
+	explicit TestBodies(const size_t numBodies) :
+			masses(numBodies, 1.0f), positions(numBodies * 3, 0.0f), velocities(numBodies * 3, 0.0f) {
+	}
+
+	/**
+	 * @brief Creates bodies of the passed masses, positions and velocities.
+	 */
+	TestBodies(std::vector<float> masses, std::vector<float> positions, std::vector<float> velocities) :
+			masses(std::move(masses)), positions(std::move(positions)), velocities(std::move(velocities)) {
+	}
+
+	physics::Bodies<float, float, float> asBodies() {
+		return {masses.data(), positions.data(), velocities.data()};
+	}
+
+	/**
+	 * @brief Sets random bodies, whose values depend on the parameters only. Each body draws its mass, its position
+	 * and its velocity in this order.
+	 * @param[out] bodies the bodies to be set.
+	 * @param numBodies the number of bodies.
+	 * @param parameters the parameters of the bodies.
+	 */
+	static void generateRandom(const physics::Bodies<float, float, float> &bodies, const size_t numBodies,
+							   const RandomBodiesParameters &parameters) {
+		std::mt19937_64 engine(parameters.seed);
+		std::uniform_real_distribution<float> massDistribution(parameters.minMass, parameters.maxMass);
+		std::uniform_real_distribution<float> positionDistribution(-parameters.halfExtent, parameters.halfExtent);
+		std::uniform_real_distribution<float> velocityDistribution(-parameters.maxSpeed, parameters.maxSpeed);
+		std::normal_distribution<float> clusterDistribution(0.0f, parameters.clusterStandardDeviation);
+		for (size_t i = 0; i < numBodies; ++i) {
+			const bool isClustered = (0.0f < parameters.clusterStandardDeviation) && (0 == (i % 2));
+			bodies.masses[i] = massDistribution(engine);
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				bodies.positions[(i * 3) + dimension] = isClustered ? clusterDistribution(engine)
+																	: positionDistribution(engine);
+			}
+			for (size_t dimension = 0; dimension < 3; ++dimension) {
+				bodies.velocities[(i * 3) + dimension] = velocityDistribution(engine);
+			}
+		}
+	}
+
+	/**
+	 * @brief Creates random bodies, see <code>generateRandom</code>.
+	 */
+	static TestBodies createRandom(const size_t numBodies, const RandomBodiesParameters &parameters) {
+		TestBodies testBodies(numBodies);
+		generateRandom(testBodies.asBodies(), numBodies, parameters);
+		return testBodies;
+	}
+
+	/**
+	 * @brief Creates the bodies of a scenario, see <code>physics::generateScenario</code>.
+	 */
+	static TestBodies createScenario(const physics::Scenario scenario, const size_t numBodies,
+									 const physics::ScenarioParameters &parameters) {
+		TestBodies testBodies(numBodies);
+		physics::generateScenario(scenario, testBodies.asBodies(), numBodies, parameters);
+		return testBodies;
+	}
+
+	/**
+	 * @brief Creates three bodies, which are heavy enough to move each other noticeably.
+	 */
+	static TestBodies createThreeBodies() {
+		return {{1e10f, 2e10f, 3e10f},
+				{-1.0f, 0.0f, 0.0f, 1.0f, 0.5f, 0.0f, 0.0f, -1.0f, 0.5f},
+				{0.0f, 0.1f, 0.0f, 0.0f, 0.0f, -0.1f, 0.1f, 0.0f, 0.0f}};
+	}
+};
+
+#endif //PHYSICS_ENGINE_TEST_BODIES_H
@@ -0,0 +1,205 @@
+// Reminder: Always include standard library and system headers before including your own headers.
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "physics/acceleration_calculation_factory.h"
+#include "commons/math.h"
+#include "test_bodies.h"
+
+namespace {
+	float calc3dVectorLength(const float *vector3d) {
+		const size_t xCoordinate = 0, yCoordinate = 1, zCoordinate = 2;
+		return std::sqrt(
+				commons::math::pow2(vector3d[xCoordinate]) +
+				commons::math::pow2(vector3d[yCoordinate]) +
+				commons::math::pow2(vector3d[zCoordinate])
+		);
+	}
+
+	/**
+	 * Returns the relative errors of the accelerations of the TreePM implementation compared with the sequential
+	 * direct summation for the passed bodies and squared softening factor, sorted ascending.
+	 */
+	std::vector<float> calcSortedRelativeErrors(const physics::Bodies<float, float, float> &bodies,
+												const size_t numBodies, const float squaredSofteningFactor = 0.0f) {
+		using namespace physics;
+		IAccelerationCalculation *const pTreePm =
+				createAccelerationCalculation(AccelerationCalculationImplementation::TREE_PM);
+		IAccelerationCalculation *const pSequential =
+				createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL);
+		std::vector<float> expected(numBodies * 3, 0.0f);
+		std::vector<float> actual(numBodies * 3, 0.0f);
+
+		pSequential->calcAccelerations(bodies, numBodies, expected.data(), squaredSofteningFactor);
+		pTreePm->calcAccelerations(bodies, numBodies, actual.data(), squaredSofteningFactor);
+
+		std::vector<float> relativeErrors(numBodies);
+		for (size_t i = 0; i < numBodies; ++i) {
+			const float difference[3] = {
+					actual[(i * 3)] - expected[(i * 3)],
+					actual[(i * 3) + 1] - expected[(i * 3) + 1],
+					actual[(i * 3) + 2] - expected[(i * 3) + 2]
+			};
+			relativeErrors[i] = calc3dVectorLength(difference) / calc3dVectorLength(&expected[i * 3]);
+		}
+		std::sort(relativeErrors.begin(), relativeErrors.end());
+
+		delete pTreePm;
+		delete pSequential;
+		return relativeErrors;
+	}
+}
+
+using namespace physics;
+
+TEST(AccelerationCalculationTest, TreePmAccelerationCalculationTest) {
+	// Preparation
+	// These values were pulled from NASA on 05/28/2022
+	const float sunMass = 1.988409871326422e+21;
+	const float sunPositionXCoordinate = 60764136.34568623 * 1000;
+	const float sunPositionYCoordinate = 138876778.5691075 * 1000;
+	const float sunPositionZCoordinate = -7392.035766117275 * 1000;
+
+	const float venusMass = 4867305814842006.0;
+	const float venusPositionXCoordinate = 155963686.5097929 * 1000;
+	const float venusPositionYCoordinate = 86372916.2720451 * 1000;
+	const float venusPositionZCoordinate = -6221383.90401521 * 1000;
+
+	const float marsMass = 641690892138501.5;
+	const float marsPositionXCoordinate = 220994088.6927211 * 1000;
+	const float marsPositionYCoordinate = 7535624.027122181 * 1000;
+	const float marsPositionZCoordinate = -6690421.407387457 * 1000;
+
+	const float squaredSofteningFactor = 0.00f;
+
+	IAccelerationCalculation *const pAccelerationCalculation =
+			createAccelerationCalculation(AccelerationCalculationImplementation::TREE_PM);
+
+	// Test case: Interaction between sun, venus and mars, which is mostly long-range
+	{
+		const size_t numBodies = 3;
+		Bodies<float, float, float> bodies{new float[numBodies], new float[numBodies * 3], new float[numBodies * 3]};
+		bodies.masses[0] = sunMass;
+		bodies.masses[1] = venusMass;
+		bodies.masses[2] = marsMass;
+		bodies.positions[0] = sunPositionXCoordinate;
+		bodies.positions[1] = sunPositionYCoordinate;
+		bodies.positions[2] = sunPositionZCoordinate;
+		bodies.positions[3] = venusPositionXCoordinate;
+		bodies.positions[4] = venusPositionYCoordinate;
+		bodies.positions[5] = venusPositionZCoordinate;
+		bodies.positions[6] = marsPositionXCoordinate;
+		bodies.positions[7] = marsPositionYCoordinate;
+		bodies.positions[8] = marsPositionZCoordinate;
+
+		auto *const accelerations = new float[numBodies * 3]();
+
+		// Stimulation
+		pAccelerationCalculation->calcAccelerations(bodies, numBodies, accelerations, squaredSofteningFactor);
+
+		// Tests
+		// The expected values are those of the direct summation, the tolerance is the accuracy of the mesh.
+		ASSERT_NEAR(2.83921921e-17, calc3dVectorLength(&accelerations[0]), 2.83921921e-17 * 0.01);
+		ASSERT_NEAR(1.11916987e-11, calc3dVectorLength(&accelerations[3]), 1.11916987e-11 * 0.01);
+		ASSERT_NEAR(3.0886132e-12, calc3dVectorLength(&accelerations[6]), 3.0886132e-12 * 0.01);
+
+		delete[] bodies.masses;
+		delete[] bodies.positions;
+		delete[] bodies.velocities;
+		delete[] accelerations;
+	}
+
+	// Clean up
+	delete pAccelerationCalculation;
+}
+
+TEST(AccelerationCalculationTest, TreePmAccelerationCalculationShouldMatchDirectSummation) {
+	// Preparation
+	const size_t numBodies = 4'000;
+	// half of the bodies are clustered, so both the short- and the long-range part matter
+	RandomBodiesParameters parameters;
+	parameters.seed = 42;
+	parameters.minMass = 1.0e+9f;
+	parameters.maxMass = 1.0e+10f;
+	parameters.halfExtent = 100.0f;
+	parameters.clusterStandardDeviation = 10.0f;
+	TestBodies clusteredBodies = TestBodies::createRandom(numBodies, parameters);
+	const Bodies<float, float, float> bodies = clusteredBodies.asBodies();
+
+	// Stimulation
+	const std::vector<float> relativeErrors = calcSortedRelativeErrors(bodies, numBodies);
+
+	// Tests
+	ASSERT_LT(relativeErrors[numBodies / 2], 5e-3); // median
+	ASSERT_LT(relativeErrors[(numBodies * 99) / 100], 3e-2); // 99th percentile
+}
+
+TEST(AccelerationCalculationTest, SoftenedTreePmAccelerationCalculationShouldMatchDirectSummation) {
+	// Preparation: the softening factor of 20 is far beyond the split scale of a few mesh cells of about 3.5
+	const size_t numBodies = 4'000;
+	RandomBodiesParameters parameters;
+	parameters.seed = 7;
+	parameters.minMass = 1.0e+9f;
+	parameters.maxMass = 1.0e+10f;
+	parameters.halfExtent = 100.0f;
+	TestBodies randomBodies = TestBodies::createRandom(numBodies, parameters);
+	const Bodies<float, float, float> bodies = randomBodies.asBodies();
+
+	// Stimulation
+	const std::vector<float> relativeErrors = calcSortedRelativeErrors(bodies, numBodies, 400.0f);
+
+	// Tests: the long-range part is not softened, so the split scale must cover the softening
+	ASSERT_LT(relativeErrors[numBodies / 2], 1e-2); // median
+	ASSERT_LT(relativeErrors[(numBodies * 99) / 100], 3e-2); // 99th percentile
+}
+
+TEST(AccelerationCalculationTest, TreePmProbesShouldMatchDirectSummation) {
+	// Preparation
+	const size_t numBodies = 4'000;
+	const size_t numProbes = 50;
+	std::vector<float> masses(numBodies), positions(numBodies * 3), velocities(numBodies * 3, 0.0f);
+	std::mt19937 engine(17);
+	std::uniform_real_distribution<float> massDistribution(1.0e+9f, 1.0e+10f);
+	std::normal_distribution<float> clusterDistribution(0.0f, 10.0f);
+	for (size_t i = 0; i < numBodies; ++i) {
+		masses[i] = massDistribution(engine);
+		for (size_t dimension = 0; dimension < 3; ++dimension) {
+			positions[(i * 3) + dimension] = clusterDistribution(engine);
+		}
+	}
+	// the probes are spread beyond the bodies, where the mesh of the long-range part does not reach
+	std::uniform_real_distribution<float> probeDistribution(-100.0f, 100.0f);
+	std::vector<float> probeMasses(numProbes, 1.0f), probePositions(numProbes * 3);
+	for (float &coordinate: probePositions) {
+		coordinate = probeDistribution(engine);
+	}
+	const Bodies<float, float, float> bodies{masses.data(), positions.data(), velocities.data()};
+	const std::unique_ptr<IAccelerationCalculation> pTreePm(
+			createAccelerationCalculation(AccelerationCalculationImplementation::TREE_PM));
+	const std::unique_ptr<IAccelerationCalculation> pSequential(
+			createAccelerationCalculation(AccelerationCalculationImplementation::SEQUENTIAL));
+	std::vector<float> expectedAccelerations(numProbes * 3), actualAccelerations(numProbes * 3);
+	std::vector<float> expectedPotentials(numProbes), actualPotentials(numProbes);
+
+	// Stimulation
+	pSequential->calcFieldAtProbes(bodies, numBodies, probeMasses.data(), probePositions.data(), numProbes,
+								   expectedAccelerations.data(), expectedPotentials.data(), 0.0f);
+	pTreePm->calcFieldAtProbes(bodies, numBodies, probeMasses.data(), probePositions.data(), numProbes,
+							   actualAccelerations.data(), actualPotentials.data(), 0.0f);
+
+	// Tests
+	ASSERT_TRUE(pTreePm->isProbeEvaluationSupported());
+	for (size_t i = 0; i < numProbes; ++i) {
+		const float difference[3] = {
+				actualAccelerations[(i * 3)] - expectedAccelerations[(i * 3)],
+				actualAccelerations[(i * 3) + 1] - expectedAccelerations[(i * 3) + 1],
+				actualAccelerations[(i * 3) + 2] - expectedAccelerations[(i * 3) + 2]
+		};
+		ASSERT_LT(calc3dVectorLength(difference), 1e-2f * calc3dVectorLength(&expectedAccelerations[i * 3]));
+		ASSERT_NEAR(expectedPotentials[i], actualPotentials[i], 1e-2f * std::abs(expectedPotentials[i]));
+	}
+}